@@ -1442,6 +1442,12 @@ CodeBlock::CodeBlock(CopyParsedBlockTag, CodeBlock& other, SymbolTable* symTab)
     setNumParameters(other.numParameters());
     optimizeAfterWarmUp();
     jitAfterWarmUp();
+
+#ifdef ARTEMIS
+    m_artemisTier = ArtemisTierUndecided;
+    m_artemisBlockLeaders = other.m_artemisBlockLeaders;
+    m_artemisFunctionId = other.m_artemisFunctionId;
+#endif
     
     if (other.m_rareData) {
         createRareDataIfNecessary();
@@ -1489,6 +1495,11 @@ CodeBlock::CodeBlock(ScriptExecutable* ownerExecutable, CodeType codeType, JSGlo
     optimizeAfterWarmUp();
     jitAfterWarmUp();
 
+#ifdef ARTEMIS
+    m_artemisTier = ArtemisTierUndecided;
+    m_artemisFunctionId = 0;
+#endif
+
 #if DUMP_CODE_BLOCK_STATISTICS
     liveCodeBlockSet.add(this);
 #endif
@@ -2105,6 +2116,23 @@ bool CodeBlock::hasGlobalResolveInfoAtBytecodeOffset(unsigned bytecodeOffset)
 }
 #endif
 
+#ifdef ARTEMIS
+void CodeBlock::computeArtemisBlockLeaders()
+{
+    m_artemisBlockLeaders.ensureSize(instructions().size());
+    m_artemisBlockLeaders.clearAll();
+
+    if (instructions().size())
+        m_artemisBlockLeaders.quickSet(0);
+
+    // Every label is recorded as a jump target, which covers branch, switch and exception handler targets.
+    for (size_t i = 0; i < m_jumpTargets.size(); ++i) {
+        if (m_jumpTargets[i] < instructions().size())
+            m_artemisBlockLeaders.quickSet(m_jumpTargets[i]);
+    }
+}
+#endif
+
 void CodeBlock::shrinkToFit()
 {
 #if ENABLE(CLASSIC_INTERPRETER)
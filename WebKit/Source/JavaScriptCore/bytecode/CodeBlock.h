@@ -62,6 +62,9 @@
 #include "UnconditionalFinalizer.h"
 #include "ValueProfile.h"
 #include <wtf/RefCountedArray.h>
+#ifdef ARTEMIS
+#include <wtf/BitVector.h>
+#endif
 #include <wtf/FastAllocBase.h>
 #include <wtf/PassOwnPtr.h>
 #include <wtf/RefPtr.h>
@@ -459,6 +462,22 @@ namespace JSC {
         SourceProvider* source() const { return m_source.get(); }
         unsigned sourceOffset() const { return m_sourceOffset; }
 
+#ifdef ARTEMIS
+        // Instrumentation tier used by the classic interpreter, see Interpreter::shouldReportBytecode.
+        enum ArtemisTier { ArtemisTierUndecided, ArtemisTierInstrumented, ArtemisTierUninstrumented };
+        ArtemisTier artemisTier() const { return m_artemisTier; }
+        void setArtemisTier(ArtemisTier tier) { m_artemisTier = tier; }
+
+        // Bytecode offsets starting a basic block, i.e. offset 0 and every jump target. Instructions
+        // between two leaders always execute together, so coverage is reported per straight-line run.
+        void computeArtemisBlockLeaders();
+        bool isArtemisBlockLeader(unsigned bytecodeOffset) const { return m_artemisBlockLeaders.quickGet(bytecodeOffset); }
+
+        // Interned id of the function, 0 until the code block is first entered, see Interpreter::reportFunctionCalled.
+        unsigned artemisFunctionId() const { return m_artemisFunctionId; }
+        void setArtemisFunctionId(unsigned functionId) { m_artemisFunctionId = functionId; }
+#endif
+
         size_t numberOfJumpTargets() const { return m_jumpTargets.size(); }
         void addJumpTarget(unsigned jumpTarget) { m_jumpTargets.append(jumpTarget); }
         unsigned jumpTarget(int index) const { return m_jumpTargets[index]; }
@@ -1149,6 +1168,12 @@ namespace JSC {
         RefPtr<SourceProvider> m_source;
         unsigned m_sourceOffset;
 
+#ifdef ARTEMIS
+        ArtemisTier m_artemisTier;
+        BitVector m_artemisBlockLeaders;
+        unsigned m_artemisFunctionId;
+#endif
+
         Vector<unsigned> m_propertyAccessInstructions;
         Vector<unsigned> m_globalResolveInstructions;
 #if ENABLE(LLINT)
@@ -32,6 +32,7 @@
 #include "BytecodeGenerator.h"
 
 #include "BatchedTransitionOptimizer.h"
+#include "Debugger.h"
 #include "JSActivation.h"
 #include "JSFunction.h"
 #include "Interpreter.h"
@@ -163,6 +164,16 @@ void ResolveResult::checkValidity()
 
 static bool s_dumpsGeneratedCode = false;
 
+static inline bool shouldEmitDebugHooks(JSGlobalObject* globalObject)
+{
+    Debugger* debugger = globalObject->debugger();
+#ifdef ARTEMIS
+    return debugger && debugger->needsExecutionHooks();
+#else
+    return debugger;
+#endif
+}
+
 void BytecodeGenerator::setDumpsGeneratedCode(bool dumpsGeneratedCode)
 {
     s_dumpsGeneratedCode = dumpsGeneratedCode;
@@ -182,6 +193,9 @@ JSObject* BytecodeGenerator::generate()
     m_scopeNode->emitBytecode(*this);
     
     m_codeBlock->instructions() = RefCountedArray<Instruction>(m_instructions);
+#ifdef ARTEMIS
+    m_codeBlock->computeArtemisBlockLeaders();
+#endif
 
     if (s_dumpsGeneratedCode)
         m_codeBlock->dump(m_scopeChain->globalObject->globalExec());
@@ -228,7 +242,7 @@ void BytecodeGenerator::preserveLastVar()
 }
 
 BytecodeGenerator::BytecodeGenerator(ProgramNode* programNode, ScopeChainNode* scopeChain, SymbolTable* symbolTable, ProgramCodeBlock* codeBlock, CompilationKind compilationKind)
-    : m_shouldEmitDebugHooks(scopeChain->globalObject->debugger())
+    : m_shouldEmitDebugHooks(shouldEmitDebugHooks(scopeChain->globalObject.get()))
     , m_shouldEmitProfileHooks(scopeChain->globalObject->globalObjectMethodTable()->supportsProfiling(scopeChain->globalObject.get()))
     , m_shouldEmitRichSourceInfo(scopeChain->globalObject->globalObjectMethodTable()->supportsRichSourceInfo(scopeChain->globalObject.get()))
     , m_scopeChain(*scopeChain->globalData, scopeChain)
@@ -299,7 +313,7 @@ BytecodeGenerator::BytecodeGenerator(ProgramNode* programNode, ScopeChainNode* s
 }
 
 BytecodeGenerator::BytecodeGenerator(FunctionBodyNode* functionBody, ScopeChainNode* scopeChain, SymbolTable* symbolTable, CodeBlock* codeBlock, CompilationKind)
-    : m_shouldEmitDebugHooks(scopeChain->globalObject->debugger())
+    : m_shouldEmitDebugHooks(shouldEmitDebugHooks(scopeChain->globalObject.get()))
     , m_shouldEmitProfileHooks(scopeChain->globalObject->globalObjectMethodTable()->supportsProfiling(scopeChain->globalObject.get()))
     , m_shouldEmitRichSourceInfo(scopeChain->globalObject->globalObjectMethodTable()->supportsRichSourceInfo(scopeChain->globalObject.get()))
     , m_scopeChain(*scopeChain->globalData, scopeChain)
@@ -460,7 +474,7 @@ BytecodeGenerator::BytecodeGenerator(FunctionBodyNode* functionBody, ScopeChainN
 }
 
 BytecodeGenerator::BytecodeGenerator(EvalNode* evalNode, ScopeChainNode* scopeChain, SymbolTable* symbolTable, EvalCodeBlock* codeBlock, CompilationKind)
-    : m_shouldEmitDebugHooks(scopeChain->globalObject->debugger())
+    : m_shouldEmitDebugHooks(shouldEmitDebugHooks(scopeChain->globalObject.get()))
     , m_shouldEmitProfileHooks(scopeChain->globalObject->globalObjectMethodTable()->supportsProfiling(scopeChain->globalObject.get()))
     , m_shouldEmitRichSourceInfo(scopeChain->globalObject->globalObjectMethodTable()->supportsRichSourceInfo(scopeChain->globalObject.get()))
     , m_scopeChain(*scopeChain->globalData, scopeChain)
@@ -1994,6 +2008,10 @@ void BytecodeGenerator::emitDebugHook(DebugHookID debugHookID, int firstLine, in
 #if ENABLE(DEBUG_WITH_BREAKPOINT)
     if (debugHookID != DidReachBreakpoint)
         return;
+#elif defined(ARTEMIS)
+    // Statement hooks are always emitted, they drive the statement coverage (see Interpreter::debug).
+    if (!m_shouldEmitDebugHooks && debugHookID != WillExecuteStatement)
+        return;
 #else
     if (!m_shouldEmitDebugHooks)
         return;
@@ -51,6 +51,11 @@ namespace JSC {
         virtual void didExecuteProgram(const DebuggerCallFrame&, intptr_t sourceID, int lineNumber) = 0;
         virtual void didReachBreakpoint(const DebuggerCallFrame&, intptr_t sourceID, int lineNumber) = 0;
 
+#ifdef ARTEMIS
+        // Debuggers which only need sourceParsed and exception can leave out the statement, call and return hooks.
+        virtual bool needsExecutionHooks() const { return true; }
+#endif
+
         void recompileAllJSFunctions(JSGlobalData*);
 
     private:
@@ -41,6 +41,10 @@ void JSCExecutionListener::javascript_bytecode_executed(JSC::Interpreter*, JSC::
     //exit(1);
 }
 
+// Silent, this is invoked for every basic block and most listeners only need the per-bytecode hook.
+void JSCExecutionListener::javascript_bytecode_range_executed(JSC::Interpreter*, JSC::CodeBlock*, unsigned, unsigned) {
+}
+
 void JSCExecutionListener::javascript_branch_executed(bool jump, Symbolic::Expression* condition, JSC::ExecState*, const JSC::Instruction*, const JSC::BytecodeInfo&) {
     cerr << "Warning: Default listener for javascript_branch_executed was invoked " << endl;
     //exit(1);
@@ -51,6 +55,21 @@ void JSCExecutionListener::javascriptConstantStringEncountered(std::string) {
     //exit(1);
 }
 
+void JSCExecutionListener::javascript_function_called(JSC::ExecState*, JSC::CodeBlock*, unsigned)
+{
+    qWarning()  << "Warning: Default listener for javascript_function_called was invoked " << endl;
+}
+
+void JSCExecutionListener::javascript_function_returned(JSC::ExecState*, JSC::CodeBlock*, unsigned)
+{
+    qWarning()  << "Warning: Default listener for javascript_function_returned was invoked " << endl;
+}
+
+void JSCExecutionListener::javascript_statement_executed(JSC::ExecState*, JSC::CodeBlock*, int)
+{
+    qWarning()  << "Warning: Default listener for javascript_statement_executed was invoked " << endl;
+}
+
 void JSCExecutionListener::javascript_property_read(std::string, JSC::ExecState*)
 {
     qWarning()  << "Warning: Default listener for javascript_property_read was invoked " << endl;
@@ -63,6 +82,11 @@ void JSCExecutionListener::javascript_property_written(std::string, JSC::ExecSta
     //exit(1);
 }
 
+bool JSCExecutionListener::shouldInstrumentSource(JSC::SourceProvider*)
+{
+    return true;
+}
+
 JSCExecutionListener* jsc_listener = 0;
 
 void register_jsc_listener(JSCExecutionListener* listener) {
@@ -19,6 +19,7 @@
 #define JSCEXECUTIONLISTENER_H
 
 #include "JavaScriptCore/symbolic/expr.h"
+#include "JavaScriptCore/parser/SourceProvider.h"
 
 #include "bytecodeinfo.h"
 
@@ -39,9 +40,19 @@ public:
     JSCExecutionListener();
     virtual void javascript_eval_call(const char * eval_string); //__attribute__((noreturn));
     virtual void javascript_bytecode_executed(JSC::Interpreter* interpreter, JSC::CodeBlock*, JSC::Instruction* inst, const JSC::BytecodeInfo&); //__attribute__((noreturn));
+    // The concrete instructions from firstOffset to lastOffset (both inclusive) in a single basic block were executed.
+    virtual void javascript_bytecode_range_executed(JSC::Interpreter* interpreter, JSC::CodeBlock*, unsigned firstOffset, unsigned lastOffset);
     virtual void javascript_branch_executed(bool jump, Symbolic::Expression* condition, JSC::ExecState*, const JSC::Instruction*, const JSC::BytecodeInfo&);
     virtual void javascriptConstantStringEncountered(std::string constant); //__attribute__((noreturn));
 
+    // Function entry and exit. functionId identifies the function across code blocks and page loads.
+    virtual void javascript_function_called(JSC::ExecState*, JSC::CodeBlock*, unsigned functionId);
+    virtual void javascript_function_returned(JSC::ExecState*, JSC::CodeBlock*, unsigned functionId);
+    virtual void javascript_statement_executed(JSC::ExecState*, JSC::CodeBlock*, int lineNumber);
+
+    // Asked at most once per source, see isIgnoredSource.
+    virtual bool shouldInstrumentSource(JSC::SourceProvider*);
+
     /* Property Access Instrumentation */
 public:
     virtual void javascript_property_read(std::string propertyName, JSC::ExecState*); //__attribute__((noreturn));
@@ -83,6 +94,25 @@ extern JSCExecutionListener* jsc_listener;
 void register_jsc_listener(JSCExecutionListener* listener);
 JSCExecutionListener* get_jsc_listener();
 
+/**
+ * Whether the instrumentation hooks should be skipped for code from this source.
+ *
+ * The flag is normally set when the source is registered with the listener. Sources which reach a hook
+ * first are decided here, so every hook only pays for a single flag test.
+ *
+ * Code from an ignored source runs without the per bytecode, property access, constant string and
+ * concrete branch hooks. Symbolic branches are still reported, and a code block switches to full
+ * per bytecode instrumentation once it sees a symbolic value.
+ */
+inline bool isIgnoredSource(JSC::SourceProvider* source)
+{
+    if (UNLIKELY(!source->isArtemisIgnoreDecided())) {
+        source->setArtemisIgnored(!get_jsc_listener()->shouldInstrumentSource(source));
+    }
+
+    return source->isArtemisIgnored();
+}
+
 }
 
 #endif // JSCEXECUTIONLISTENER_H
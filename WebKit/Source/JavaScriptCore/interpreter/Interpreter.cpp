@@ -91,6 +91,20 @@ namespace JSC {
 #ifdef ARTEMIS
 Symbolic::SymbolicInterpreter* Interpreter::m_symbolic = new Symbolic::SymbolicInterpreter();
 bool Interpreter::m_enableInstrumentations = true;
+
+// The property access and constant string hooks are skipped for sources ignored by Artemis, before the
+// property name or string is converted for the listener.
+static ALWAYS_INLINE bool isPropertyAccessInstrumented(CallFrame* callFrame)
+{
+    return jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled() &&
+            !jscinst::isIgnoredSource(callFrame->codeBlock()->source());
+}
+
+static ALWAYS_INLINE bool isConstantStringInstrumented(CallFrame* callFrame)
+{
+    return jscinst::get_jsc_listener()->isConstantStringInstrumentationEnabled() &&
+            !jscinst::isIgnoredSource(callFrame->codeBlock()->source());
+}
 #endif
 
 // Returns the depth of the scope chain within a given call frame.
@@ -121,7 +135,7 @@ NEVER_INLINE bool Interpreter::resolve(CallFrame* callFrame, Instruction* vPC, J
     Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-    if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+    if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, ident.ascii().data());
 	}
 #endif
@@ -167,7 +181,7 @@ NEVER_INLINE bool Interpreter::resolveSkip(CallFrame* callFrame, Instruction* vP
     Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-    if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+    if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, ident.ascii().data());
 	}
 #endif
@@ -200,7 +214,7 @@ NEVER_INLINE bool Interpreter::resolveGlobal(CallFrame* callFrame, Instruction*
     int offset = vPC[4].u.operand;
 
 #ifdef ARTEMIS
-    if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+    if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
 	}
 #endif
@@ -244,7 +258,7 @@ NEVER_INLINE bool Interpreter::resolveGlobalDynamic(CallFrame* callFrame, Instru
     int skip = vPC[5].u.operand;
 
 #ifdef ARTEMIS
-    if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+    if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
 	}
 #endif
@@ -323,7 +337,7 @@ NEVER_INLINE void Interpreter::resolveBase(CallFrame* callFrame, Instruction* vP
     Identifier ident = callFrame->codeBlock()->identifier(property);
 
 #ifdef ARTEMIS
-    if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+    if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, ident.ascii().data());
 	}
 #endif
@@ -390,7 +404,7 @@ NEVER_INLINE bool Interpreter::resolveThisAndProperty(CallFrame* callFrame, Inst
     Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-    if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+    if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, ident.ascii().data());
 	}
 #endif
@@ -499,6 +513,184 @@ ALWAYS_INLINE void Interpreter::writeProperty(CallFrame* callFrame, const Symbol
 
 }
 
+/**
+ * Mixed mode execution.
+ *
+ * The JIT and the classic interpreter can not be mixed in this version of JSC, so the uninstrumented tier
+ * is the classic interpreter without the per bytecode hook. Each code block is assigned a tier the first
+ * time it executes, from the ignore flag of its source. Once a symbolic value reaches an uninstrumented code block the
+ * block is moved to the instrumented tier for the rest of its lifetime, starting with the current bytecode.
+ */
+ALWAYS_INLINE bool Interpreter::shouldReportBytecode(CodeBlock* codeBlock, const BytecodeInfo& info)
+{
+    if (UNLIKELY(codeBlock->artemisTier() == CodeBlock::ArtemisTierUndecided)) {
+        decideArtemisTier(codeBlock);
+    }
+
+    if (LIKELY(codeBlock->artemisTier() == CodeBlock::ArtemisTierInstrumented)) {
+        return true;
+    }
+
+    if (UNLIKELY(info.isSymbolic())) {
+        codeBlock->setArtemisTier(CodeBlock::ArtemisTierInstrumented);
+        return true;
+    }
+
+    return false;
+}
+
+NEVER_INLINE void Interpreter::decideArtemisTier(CodeBlock* codeBlock)
+{
+    codeBlock->setArtemisTier(jscinst::isIgnoredSource(codeBlock->source()) ?
+                                  CodeBlock::ArtemisTierUninstrumented : CodeBlock::ArtemisTierInstrumented);
+}
+
+/*
+ * Gates for the ail_* hooks of the symbolic interpreter, so it is only entered where it has work to do.
+ *
+ * Concrete operands never produce a symbolic result, so binary operations only enter the symbolic
+ * interpreter when one of the operands carries the symbolic tag. Branches are reported even when their
+ * condition is concrete, as concrete branches are part of the trace, except in code blocks of ignored
+ * sources where the hook drops them anyway. Calls carry no symbolic state, so they are skipped in the
+ * uninstrumented tier as well. The tier test is a load and a compare, the hooks are out of line calls.
+ */
+ALWAYS_INLINE JSValue Interpreter::symbolicBinaryOp(CallFrame* callFrame, const Instruction* vPC, BytecodeInfo& info,
+                                                    JSValue& x, Symbolic::OP op, JSValue& y, JSValue result)
+{
+    if (LIKELY(!x.isSymbolic() && !y.isSymbolic()))
+        return result;
+
+    return m_symbolic->ail_op_binary(callFrame, vPC, info, x, op, y, result);
+}
+
+ALWAYS_INLINE void Interpreter::symbolicJumpIff(CallFrame* callFrame, const Instruction* vPC, BytecodeInfo& info,
+                                                JSValue& condition, bool jumps)
+{
+    if (LIKELY(!condition.isSymbolic()) && callFrame->codeBlock()->artemisTier() == CodeBlock::ArtemisTierUninstrumented)
+        return;
+
+    m_symbolic->ail_jmp_iff(callFrame, vPC, info, condition, jumps);
+}
+
+ALWAYS_INLINE void Interpreter::symbolicCall(CallFrame* callFrame, const Instruction* vPC, BytecodeInfo& info)
+{
+    if (callFrame->codeBlock()->artemisTier() == CodeBlock::ArtemisTierUninstrumented)
+        return;
+
+    m_symbolic->ail_call(callFrame, vPC, info);
+}
+
+ALWAYS_INLINE void Interpreter::symbolicCallNative(CallFrame* callFrame, const Instruction* vPC, BytecodeInfo& info,
+                                                   native_function_ID_t functionID)
+{
+    if (callFrame->codeBlock()->artemisTier() == CodeBlock::ArtemisTierUninstrumented)
+        return;
+
+    m_symbolic->ail_call_native(callFrame, vPC, info, functionID);
+}
+
+/*
+ * Concrete instructions are not reported one by one. Consecutive instructions of the same frame are
+ * collected into a range which is reported when control leaves it: at a basic block leader (computed by
+ * the BytecodeGenerator), at a call or return, or when privateExecute exits. Instructions which throw
+ * never reach ARTEMIS_BYTECODE_POST, so a range only holds instructions which completed.
+ *
+ * Symbolic instructions are still reported individually, as the listeners distinguish them in the coverage.
+ * Nothing is recorded while instrumentation is disabled, a pending range is still flushed as usual.
+ */
+ALWAYS_INLINE void Interpreter::recordExecutedBytecode(CallFrame* callFrame, CodeBlock* codeBlock, Instruction* vPC, const BytecodeInfo& info)
+{
+    unsigned bytecodeOffset = vPC - codeBlock->instructions().begin();
+
+    if (UNLIKELY(info.isSymbolic())) {
+        m_symbolic->recordSymbolicInstruction(getOpcodeID(vPC->u.opcode));
+        flushExecutedBytecodes();
+        jscinst::get_jsc_listener()->javascript_bytecode_executed(this, codeBlock, vPC, info);
+        return;
+    }
+
+    if (LIKELY(m_executedBytecodes.codeBlock == codeBlock && m_executedBytecodes.callFrame == callFrame
+               && bytecodeOffset > m_executedBytecodes.lastOffset && !codeBlock->isArtemisBlockLeader(bytecodeOffset))) {
+        m_executedBytecodes.lastOffset = bytecodeOffset;
+        return;
+    }
+
+    flushExecutedBytecodes();
+
+    m_executedBytecodes.callFrame = callFrame;
+    m_executedBytecodes.codeBlock = codeBlock;
+    m_executedBytecodes.firstOffset = bytecodeOffset;
+    m_executedBytecodes.lastOffset = bytecodeOffset;
+}
+
+void Interpreter::flushExecutedBytecodes()
+{
+    if (!m_executedBytecodes.codeBlock)
+        return;
+
+    CodeBlock* codeBlock = m_executedBytecodes.codeBlock;
+    m_executedBytecodes.codeBlock = 0;
+
+    jscinst::get_jsc_listener()->javascript_bytecode_range_executed(this, codeBlock, m_executedBytecodes.firstOffset, m_executedBytecodes.lastOffset);
+}
+
+/*
+ * Function entry and exit are reported directly from op_enter, op_ret and exception unwinding, so no
+ * Debugger has to be attached for them.
+ *
+ * Functions are identified by their position in the source rather than by their code block, as code
+ * blocks are recreated on every page load and may be collected at any time. The id is interned the first
+ * time a code block is entered and cached on it.
+ */
+ALWAYS_INLINE void Interpreter::reportFunctionCalled(CallFrame* callFrame, CodeBlock* codeBlock)
+{
+    if (UNLIKELY(!codeBlock->artemisFunctionId()))
+        internArtemisFunctionId(codeBlock);
+
+    jscinst::get_jsc_listener()->javascript_function_called(callFrame, codeBlock, codeBlock->artemisFunctionId());
+}
+
+ALWAYS_INLINE void Interpreter::reportFunctionReturned(CallFrame* callFrame, CodeBlock* codeBlock)
+{
+    if (UNLIKELY(!codeBlock->artemisFunctionId()))
+        internArtemisFunctionId(codeBlock);
+
+    jscinst::get_jsc_listener()->javascript_function_returned(callFrame, codeBlock, codeBlock->artemisFunctionId());
+}
+
+NEVER_INLINE void Interpreter::internArtemisFunctionId(CodeBlock* codeBlock)
+{
+    typedef HashMap<String, unsigned> FunctionIdMap;
+    DEFINE_STATIC_LOCAL(FunctionIdMap, functionIds, ());
+
+    SourceProvider* source = codeBlock->source();
+    String key = makeString(String(source->url().impl()), ":",
+                            String::number(source->startPosition().m_line.zeroBasedInt()), ":",
+                            String::number(codeBlock->sourceOffset()));
+
+    FunctionIdMap::AddResult result = functionIds.add(key, functionIds.size() + 1);
+    codeBlock->setArtemisFunctionId(result.iterator->second);
+}
+
+// Reports the pending range on every exit from privateExecute.
+class ExecutedBytecodesFlusher {
+public:
+    ExecutedBytecodesFlusher(Interpreter* interpreter, void (Interpreter::*flush)())
+        : m_interpreter(interpreter)
+        , m_flush(flush)
+    {
+    }
+
+    ~ExecutedBytecodesFlusher()
+    {
+        (m_interpreter->*m_flush)();
+    }
+
+private:
+    Interpreter* m_interpreter;
+    void (Interpreter::*m_flush)();
+};
+
 #endif
 
 #if ENABLE(CLASSIC_INTERPRETER)
@@ -833,6 +1025,11 @@ NEVER_INLINE bool Interpreter::unwindCallFrame(CallFrame*& callFrame, JSValue ex
     CodeBlock* oldCodeBlock = codeBlock;
     ScopeChainNode* scopeChain = callFrame->scopeChain();
 
+#ifdef ARTEMIS
+    if (oldCodeBlock->codeType() == FunctionCode)
+        reportFunctionReturned(callFrame, oldCodeBlock);
+#endif
+
     if (Debugger* debugger = callFrame->dynamicGlobalObject()->debugger()) {
         DebuggerCallFrame debuggerCallFrame(callFrame, exceptionValue);
         if (callFrame->callee())
@@ -1759,9 +1956,19 @@ JSValue Interpreter::execute(EvalExecutable* eval, CallFrame* callFrame, JSValue
 
 NEVER_INLINE void Interpreter::debug(CallFrame* callFrame, DebugHookID debugHookID, int firstLine, int lastLine)
 {
+#ifdef ARTEMIS
+    if (debugHookID == WillExecuteStatement)
+        jscinst::get_jsc_listener()->javascript_statement_executed(callFrame, callFrame->codeBlock(), firstLine);
+#endif
+
     Debugger* debugger = callFrame->dynamicGlobalObject()->debugger();
+#ifdef ARTEMIS
+    if (!debugger || !debugger->needsExecutionHooks())
+        return;
+#else
     if (!debugger)
         return;
+#endif
 
     switch (debugHookID) {
         case DidEnterCallFrame:
@@ -2086,6 +2293,8 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
     m_symbolic->preExecution(callFrame);
     CodeBlock* oldCodeBlock = codeBlock;
     Instruction* oldPC = vPC;
+    CallFrame* oldCallFrame = callFrame;
+    ExecutedBytecodesFlusher executedBytecodesFlusher(this, &Interpreter::flushExecutedBytecodes);
 #endif
 
 #define CHECK_FOR_TIMEOUT() \
@@ -2104,8 +2313,13 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 #endif
 
 #ifdef ARTEMIS
-#define ARTEMIS_BYTECODE_PRE oldCodeBlock = codeBlock; oldPC = vPC;
-#define ARTEMIS_BYTECODE_POST jscinst::get_jsc_listener()->javascript_bytecode_executed(this, oldCodeBlock, oldPC, bytecodeInfo); bytecodeInfo = bytecodeInfoPrestine;
+#define ARTEMIS_BYTECODE_PRE oldCodeBlock = codeBlock; oldPC = vPC; oldCallFrame = callFrame;
+#define ARTEMIS_BYTECODE_POST \
+    if (LIKELY(m_enableInstrumentations) && shouldReportBytecode(oldCodeBlock, bytecodeInfo)) \
+        recordExecutedBytecode(oldCallFrame, oldCodeBlock, oldPC, bytecodeInfo); \
+    if (callFrame != oldCallFrame) \
+        flushExecutedBytecodes(); \
+    bytecodeInfo = bytecodeInfoPrestine;
 #else
 #define ARTEMIS_BYTECODE_PRE
 #define ARTEMIS_BYTECODE_LISTEN
@@ -2229,11 +2443,11 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       src1, Symbolic::EQUAL, src2,
-                                                       callFrame->uncheckedR(dst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 src1, Symbolic::EQUAL, src2,
+                                 callFrame->uncheckedR(dst).jsValue());
 
-        if (jscinst::get_jsc_listener()->isConstantStringInstrumentationEnabled()) {
+        if (isConstantStringInstrumented(callFrame)) {
             checkForConstantString(callFrame, src1);
             checkForConstantString(callFrame, src2);
         }
@@ -2262,9 +2476,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 #ifdef ARTEMIS
         JSValue jsn = jsNull();
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       src, Symbolic::EQUAL, jsn,
-                                                       callFrame->uncheckedR(dst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 src, Symbolic::EQUAL, jsn,
+                                 callFrame->uncheckedR(dst).jsValue());
 #endif
 
         vPC += OPCODE_LENGTH(op_eq_null);
@@ -2290,11 +2504,11 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       src1, Symbolic::NOT_EQUAL, src2,
-                                                       callFrame->uncheckedR(dst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 src1, Symbolic::NOT_EQUAL, src2,
+                                 callFrame->uncheckedR(dst).jsValue());
 
-        if (jscinst::get_jsc_listener()->isConstantStringInstrumentationEnabled()) {
+        if (isConstantStringInstrumented(callFrame)) {
             checkForConstantString(callFrame, src1);
             checkForConstantString(callFrame, src2);
         }
@@ -2323,9 +2537,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 #ifdef ARTEMIS
         JSValue jsn = jsNull();
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       src, Symbolic::NOT_EQUAL, jsn,
-                                                       callFrame->uncheckedR(dst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 src, Symbolic::NOT_EQUAL, jsn,
+                                 callFrame->uncheckedR(dst).jsValue());
 #endif
 
         vPC += OPCODE_LENGTH(op_neq_null);
@@ -2347,11 +2561,11 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       src1, Symbolic::STRICT_EQUAL, src2,
-                                                       callFrame->uncheckedR(dst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 src1, Symbolic::STRICT_EQUAL, src2,
+                                 callFrame->uncheckedR(dst).jsValue());
 
-        if (jscinst::get_jsc_listener()->isConstantStringInstrumentationEnabled()) {
+        if (isConstantStringInstrumented(callFrame)) {
             checkForConstantString(callFrame, src1);
             checkForConstantString(callFrame, src2);
         }
@@ -2376,11 +2590,11 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       src1, Symbolic::NOT_STRICT_EQUAL, src2,
-                                                       callFrame->uncheckedR(dst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 src1, Symbolic::NOT_STRICT_EQUAL, src2,
+                                 callFrame->uncheckedR(dst).jsValue());
 
-        if (jscinst::get_jsc_listener()->isConstantStringInstrumentationEnabled()) {
+        if (isConstantStringInstrumented(callFrame)) {
             checkForConstantString(callFrame, src1);
             checkForConstantString(callFrame, src2);
         }
@@ -2405,9 +2619,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       src1, Symbolic::LESS_STRICT, src2,
-                                                       callFrame->uncheckedR(dst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 src1, Symbolic::LESS_STRICT, src2,
+                                 callFrame->uncheckedR(dst).jsValue());
 #endif
 
         vPC += OPCODE_LENGTH(op_less);
@@ -2429,9 +2643,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       src1, Symbolic::LESS_EQ, src2,
-                                                       callFrame->uncheckedR(dst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 src1, Symbolic::LESS_EQ, src2,
+                                 callFrame->uncheckedR(dst).jsValue());
 #endif
 
         vPC += OPCODE_LENGTH(op_lesseq);
@@ -2453,9 +2667,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       src1, Symbolic::GREATER_STRICT, src2,
-                                                       callFrame->uncheckedR(dst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 src1, Symbolic::GREATER_STRICT, src2,
+                                 callFrame->uncheckedR(dst).jsValue());
 #endif
 
         vPC += OPCODE_LENGTH(op_greater);
@@ -2477,9 +2691,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       src1, Symbolic::GREATER_EQ, src2,
-                                                       callFrame->uncheckedR(dst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 src1, Symbolic::GREATER_EQ, src2,
+                                 callFrame->uncheckedR(dst).jsValue());
 #endif
 
         vPC += OPCODE_LENGTH(op_greatereq);
@@ -2504,9 +2718,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 #ifdef ARTEMIS
         JSValue jsn = jsNumber(1);
         callFrame->uncheckedR(srcDst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       v, Symbolic::ADD, jsn,
-                                                       callFrame->uncheckedR(srcDst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 v, Symbolic::ADD, jsn,
+                                 callFrame->uncheckedR(srcDst).jsValue());
 #endif
 
         vPC += OPCODE_LENGTH(op_pre_inc);
@@ -2531,9 +2745,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 #ifdef ARTEMIS
         JSValue jsn = jsNumber(1);
         callFrame->uncheckedR(srcDst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       v, Symbolic::SUBTRACT, jsn,
-                                                       callFrame->uncheckedR(srcDst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 v, Symbolic::SUBTRACT, jsn,
+                                 callFrame->uncheckedR(srcDst).jsValue());
 #endif
 
         vPC += OPCODE_LENGTH(op_pre_dec);
@@ -2562,9 +2776,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 #ifdef ARTEMIS
         JSValue jsn = jsNumber(1);
         callFrame->uncheckedR(srcDst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       v, Symbolic::ADD, jsn,
-                                                       callFrame->uncheckedR(srcDst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 v, Symbolic::ADD, jsn,
+                                 callFrame->uncheckedR(srcDst).jsValue());
 #endif
 
         vPC += OPCODE_LENGTH(op_post_inc);
@@ -2593,9 +2807,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 #ifdef ARTEMIS
         JSValue jsn = jsNumber(1);
         callFrame->uncheckedR(srcDst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       v, Symbolic::SUBTRACT, jsn,
-                                                       callFrame->uncheckedR(srcDst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 v, Symbolic::SUBTRACT, jsn,
+                                 callFrame->uncheckedR(srcDst).jsValue());
 #endif
 
         vPC += OPCODE_LENGTH(op_post_dec);
@@ -2623,9 +2837,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 #ifdef ARTEMIS
         JSValue jsn = jsNumber(1);
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       srcVal, Symbolic::MULTIPLY, jsn,
-                                                       callFrame->uncheckedR(dst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 srcVal, Symbolic::MULTIPLY, jsn,
+                                 callFrame->uncheckedR(dst).jsValue());
 #endif
 
         vPC += OPCODE_LENGTH(op_to_jsnumber);
@@ -2650,9 +2864,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 #ifdef ARTEMIS
         JSValue jsn = jsNumber(-1);
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       src, Symbolic::MULTIPLY, jsn,
-                                                       callFrame->uncheckedR(dst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 src, Symbolic::MULTIPLY, jsn,
+                                 callFrame->uncheckedR(dst).jsValue());
 #endif
 
         vPC += OPCODE_LENGTH(op_negate);
@@ -2678,9 +2892,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       src1, Symbolic::ADD, src2,
-                                                       callFrame->uncheckedR(dst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 src1, Symbolic::ADD, src2,
+                                 callFrame->uncheckedR(dst).jsValue());
 #endif
 
         vPC += OPCODE_LENGTH(op_add);
@@ -2705,9 +2919,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       src1, Symbolic::MULTIPLY, src2,
-                                                       callFrame->uncheckedR(dst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 src1, Symbolic::MULTIPLY, src2,
+                                 callFrame->uncheckedR(dst).jsValue());
 #endif
 
         vPC += OPCODE_LENGTH(op_mul);
@@ -2730,9 +2944,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       dividend, Symbolic::DIVIDE, divisor,
-                                                       result);
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 dividend, Symbolic::DIVIDE, divisor,
+                                 result);
 #endif
 
         vPC += OPCODE_LENGTH(op_div);
@@ -2756,9 +2970,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       dividend, Symbolic::MODULO, divisor,
-                                                       result);
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 dividend, Symbolic::MODULO, divisor,
+                                 result);
 #endif
 
             vPC += OPCODE_LENGTH(op_mod);
@@ -2775,9 +2989,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       dividend, Symbolic::MODULO, divisor,
-                                                       result);
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 dividend, Symbolic::MODULO, divisor,
+                                 result);
 #endif
 
         vPC += OPCODE_LENGTH(op_mod);
@@ -2803,9 +3017,9 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         callFrame->uncheckedR(dst) = \
-                Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                       src1, Symbolic::SUBTRACT, src2,
-                                                       callFrame->uncheckedR(dst).jsValue());
+                symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                                 src1, Symbolic::SUBTRACT, src2,
+                                 callFrame->uncheckedR(dst).jsValue());
 #endif
 
         vPC += OPCODE_LENGTH(op_sub);
@@ -3202,7 +3416,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         int index = vPC[2].u.operand;
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, scope->symbolTable(), index);
 	}
 #endif
@@ -3222,7 +3436,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         int value = vPC[2].u.operand;
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, scope->symbolTable(), index);
 	}
 #endif
@@ -3268,7 +3482,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         ASSERT(callFrame->r(dst).jsValue());
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, scope->symbolTable(), index);
 	}
 #endif
@@ -3311,7 +3525,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         scope->registerAt(index).set(*globalData, scope, callFrame->r(value).jsValue());
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, scope->symbolTable(), index);
 	}
 #endif
@@ -3344,7 +3558,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, ident.ascii().data());
 	}
 #endif
@@ -3407,7 +3621,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
         Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, ident.ascii().data());
 	}
 #endif
@@ -3449,7 +3663,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
 	}
 #endif
@@ -3492,7 +3706,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
 	}
 #endif
@@ -3543,7 +3757,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
 	}
 #endif
@@ -3600,7 +3814,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
 	}
 #endif
@@ -3654,7 +3868,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
 	}
 #endif
@@ -3716,7 +3930,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
 	}
 #endif
@@ -3771,7 +3985,7 @@ JSValue Interpreter::privateExecute(ExecutionFlag flag, RegisterFile* registerFi
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
 	}
 #endif
@@ -3818,7 +4032,7 @@ skip_id_custom_self:
         Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, ident.ascii().data());
 	}
 #endif
@@ -3852,7 +4066,7 @@ skip_id_custom_self:
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
 	}
 #endif
@@ -3919,7 +4133,7 @@ skip_id_custom_self:
 
 #ifdef ARTEMIS
         int property = vPC[3].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
 	}
 #endif
@@ -4034,7 +4248,7 @@ skip_id_custom_self:
         Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, ident.ascii().data());
 	}
 #endif
@@ -4087,7 +4301,7 @@ skip_id_custom_self:
 
 #ifdef ARTEMIS
         int property = vPC[2].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
 	}
 #endif
@@ -4151,7 +4365,7 @@ skip_id_custom_self:
 
 #ifdef ARTEMIS
         int property = vPC[2].u.operand;
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, codeBlock->identifier(property).ascii().data());
 	}
 #endif
@@ -4200,7 +4414,7 @@ skip_id_custom_self:
         Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, ident.ascii().data());
 	}
 #endif
@@ -4232,7 +4446,7 @@ skip_id_custom_self:
         Identifier& ident = codeBlock->identifier(property);
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
 		readProperty(callFrame, ident.ascii().data());
 	}
 #endif
@@ -4261,7 +4475,7 @@ skip_id_custom_self:
         JSValue expectedSubscript = callFrame->r(expected).jsValue();
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
         readProperty(callFrame, subscript.toUString(callFrame).ascii().data());
 	}
 #endif
@@ -4334,7 +4548,7 @@ skip_id_custom_self:
         JSValue subscript = callFrame->r(property).jsValue();
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
         readProperty(callFrame, subscript.toUString(callFrame).ascii().data());
 	}
 #endif
@@ -4382,7 +4596,7 @@ skip_id_custom_self:
         JSValue subscript = callFrame->r(property).jsValue();
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
         readProperty(callFrame, subscript.toUString(callFrame).ascii().data());
 	}
 #endif
@@ -4425,7 +4639,7 @@ skip_id_custom_self:
         JSValue subscript = callFrame->r(property).jsValue();
 
 #ifdef ARTEMIS
-        if (jscinst::get_jsc_listener()->isPropertyAccessInstrumentationEnabled()) {
+        if (isPropertyAccessInstrumented(callFrame)) {
         readProperty(callFrame, subscript.toUString(callFrame).ascii().data());
 	}
 #endif
@@ -4538,12 +4752,12 @@ skip_id_custom_self:
         bool _jumped = _v.toBoolean(callFrame);
         JSValue _r = jsBoolean(_jumped);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    _v, Symbolic::EQUAL, _jst,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              _v, Symbolic::EQUAL, _jst,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, _jumped);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, _jumped);
 
         if (_jumped) {
             vPC += target;
@@ -4591,12 +4805,12 @@ skip_id_custom_self:
         bool _jumped = !_v.toBoolean(callFrame);
         JSValue _r = jsBoolean(_jumped);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    _v, Symbolic::EQUAL, _jsf,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              _v, Symbolic::EQUAL, _jsf,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, _jumped);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, _jumped);
 
 
         if (_jumped) {
@@ -4642,12 +4856,12 @@ skip_id_custom_self:
         bool _jumped = _v.toBoolean(callFrame);
         JSValue _r = jsBoolean(_jumped);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    _v, Symbolic::EQUAL, _jst,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              _v, Symbolic::EQUAL, _jst,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, _jumped);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, _jumped);
 
         if (_jumped) {
             vPC += target;
@@ -4690,12 +4904,12 @@ skip_id_custom_self:
         bool _jumped = !_v.toBoolean(callFrame);
         JSValue _r = jsBoolean(_jumped);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    _v, Symbolic::EQUAL, _jsf,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              _v, Symbolic::EQUAL, _jsf,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, _jumped);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, _jumped);
 
 
         if (_jumped) {
@@ -4728,12 +4942,12 @@ skip_id_custom_self:
         bool _jumped = (srcValue.isUndefinedOrNull() || (srcValue.isCell() && srcValue.asCell()->structure()->typeInfo().masqueradesAsUndefined()));
         JSValue _r = jsBoolean(_jumped);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    srcValue, Symbolic::EQUAL, _jsn,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              srcValue, Symbolic::EQUAL, _jsn,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, _jumped);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, _jumped);
 
         if (_jumped) {
             vPC += target;
@@ -4765,12 +4979,12 @@ skip_id_custom_self:
         bool _jumped = (!srcValue.isUndefinedOrNull() && (!srcValue.isCell() || !srcValue.asCell()->structure()->typeInfo().masqueradesAsUndefined()));
         JSValue _r = jsBoolean(_jumped);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    srcValue, Symbolic::NOT_EQUAL, _jsn,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              srcValue, Symbolic::NOT_EQUAL, _jsn,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, _jumped);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, _jumped);
 
         if (_jumped) {
             vPC += target;
@@ -4824,12 +5038,12 @@ skip_id_custom_self:
 #ifdef ARTEMIS
         JSValue _r = jsBoolean(result);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    src1, Symbolic::LESS_STRICT, src2,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              src1, Symbolic::LESS_STRICT, src2,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, result);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, result);
 #endif
 
         if (result) {
@@ -4862,12 +5076,12 @@ skip_id_custom_self:
 #ifdef ARTEMIS
         JSValue _r = jsBoolean(result);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    src1, Symbolic::LESS_STRICT, src2,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              src1, Symbolic::LESS_STRICT, src2,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, result);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, result);
 #endif
 
         if (result) {
@@ -4900,12 +5114,12 @@ skip_id_custom_self:
 #ifdef ARTEMIS
         JSValue _r = jsBoolean(result);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    src1, Symbolic::GREATER_STRICT, src2,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              src1, Symbolic::GREATER_STRICT, src2,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, result);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, result);
 #endif
 
         if (result) {
@@ -4938,12 +5152,12 @@ skip_id_custom_self:
 #ifdef ARTEMIS
         JSValue _r = jsBoolean(result);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    src1, Symbolic::GREATER_EQ, src2,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              src1, Symbolic::GREATER_EQ, src2,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, result);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, result);
 #endif
 
         if (result) {
@@ -4973,12 +5187,12 @@ skip_id_custom_self:
 #ifdef ARTEMIS
         JSValue _r = jsBoolean(result);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    src1, Symbolic::LESS_STRICT, src2,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              src1, Symbolic::LESS_STRICT, src2,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, result);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, result);
 #endif
 
         if (result) {
@@ -5007,12 +5221,12 @@ skip_id_custom_self:
 #ifdef ARTEMIS
         JSValue _r = jsBoolean(result);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    src1, Symbolic::LESS_EQ, src2,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              src1, Symbolic::LESS_EQ, src2,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, result);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, result);
 #endif
 
         if (result) {
@@ -5041,12 +5255,12 @@ skip_id_custom_self:
 #ifdef ARTEMIS
         JSValue _r = jsBoolean(result);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    src1, Symbolic::GREATER_STRICT, src2,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              src1, Symbolic::GREATER_STRICT, src2,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, result);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, result);
 #endif
 
         if (result) {
@@ -5075,12 +5289,12 @@ skip_id_custom_self:
 #ifdef ARTEMIS
         JSValue _r = jsBoolean(result);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    src1, Symbolic::GREATER_EQ, src2,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              src1, Symbolic::GREATER_EQ, src2,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, result);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, result);
 #endif
 
         if (result) {
@@ -5109,12 +5323,12 @@ skip_id_custom_self:
 #ifdef ARTEMIS
         JSValue _r = jsBoolean(!result);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    src1, Symbolic::GREATER_EQ, src2,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              src1, Symbolic::GREATER_EQ, src2,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, !result);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, !result);
 #endif
 
         if (!result) {
@@ -5143,12 +5357,12 @@ skip_id_custom_self:
 #ifdef ARTEMIS
         JSValue _r = jsBoolean(!result);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    src1, Symbolic::GREATER_STRICT, src2,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              src1, Symbolic::GREATER_STRICT, src2,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, !result);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, !result);
 #endif
 
         if (!result) {
@@ -5177,12 +5391,12 @@ skip_id_custom_self:
 #ifdef ARTEMIS
         JSValue _r = jsBoolean(!result);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    src1, Symbolic::LESS_EQ, src2,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              src1, Symbolic::LESS_EQ, src2,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, !result);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, !result);
 #endif
 
         if (!result) {
@@ -5211,12 +5425,12 @@ skip_id_custom_self:
 #ifdef ARTEMIS
         JSValue _r = jsBoolean(!result);
 
-        _r = Interpreter::m_symbolic->ail_op_binary(callFrame, vPC, bytecodeInfo,
-                                                    src1, Symbolic::LESS_STRICT, src2,
-                                                    _r);
+        _r = symbolicBinaryOp(callFrame, vPC, bytecodeInfo,
+                              src1, Symbolic::LESS_STRICT, src2,
+                              _r);
 
-        Interpreter::m_symbolic->ail_jmp_iff(callFrame, vPC, bytecodeInfo,
-                                             _r, !result);
+        symbolicJumpIff(callFrame, vPC, bytecodeInfo,
+                        _r, !result);
 #endif
 
         if (!result) {
@@ -5397,7 +5611,7 @@ skip_id_custom_self:
         if (callType == CallTypeJS) {
 
 #ifdef ARTEMIS
-            Interpreter::m_symbolic->ail_call(callFrame, vPC, bytecodeInfo);
+            symbolicCall(callFrame, vPC, bytecodeInfo);
 #endif
 
             ScopeChainNode* callDataScopeChain = callData.js.scopeChain;
@@ -5442,8 +5656,8 @@ skip_id_custom_self:
                 *topCallFrameSlot = callFrame;
 
 #ifdef ARTEMIS
-                Interpreter::m_symbolic->ail_call_native(callFrame, vPC, bytecodeInfo,
-                                                         (native_function_ID_t)callData.native.function);
+                symbolicCallNative(callFrame, vPC, bytecodeInfo,
+                                   (native_function_ID_t)callData.native.function);
 #endif
 
             }
@@ -5602,6 +5816,10 @@ skip_id_custom_self:
 
         JSValue returnValue = callFrame->r(result).jsValue();
 
+#ifdef ARTEMIS
+        reportFunctionReturned(callFrame, codeBlock);
+#endif
+
         vPC = callFrame->returnVPC();
         callFrame = callFrame->callerFrame();
 
@@ -5644,6 +5862,10 @@ skip_id_custom_self:
         if (UNLIKELY(!returnValue.isObject()))
             returnValue = callFrame->r(vPC[2].u.operand).jsValue();
 
+#ifdef ARTEMIS
+        reportFunctionReturned(callFrame, codeBlock);
+#endif
+
         vPC = callFrame->returnVPC();
         callFrame = callFrame->callerFrame();
 
@@ -5670,6 +5892,11 @@ skip_id_custom_self:
         for (size_t count = codeBlock->m_numVars; i < count; ++i)
             callFrame->uncheckedR(i) = jsUndefined();
 
+#ifdef ARTEMIS
+        if (codeBlock->codeType() == FunctionCode)
+            reportFunctionCalled(callFrame, codeBlock);
+#endif
+
         vPC += OPCODE_LENGTH(op_enter);
         NEXT_INSTRUCTION();
     }
@@ -252,6 +252,39 @@ namespace JSC {
         ALWAYS_INLINE void readProperty(CallFrame* callFrame, const SymbolTable& symbolTable, int index);
         ALWAYS_INLINE void writeProperty(CallFrame* callFrame, std::string propertyName);
         ALWAYS_INLINE void writeProperty(CallFrame* callFrame, const SymbolTable& symbolTable, int index);
+
+        ALWAYS_INLINE bool shouldReportBytecode(CodeBlock*, const BytecodeInfo&);
+        NEVER_INLINE void decideArtemisTier(CodeBlock*);
+
+        ALWAYS_INLINE JSValue symbolicBinaryOp(CallFrame*, const Instruction*, BytecodeInfo&, JSValue& x, Symbolic::OP, JSValue& y, JSValue result);
+        ALWAYS_INLINE void symbolicJumpIff(CallFrame*, const Instruction*, BytecodeInfo&, JSValue& condition, bool jumps);
+        ALWAYS_INLINE void symbolicCall(CallFrame*, const Instruction*, BytecodeInfo&);
+        ALWAYS_INLINE void symbolicCallNative(CallFrame*, const Instruction*, BytecodeInfo&, native_function_ID_t);
+
+        ALWAYS_INLINE void reportFunctionCalled(CallFrame*, CodeBlock*);
+        ALWAYS_INLINE void reportFunctionReturned(CallFrame*, CodeBlock*);
+        NEVER_INLINE void internArtemisFunctionId(CodeBlock*);
+
+        ALWAYS_INLINE void recordExecutedBytecode(CallFrame*, CodeBlock*, Instruction*, const BytecodeInfo&);
+        void flushExecutedBytecodes();
+
+        // The straight-line run of concrete instructions executed since the last report, see recordExecutedBytecode.
+        struct ExecutedBytecodeRange {
+            ExecutedBytecodeRange()
+                : callFrame(0)
+                , codeBlock(0)
+                , firstOffset(0)
+                , lastOffset(0)
+            {
+            }
+
+            CallFrame* callFrame;
+            CodeBlock* codeBlock;
+            unsigned firstOffset;
+            unsigned lastOffset;
+        };
+
+        ExecutedBytecodeRange m_executedBytecodes;
 #endif
 	
 #if ENABLE(CLASSIC_INTERPRETER)
@@ -46,6 +46,9 @@ namespace JSC {
             , m_validated(false)
             , m_cache(cache ? cache : new SourceProviderCache)
             , m_cacheOwned(!cache)
+#ifdef ARTEMIS
+            , m_artemisIgnore(ArtemisIgnoreUndecided)
+#endif
         {
             turnOffVerifier();
         }
@@ -68,6 +71,13 @@ namespace JSC {
 
         SourceProviderCache* cache() const { return m_cache; }
         void notifyCacheSizeChanged(int delta) { if (!m_cacheOwned) cacheSizeChanged(delta); }
+
+#ifdef ARTEMIS
+        // Set by Artemis, see jscinst::isIgnoredSource.
+        bool isArtemisIgnoreDecided() const { return m_artemisIgnore != ArtemisIgnoreUndecided; }
+        bool isArtemisIgnored() const { return m_artemisIgnore == ArtemisIgnored; }
+        void setArtemisIgnored(bool ignored) { m_artemisIgnore = ignored ? ArtemisIgnored : ArtemisInstrumented; }
+#endif
         
     private:
         virtual void cacheSizeChanged(int delta) { UNUSED_PARAM(delta); }
@@ -77,6 +87,11 @@ namespace JSC {
         bool m_validated;
         SourceProviderCache* m_cache;
         bool m_cacheOwned;
+
+#ifdef ARTEMIS
+        enum ArtemisIgnore { ArtemisIgnoreUndecided, ArtemisInstrumented, ArtemisIgnored };
+        ArtemisIgnore m_artemisIgnore;
+#endif
     };
 
     class UStringSourceProvider : public SourceProvider {
@@ -17,6 +17,7 @@
 #include <tr1/unordered_set>
 #include <inttypes.h>
 #include <iostream>
+#include <algorithm>
 
 #include "config.h"
 #include "WTF/wtf/ExportMacros.h"
@@ -53,6 +54,7 @@ SymbolicInterpreter::SymbolicInterpreter() :
     m_inSession(false),
     m_shouldGC(false)
 {
+    std::fill(m_symbolicOpcodeHits, m_symbolicOpcodeHits + JSC::numOpcodeIDs, 0);
 }
 
 void SymbolicInterpreter::ail_call(JSC::CallFrame*, const JSC::Instruction*, JSC::BytecodeInfo&)
@@ -377,13 +379,17 @@ void SymbolicInterpreter::ail_jmp_iff(JSC::CallFrame* callFrame,
     if (!m_inSession) {
 
         // Notify Artemis directly about this branch
-        jscinst::get_jsc_listener()->javascript_branch_executed(jumps, NULL, callFrame, vPC, info);
+        if (!jscinst::isIgnoredSource(callFrame->codeBlock()->source())) {
+            jscinst::get_jsc_listener()->javascript_branch_executed(jumps, NULL, callFrame, vPC, info);
+        }
 
         return;
     }
 
     if (condition.isSymbolic()) {
         info.setSymbolic();
+    } else if (jscinst::isIgnoredSource(callFrame->codeBlock()->source())) {
+        return;
     }
 
     jscinst::get_jsc_listener()->javascript_branch_executed(jumps, condition.isSymbolic() ? condition.asSymbolic() : NULL, callFrame, vPC, info);
@@ -22,6 +22,7 @@
 #include "WTF/wtf/ExportMacros.h"
 #include "JavaScriptCore/runtime/CallData.h"
 #include "JavaScriptCore/instrumentation/bytecodeinfo.h"
+#include "JavaScriptCore/bytecode/Opcode.h"
 #include "instrumentation/jscexecutionlistener.h"
 
 #include "native/nativelookup.h"
@@ -73,6 +74,17 @@ public:
     void beginSession();
     void endSession();
 
+    /*
+     * Number of symbolic executions of each opcode, accumulated over all sessions
+     */
+    inline void recordSymbolicInstruction(JSC::OpcodeID opcodeID) {
+        m_symbolicOpcodeHits[opcodeID]++;
+    }
+
+    inline unsigned getSymbolicInstructionCount(JSC::OpcodeID opcodeID) const {
+        return m_symbolicOpcodeHits[opcodeID];
+    }
+
 private:
     void fatalError(JSC::CodeBlock* codeBlock, std::string reason) __attribute__((noreturn));
 
@@ -81,6 +93,8 @@ private:
 
     bool m_inSession;
     bool m_shouldGC;
+
+    unsigned m_symbolicOpcodeHits[JSC::numOpcodeIDs];
 };
 
 }
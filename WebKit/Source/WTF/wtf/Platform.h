@@ -939,6 +939,12 @@
 /* Regular Expression Tracing - Set to 1 to trace RegExp's in jsc.  Results dumped at exit */
 #define ENABLE_REGEXP_TRACING 0
 
+/* Artemis instruments the bytecode in the classic interpreter, but symbolic regular expressions are tracked
+   at the RegExp call boundary, so concrete matches can still use the regex JIT. */
+#if !defined(ENABLE_YARR_JIT) && defined(ARTEMIS) && (CPU(X86) || CPU(X86_64)) && !OS(WINDOWS)
+#define ENABLE_YARR_JIT 1
+#endif
+
 /* Yet Another Regex Runtime - turned on by default for JIT enabled ports. */
 #if !defined(ENABLE_YARR_JIT) && ENABLE(JIT) && !PLATFORM(CHROMIUM)
 #define ENABLE_YARR_JIT 1
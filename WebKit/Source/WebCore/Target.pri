@@ -73,7 +73,9 @@ SOURCES += \
     accessibility/AXObjectCache.cpp \
     bindings/generic/ActiveDOMCallback.cpp \
     bindings/generic/RuntimeEnabledFeatures.cpp \
-    instrumentation/listenerdebugger.cpp
+    instrumentation/listenerdebugger.cpp \
+    instrumentation/domstatetracker.cpp \
+    instrumentation/virtualclock.cpp
 
 v8 {
     include($$PWD/../JavaScriptCore/yarr/yarr.pri)
@@ -1406,7 +1408,9 @@ HEADERS += \
     bindings/generic/ActiveDOMCallback.h \
     bindings/generic/RuntimeEnabledFeatures.h \
     instrumentation/executionlistener.h \
-    instrumentation/listenerdebugger.h
+    instrumentation/listenerdebugger.h \
+    instrumentation/domstatetracker.h \
+    instrumentation/virtualclock.h
 
 v8 {
     HEADERS += \
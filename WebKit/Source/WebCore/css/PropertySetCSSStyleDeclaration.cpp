@@ -30,6 +30,10 @@
 #include "StylePropertySet.h"
 #include "StyledElement.h"
 
+#ifdef ARTEMIS
+#include <instrumentation/domstatetracker.h>
+#endif
+
 using namespace std;
 
 namespace WebCore {
@@ -355,6 +359,9 @@ void InlineCSSStyleDeclaration::setNeedsStyleRecalc()
 {
     if (!m_parentElement)
         return;
+#ifdef ARTEMIS
+    inst::DOMStateTracker::inlineStyleChanged(m_parentElement);
+#endif
     m_parentElement->setNeedsStyleRecalc(InlineStyleChange);
     m_parentElement->invalidateStyleAttribute();
     StyleAttributeMutationScope(this).didInvalidateStyleAttr();
@@ -34,6 +34,10 @@
 #include "TextBreakIterator.h"
 #include "WebKitMutationObserver.h"
 
+#ifdef ARTEMIS
+#include <instrumentation/domstatetracker.h>
+#endif
+
 using namespace std;
 
 namespace WebCore {
@@ -78,7 +82,13 @@ unsigned CharacterData::parserAppendData(const UChar* data, unsigned dataLength,
     if (!end)
         return 0;
 
+#ifdef ARTEMIS
+    String oldData = m_data;
     m_data.append(data, end);
+    inst::DOMStateTracker::characterDataWillChange(this, oldData, m_data);
+#else
+    m_data.append(data, end);
+#endif
 
     updateRenderer(oldLength, 0);
     document()->incDOMTreeVersion();
@@ -177,6 +187,9 @@ void CharacterData::setDataAndUpdate(const String& newData, unsigned offsetOfRep
     if (document()->frame())
         document()->frame()->selection()->textWillBeReplaced(this, offsetOfReplacedData, oldLength, newLength);
     String oldData = m_data;
+#ifdef ARTEMIS
+    inst::DOMStateTracker::characterDataWillChange(this, oldData, newData);
+#endif
     m_data = newData;
     updateRenderer(offsetOfReplacedData, oldLength);
     document()->incDOMTreeVersion();
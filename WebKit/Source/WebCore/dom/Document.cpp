@@ -206,6 +206,10 @@
 #include "NodeRareData.h"
 #endif
 
+#ifdef ARTEMIS
+#include <instrumentation/domstatetracker.h>
+#endif
+
 using namespace std;
 using namespace WTF;
 using namespace Unicode;
@@ -423,6 +427,9 @@ Document::Document(Frame* frame, const KURL& url, bool isXHTML, bool isHTML)
     , m_compatibilityMode(NoQuirksMode)
     , m_compatibilityModeLocked(false)
     , m_domTreeVersion(++s_globalTreeVersion)
+#ifdef ARTEMIS
+    , m_artemisDomMutationCount(0)
+#endif
 #if ENABLE(MUTATION_OBSERVERS)
     , m_mutationObserverTypes(0)
 #endif
@@ -766,6 +773,13 @@ void Document::resetActiveLinkColor()
     m_activeLinkColor.setNamedColor("red");
 }
 
+#ifdef ARTEMIS
+uint64_t Document::artemisDomStateHash()
+{
+    return inst::DOMStateTracker::documentHash(this);
+}
+#endif
+
 void Document::setDocType(PassRefPtr<DocumentType> docType)
 {
     // This should never be called more than once.
@@ -3040,6 +3054,12 @@ MouseEventWithHitTestResults Document::prepareMouseEvent(const HitTestRequest& r
     if (!renderer())
         return MouseEventWithHitTestResults(event, HitTestResult(LayoutPoint()));
 
+#ifdef ARTEMIS
+    // Layout is not scheduled for headless pages, so the hit test has to bring it up to date.
+    if (settings() && settings()->artemisLayoutOnDemand())
+        updateLayoutIgnorePendingStylesheets();
+#endif
+
     HitTestResult result(documentPoint);
     renderView()->hitTest(request, result);
 
@@ -938,6 +938,14 @@ public:
     void incDOMTreeVersion() { m_domTreeVersion = ++s_globalTreeVersion; }
     uint64_t domTreeVersion() const { return m_domTreeVersion; }
 
+#ifdef ARTEMIS
+    // Maintained by inst::DOMStateTracker at the DOM mutation points.
+    uint64_t artemisDomStateHash();
+    uint64_t artemisDomMutationCount() const { return m_artemisDomMutationCount; }
+    void artemisRecordDomMutation() { m_artemisDomMutationCount++; }
+    HashMap<Node*, uint64_t>& artemisSubtreeHashes() { return m_artemisSubtreeHashes; }
+#endif
+
     void setDocType(PassRefPtr<DocumentType>);
 
     // XPathEvaluator methods
@@ -1301,6 +1309,11 @@ private:
 
     uint64_t m_domTreeVersion;
     static uint64_t s_globalTreeVersion;
+
+#ifdef ARTEMIS
+    HashMap<Node*, uint64_t> m_artemisSubtreeHashes;
+    uint64_t m_artemisDomMutationCount;
+#endif
     
     HashSet<NodeIterator*> m_nodeIterators;
     HashSet<Range*> m_ranges;
@@ -73,6 +73,10 @@
 #include "htmlediting.h"
 #include <wtf/text/CString.h>
 
+#ifdef ARTEMIS
+#include <instrumentation/domstatetracker.h>
+#endif
+
 #if ENABLE(SVG)
 #include "SVGElement.h"
 #include "SVGNames.h"
@@ -2031,6 +2035,10 @@ bool Element::hasNamedNodeMap() const
 
 void Element::willModifyAttribute(const QualifiedName& name, const AtomicString& oldValue, const AtomicString& newValue)
 {
+#ifdef ARTEMIS
+    inst::DOMStateTracker::attributeWillChange(this, name, oldValue, newValue);
+#endif
+
     if (isIdAttributeName(name))
         updateId(oldValue, newValue);
     else if (name == HTMLNames::nameAttr)
@@ -103,6 +103,10 @@
 #include <wtf/PassOwnPtr.h>
 #include <wtf/RefCountedLeakCounter.h>
 #include <wtf/UnusedParam.h>
+
+#ifdef ARTEMIS
+#include <instrumentation/domstatetracker.h>
+#endif
 #include <wtf/Vector.h>
 #include <wtf/text/CString.h>
 #include <wtf/text/StringBuilder.h>
@@ -2386,16 +2390,24 @@ ScriptExecutionContext* Node::scriptExecutionContext() const
 Node::InsertionNotificationRequest Node::insertedInto(Node* insertionPoint)
 {
     ASSERT(insertionPoint->inDocument() || isContainerNode());
-    if (insertionPoint->inDocument())
+    if (insertionPoint->inDocument()) {
         setFlag(InDocumentFlag);
+#ifdef ARTEMIS
+        inst::DOMStateTracker::nodeInserted(this);
+#endif
+    }
     return InsertionDone;
 }
 
 void Node::removedFrom(Node* insertionPoint)
 {
     ASSERT(insertionPoint->inDocument() || isContainerNode());
-    if (insertionPoint->inDocument())
+    if (insertionPoint->inDocument()) {
+#ifdef ARTEMIS
+        inst::DOMStateTracker::nodeRemoved(this, insertionPoint);
+#endif
         clearFlag(InDocumentFlag);
+    }
 }
 
 void Node::didMoveToNewDocument(Document* oldDocument)
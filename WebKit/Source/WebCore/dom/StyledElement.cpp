@@ -41,6 +41,10 @@
 #include "StyleResolver.h"
 #include <wtf/HashFunctions.h>
 
+#ifdef ARTEMIS
+#include <instrumentation/domstatetracker.h>
+#endif
+
 using namespace std;
 
 namespace WebCore {
@@ -185,6 +189,9 @@ void StyledElement::parseAttribute(Attribute* attr)
 
 void StyledElement::inlineStyleChanged()
 {
+#ifdef ARTEMIS
+    inst::DOMStateTracker::inlineStyleChanged(this);
+#endif
     setNeedsStyleRecalc(InlineStyleChange);
     setIsStyleAttributeValid(false);
     InspectorInstrumentation::didInvalidateStyleAttr(document(), this);
@@ -0,0 +1,201 @@
+#ifdef ARTEMIS
+#include <config.h>
+
+#include "domstatetracker.h"
+
+#include "CharacterData.h"
+#include "Document.h"
+#include "Element.h"
+#include "HTMLNames.h"
+#include "Node.h"
+#include "QualifiedName.h"
+#include "StylePropertySet.h"
+#include "StyledElement.h"
+
+#include <wtf/text/AtomicString.h>
+#include <wtf/text/WTFString.h>
+
+namespace inst {
+
+    enum TermKind {
+        ELEMENT_TERM = 1,
+        ATTRIBUTE_TERM = 2,
+        CHARACTER_DATA_TERM = 3,
+        OTHER_NODE_TERM = 4
+    };
+
+    static inline uint64_t mix(uint64_t h)
+    {
+        h ^= h >> 33;
+        h *= 0xff51afd7ed558ccdULL;
+        h ^= h >> 33;
+        h *= 0xc4ceb9fe1a85ec53ULL;
+        h ^= h >> 33;
+        return h;
+    }
+
+    static inline uint64_t combine(uint64_t seed, uint64_t value)
+    {
+        return mix(seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+    }
+
+    static inline unsigned stringHash(const WTF::String& string)
+    {
+        return string.isNull() ? 0 : string.impl()->hash();
+    }
+
+    bool DOMStateTracker::isTracked(WebCore::Node* node)
+    {
+        return node->inDocument() && !node->isInShadowTree();
+    }
+
+    void DOMStateTracker::invalidate(WebCore::Node* node)
+    {
+        WebCore::Document* document = node->document();
+        SubtreeHashes& hashes = document->artemisSubtreeHashes();
+
+        hashes.remove(node);
+
+        // A node is only cached if all of its descendants are, so the walk can stop at the first uncached ancestor.
+        for (WebCore::Node* ancestor = node->parentNode(); ancestor; ancestor = ancestor->parentNode()) {
+            SubtreeHashes::iterator entry = hashes.find(ancestor);
+            if (entry == hashes.end()) {
+                break;
+            }
+            hashes.remove(entry);
+        }
+
+        document->artemisRecordDomMutation();
+    }
+
+    uint64_t DOMStateTracker::nodeTerm(WebCore::Node* node)
+    {
+        if (node->isElementNode()) {
+            WebCore::Element* element = toElement(node);
+            uint64_t term = combine(ELEMENT_TERM, stringHash(element->localName()));
+
+            // Attribute order is not significant, so the attribute terms are summed.
+            uint64_t attributes = 0;
+            if (element->hasAttributes()) {
+                for (unsigned i = 0; i < element->attributeCount(); i++) {
+                    WebCore::Attribute* attribute = element->attributeItem(i);
+                    attributes += attributeTerm(attribute->name(), attribute->value());
+                }
+            }
+
+            WTF::String style = inlineStyleText(element);
+            if (!style.isEmpty()) {
+                attributes += combine(combine(ATTRIBUTE_TERM, stringHash(WebCore::HTMLNames::styleAttr.localName())), stringHash(style));
+            }
+
+            return combine(term, attributes);
+        }
+
+        if (node->isCharacterDataNode()) {
+            return combine(combine(CHARACTER_DATA_TERM, node->nodeType()), stringHash(static_cast<WebCore::CharacterData*>(node)->data()));
+        }
+
+        return combine(combine(OTHER_NODE_TERM, node->nodeType()), stringHash(node->nodeName()));
+    }
+
+    // The style attribute is hashed from the inline style instead, see inlineStyleText.
+    uint64_t DOMStateTracker::attributeTerm(const WebCore::QualifiedName& name, const WTF::AtomicString& value)
+    {
+        if (value.isNull() || name == WebCore::HTMLNames::styleAttr) {
+            return 0;
+        }
+
+        return combine(combine(ATTRIBUTE_TERM, stringHash(name.localName())), stringHash(value));
+    }
+
+    WTF::String DOMStateTracker::inlineStyleText(WebCore::Element* element)
+    {
+        if (!element->isStyledElement()) {
+            return WTF::String();
+        }
+
+        const WebCore::StylePropertySet* style = static_cast<WebCore::StyledElement*>(element)->inlineStyle();
+        return style ? style->asText() : WTF::String();
+    }
+
+    uint64_t DOMStateTracker::subtreeHash(WebCore::Node* node, SubtreeHashes& hashes)
+    {
+        SubtreeHashes::iterator cached = hashes.find(node);
+        if (cached != hashes.end()) {
+            return cached->second;
+        }
+
+        uint64_t hash = nodeTerm(node);
+        uint64_t children = 0;
+
+        for (WebCore::Node* child = node->firstChild(); child; child = child->nextSibling()) {
+            hash = combine(hash, subtreeHash(child, hashes));
+            children++;
+        }
+
+        hash = combine(hash, children);
+        hashes.set(node, hash);
+        return hash;
+    }
+
+    uint64_t DOMStateTracker::documentHash(WebCore::Document* document)
+    {
+        return subtreeHash(document, document->artemisSubtreeHashes());
+    }
+
+    void DOMStateTracker::nodeInserted(WebCore::Node* node)
+    {
+        if (!isTracked(node) || node->isDocumentNode()) {
+            return;
+        }
+
+        invalidate(node);
+    }
+
+    void DOMStateTracker::nodeRemoved(WebCore::Node* node, WebCore::Node* insertionPoint)
+    {
+        if (!isTracked(node) || node->isDocumentNode()) {
+            return;
+        }
+
+        // The root of the removed subtree is already detached, so its old parent is invalidated instead. Every removed
+        // node passes through here, so no hash is kept for a node which has left the document.
+        node->document()->artemisSubtreeHashes().remove(node);
+        invalidate(insertionPoint);
+    }
+
+    void DOMStateTracker::attributeWillChange(WebCore::Element* element, const WebCore::QualifiedName& name,
+                                              const WTF::AtomicString& oldValue, const WTF::AtomicString& newValue)
+    {
+        if (!isTracked(element) || oldValue == newValue) {
+            return;
+        }
+
+        // Reading the style attribute after a CSSOM change writes the inline style back to it, which is no change.
+        if (name == WebCore::HTMLNames::styleAttr && WTF::String(newValue) == inlineStyleText(element)) {
+            return;
+        }
+
+        invalidate(element);
+    }
+
+    void DOMStateTracker::inlineStyleChanged(WebCore::StyledElement* element)
+    {
+        if (!isTracked(element)) {
+            return;
+        }
+
+        invalidate(element);
+    }
+
+    void DOMStateTracker::characterDataWillChange(WebCore::CharacterData* node, const WTF::String& oldData, const WTF::String& newData)
+    {
+        if (!isTracked(node) || oldData == newData) {
+            return;
+        }
+
+        invalidate(node);
+    }
+
+}
+#endif
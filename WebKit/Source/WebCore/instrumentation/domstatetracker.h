@@ -0,0 +1,70 @@
+#ifdef ARTEMIS
+#ifndef DOMSTATETRACKER_H
+#define DOMSTATETRACKER_H
+
+#include <stdint.h>
+
+#include <wtf/HashMap.h>
+
+namespace WTF {
+    class String;
+    class AtomicString;
+}
+
+namespace WebCore {
+    class Node;
+    class Element;
+    class CharacterData;
+    class Document;
+    class QualifiedName;
+    class StyledElement;
+}
+
+namespace inst {
+
+    /**
+      Maintains a structural hash of each document, kept up to date from the DOM mutation points
+      instead of being recomputed from a serialisation of the page.
+
+      The hash of a node combines its own term (tag and attributes, or character data) with the
+      hashes of its children in order, so sibling order and the position of moved nodes are part of
+      the hash. Each document caches the hash of every subtree which has not changed since it was
+      last hashed. A mutation drops the cached hashes of the node and its ancestors, stopping at the
+      first ancestor which is not cached, so recording it is O(1) amortised. documentHash() then only
+      rehashes the children of the nodes on the mutated paths.
+
+      Shadow trees are excluded. The style attribute is hashed from the inline style of the element
+      rather than from its value, as CSSOM changes to the inline style only update the attribute when
+      it is next read.
+      */
+    class DOMStateTracker
+    {
+    public:
+        typedef WTF::HashMap<WebCore::Node*, uint64_t> SubtreeHashes;
+
+        static void nodeInserted(WebCore::Node*);
+        static void nodeRemoved(WebCore::Node*, WebCore::Node* insertionPoint);
+
+        static void attributeWillChange(WebCore::Element*, const WebCore::QualifiedName&,
+                                        const WTF::AtomicString& oldValue, const WTF::AtomicString& newValue);
+
+        static void characterDataWillChange(WebCore::CharacterData*, const WTF::String& oldData, const WTF::String& newData);
+
+        // Changes to the inline style which do not go through the style attribute (CSSOM and editing).
+        static void inlineStyleChanged(WebCore::StyledElement*);
+
+        static uint64_t documentHash(WebCore::Document*);
+
+    private:
+        static bool isTracked(WebCore::Node*);
+        static void invalidate(WebCore::Node*);
+        static uint64_t subtreeHash(WebCore::Node*, SubtreeHashes&);
+        static uint64_t nodeTerm(WebCore::Node*);
+        static uint64_t attributeTerm(const WebCore::QualifiedName&, const WTF::AtomicString& value);
+        static WTF::String inlineStyleText(WebCore::Element*);
+    };
+
+}
+
+#endif // DOMSTATETRACKER_H
+#endif
@@ -58,21 +58,6 @@ public:
       */
     virtual void javascript_code_loaded(JSC::SourceProvider* sp, JSC::ExecState*) = 0;
 
-    /**
-      Coverage information
-      */
-    virtual void javascript_executed_statement(const JSC::DebuggerCallFrame&, uint lineNumber) = 0;
-
-    /**
-      Function calls
-      */
-    virtual void javascript_called_function(const JSC::DebuggerCallFrame&) = 0;
-
-    /**
-      Function returns
-      */
-    virtual void javascript_returned_function(const JSC::DebuggerCallFrame&) = 0;
-
     /**
       Exception
       */
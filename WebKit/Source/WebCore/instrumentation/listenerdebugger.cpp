@@ -21,17 +21,10 @@ namespace inst {
         }
     }
 
-    void ListenerDebugger::atStatement(const JSC::DebuggerCallFrame& frame, intptr_t sourceID, int lineNumber) {
-        el->javascript_executed_statement(frame, lineNumber);
-    }
-
-    void ListenerDebugger::callEvent(const JSC::DebuggerCallFrame& frame, intptr_t sourceID, int lineNumber) {
-        el->javascript_called_function(frame);
-    }
-
-    void ListenerDebugger::returnEvent(const JSC::DebuggerCallFrame& frame, intptr_t sourceID, int lineNumber) {
-        el->javascript_returned_function(frame);
-    }
+    // Statements, calls and returns are reported by the interpreter directly, see jscinst::JSCExecutionListener.
+    void ListenerDebugger::atStatement(const JSC::DebuggerCallFrame&, intptr_t sourceID, int lineNumber) {}
+    void ListenerDebugger::callEvent(const JSC::DebuggerCallFrame&, intptr_t sourceID, int lineNumber) {}
+    void ListenerDebugger::returnEvent(const JSC::DebuggerCallFrame&, intptr_t sourceID, int lineNumber) {}
 
     void ListenerDebugger::willExecuteProgram(const JSC::DebuggerCallFrame&, intptr_t sourceID, int lineNumber) {}
     void ListenerDebugger::didExecuteProgram(const JSC::DebuggerCallFrame&, intptr_t sourceID, int lineNumber) {}
@@ -39,6 +39,8 @@ namespace inst {
         void didExecuteProgram(const JSC::DebuggerCallFrame&, intptr_t sourceID, int lineNumber);
         void didReachBreakpoint(const JSC::DebuggerCallFrame&, intptr_t sourceID, int lineNumber);
 
+        bool needsExecutionHooks() const { return false; }
+
         ~ListenerDebugger();
         void detach(JSC::JSGlobalObject*);
 
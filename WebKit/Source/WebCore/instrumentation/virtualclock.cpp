@@ -0,0 +1,110 @@
+#ifdef ARTEMIS
+#include <config.h>
+
+#include "virtualclock.h"
+
+#include "SuspendableTimer.h"
+
+#include <algorithm>
+
+namespace inst {
+
+    bool VirtualClock::s_enabled = false;
+    double VirtualClock::s_now = 0;
+    unsigned VirtualClock::s_lastSequence = 0;
+    WTF::Vector<VirtualClock::Entry> VirtualClock::s_heap;
+    WTF::HashSet<WebCore::SuspendableTimer*> VirtualClock::s_scheduled;
+
+    bool VirtualClock::isCurrent(const Entry& entry)
+    {
+        // The timer is only dereferenced once it is known to be alive, a deleted timer is always unscheduled.
+        return s_scheduled.contains(entry.timer) && entry.timer->m_virtualSequence == entry.sequence;
+    }
+
+    void VirtualClock::popEntry()
+    {
+        std::pop_heap(s_heap.begin(), s_heap.end(), EntryLaterThan());
+        s_heap.removeLast();
+    }
+
+    void VirtualClock::compact()
+    {
+        WTF::Vector<Entry> current;
+        current.reserveCapacity(s_scheduled.size());
+
+        for (size_t i = 0; i < s_heap.size(); i++) {
+            if (isCurrent(s_heap[i])) {
+                current.append(s_heap[i]);
+            }
+        }
+
+        s_heap.swap(current);
+        std::make_heap(s_heap.begin(), s_heap.end(), EntryLaterThan());
+    }
+
+    void VirtualClock::schedule(WebCore::SuspendableTimer* timer, double fireTime)
+    {
+        timer->m_virtualActive = true;
+        timer->m_virtualFireTime = fireTime;
+        timer->m_virtualSequence = ++s_lastSequence;
+        s_scheduled.add(timer);
+
+        Entry entry = { fireTime, timer->m_virtualSequence, timer };
+        s_heap.append(entry);
+        std::push_heap(s_heap.begin(), s_heap.end(), EntryLaterThan());
+
+        if (s_heap.size() > 2 * s_scheduled.size() + 64) {
+            compact();
+        }
+    }
+
+    void VirtualClock::unschedule(WebCore::SuspendableTimer* timer)
+    {
+        timer->m_virtualActive = false;
+        timer->m_virtualFireTime = 0;
+        s_scheduled.remove(timer);
+    }
+
+    void VirtualClock::reset()
+    {
+        WTF::HashSet<WebCore::SuspendableTimer*>::iterator end = s_scheduled.end();
+        for (WTF::HashSet<WebCore::SuspendableTimer*>::iterator it = s_scheduled.begin(); it != end; ++it) {
+            (*it)->m_virtualActive = false;
+            (*it)->m_virtualFireTime = 0;
+        }
+
+        s_scheduled.clear();
+        s_heap.clear();
+        s_now = 0;
+    }
+
+    bool VirtualClock::fireNext(double horizon)
+    {
+        while (!s_heap.isEmpty() && !isCurrent(s_heap.first())) {
+            popEntry();
+        }
+
+        if (s_heap.isEmpty() || s_heap.first().fireTime > horizon) {
+            return false;
+        }
+
+        WebCore::SuspendableTimer* timer = s_heap.first().timer;
+        popEntry();
+
+        s_now = std::max(s_now, timer->m_virtualFireTime);
+
+        // As in ThreadTimers, a repeating timer is rescheduled before it fires, so it can stop or adjust itself.
+        double interval = timer->m_virtualRepeatInterval;
+        if (interval) {
+            schedule(timer, s_now + interval);
+        } else {
+            unschedule(timer);
+        }
+
+        // The timer may be deleted by firing it.
+        timer->fired();
+        return true;
+    }
+
+}
+#endif
@@ -0,0 +1,74 @@
+#ifdef ARTEMIS
+#ifndef VIRTUALCLOCK_H
+#define VIRTUALCLOCK_H
+
+#include <wtf/HashSet.h>
+#include <wtf/Vector.h>
+
+namespace WebCore {
+    class SuspendableTimer;
+}
+
+namespace inst {
+
+    /**
+      A virtual time source for the SuspendableTimers (setTimeout, setInterval and the document event queue).
+
+      While enabled, newly created SuspendableTimers are kept out of the platform timer heap and are scheduled
+      against the virtual time of this clock instead. Virtual time never advances on its own, it jumps to the
+      fire time of the next timer whenever fireNext is called, so a timer with a long delay costs no wall time.
+      Time intervals are in seconds, as for TimerBase.
+
+      The clock is driven by the embedder, which fires timers when the engine is otherwise idle.
+      */
+    class VirtualClock
+    {
+    public:
+        static void setEnabled(bool enabled) { s_enabled = enabled; }
+        static bool isEnabled() { return s_enabled; }
+
+        static double now() { return s_now; }
+
+        // Fires the earliest scheduled timer if it is due no later than horizon. Returns false if none is.
+        static bool fireNext(double horizon);
+
+        static unsigned pendingTimerCount() { return s_scheduled.size(); }
+
+        // Unschedules every timer and rewinds virtual time to 0, so a new execution starts from a clean clock.
+        static void reset();
+
+        static void schedule(WebCore::SuspendableTimer*, double fireTime);
+        static void unschedule(WebCore::SuspendableTimer*);
+
+    private:
+        struct Entry {
+            double fireTime;
+            unsigned sequence;
+            WebCore::SuspendableTimer* timer;
+        };
+
+        struct EntryLaterThan {
+            bool operator()(const Entry& a, const Entry& b) const
+            {
+                return a.fireTime > b.fireTime || (a.fireTime == b.fireTime && a.sequence > b.sequence);
+            }
+        };
+
+        static bool isCurrent(const Entry&);
+        static void popEntry();
+        static void compact();
+
+        static bool s_enabled;
+        static double s_now;
+        static unsigned s_lastSequence;
+
+        // A heap of schedulings, ordered by fire time. Rescheduling or stopping a timer leaves its old entry in
+        // the heap, entries whose sequence number is no longer the timer's are skipped when they reach the top.
+        static WTF::Vector<Entry> s_heap;
+        static WTF::HashSet<WebCore::SuspendableTimer*> s_scheduled;
+    };
+
+}
+
+#endif // VIRTUALCLOCK_H
+#endif
@@ -2041,6 +2041,10 @@ void FrameView::scheduleRelayout()
     }
     if (!m_layoutSchedulingEnabled)
         return;
+#ifdef ARTEMIS
+    if (m_frame->settings() && m_frame->settings()->artemisLayoutOnDemand())
+        return;
+#endif
     if (!needsLayout())
         return;
     if (!m_frame->document()->shouldScheduleLayout())
@@ -2080,6 +2084,15 @@ void FrameView::scheduleRelayoutOfSubtree(RenderObject* relayoutRoot)
 {
     ASSERT(m_frame->view() == this);
 
+#ifdef ARTEMIS
+    // Without a scheduled subtree layout, the next layout has to start from the root.
+    if (m_frame->settings() && m_frame->settings()->artemisLayoutOnDemand()) {
+        if (relayoutRoot)
+            relayoutRoot->markContainingBlocksForLayout(false);
+        return;
+    }
+#endif
+
     RenderView* root = rootRenderer(this);
     if (root && root->needsLayout()) {
         if (relayoutRoot)
@@ -264,6 +264,9 @@ Settings::Settings(Page* page)
     , m_threadedAnimationEnabled(false)
     , m_shouldRespectImageOrientation(false)
     , m_wantsBalancedSetDefersLoadingBehavior(false)
+#ifdef ARTEMIS
+    , m_artemisLayoutOnDemand(false)
+#endif
     , m_loadsImagesAutomaticallyTimer(this, &Settings::loadsImagesAutomaticallyTimerFired)
     , m_incrementalRenderingSuppressionTimeoutInSeconds(defaultIncrementalRenderingSuppressionTimeoutInSeconds)
 {
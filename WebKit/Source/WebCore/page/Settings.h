@@ -563,6 +563,12 @@ namespace WebCore {
         static bool shouldRespectPriorityInCSSAttributeSetters();
 #endif
 
+#ifdef ARTEMIS
+        // Headless Artemis pages never schedule layout, it is only done when something needs the geometry.
+        void setArtemisLayoutOnDemand(bool onDemand) { m_artemisLayoutOnDemand = onDemand; }
+        bool artemisLayoutOnDemand() const { return m_artemisLayoutOnDemand; }
+#endif
+
     private:
         Settings(Page*);
 
@@ -721,6 +727,9 @@ namespace WebCore {
         bool m_threadedAnimationEnabled : 1;
         bool m_shouldRespectImageOrientation : 1;
         bool m_wantsBalancedSetDefersLoadingBehavior : 1;
+#ifdef ARTEMIS
+        bool m_artemisLayoutOnDemand : 1;
+#endif
 
         Timer<Settings> m_loadsImagesAutomaticallyTimer;
         void loadsImagesAutomaticallyTimerFired(Timer<Settings>*);
@@ -29,6 +29,11 @@
 
 #include "ScriptExecutionContext.h"
 
+#ifdef ARTEMIS
+#include "instrumentation/virtualclock.h"
+#include <algorithm>
+#endif
+
 namespace WebCore {
 
 SuspendableTimer::SuspendableTimer(ScriptExecutionContext* context)
@@ -39,11 +44,22 @@ SuspendableTimer::SuspendableTimer(ScriptExecutionContext* context)
 #if !ASSERT_DISABLED
     , m_suspended(false)
 #endif
+#ifdef ARTEMIS
+    , m_virtual(inst::VirtualClock::isEnabled())
+    , m_virtualActive(false)
+    , m_virtualFireTime(0)
+    , m_virtualRepeatInterval(0)
+    , m_virtualSequence(0)
+#endif
 {
 }
 
 SuspendableTimer::~SuspendableTimer()
 {
+#ifdef ARTEMIS
+    if (m_virtualActive)
+        inst::VirtualClock::unschedule(this);
+#endif
 }
 
 bool SuspendableTimer::hasPendingActivity() const
@@ -53,7 +69,11 @@ bool SuspendableTimer::hasPendingActivity() const
 
 void SuspendableTimer::stop()
 {
+#ifdef ARTEMIS
+    stopTimer();
+#else
     TimerBase::stop();
+#endif
 }
 
 void SuspendableTimer::suspend(ReasonForSuspension)
@@ -66,7 +86,11 @@ void SuspendableTimer::suspend(ReasonForSuspension)
     if (m_active) {
         m_nextFireInterval = nextFireInterval();
         m_repeatInterval = repeatInterval();
+#ifdef ARTEMIS
+        stopTimer();
+#else
         TimerBase::stop();
+#endif
     }
 }
 
@@ -85,4 +109,69 @@ bool SuspendableTimer::canSuspend() const
     return true;
 }
 
+#ifdef ARTEMIS
+void SuspendableTimer::start(double nextFireInterval, double repeatInterval)
+{
+    if (!m_virtual) {
+        TimerBase::start(nextFireInterval, repeatInterval);
+        return;
+    }
+
+    m_virtualRepeatInterval = repeatInterval;
+    inst::VirtualClock::schedule(this, inst::VirtualClock::now() + nextFireInterval);
+}
+
+void SuspendableTimer::stopTimer()
+{
+    if (!m_virtual) {
+        TimerBase::stop();
+        return;
+    }
+
+    m_virtualRepeatInterval = 0;
+    if (m_virtualActive)
+        inst::VirtualClock::unschedule(this);
+}
+
+bool SuspendableTimer::isActive() const
+{
+    return m_virtual ? m_virtualActive : TimerBase::isActive();
+}
+
+double SuspendableTimer::nextFireInterval() const
+{
+    if (!m_virtual)
+        return TimerBase::nextFireInterval();
+
+    ASSERT(m_virtualActive);
+    return std::max(m_virtualFireTime - inst::VirtualClock::now(), 0.0);
+}
+
+double SuspendableTimer::repeatInterval() const
+{
+    return m_virtual ? m_virtualRepeatInterval : TimerBase::repeatInterval();
+}
+
+void SuspendableTimer::augmentFireInterval(double delta)
+{
+    if (!m_virtual) {
+        TimerBase::augmentFireInterval(delta);
+        return;
+    }
+
+    inst::VirtualClock::schedule(this, m_virtualFireTime + delta);
+}
+
+void SuspendableTimer::augmentRepeatInterval(double delta)
+{
+    if (!m_virtual) {
+        TimerBase::augmentRepeatInterval(delta);
+        return;
+    }
+
+    augmentFireInterval(delta);
+    m_virtualRepeatInterval += delta;
+}
+#endif
+
 } // namespace WebCore
@@ -30,6 +30,12 @@
 #include "ActiveDOMObject.h"
 #include "Timer.h"
 
+#ifdef ARTEMIS
+namespace inst {
+    class VirtualClock;
+}
+#endif
+
 namespace WebCore {
 
 class SuspendableTimer : public TimerBase, public ActiveDOMObject {
@@ -44,9 +50,35 @@ public:
     virtual void suspend(ReasonForSuspension);
     virtual void resume();
 
+#ifdef ARTEMIS
+    // These hide the TimerBase scheduling, so timers created while inst::VirtualClock is enabled run on virtual time.
+    void start(double nextFireInterval, double repeatInterval);
+    void startRepeating(double repeatInterval) { start(repeatInterval, repeatInterval); }
+    void startOneShot(double interval) { start(interval, 0); }
+
+    bool isActive() const;
+    double nextFireInterval() const;
+    double repeatInterval() const;
+
+    void augmentFireInterval(double delta);
+    void augmentRepeatInterval(double delta);
+#endif
+
 private:
     virtual void fired() = 0;
 
+#ifdef ARTEMIS
+    void stopTimer();
+
+    bool m_virtual;
+    bool m_virtualActive;
+    double m_virtualFireTime;
+    double m_virtualRepeatInterval; // 0 if not repeating
+    unsigned m_virtualSequence;
+
+    friend class inst::VirtualClock;
+#endif
+
     double m_nextFireInterval;
     double m_repeatInterval;
     bool m_active;
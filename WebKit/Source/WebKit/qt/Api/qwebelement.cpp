@@ -48,6 +48,7 @@
 #endif
 #include "NodeList.h"
 #include "RenderImage.h"
+#include "Settings.h"
 #include "ScriptState.h"
 #include "StaticNodeList.h"
 #include "StyleResolver.h"
@@ -62,7 +63,10 @@
 
 #ifdef ARTEMIS
 #include "interpreter/Interpreter.h"
-
+#include "HTMLInputElement.h"
+#include "HTMLNames.h"
+#include "HTMLSelectElement.h"
+#include "HTMLTextAreaElement.h"
 #endif
 
 #include <QPainter>
@@ -557,6 +561,12 @@ QRect QWebElement::geometry() const
 {
     if (!m_element)
         return QRect();
+#ifdef ARTEMIS
+    // Layout is not scheduled for these pages, see QWebPage::setLayoutOnDemand().
+    Document* document = m_element->document();
+    if (document->settings() && document->settings()->artemisLayoutOnDemand())
+        document->updateLayoutIgnorePendingStylesheets();
+#endif
     return m_element->getPixelSnappedRect();
 }
 
@@ -857,6 +867,119 @@ int QWebElement::numberOfChildren(QString cssSelector){
     return counter;
 }
 
+/*!
+    Sets the value of an input, select or textarea element, as the
+    JavaScript assignment element.value = value would, but without
+    running any JavaScript.
+
+    Returns false if the element is not one of these form fields.
+*/
+bool QWebElement::setFormValue(const QString& value)
+{
+    if (!m_element)
+        return false;
+
+    if (m_element->hasTagName(HTMLNames::inputTag)) {
+        static_cast<HTMLInputElement*>(m_element)->setValue(value);
+        return true;
+    }
+
+    if (m_element->hasTagName(HTMLNames::selectTag)) {
+        static_cast<HTMLSelectElement*>(m_element)->setValue(value);
+        return true;
+    }
+
+    if (m_element->hasTagName(HTMLNames::textareaTag)) {
+        static_cast<HTMLTextAreaElement*>(m_element)->setValue(value);
+        return true;
+    }
+
+    return false;
+}
+
+/*!
+    Sets the checked state of an input element, as the JavaScript
+    assignment element.checked = checked would, but without running
+    any JavaScript.
+
+    Returns false if the element is not an input element.
+*/
+bool QWebElement::setFormChecked(bool checked)
+{
+    if (!m_element || !m_element->hasTagName(HTMLNames::inputTag))
+        return false;
+
+    static_cast<HTMLInputElement*>(m_element)->setChecked(checked);
+    return true;
+}
+
+/*!
+    Returns the value of an input, select or textarea element, as the
+    JavaScript expression element.value would, but without running any
+    JavaScript.
+
+    Returns a null string if the element is not one of these form fields.
+*/
+QString QWebElement::formValue() const
+{
+    if (!m_element)
+        return QString();
+
+    if (m_element->hasTagName(HTMLNames::inputTag))
+        return static_cast<HTMLInputElement*>(m_element)->value();
+
+    if (m_element->hasTagName(HTMLNames::selectTag))
+        return static_cast<HTMLSelectElement*>(m_element)->value();
+
+    if (m_element->hasTagName(HTMLNames::textareaTag))
+        return static_cast<HTMLTextAreaElement*>(m_element)->value();
+
+    return QString();
+}
+
+/*!
+    Returns the checked state of an input element, as the JavaScript
+    expression element.checked would, but without running any JavaScript.
+
+    Returns false if the element is not an input element.
+*/
+bool QWebElement::formChecked() const
+{
+    if (!m_element || !m_element->hasTagName(HTMLNames::inputTag))
+        return false;
+
+    return static_cast<HTMLInputElement*>(m_element)->checked();
+}
+
+/*!
+    Returns the descendant found by following \a path from this element.
+    Every entry in the path is the 1-based position of an element among the
+    element children of the previous one, as in firstChild() and
+    nextSibling(). Text and comment nodes are not counted.
+
+    Returns a null element if the path leaves the tree.
+*/
+QWebElement QWebElement::elementAtPath(const QList<int>& path) const
+{
+    Element* current = m_element;
+
+    for (int i = 0; i < path.size() && current; i++) {
+        Node* child = current->firstChild();
+        while (child && !child->isElementNode())
+            child = child->nextSibling();
+
+        for (int position = 1; position < path.at(i) && child; position++) {
+            child = child->nextSibling();
+            while (child && !child->isElementNode())
+                child = child->nextSibling();
+        }
+
+        current = static_cast<Element*>(child);
+    }
+
+    return QWebElement(current);
+}
+
 #endif
 
 
@@ -143,6 +143,14 @@ public:
     QString xPath();
     int numberOfChildren(QString cssSelector);
 
+    bool setFormValue(const QString& value);
+    bool setFormChecked(bool checked);
+
+    QString formValue() const;
+    bool formChecked() const;
+
+    QWebElement elementAtPath(const QList<int>& path) const;
+
 #else
     QVariant evaluateJavaScript(const QString& scriptSource);
 #endif
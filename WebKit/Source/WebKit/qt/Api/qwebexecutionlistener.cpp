@@ -38,6 +38,7 @@
 #include "WebCore/xml/LazyXMLHttpRequest.h"
 #include "WebCore/dom/ScriptExecutionContext.h"
 #include "WebCore/page/DOMTimer.h"
+#include "WebCore/instrumentation/virtualclock.h"
 #include "JavaScriptCore/parser/SourceCode.h"
 #include "JavaScriptCore/interpreter/CallFrame.h"
 #include "JavaScriptCore/runtime/ScopeChain.h"
@@ -90,6 +91,20 @@ QList<QString> QWebExecutionListener::getHeapReport(int &heapReportNumber){
     return m_heapReport;
 }
 
+/**
+ * Code loaded from one of these URLs is ignored by the instrumentation hooks inside JSC, see jscinst::isIgnoredSource.
+ * Only sources loaded after this call are affected.
+ */
+void QWebExecutionListener::setUninstrumentedUrls(const QSet<QString>& urls)
+{
+    m_uninstrumentedUrls = urls;
+}
+
+bool QWebExecutionListener::shouldInstrumentSource(JSC::SourceProvider* sourceProvider)
+{
+    return !m_uninstrumentedUrls.contains(QString::fromStdString(sourceProvider->url().utf8().data()));
+}
+
 void QWebExecutionListener::eventCleared(WebCore::EventTarget * target, const char* type) {
     std::string typeString = std::string(type);
 
@@ -192,6 +207,40 @@ void QWebExecutionListener::clearTimers() {
     m_timers.clear();
 }
 
+/**
+ * Timers created from now on run on virtual time, see inst::VirtualClock.
+ * They only fire through timerFire or fireNextVirtualTimer.
+ */
+void QWebExecutionListener::enableVirtualTime() {
+    inst::VirtualClock::setEnabled(true);
+}
+
+/**
+ * Drops all pending virtual timers and goes back to wall clock time for the timers created from now on.
+ */
+void QWebExecutionListener::disableVirtualTime() {
+    inst::VirtualClock::reset();
+    inst::VirtualClock::setEnabled(false);
+}
+
+/**
+ * Drops all pending virtual timers and rewinds virtual time, before a new page is loaded.
+ */
+void QWebExecutionListener::resetVirtualTime() {
+    inst::VirtualClock::reset();
+}
+
+double QWebExecutionListener::virtualTime() const {
+    return inst::VirtualClock::now();
+}
+
+/**
+ * Advances virtual time to the earliest pending timer and fires it, if it is due no later than horizon (in seconds).
+ */
+bool QWebExecutionListener::fireNextVirtualTimer(double horizon) {
+    return inst::VirtualClock::fireNext(horizon);
+}
+
 // TIMERS END
 
 bool domNodeSignature(JSC::CallFrame * cframe, JSC::JSObject * domElement, QString * signature) {
@@ -252,25 +301,40 @@ bool domNodeSignature(JSC::CallFrame * cframe, JSC::JSObject * domElement, QStri
 **/
 
 
-void QWebExecutionListener::javascript_called_function(const JSC::DebuggerCallFrame& frame) {
+/**
+ * The name of a function is only computed the first time the function is called.
+ */
+QString QWebExecutionListener::functionName(JSC::ExecState* callFrame, unsigned functionId) {
+
+    QHash<unsigned, QString>::const_iterator iter = m_functionNames.constFind(functionId);
+
+    if (iter != m_functionNames.constEnd()) {
+        return iter.value();
+    }
+
+    QString name = QString::fromAscii(JSC::DebuggerCallFrame(callFrame).calculatedFunctionName().ascii().data());
+    m_functionNames.insert(functionId, name);
+
+    return name;
+}
+
+void QWebExecutionListener::javascript_function_called(JSC::ExecState* callFrame, JSC::CodeBlock* codeBlock, unsigned functionId) {
 
     if (!JSC::Interpreter::m_enableInstrumentations)
         return;
 
-    std::string functionName = std::string(frame.calculatedFunctionName().ascii().data());
-
-    JSC::CodeBlock* codeBlock = frame.callFrame()->codeBlock();
+    QString functionName = this->functionName(callFrame, functionId);
 
     if((m_reportHeapMode > 0 && (m_reportHeapMode > 1 || functionName.length() > 0)) && (m_heapReportFactor == 0 || 0 == (rand() % m_heapReportFactor))){
         qDebug() << "REPORTIN";
-        JSC::JSFunction* functionObject = (JSC::JSFunction*) frame.callFrame()->callee();
+        JSC::JSFunction* functionObject = (JSC::JSFunction*) callFrame->callee();
 
         std::stringstream ss;
         ss << std::string(JSC::JSObject::className(functionObject).ascii().data()) ;
         ss << "@";
         ss << (const void *) static_cast<const void*>(functionObject);
-        QString url = m_sourceRegistry.get(frame.callFrame()->codeBlock()->source())->getUrl();
-        string fn = functionName.length() >0 ? "\""+functionName + "\"" : "null";
+        QString url = m_sourceRegistry.get(codeBlock->source())->getUrl();
+        string fn = functionName.length() >0 ? "\""+functionName.toStdString() + "\"" : "null";
 
         string offset = QString::number(((JSC::JSFunction*) functionObject)->sourceCode()->startOffset()).toStdString();
         string s = "{\"function-name\":"+fn+", \"source\":\""+url.toStdString()+"\", \"line-number\":";
@@ -282,9 +346,9 @@ void QWebExecutionListener::javascript_called_function(const JSC::DebuggerCallFr
                 .append(QString::fromStdString(", \"time\":\""))
                 .append(dt)
                 .append(QString::fromStdString("\", \"object\":"))
-                .append(functionObject->getAsJSONString(frame.callFrame(), visitedObjects))
+                .append(functionObject->getAsJSONString(callFrame, visitedObjects))
                 .append(QString::fromStdString(", \"state\":"));
-        frame.callFrame()->heap()->heapAsString(frame.callFrame(), &hReport, visitedObjects);
+        callFrame->heap()->heapAsString(callFrame, &hReport, visitedObjects);
         hReport.append(QString::fromStdString("}"));
         m_heapReport.append(hReport);
         if(m_heapReport.length() >=10){
@@ -314,15 +378,15 @@ void QWebExecutionListener::javascript_called_function(const JSC::DebuggerCallFr
     }
 
 
-    emit sigJavascriptFunctionCalled(QString::fromStdString(functionName),
+    emit sigJavascriptFunctionCalled(functionName,
                                      codeBlock->numberOfInstructions(),
                                      codeBlock->lineNumberForBytecodeOffset(0),
                                      codeBlock->sourceOffset(),
                                      m_sourceRegistry.get(codeBlock->source()));
 
-    if (functionName.compare("__jquery_event_add__") == 0) {
+    if (functionName == QLatin1String("__jquery_event_add__")) {
 
-        JSC::CallFrame* cframe = frame.callFrame(); JSC::JSValue element = cframe->argument(0);
+        JSC::CallFrame* cframe = callFrame; JSC::JSValue element = cframe->argument(0);
         
         if (element.isObject() == false) {
             qWarning() << "WARNING: unknown element encountered when handling JQuery support";
@@ -359,13 +423,12 @@ void QWebExecutionListener::javascript_called_function(const JSC::DebuggerCallFr
     }
 }
 
-void QWebExecutionListener::javascript_returned_function(const JSC::DebuggerCallFrame& frame) {
+void QWebExecutionListener::javascript_function_returned(JSC::ExecState* callFrame, JSC::CodeBlock*, unsigned functionId) {
 
     if (!JSC::Interpreter::m_enableInstrumentations)
         return;
 
-    std::string functionName = std::string(frame.calculatedFunctionName().ascii().data());
-    emit sigJavascriptFunctionReturned(QString::fromStdString(functionName));
+    emit sigJavascriptFunctionReturned(functionName(callFrame, functionId));
 }
 
 void QWebExecutionListener::exceptional_condition(std::string cause, intptr_t sourceID, int lineNumber) {
@@ -412,17 +475,24 @@ void QWebExecutionListener::javascript_code_loaded(JSC::SourceProvider* sp, JSC:
     if (!JSC::Interpreter::m_enableInstrumentations)
         return;
 
+    if (!sp->isArtemisIgnoreDecided()) {
+        sp->setArtemisIgnored(!shouldInstrumentSource(sp));
+    }
+
     std::string source(sp->getRange(0, sp->length()).utf8().data());
 
     emit loadedJavaScript(QString(tr(source.c_str())), m_sourceRegistry.get(sp));
 }
 
-void QWebExecutionListener::javascript_executed_statement(const JSC::DebuggerCallFrame& callFrame, uint linenumber) {
+void QWebExecutionListener::javascript_statement_executed(JSC::ExecState*, JSC::CodeBlock* codeBlock, int linenumber) {
 
     if (!JSC::Interpreter::m_enableInstrumentations)
         return;
 
-    JSC::SourceProvider* sourceProvider = callFrame.callFrame()->codeBlock()->source();
+    JSC::SourceProvider* sourceProvider = codeBlock->source();
+
+    if (jscinst::isIgnoredSource(sourceProvider))
+        return;
 
     emit statementExecuted(linenumber,
                            m_sourceRegistry.get(sourceProvider));
@@ -451,6 +521,42 @@ void QWebExecutionListener::javascript_bytecode_executed(JSC::Interpreter* inter
                                        m_sourceRegistry.get(codeBlock->source()));
 }
 
+void QWebExecutionListener::javascript_bytecode_range_executed(JSC::Interpreter* interpreter,
+                                                               JSC::CodeBlock* codeBlock,
+                                                               unsigned firstOffset,
+                                                               unsigned lastOffset) {
+
+    if (!JSC::Interpreter::m_enableInstrumentations)
+        return;
+
+    QSource* source = m_sourceRegistry.get(codeBlock->source());
+    BytecodeRange range(qMakePair(source, codeBlock->sourceOffset()), qMakePair(firstOffset, lastOffset));
+
+    if (m_reportedBytecodeRanges.contains(range))
+        return;
+
+    m_reportedBytecodeRanges.insert(range);
+
+    QList<ByteCodeInfoStruct> binfos;
+
+    for (unsigned bytecodeOffset = firstOffset; bytecodeOffset <= lastOffset; ) {
+        JSC::Instruction* instruction = codeBlock->instructions().begin() + bytecodeOffset;
+
+        ByteCodeInfoStruct binfo;
+        binfo.opcodeId = interpreter->getOpcodeID(instruction->u.opcode);
+        binfo.linenumber = codeBlock->lineNumberForBytecodeOffset(bytecodeOffset);
+        binfo.isSymbolic = false;
+        binfo.bytecodeOffset = bytecodeOffset;
+
+        codeBlock->expressionRangeForBytecodeOffset(bytecodeOffset, binfo.divot, binfo.startOffset, binfo.endOffset);
+        binfos.append(binfo);
+
+        bytecodeOffset += JSC::opcodeLengths[binfo.opcodeId];
+    }
+
+    emit sigJavascriptBytecodeRangeExecuted(binfos, codeBlock->sourceOffset(), source);
+}
+
 void QWebExecutionListener::javascript_property_read(std::string propertyName, JSC::CallFrame* callFrame)
 {
 
@@ -519,6 +625,25 @@ void QWebExecutionListener::endSymbolicSession()
     JSC::Interpreter::m_symbolic->endSession();
 }
 
+/**
+ * Opcode name -> number of times an instruction with that opcode was executed symbolically.
+ * Opcodes which were never executed symbolically are left out.
+ */
+QMap<QString, uint> QWebExecutionListener::getSymbolicInstructionCounts() const
+{
+    QMap<QString, uint> counts;
+
+    for (int opcodeID = 0; opcodeID < JSC::numOpcodeIDs; opcodeID++) {
+        uint count = JSC::Interpreter::m_symbolic->getSymbolicInstructionCount((JSC::OpcodeID)opcodeID);
+
+        if (count > 0) {
+            counts.insert(QString::fromAscii(JSC::opcodeNames[opcodeID]), count);
+        }
+    }
+
+    return counts;
+}
+
 namespace inst {
 
 ExecutionListener* listener = 0;
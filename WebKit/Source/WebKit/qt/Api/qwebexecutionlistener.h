@@ -17,6 +17,9 @@
 #include <QtCore/qobject.h>
 #include <QUrl>
 #include <QMap>
+#include <QSet>
+#include <QHash>
+#include <QPair>
 #include "qwebkitglobal.h"
 #include "qwebelement.h"
 
@@ -54,6 +57,7 @@ struct ByteCodeInfoStruct
 };
 
 Q_DECLARE_METATYPE(ByteCodeInfoStruct);
+Q_DECLARE_METATYPE(QList<ByteCodeInfoStruct>);
 
 class QWEBKIT_EXPORT QWebExecutionListener : public QObject, public inst::ExecutionListener, public jscinst::JSCExecutionListener
 {
@@ -72,11 +76,12 @@ public:
     virtual void exceptional_condition(std::string cause, intptr_t sourceID, int lineNumber);
     virtual void url_changed(JSC::JSValue, JSC::ExecState* e);
     virtual void webkit_ajax_send(const char * url, const char * data);
-    virtual void javascript_called_function(const JSC::DebuggerCallFrame&);
-    virtual void javascript_returned_function(const JSC::DebuggerCallFrame&);
+    virtual void javascript_function_called(JSC::ExecState*, JSC::CodeBlock*, unsigned functionId);
+    virtual void javascript_function_returned(JSC::ExecState*, JSC::CodeBlock*, unsigned functionId);
 
-    virtual void javascript_executed_statement(const JSC::DebuggerCallFrame&, uint lineNumber); // from the debugger
+    virtual void javascript_statement_executed(JSC::ExecState*, JSC::CodeBlock*, int lineNumber);
     virtual void javascript_bytecode_executed(JSC::Interpreter* interpreter, JSC::CodeBlock*, JSC::Instruction* inst, const JSC::BytecodeInfo& info); // interpreter instrumentation
+    virtual void javascript_bytecode_range_executed(JSC::Interpreter* interpreter, JSC::CodeBlock*, unsigned firstOffset, unsigned lastOffset);
     virtual void javascript_property_read(std::string propertyName, JSC::ExecState*);
     virtual void javascript_property_written(std::string propertyName, JSC::ExecState*);
     virtual void javascript_branch_executed(bool jump, Symbolic::Expression* condition, JSC::ExecState*, const JSC::Instruction*, const JSC::BytecodeInfo&);
@@ -84,6 +89,9 @@ public:
     void javascriptConstantStringEncountered(std::string constant);
     virtual void javascript_eval_call(const char * eval_string);
 
+    virtual bool shouldInstrumentSource(JSC::SourceProvider* sourceProvider);
+    void setUninstrumentedUrls(const QSet<QString>& urls);
+
     virtual void ajaxCallbackEventAdded(WebCore::LazyXMLHttpRequest*);
 
     void ajaxCallbackFire(int callbackId);
@@ -96,22 +104,37 @@ public:
     void timerFire(int timerId);
     void clearTimers();
 
+    void enableVirtualTime();
+    void disableVirtualTime();
+    void resetVirtualTime();
+    double virtualTime() const;
+    bool fireNextVirtualTimer(double horizon);
+
     void enableHeapReport(bool namedOnly, int heapReportNumber, int factor);
     QList<QString> getHeapReport(int &heapReportNumber);
 
     void beginSymbolicSession();
     void endSymbolicSession();
+    QMap<QString, uint> getSymbolicInstructionCounts() const;
 
     static QWebExecutionListener* getListener();
     static void attachListeners();
 
 private:
+    QString functionName(JSC::ExecState*, unsigned functionId);
+
     QMap<int, WebCore::ScriptExecutionContext*> m_timers;
 
     QMap<int, WebCore::LazyXMLHttpRequest*> m_ajax_callbacks;
     int m_ajax_callback_next_id;
 
     QSourceRegistry m_sourceRegistry;
+    QSet<QString> m_uninstrumentedUrls;
+
+    // Concrete ranges already reported, <<source, code block source offset>, <first offset, last offset>>.
+    typedef QPair<QPair<QSource*, uint>, QPair<uint, uint> > BytecodeRange;
+    QSet<BytecodeRange> m_reportedBytecodeRanges;
+    QHash<unsigned, QString> m_functionNames; // <function id, name>
     QList<QString> m_heapReport;
     int m_reportHeapMode;
     int m_heapReportNumber;
@@ -146,6 +169,8 @@ signals:
     void sigJavascriptFunctionCalled(QString functionName, size_t bytecodeSize, uint functionLine, uint sourceOffset, QSource* source);
     void sigJavascriptFunctionReturned(QString functionName);
     void sigJavascriptBytecodeExecuted(const ByteCodeInfoStruct byteInfo, uint sourceOffset, QSource* source);
+    // Coverage is cumulative, so each distinct range is only reported the first time it is executed.
+    void sigJavascriptBytecodeRangeExecuted(const QList<ByteCodeInfoStruct> byteInfos, uint sourceOffset, QSource* source);
     void sigJavascriptBranchExecuted(bool jump, Symbolic::Expression* condition, uint sourceOffset, QSource* source, const ByteCodeInfoStruct byteInfo);
 
     /* Page Load Instrumentation */
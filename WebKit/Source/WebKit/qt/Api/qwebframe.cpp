@@ -46,6 +46,11 @@
 #endif
 #include "GraphicsContext.h"
 #include "HTMLMetaElement.h"
+#ifdef ARTEMIS
+#include "HTMLCollection.h"
+#include "HTMLFormElement.h"
+#include <wtf/text/StringConcatenate.h>
+#endif
 #include "HitTestResult.h"
 #include "HTTPParsers.h"
 #include "IconDatabase.h"
@@ -719,6 +724,107 @@ QString QWebFrame::toHtml() const
     return createMarkup(d->frame->document());
 }
 
+#ifdef ARTEMIS
+/*!
+    Returns a hash of the frame's DOM which is maintained incrementally at the
+    DOM mutation points, so it can be read without serialising the document.
+
+    Equal documents have equal hashes. The hash accounts for the order of
+    nodes and for the inline style of elements.
+
+    \sa domMutationCount()
+*/
+quint64 QWebFrame::domStateHash() const
+{
+    if (!d->frame->document())
+        return 0;
+    return d->frame->document()->artemisDomStateHash();
+}
+
+/*!
+    Returns the number of DOM mutations recorded for the frame's current
+    document. It is incremented for every mutation which can change
+    domStateHash().
+*/
+quint64 QWebFrame::domMutationCount() const
+{
+    if (!d->frame->document())
+        return 0;
+    return d->frame->document()->artemisDomMutationCount();
+}
+
+/*!
+    Returns the version of the frame's document tree. WebCore assigns a new
+    version whenever nodes are inserted or removed or attributes change, and
+    versions are never shared between documents, so a changed version also
+    reveals that a new page has been loaded into the frame.
+*/
+quint64 QWebFrame::domTreeVersion() const
+{
+    if (!d->frame->document())
+        return 0;
+    return d->frame->document()->domTreeVersion();
+}
+
+/*!
+    Performs any pending style recalculation and layout of the frame and its
+    subframes right away, instead of waiting for the layout timer.
+
+    Returns false if there was nothing to do.
+*/
+bool QWebFrame::flushPendingLayout()
+{
+    WebCore::FrameView* view = d->frame->view();
+    WebCore::Document* document = d->frame->document();
+    if (!view || !document)
+        return false;
+
+    bool stylePending = document->needsStyleRecalc() || document->childNeedsStyleRecalc();
+
+    // Layout which has not been scheduled is left alone, see QWebPage::setLayoutOnDemand().
+    if (d->frame->settings() && d->frame->settings()->artemisLayoutOnDemand()) {
+        if (stylePending)
+            document->updateStyleIfNeeded();
+        return stylePending;
+    }
+
+    if (!view->layoutPending() && !view->needsLayout() && !stylePending)
+        return false;
+
+    view->updateLayoutAndStyleIfNeededRecursive();
+    return true;
+}
+
+/*!
+    Gives every field of every form in the frame's document the id
+    "<prefix>-<form index>-<field index>", unless the field already has an
+    id which does not contain the prefix. Fields are numbered as in the
+    document.forms and form.elements collections.
+*/
+void QWebFrame::assignFormFieldIds(const QString& prefix)
+{
+    Document* document = d->frame->document();
+    if (!document)
+        return;
+
+    String idPrefix = prefix;
+    HTMLCollection* forms = document->forms();
+
+    for (unsigned i = 0; i < forms->length(); ++i) {
+        HTMLFormElement* form = static_cast<HTMLFormElement*>(forms->item(i));
+        HTMLCollection* elements = form->elements();
+
+        for (unsigned j = 0; j < elements->length(); ++j) {
+            Element* element = static_cast<Element*>(elements->item(j));
+            const AtomicString& id = element->getIdAttribute();
+
+            if (id.isEmpty() || id.contains(idPrefix))
+                element->setIdAttribute(makeString(idPrefix, "-", String::number(i), "-", String::number(j)));
+        }
+    }
+}
+#endif
+
 /*!
     Returns the content of this frame converted to plain text, completely
     stripped of all HTML formatting.
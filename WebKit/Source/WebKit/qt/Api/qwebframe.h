@@ -138,6 +138,14 @@ public:
     QString toPlainText() const;
     QString renderTreeDump() const;
 
+#ifdef ARTEMIS
+    quint64 domStateHash() const;
+    quint64 domMutationCount() const;
+    quint64 domTreeVersion() const;
+    bool flushPendingLayout();
+    void assignFormFieldIds(const QString& prefix);
+#endif
+
     QString title() const;
     void setUrl(const QUrl &url);
     QUrl url() const;
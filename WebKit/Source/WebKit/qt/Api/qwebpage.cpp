@@ -2450,6 +2450,20 @@ void QWebPage::setViewportSize(const QSize &size) const
     }
 }
 
+#ifdef ARTEMIS
+/*!
+    If \a onDemand is true, the page never schedules layout by itself. Layout
+    is done when something needs the geometry of the page, e.g. by
+    QWebElement::geometry() or when handling an input event.
+
+    Intended for pages without a view, which are never painted.
+*/
+void QWebPage::setLayoutOnDemand(bool onDemand)
+{
+    d->page->settings()->setArtemisLayoutOnDemand(onDemand);
+}
+#endif
+
 static int getintenv(const char* variable)
 {
     bool ok;
@@ -287,6 +287,9 @@ public:
 
     QSize viewportSize() const;
     void setViewportSize(const QSize &size) const;
+#ifdef ARTEMIS
+    void setLayoutOnDemand(bool onDemand);
+#endif
     ViewportAttributes viewportAttributesForSize(const QSize& availableSize) const;
 
     QSize preferredContentsSize() const;
@@ -34,6 +34,7 @@ HEADERS += src/runtime/input/ajaxinput.h \
     src/runtime/browser/executionresult.h \
     src/runtime/browser/webkitexecutor.h \
     src/runtime/browser/timer.h \
+    src/runtime/browser/quiescencedetector.h \
     src/runtime/worklist/deterministicworklist.h \
     src/runtime/worklist/worklist.h \
     src/strategies/termination/numberofiterationstermination.h \
@@ -56,6 +57,7 @@ HEADERS += src/runtime/input/ajaxinput.h \
     src/util/urlutil.h \
     src/statistics/statsstorage.h \
     src/statistics/writers/pretty.h \
+    src/statistics/writers/json.h \
     src/exceptionhandlingqapp.h \
     src/runtime/browser/executionresultbuilder.h \
     src/strategies/inputgenerator/form/forminputgenerator.h \
@@ -71,6 +73,8 @@ HEADERS += src/runtime/input/ajaxinput.h \
     src/runtime/input/events/toucheventparameters.h \
     src/model/pathtracer.h \
     src/runtime/toplevel/artemisruntime.h \
+    src/runtime/pagestate/pagestateabstraction.h \
+    src/runtime/pagestate/visitedstateindex.h \
     src/runtime/browser/artemiswebview.h \
     src/runtime/browser/artemiswebpage.h \
     src/concolic/search/search.h \
@@ -89,6 +93,7 @@ HEADERS += src/runtime/input/ajaxinput.h \
     src/runtime/toplevel/manualruntime.h \
     src/runtime/input/events/unknowneventparameters.h \
     src/concolic/traceeventdetectors.h \
+    src/concolic/domtokeniser.h \
     src/concolic/tracestatistics.h \
     src/concolic/solver/solution.h \
     src/concolic/solver/expressionprinter.h \
@@ -116,10 +121,23 @@ HEADERS += src/runtime/input/ajaxinput.h \
     src/concolic/executiontree/nodes/traceunexploredunsat.h \
     src/concolic/executiontree/nodes/traceunexploredmissed.h \
     src/concolic/executiontree/nodes/traceunexploredunsolvable.h \
+    src/concolic/executiontree/nodes/traceunexploredtimeout.h \
     src/concolic/mockentrypointdetector.h \
     src/runtime/input/clickinput.h \
     src/concolic/executiontree/tracedisplayoverview.h \
+    src/concolic/executiontree/tracecheckpoint.h \
+    src/concolic/executiontree/traceeventlog.h \
     src/concolic/solver/cvc4solver.h \
+    src/concolic/solver/processsolver.h \
+    src/concolic/solver/portfoliosolver.h \
+    src/concolic/solver/cachingsolver.h \
+    src/concolic/solver/expressionevaluator.h \
+    src/concolic/solver/expressionkeyprinter.h \
+    src/concolic/solver/expressionsimplifier.h \
+    src/concolic/solver/expressionserializer.h \
+    src/concolic/solver/concreteregex.h \
+    src/concolic/solver/localsearchsolver.h \
+    src/concolic/solver/simplifyingsolver.h \
     src/concolic/solver/constraintwriter/cvc4.h \
     src/concolic/solver/constraintwriter/smt.h \
     src/concolic/solver/constraintwriter/cvc4regexcompiler.h \
@@ -150,6 +168,7 @@ SOURCES += src/runtime/input/ajaxinput.cpp \
     src/runtime/browser/executionresult.cpp \
     src/runtime/browser/webkitexecutor.cpp \
     src/runtime/browser/timer.cpp \
+    src/runtime/browser/quiescencedetector.cpp \
     src/runtime/worklist/deterministicworklist.cpp \
     src/strategies/termination/numberofiterationstermination.cpp \
     src/strategies/inputgenerator/randominputgenerator.cpp \
@@ -168,6 +187,7 @@ SOURCES += src/runtime/input/ajaxinput.cpp \
     src/util/urlutil.cpp \
     src/statistics/statsstorage.cpp \
     src/statistics/writers/pretty.cpp \
+    src/statistics/writers/json.cpp \
     src/exceptionhandlingqapp.cpp \
     src/runtime/browser/executionresultbuilder.cpp \
     src/strategies/inputgenerator/event/staticeventparametergenerator.cpp \
@@ -181,6 +201,8 @@ SOURCES += src/runtime/input/ajaxinput.cpp \
     src/runtime/input/events/toucheventparameters.cpp \
     src/model/pathtracer.cpp \
     src/runtime/toplevel/artemisruntime.cpp \
+    src/runtime/pagestate/pagestateabstraction.cpp \
+    src/runtime/pagestate/visitedstateindex.cpp \
     src/concolic/solver/expressionprinter.cpp \
     src/concolic/solver/solver.cpp \
     src/concolic/entrypoints.cpp \
@@ -195,6 +217,7 @@ SOURCES += src/runtime/input/ajaxinput.cpp \
     src/runtime/toplevel/manualruntime.cpp \
     src/runtime/input/events/unknowneventparameters.cpp \
     src/concolic/traceeventdetectors.cpp \
+    src/concolic/domtokeniser.cpp \
     src/concolic/tracestatistics.cpp \
     src/concolic/solver/solution.cpp \
     src/runtime/demomode/traceviewerdialog.cpp \
@@ -222,10 +245,23 @@ SOURCES += src/runtime/input/ajaxinput.cpp \
     src/concolic/executiontree/nodes/traceunexploredunsat.cpp \
     src/concolic/executiontree/nodes/traceunexploredmissed.cpp \
     src/concolic/executiontree/nodes/traceunexploredunsolvable.cpp \
+    src/concolic/executiontree/nodes/traceunexploredtimeout.cpp \
     src/concolic/mockentrypointdetector.cpp \
     src/runtime/input/clickinput.cpp \
     src/concolic/executiontree/tracedisplayoverview.cpp \
+    src/concolic/executiontree/tracecheckpoint.cpp \
+    src/concolic/executiontree/traceeventlog.cpp \
     src/concolic/solver/cvc4solver.cpp \
+    src/concolic/solver/processsolver.cpp \
+    src/concolic/solver/portfoliosolver.cpp \
+    src/concolic/solver/cachingsolver.cpp \
+    src/concolic/solver/expressionevaluator.cpp \
+    src/concolic/solver/expressionkeyprinter.cpp \
+    src/concolic/solver/expressionsimplifier.cpp \
+    src/concolic/solver/expressionserializer.cpp \
+    src/concolic/solver/concreteregex.cpp \
+    src/concolic/solver/localsearchsolver.cpp \
+    src/concolic/solver/simplifyingsolver.cpp \
     src/concolic/solver/constraintwriter/cvc4.cpp \
     src/concolic/solver/constraintwriter/smt.cpp \
     src/concolic/solver/constraintwriter/cvc4regexcompiler.cpp \
@@ -27,6 +27,8 @@
 #include "artemisapplication.h"
 #include "util/loggingutil.h"
 #include "artemisglobals.h"
+#include "runtime/toplevel/concolicruntime.h"
+#include "runtime/pagestate/visitedstateindex.h"
 
 using namespace std;
 
@@ -53,6 +55,20 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
             "\n"
             "-s       : Enable DOM state checking\n"
             "\n"
+            "--state-abstraction <abstraction>:\n"
+            "           Select the page state abstraction used by DOM state checking. Implies -s.\n"
+            "\n"
+            "           dom - (default) the complete DOM, including text\n"
+            "           structure - element structure, form field values and registered event handlers,\n"
+            "                       ignoring text and digit runs in attribute values\n"
+            "\n"
+            "--state-ignore-attribute <name>:\n"
+            "           Ignore the value of the attribute <name> in the structure abstraction.\n"
+            "\n"
+            "--state-approximate <k>:\n"
+            "           Also treat a state as visited if it differs from a visited state in at most <k> bits\n"
+            "           of its 64 bit SimHash (structure abstraction only, 0 to 7). Default is 0.\n"
+            "\n"
             "-e       : Negate the last solved PC printet to stdout (used for testing)\n"
             "\n"
             "--major-mode <mode>:\n"
@@ -94,16 +110,53 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
             "           none - Do not output any graphs.\n"
             "           final (default) - Generate a graph of the final tree after analysis.\n"
             "           final-overview - Like final but also includes a simplified overview graph."
-            "           all - Generate a graph of the tree at every iteration.\n"
+            "           all - Like final, and also keep a log of the tree from which a graph of every iteration can\n"
+            "                 be generated with --concolic-tree-render.\n"
             "           all-overview - Like all but also includes simplified overview graphs."
             "\n"
+            "--concolic-tree-render <log>\n"
+            "           Generate the graphs of the tree from a log kept by an earlier run (see --concolic-tree-output)\n"
+            "           and exit. Use with --concolic-tree-output to choose the graphs to generate.\n"
+            "\n"
             "--concolic-unlimited-depth\n"
             "           Removes the depth limit from the concolic search procedure.\n"
             "\n"
+            "--concolic-all-entry-points\n"
+            "           Explore every detected entry point on the page instead of choosing one. Each entry point has its\n"
+            "           own execution tree, and the one with the most unexplored branches is explored next.\n"
+            "\n"
+            "--concolic-checkpoint <file>\n"
+            "           Save the execution tree and search state to <file> after each iteration. If <file> holds a tree\n"
+            "           from an earlier run on the same site, the analysis resumes from that tree.\n"
+            "           The changes made between full saves are appended to <file>.log.\n"
+            "\n"
             "--smt-solver <solver>:\n"
             "           z3str - Use the Z3-str SMT solver as backend.\n"
             "           cvc4 (default) - Use the CVC4 SMT solver as backend. CVC4 is required to be on your path.\n"
-            "           kaluza - Use the Kaluza solver as backend."
+            "           kaluza - Use the Kaluza solver as backend.\n"
+            "           portfolio - Run CVC4 and Z3-str concurrently and use the first to decide the constraints."
+            "\n"
+            "--smt-timeout <ms>\n"
+            "           Stop the solver after <ms> milliseconds on a query (default 10000, 0 for no limit).\n"
+            "           Once everything else in the concolic tree is explored, queries which timed out are retried with\n"
+            "           larger time budgets.\n"
+            "\n"
+            "--smt-local-search <n>\n"
+            "           Before running the solver, search for a solution by mutating recent inputs with the constants of the\n"
+            "           constraints, checking at most <n> candidates (default 500, 0 to disable).\n"
+            "\n"
+            "--smt-cache <file>\n"
+            "           Keep solver results in <file> between runs on the same site. Queries which are subsets of a cached\n"
+            "           UNSAT query, or are satisfied by a cached solution, are answered without running the solver.\n"
+            "\n"
+            "--smt-query-cache <on|off>\n"
+            "           Answer queries from the results of earlier queries (default on). Use off to compare against the\n"
+            "           uncached solver, --smt-cache is then ignored.\n"
+            "\n"
+            "--smt-simplify <on|off>\n"
+            "           Simplify the constraints before they are given to the solver (default on). Constant\n"
+            "           subexpressions are folded, and conditions which are duplicated or implied by equalities on the same\n"
+            "           input are removed.\n"
             "\n"
             "--strategy-priority <strategy>:\n"
             "           Select priority strategy.\n"
@@ -130,6 +183,18 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
             "\n"
             "--function-call-heap-report-random-factor <int>\n"
             "           When faced with many function calls, this parameter saves data with a factor <int>^-1\n"
+            "\n"
+            "--statistics-json <file>\n"
+            "           Also write the final statistics to <file> as a JSON object.\n"
+            "\n"
+            "--virtual-time <ms>\n"
+            "           Run setTimeout and setInterval timers on virtual time. After the page load and after every event,\n"
+            "           timers due within <ms> of virtual time are fired at once, until the page is quiescent.\n"
+            "           By default timers run in real time.\n"
+            "\n"
+            "--headless\n"
+            "           Run the page without a view, in a fixed 1024x768 viewport. Layout is only done when the\n"
+            "           geometry of the page is needed and nothing is painted. Ignored in the manual mode.\n"
             "\n";
 
     struct option long_options[] = {
@@ -145,8 +210,22 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
     {"concolic-tree-output", required_argument, NULL, 'd'},
     {"concolic-button", required_argument, NULL, 'b'},
     {"concolic-unlimited-depth", no_argument, NULL, 'u'},
+    {"concolic-all-entry-points", no_argument, NULL, 'A'},
+    {"concolic-checkpoint", required_argument, NULL, 'K'},
+    {"concolic-tree-render", required_argument, NULL, 'R'},
     {"smt-solver", required_argument, NULL, 'n'},
+    {"smt-timeout", required_argument, NULL, 'S'},
+    {"smt-cache", required_argument, NULL, 'C'},
+    {"smt-local-search", required_argument, NULL, 'L'},
+    {"smt-query-cache", required_argument, NULL, 'Q'},
+    {"smt-simplify", required_argument, NULL, 'N'},
     {"export-event-sequence", required_argument, NULL, 'o'},
+    {"state-abstraction", required_argument, NULL, 'w'},
+    {"state-ignore-attribute", required_argument, NULL, 'W'},
+    {"state-approximate", required_argument, NULL, 'Y'},
+    {"statistics-json", required_argument, NULL, 'J'},
+    {"virtual-time", required_argument, NULL, 'T'},
+    {"headless", no_argument, NULL, 'H'},
     {"help", no_argument, NULL, 'h'},
     {"option-values", optional_argument, NULL, 'q'},
     {0, 0, 0, 0}
@@ -258,6 +337,93 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
             break;
         }
 
+        case 'J': {
+            options.statisticsJsonFile = QString(optarg);
+            break;
+        }
+
+        case 'S': {
+            bool ok;
+            int timeout = QString(optarg).toInt(&ok);
+
+            if (!ok || timeout < 0) {
+                cerr << "ERROR: Invalid choice of smt-timeout " << optarg << endl;
+                exit(1);
+            }
+
+            options.solverTimeout = timeout;
+            break;
+        }
+
+        case 'C': {
+            options.solverCacheFile = QString(optarg);
+            break;
+        }
+
+        case 'K': {
+            options.concolicCheckpointFile = QString(optarg);
+            break;
+        }
+
+        case 'R': {
+            options.concolicTreeRenderLog = QString(optarg);
+            break;
+        }
+
+        case 'L': {
+            bool ok;
+            int budget = QString(optarg).toInt(&ok);
+
+            if (!ok || budget < 0) {
+                cerr << "ERROR: Invalid choice of smt-local-search " << optarg << endl;
+                exit(1);
+            }
+
+            options.solverLocalSearchBudget = budget;
+            break;
+        }
+
+        case 'Q': {
+
+            if (string(optarg).compare("on") == 0) {
+                options.solverQueryCache = true;
+            } else if (string(optarg).compare("off") == 0) {
+                options.solverQueryCache = false;
+            } else {
+                cerr << "ERROR: Invalid choice of smt-query-cache " << optarg << endl;
+                exit(1);
+            }
+
+            break;
+        }
+
+        case 'N': {
+
+            if (string(optarg).compare("on") == 0) {
+                options.solverSimplify = true;
+            } else if (string(optarg).compare("off") == 0) {
+                options.solverSimplify = false;
+            } else {
+                cerr << "ERROR: Invalid choice of smt-simplify " << optarg << endl;
+                exit(1);
+            }
+
+            break;
+        }
+
+        case 'T': {
+            bool ok;
+            int horizon = QString(optarg).toInt(&ok);
+
+            if (!ok || horizon < 0) {
+                cerr << "ERROR: Invalid choice of virtual-time " << optarg << endl;
+                exit(1);
+            }
+
+            options.virtualTimeHorizon = horizon;
+            break;
+        }
+
         case 'k': {
             options.coverageIgnoreUrls.insert(QUrl(QString(optarg)));
             break;
@@ -292,6 +458,8 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
                 options.solver = artemis::Z3STR;
             } else if (string(optarg).compare("cvc4") == 0) {
                 options.solver = artemis::CVC4;
+            } else if (string(optarg).compare("portfolio") == 0) {
+                options.solver = artemis::PORTFOLIO;
             } else {
                 cerr << "ERROR: Invalid choice of --smt-solver " << optarg << endl;
                 exit(1);
@@ -340,7 +508,9 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
                 } else if(string(optarg).compare("--function-call-heap-report") == 0){
                     std::cout << "all named none";
                 } else if(string(optarg).compare("--smt-solver") == 0){
-                    std::cout << "z3str cvc4 kaluza";
+                    std::cout << "z3str cvc4 kaluza portfolio";
+                } else if(string(optarg).compare("--state-abstraction") == 0){
+                    std::cout << "dom structure";
                 } else if(string(optarg).compare("--export-event-sequence") == 0){
                     std::cout << "selenium";
                 }
@@ -354,12 +524,26 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
                              "--concolic-button "
                              "--concolic-tree-output "
                              "--concolic-unlimited-depth "
+                             "--concolic-all-entry-points "
+                             "--concolic-checkpoint "
+                             "--concolic-tree-render "
                              "--strategy-priority "
                              "--smt-solver "
+                             "--smt-timeout "
+                             "--smt-cache "
+                             "--smt-local-search "
+                             "--smt-query-cache "
+                             "--smt-simplify "
                              "--export-event-sequence "
                              "--input-strategy-same-length "
                              "--function-call-heap-report "
                              "--function-call-heap-report-random-factor "
+                             "--state-abstraction "
+                             "--state-ignore-attribute "
+                             "--state-approximate "
+                             "--statistics-json "
+                             "--virtual-time "
+                             "--headless "
                              "--export-event-sequence";
             }
 
@@ -387,6 +571,16 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
             break;
         }
 
+        case 'A': {
+            options.concolicAllEntryPoints = true;
+            break;
+        }
+
+        case 'H': {
+            options.headless = true;
+            break;
+        }
+
         case 'v': {
            artemis::Log::addLogLevel(artemis::OFF);
 
@@ -419,6 +613,39 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
            break;
        }
 
+        case 'w': {
+
+            if (string(optarg).compare("dom") == 0) {
+                options.stateAbstraction = artemis::STATE_DOM;
+            } else if (string(optarg).compare("structure") == 0) {
+                options.stateAbstraction = artemis::STATE_STRUCTURE;
+            } else {
+                cerr << "ERROR: Invalid choice of state-abstraction " << optarg << endl;
+                exit(1);
+            }
+
+            options.disableStateCheck = false;
+            break;
+        }
+
+        case 'W': {
+            options.stateIgnoredAttributes.insert(QString(optarg));
+            break;
+        }
+
+        case 'Y': {
+            bool ok;
+            int distance = QString(optarg).toInt(&ok);
+
+            if (!ok || distance < 0 || distance > (int)artemis::VisitedStateIndex::MAX_DISTANCE) {
+                cerr << "ERROR: Invalid choice of state-approximate " << optarg << endl;
+                exit(1);
+            }
+
+            options.stateApproximateDistance = distance;
+            break;
+        }
+
         case 'x': {
 
             if (string(optarg).compare("javascript-constants") == 0) {
@@ -473,8 +700,8 @@ QUrl parseCmd(int argc, char* argv[], artemis::Options& options)
     QUrl url;
 
     if (optind >= argc) {
-        // If we are in manual mode then the url is optional.
-        if(options.majorMode != artemis::MANUAL){
+        // If we are in manual mode or only rendering a tree log then the url is optional.
+        if(options.majorMode != artemis::MANUAL && options.concolicTreeRenderLog.isEmpty()){
             cerr << "Error: You must specify a URL" << endl;
             exit(1);
         }else{
@@ -543,6 +770,10 @@ int main(int argc, char* argv[])
     artemis::Options options;
     QUrl url = parseCmd(argc, argv, options);
 
+    if (!options.concolicTreeRenderLog.isEmpty()) {
+        return artemis::ConcolicRuntime::renderTreeLog(options.concolicTreeRenderLog, options) ? 0 : 1;
+    }
+
     artemis::ArtemisApplication artemisApp(0, &app, options, url);
     artemisApp.run(url);
 
@@ -0,0 +1,194 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "domtokeniser.h"
+
+namespace artemis
+{
+
+static const int INITIAL_TABLE_SIZE = 1024; // Must be a power of two.
+
+// Lookup table for the ASCII delimiters, built once.
+struct DelimiterTable
+{
+    bool isDelimiter[128];
+
+    DelimiterTable()
+    {
+        memset(isDelimiter, 0, sizeof(isDelimiter));
+
+        const char* delimiters = "\t\n\v\f\r <>\"':.,!?/;-";
+        for (const char* c = delimiters; *c != '\0'; c++) {
+            isDelimiter[(int)*c] = true;
+        }
+    }
+};
+
+static const DelimiterTable delimiterTable;
+
+static inline bool isDelimiter(ushort c)
+{
+    if (c < 128) {
+        return delimiterTable.isDelimiter[c];
+    }
+
+    return QChar(c).isSpace();
+}
+
+DomTokeniser::DomTokeniser(const QList<QString>& indicators) :
+    mTable(INITIAL_TABLE_SIZE, 0)
+{
+    for (int i = 0; i < indicators.size(); i++) {
+        mFoldedIndicators.insert(indicators.at(i).toCaseFolded(), i);
+    }
+}
+
+QVector<domtokenid_t> DomTokeniser::tokenise(const QString& dom)
+{
+    QVector<domtokenid_t> tokens;
+
+    const ushort* data = dom.utf16();
+    const int length = dom.length();
+    int i = 0;
+
+    while (i < length) {
+
+        while (i < length && isDelimiter(data[i])) {
+            i++;
+        }
+
+        if (i == length) {
+            break;
+        }
+
+        int start = i;
+
+#ifdef __SSE2__
+        // Skip eight characters at a time while they are all in [0x40, 0x7F]. None of the delimiters are in
+        // that range, and it covers all ASCII letters, so most of a word is consumed here.
+        const __m128i lower = _mm_set1_epi16(0x40);
+        const __m128i minusOne = _mm_set1_epi16(-1);
+
+        while (i + 8 <= length) {
+            __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i shifted = _mm_sub_epi16(chars, lower);
+            __m128i inRange = _mm_and_si128(_mm_cmplt_epi16(shifted, lower), _mm_cmpgt_epi16(shifted, minusOne));
+
+            if (_mm_movemask_epi8(inRange) != 0xFFFF) {
+                break;
+            }
+
+            i += 8;
+        }
+#endif
+
+        while (i < length && !isDelimiter(data[i])) {
+            i++;
+        }
+
+        tokens.append(intern(data + start, i - start));
+    }
+
+    return tokens;
+}
+
+domtokenid_t DomTokeniser::intern(const ushort* data, int length)
+{
+    // FNV-1a
+    uint hash = 2166136261u;
+    for (int i = 0; i < length; i++) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+
+    uint mask = mTable.size() - 1;
+    uint slot = hash & mask;
+
+    while (mTable.at(slot) != 0) {
+        domtokenid_t candidate = mTable.at(slot) - 1;
+
+        if (mHashes.at(candidate) == hash && mLengths.at(candidate) == length &&
+                memcmp(mPool.constData() + mOffsets.at(candidate), data, length * sizeof(ushort)) == 0) {
+            return candidate;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    // New token
+    domtokenid_t token = mHashes.size();
+
+    mHashes.append(hash);
+    mOffsets.append(mPool.size());
+    mLengths.append(length);
+
+    int offset = mPool.size();
+    mPool.resize(offset + length);
+    memcpy(mPool.data() + offset, data, length * sizeof(ushort));
+
+    mIndicatorIndex.append(mFoldedIndicators.value(QString::fromUtf16(data, length).toCaseFolded(), -1));
+
+    mTable[slot] = token + 1;
+
+    if ((uint)mHashes.size() * 2 > (uint)mTable.size()) {
+        grow();
+    }
+
+    return token;
+}
+
+void DomTokeniser::grow()
+{
+    mTable = QVector<uint>(mTable.size() * 2, 0);
+    uint mask = mTable.size() - 1;
+
+    for (int token = 0; token < mHashes.size(); token++) {
+        uint slot = mHashes.at(token) & mask;
+
+        while (mTable.at(slot) != 0) {
+            slot = (slot + 1) & mask;
+        }
+
+        mTable[slot] = token + 1;
+    }
+}
+
+QString DomTokeniser::getToken(domtokenid_t token) const
+{
+    return QString::fromUtf16(mPool.constData() + mOffsets.at(token), mLengths.at(token));
+}
+
+uint DomTokeniser::numTokens() const
+{
+    return mHashes.size();
+}
+
+void DomTokeniser::clear()
+{
+    mTable = QVector<uint>(INITIAL_TABLE_SIZE, 0);
+    mHashes.clear();
+    mOffsets.clear();
+    mLengths.clear();
+    mIndicatorIndex.clear();
+    mPool.clear();
+}
+
+}
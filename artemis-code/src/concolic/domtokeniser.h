@@ -0,0 +1,81 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <QString>
+#include <QList>
+#include <QHash>
+#include <QVector>
+
+#ifndef DOMTOKENISER_H
+#define DOMTOKENISER_H
+
+namespace artemis
+{
+
+typedef uint domtokenid_t;
+
+/*
+ *  Splits serialised DOMs into tokens and interns every token, so that later stages can work on integer IDs
+ *  instead of strings.
+ *
+ *  A token is a maximal run of characters which are not delimiters. The delimiters are the same as the ones
+ *  used by the old QRegExp based tokeniser: whitespace (as defined by QChar::isSpace) and < > " ' : . , ! ? / ; -
+ *
+ *  Each interned token is matched once (case-insensitively) against the list of indicator words given to the
+ *  constructor, so checking an occurrence of a token is a single array lookup.
+ *
+ *  Token IDs are only stable until clear() is called, which drops every interned token.
+ */
+class DomTokeniser
+{
+public:
+    DomTokeniser(const QList<QString>& indicators);
+
+    QVector<domtokenid_t> tokenise(const QString& dom);
+
+    // Index into the indicator list given to the constructor, or -1 if the token is not an indicator.
+    inline int indicatorIndex(domtokenid_t token) const
+    {
+        return mIndicatorIndex.at(token);
+    }
+
+    QString getToken(domtokenid_t token) const;
+    uint numTokens() const;
+
+    void clear();
+
+private:
+    domtokenid_t intern(const ushort* data, int length);
+    void grow();
+
+    // Open addressing hash table, holding token ID + 1 (0 marks an empty slot).
+    QVector<uint> mTable;
+
+    // Indexed by token ID.
+    QVector<uint> mHashes;
+    QVector<int> mOffsets;
+    QVector<int> mLengths;
+    QVector<int> mIndicatorIndex;
+
+    // Characters of all interned tokens, back to back.
+    QVector<ushort> mPool;
+
+    QHash<QString, int> mFoldedIndicators;
+};
+
+}
+
+#endif // DOMTOKENISER_H
@@ -0,0 +1,52 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRACEUNEXPLOREDTIMEOUT_H
+#define TRACEUNEXPLOREDTIMEOUT_H
+
+#include "traceunexplored.h"
+
+namespace artemis {
+
+/**
+ *  A marker for parts of the tree which we attempted to explore but the solver ran out of time on the PC.
+ *
+ *  Unlike the other markers this is not a singleton, as it records the time budget which was exceeded so the node
+ *  can be retried with a larger one.
+ */
+class TraceUnexploredTimeout : public TraceUnexplored
+{
+public:
+    TraceUnexploredTimeout(uint budget);
+
+    void accept(TraceVisitor* visitor);
+    bool isEqualShallow(const QSharedPointer<const TraceNode>& other);
+    ~TraceUnexploredTimeout() {}
+
+    // The solver time budget in milliseconds which was exceeded.
+    inline uint getBudget() const {
+        return mBudget;
+    }
+
+private:
+    uint mBudget;
+};
+
+typedef QSharedPointer<TraceUnexploredTimeout> TraceUnexploredTimeoutPtr;
+
+}
+
+#endif // TRACEUNEXPLOREDTIMEOUT_H
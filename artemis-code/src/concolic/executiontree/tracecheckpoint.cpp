@@ -0,0 +1,375 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <QDateTime>
+#include <QFile>
+
+#include "util/loggingutil.h"
+
+#include "traceeventlog.h"
+
+#include "tracecheckpoint.h"
+
+namespace artemis
+{
+
+TraceCheckpoint::TraceCheckpoint(QDataStream& nodes, QDataStream& expressions)
+    : mNodes(nodes)
+    , mExpressions(expressions)
+{
+}
+
+bool TraceCheckpoint::save(const QString& fileName, const QString& site, TraceNodePtr tree, const SearchState& state, quint64* stamp)
+{
+    // The expression records are only known once the whole tree has been visited, so both parts are built in
+    // memory and then written out after the header.
+    QByteArray nodes, expressions;
+    QDataStream nodeStream(&nodes, QIODevice::WriteOnly);
+    QDataStream expressionStream(&expressions, QIODevice::WriteOnly);
+
+    TraceCheckpoint writer(nodeStream, expressionStream);
+    writer.writeNode(tree);
+
+    QString tempFileName = fileName + ".tmp";
+    QFile file(tempFileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    // Only needs to differ from the stamp of the checkpoint being replaced.
+    quint64 newStamp = ((quint64)QDateTime::currentMSecsSinceEpoch() << 16) ^ (quint64)qrand();
+
+    QDataStream out(&file);
+    out << FILE_MAGIC << FILE_VERSION << site << newStamp;
+    writeState(out, state);
+    out << writer.mExpressions.size();
+    out.writeRawData(expressions.constData(), expressions.size());
+    out.writeRawData(nodes.constData(), nodes.size());
+
+    file.close();
+    if (out.status() != QDataStream::Ok || file.error() != QFile::NoError) {
+        QFile::remove(tempFileName);
+        return false;
+    }
+
+    // rename(2) replaces the old checkpoint atomically, unlike QFile::rename, which fails if the file exists.
+    if (::rename(QFile::encodeName(tempFileName).constData(), QFile::encodeName(fileName).constData()) != 0) {
+        QFile::remove(tempFileName);
+        return false;
+    }
+
+    // The old journal does not match the new stamp, so it is only removed to save space.
+    QFile::remove(journalFileName(fileName));
+
+    if (stamp != NULL) {
+        *stamp = newStamp;
+    }
+    return true;
+}
+
+TraceNodePtr TraceCheckpoint::load(const QString& fileName, const QString& site, SearchState& state)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0) {
+        return TraceNodePtr();
+    }
+
+    uchar* data = file.map(0, file.size());
+    if (data == NULL) {
+        return TraceNodePtr();
+    }
+
+    // Reads straight from the mapping, without copying the file.
+    QByteArray mapped = QByteArray::fromRawData((const char*)data, file.size());
+    QDataStream in(mapped);
+
+    quint32 magic, version, expressionCount;
+    QString savedSite;
+    quint64 stamp;
+    SearchState saved;
+    in >> magic >> version >> savedSite >> stamp;
+    readState(in, saved);
+    in >> expressionCount;
+
+    bool ok = in.status() == QDataStream::Ok && magic == FILE_MAGIC && version == FILE_VERSION && savedSite == site;
+
+    ExpressionDeserializer expressions(in);
+    for (quint32 i = 0; ok && i < expressionCount; i++) {
+        ok = expressions.readRecord();
+    }
+
+    TraceNodePtr tree;
+    if (ok) {
+        tree = readNode(in, expressions, ok);
+    }
+
+    file.unmap(data);
+
+    if (!ok || tree.isNull()) {
+        return TraceNodePtr();
+    }
+
+    // A journal which cannot be opened (e.g. none was written since the save) or which belongs to an earlier
+    // checkpoint leaves the saved tree as it is.
+    TraceEventLogReader journal(journalFileName(fileName), tree);
+    if (journal.open() && journal.getBase() == stamp) {
+        while (journal.next()) {
+        }
+
+        tree = journal.getTree();
+        if (journal.hasSearchState()) {
+            saved = journal.getSearchState();
+        }
+    }
+
+    state = saved;
+    return tree;
+}
+
+QString TraceCheckpoint::journalFileName(const QString& fileName)
+{
+    return fileName + ".log";
+}
+
+void TraceCheckpoint::writeState(QDataStream& out, const SearchState& state)
+{
+    out << state.iterations << state.depthLimit << state.searchPasses
+        << state.solverBudget << state.solverEscalations << state.solverTimeoutsPending;
+}
+
+void TraceCheckpoint::readState(QDataStream& in, SearchState& state)
+{
+    in >> state.iterations >> state.depthLimit >> state.searchPasses
+       >> state.solverBudget >> state.solverEscalations >> state.solverTimeoutsPending;
+}
+
+/** Writing **/
+
+void TraceCheckpoint::writeNode(TraceNodePtr node)
+{
+    if (node.isNull()) {
+        mNodes << (quint8)NO_NODE;
+    } else {
+        node->accept(this);
+    }
+}
+
+void TraceCheckpoint::writeBranches(TraceBranch* node)
+{
+    writeNode(node->getFalseBranch());
+    writeNode(node->getTrueBranch());
+}
+
+void TraceCheckpoint::visit(TraceNode* node)
+{
+    Log::fatal("Trace checkpoint visited a node of unknown type.");
+    exit(1);
+}
+
+void TraceCheckpoint::visit(TraceConcreteBranch* node)
+{
+    mNodes << (quint8)CONCRETE_BRANCH;
+    writeBranches(node);
+}
+
+void TraceCheckpoint::visit(TraceSymbolicBranch* node)
+{
+    // Written first, so the records of the condition precede the branch when the file is read.
+    quint32 condition = mExpressions.write(node->getSymbolicCondition());
+
+    mNodes << (quint8)SYMBOLIC_BRANCH << condition;
+    writeBranches(node);
+}
+
+void TraceCheckpoint::visit(TraceUnexplored* node)
+{
+    mNodes << (quint8)UNEXPLORED;
+}
+
+void TraceCheckpoint::visit(TraceUnexploredUnsat* node)
+{
+    mNodes << (quint8)UNEXPLORED_UNSAT;
+}
+
+void TraceCheckpoint::visit(TraceUnexploredUnsolvable* node)
+{
+    mNodes << (quint8)UNEXPLORED_UNSOLVABLE;
+}
+
+void TraceCheckpoint::visit(TraceUnexploredMissed* node)
+{
+    mNodes << (quint8)UNEXPLORED_MISSED;
+}
+
+void TraceCheckpoint::visit(TraceUnexploredTimeout* node)
+{
+    mNodes << (quint8)UNEXPLORED_TIMEOUT << (quint32)node->getBudget();
+}
+
+void TraceCheckpoint::visit(TraceAlert* node)
+{
+    mNodes << (quint8)ALERT << node->message;
+    writeNode(node->next);
+}
+
+void TraceCheckpoint::visit(TraceDomModification* node)
+{
+    mNodes << (quint8)DOM_MODIFICATION << node->amountModified << node->words;
+    writeNode(node->next);
+}
+
+void TraceCheckpoint::visit(TracePageLoad* node)
+{
+    mNodes << (quint8)PAGE_LOAD << node->url;
+    writeNode(node->next);
+}
+
+void TraceCheckpoint::visit(TraceFunctionCall* node)
+{
+    mNodes << (quint8)FUNCTION_CALL << node->name;
+    writeNode(node->next);
+}
+
+void TraceCheckpoint::visit(TraceEndSuccess* node)
+{
+    mNodes << (quint8)END_SUCCESS;
+    writeNode(node->next);
+}
+
+void TraceCheckpoint::visit(TraceEndFailure* node)
+{
+    mNodes << (quint8)END_FAILURE;
+    writeNode(node->next);
+}
+
+void TraceCheckpoint::visit(TraceEndUnknown* node)
+{
+    mNodes << (quint8)END_UNKNOWN;
+}
+
+/** Reading **/
+
+TraceNodePtr TraceCheckpoint::readBranches(QSharedPointer<TraceBranch> branch, QDataStream& in, const ExpressionDeserializer& expressions, bool& ok)
+{
+    branch->setFalseBranch(readNode(in, expressions, ok));
+    branch->setTrueBranch(readNode(in, expressions, ok));
+
+    // The branches of a node in the tree are never null, they are unexplored instead.
+    ok = ok && !branch->getFalseBranch().isNull() && !branch->getTrueBranch().isNull();
+
+    return branch;
+}
+
+TraceNodePtr TraceCheckpoint::readNode(QDataStream& in, const ExpressionDeserializer& expressions, bool& ok)
+{
+    quint8 kind;
+    in >> kind;
+
+    if (!ok || in.status() != QDataStream::Ok) {
+        ok = false;
+        return TraceNodePtr();
+    }
+
+    switch (kind) {
+    case NO_NODE:
+        return TraceNodePtr();
+
+    case CONCRETE_BRANCH:
+        return readBranches(QSharedPointer<TraceBranch>(new TraceConcreteBranch()), in, expressions, ok);
+
+    case SYMBOLIC_BRANCH: {
+        quint32 index;
+        in >> index;
+
+        Symbolic::Expression* condition = expressions.get(index);
+        if (condition == NULL) {
+            ok = false;
+            return TraceNodePtr();
+        }
+
+        return readBranches(QSharedPointer<TraceBranch>(new TraceSymbolicBranch(condition)), in, expressions, ok);
+    }
+
+    case UNEXPLORED:
+        return TraceUnexplored::getInstance();
+
+    case UNEXPLORED_UNSAT:
+        return TraceUnexploredUnsat::getInstance();
+
+    case UNEXPLORED_UNSOLVABLE:
+        return TraceUnexploredUnsolvable::getInstance();
+
+    case UNEXPLORED_MISSED:
+        return TraceUnexploredMissed::getInstance();
+
+    case UNEXPLORED_TIMEOUT: {
+        quint32 budget;
+        in >> budget;
+        return TraceNodePtr(new TraceUnexploredTimeout(budget));
+    }
+
+    case ALERT: {
+        QSharedPointer<TraceAlert> alert = QSharedPointer<TraceAlert>(new TraceAlert());
+        in >> alert->message;
+        alert->next = readNode(in, expressions, ok);
+        return alert;
+    }
+
+    case DOM_MODIFICATION: {
+        QSharedPointer<TraceDomModification> modification = QSharedPointer<TraceDomModification>(new TraceDomModification());
+        in >> modification->amountModified >> modification->words;
+        modification->next = readNode(in, expressions, ok);
+        return modification;
+    }
+
+    case PAGE_LOAD: {
+        QSharedPointer<TracePageLoad> load = QSharedPointer<TracePageLoad>(new TracePageLoad());
+        in >> load->url;
+        load->next = readNode(in, expressions, ok);
+        return load;
+    }
+
+    case FUNCTION_CALL: {
+        QSharedPointer<TraceFunctionCall> call = QSharedPointer<TraceFunctionCall>(new TraceFunctionCall());
+        in >> call->name;
+        call->next = readNode(in, expressions, ok);
+        return call;
+    }
+
+    case END_SUCCESS: {
+        QSharedPointer<TraceEndSuccess> end = QSharedPointer<TraceEndSuccess>(new TraceEndSuccess());
+        end->next = readNode(in, expressions, ok);
+        return end;
+    }
+
+    case END_FAILURE: {
+        QSharedPointer<TraceEndFailure> end = QSharedPointer<TraceEndFailure>(new TraceEndFailure());
+        end->next = readNode(in, expressions, ok);
+        return end;
+    }
+
+    case END_UNKNOWN:
+        return TraceNodePtr(new TraceEndUnknown());
+
+    default:
+        ok = false;
+        return TraceNodePtr();
+    }
+}
+
+} // namespace artemis
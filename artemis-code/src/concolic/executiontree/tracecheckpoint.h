@@ -0,0 +1,116 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRACECHECKPOINT_H
+#define TRACECHECKPOINT_H
+
+#include <QDataStream>
+#include <QString>
+
+#include "concolic/executiontree/tracenodes.h"
+#include "concolic/solver/expressionserializer.h"
+
+namespace artemis
+{
+
+/**
+ *  Saves an execution tree (with its symbolic conditions and annotations) and the state of the search over it to a
+ *  binary file, so an interrupted concolic run can be resumed, or a later run can start from an earlier tree.
+ *
+ *  File format (QDataStream): magic, version, site url, stamp, search state, the number of expression records, the
+ *  expression records (see ExpressionSerializer), then the nodes of the tree in pre-order. Each node is a kind
+ *  followed by its fields, symbolic branches refer to their condition by its expression index.
+ *
+ *  The file is written to a temporary file which atomically replaces the old checkpoint, so a crash while saving
+ *  leaves either the previous or the new checkpoint. It is memory mapped for loading.
+ *
+ *  Between two saves, the changes to the tree and the search state can be appended to a journal next to the file
+ *  (see journalFileName), which is a TraceEventLog based on the stamp of the checkpoint. Loading replays the journal
+ *  onto the saved tree, up to its last complete event, if their stamps match. A journal left over from the previous
+ *  checkpoint is therefore never replayed onto a new one.
+ */
+class TraceCheckpoint : public TraceVisitor
+{
+public:
+    // The state of the search procedure in ConcolicRuntime.
+    struct SearchState
+    {
+        SearchState() : iterations(0), depthLimit(0), searchPasses(0), solverBudget(0), solverEscalations(0), solverTimeoutsPending(false) {}
+        qint32 iterations;
+        qint32 depthLimit;
+        qint32 searchPasses;
+        quint32 solverBudget;
+        qint32 solverEscalations;
+        bool solverTimeoutsPending;
+    };
+
+    // Returns the stamp of the new checkpoint in stamp, which its journal must be opened with.
+    static bool save(const QString& fileName, const QString& site, TraceNodePtr tree, const SearchState& state, quint64* stamp = NULL);
+
+    // Returns the tree, or null if the file could not be read or was saved for a different site.
+    static TraceNodePtr load(const QString& fileName, const QString& site, SearchState& state);
+
+    static QString journalFileName(const QString& fileName);
+
+    void visit(TraceNode* node); // Never called unless node types change.
+    void visit(TraceConcreteBranch* node);
+    void visit(TraceSymbolicBranch* node);
+    void visit(TraceUnexplored* node);
+    void visit(TraceUnexploredUnsat* node);
+    void visit(TraceUnexploredUnsolvable* node);
+    void visit(TraceUnexploredMissed* node);
+    void visit(TraceUnexploredTimeout* node);
+    void visit(TraceAlert* node);
+    void visit(TraceDomModification* node);
+    void visit(TracePageLoad* node);
+    void visit(TraceFunctionCall* node);
+    void visit(TraceEndSuccess* node);
+    void visit(TraceEndFailure* node);
+    void visit(TraceEndUnknown* node);
+
+private:
+    // The tree log writes and reads its events in the same format.
+    friend class TraceEventLog;
+    friend class TraceEventLogReader;
+
+    TraceCheckpoint(QDataStream& nodes, QDataStream& expressions);
+
+    enum NodeKind {
+        NO_NODE, CONCRETE_BRANCH, SYMBOLIC_BRANCH,
+        UNEXPLORED, UNEXPLORED_UNSAT, UNEXPLORED_UNSOLVABLE, UNEXPLORED_MISSED, UNEXPLORED_TIMEOUT,
+        ALERT, DOM_MODIFICATION, PAGE_LOAD, FUNCTION_CALL,
+        END_SUCCESS, END_FAILURE, END_UNKNOWN
+    };
+
+    void writeNode(TraceNodePtr node);
+    void writeBranches(TraceBranch* node);
+
+    static void writeState(QDataStream& out, const SearchState& state);
+    static void readState(QDataStream& in, SearchState& state);
+
+    static TraceNodePtr readNode(QDataStream& in, const ExpressionDeserializer& expressions, bool& ok);
+    static TraceNodePtr readBranches(QSharedPointer<TraceBranch> branch, QDataStream& in, const ExpressionDeserializer& expressions, bool& ok);
+
+    QDataStream& mNodes;
+    ExpressionSerializer mExpressions;
+
+    static const quint32 FILE_MAGIC = 0x41525454; // "ARTT"
+    static const quint32 FILE_VERSION = 2;
+};
+
+} // namespace artemis
+
+#endif // TRACECHECKPOINT_H
@@ -39,6 +39,7 @@ TraceDisplay::TraceDisplay(bool simplified) :
     mStyleUnexploredUnsat = "[label = \"UNSAT\", shape = ellipse, style = filled, fillcolor = lightgray]";
     mStyleUnexploredUnsolvable = "[label = \"Could not solve\", shape = ellipse, style = filled, fillcolor = lightgray]";
     mStyleUnexploredMissed = "[label = \"Missed\", shape = ellipse, style = filled, fillcolor = lightgray]";
+    mStyleUnexploredTimeout = "[shape = ellipse, style = filled, fillcolor = lightgray]";
     mStyleAlerts = "[shape = rectangle, style = filled, fillcolor = beige]";
     mStyleDomMods = "[shape = rectangle, style = filled, fillcolor = peachpuff]";
     mStyleLoads = "[shape = rectangle, style=filled, fillcolor = honeydew]";
@@ -105,6 +106,12 @@ QString TraceDisplay::makeGraph(TraceNodePtr tree)
     }
     result += indent + "}\n\n";
 
+    result += indent + "subgraph unexplored_timeout {\n" + indent + indent + "node " + mStyleUnexploredTimeout + ";\n\n";
+    foreach(QString node, mHeaderUnexploredTimeout){
+        result += indent + indent + node + ";\n";
+    }
+    result += indent + "}\n\n";
+
     result += indent + "subgraph alerts {\n" + indent + indent + "node " + mStyleAlerts + ";\n\n";
     foreach(QString node, mHeaderAlerts){
         result += indent + indent + node + ";\n";
@@ -355,6 +362,18 @@ void TraceDisplay::visit(TraceUnexploredMissed *node)
     addInEdge(name);
 }
 
+void TraceDisplay::visit(TraceUnexploredTimeout *node)
+{
+    flushAggregation();
+
+    QString name = QString("unexp_timeout_%1").arg(mNodeCounter);
+    mNodeCounter++;
+
+    mHeaderUnexploredTimeout.append(QString("%1 [label = \"Timed out\\n(%2 ms)\"]").arg(name).arg(node->getBudget()));
+
+    addInEdge(name);
+}
+
 
 void TraceDisplay::visit(TraceAlert *node)
 {
@@ -509,6 +528,7 @@ void TraceDisplay::clearData()
     mHeaderUnexploredUnsat.clear();
     mHeaderUnexploredUnsolvable.clear();
     mHeaderUnexploredMissed.clear();
+    mHeaderUnexploredTimeout.clear();
     mHeaderAlerts.clear();
     mHeaderDomMods.clear();
     mHeaderLoads.clear();
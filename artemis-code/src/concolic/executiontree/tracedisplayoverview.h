@@ -41,6 +41,7 @@ public:
     //void visit(TraceUnexploredUnsat* node);       // Handled by TraceDisplay
     //void visit(TraceUnexploredUnsolvable* node);  // Handled by TraceDisplay
     //void visit(TraceUnexploredMissed* node);      // Handled by TraceDisplay
+    //void visit(TraceUnexploredTimeout* node);     // Handled by TraceDisplay
     void visit(TraceAlert* node);
     void visit(TraceDomModification* node);
     void visit(TracePageLoad* node);
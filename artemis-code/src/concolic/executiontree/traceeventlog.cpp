@@ -0,0 +1,259 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "concolic/executiontree/tracemerger.h"
+
+#include "traceeventlog.h"
+
+namespace artemis
+{
+
+TraceEventLog::TraceEventLog()
+    : mNodeStream(&mNodeBuffer)
+    , mExpressionStream(&mExpressionBuffer)
+    , mExpressionsWritten(0)
+{
+    mNodeBuffer.open(QIODevice::WriteOnly);
+    mExpressionBuffer.open(QIODevice::WriteOnly);
+}
+
+bool TraceEventLog::open(const QString& fileName, quint64 base)
+{
+    close();
+
+    mFile.setFileName(fileName);
+    if (!mFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        return false;
+    }
+
+    mWriter = QSharedPointer<TraceCheckpoint>(new TraceCheckpoint(mNodeStream, mExpressionStream));
+    mExpressionsWritten = 0;
+
+    QDataStream out(&mFile);
+    out << FILE_MAGIC << FILE_VERSION << base;
+    mFile.flush();
+
+    return out.status() == QDataStream::Ok;
+}
+
+bool TraceEventLog::isOpen() const
+{
+    return mFile.isOpen();
+}
+
+void TraceEventLog::close()
+{
+    if (mFile.isOpen()) {
+        mFile.close();
+    }
+    mWriter.clear();
+}
+
+void TraceEventLog::addTrace(TraceNodePtr trace)
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    mWriter->writeNode(trace);
+    writeEvent(TRACE);
+}
+
+void TraceEventLog::addMarker(const QVector<bool>& path, TraceNodePtr marker)
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    mNodeStream << path;
+    mWriter->writeNode(marker);
+    writeEvent(MARKER);
+}
+
+void TraceEventLog::addState(const TraceCheckpoint::SearchState& state)
+{
+    if (!isOpen()) {
+        return;
+    }
+
+    TraceCheckpoint::writeState(mNodeStream, state);
+    writeEvent(STATE);
+}
+
+qint64 TraceEventLog::size() const
+{
+    return mFile.size();
+}
+
+void TraceEventLog::writeEvent(EventType type)
+{
+    quint32 expressionCount = mWriter->mExpressions.size() - mExpressionsWritten;
+    mExpressionsWritten += expressionCount;
+
+    QDataStream out(&mFile);
+    out << (quint8)type << expressionCount;
+    out.writeRawData(mExpressionBuffer.data().constData(), mExpressionBuffer.data().size());
+    out.writeRawData(mNodeBuffer.data().constData(), mNodeBuffer.data().size());
+
+    // Flushed per event, so a crash loses at most the event being written.
+    mFile.flush();
+
+    mExpressionBuffer.buffer().clear();
+    mExpressionBuffer.seek(0);
+    mNodeBuffer.buffer().clear();
+    mNodeBuffer.seek(0);
+}
+
+TraceEventLogReader::TraceEventLogReader(const QString& fileName, TraceNodePtr tree)
+    : mFile(fileName)
+    , mStream(&mFile)
+    , mExpressions(mStream)
+    , mTree(tree)
+    , mBase(0)
+    , mHasSearchState(false)
+{
+}
+
+bool TraceEventLogReader::open()
+{
+    if (!mFile.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    quint32 magic, version;
+    mStream >> magic >> version >> mBase;
+
+    return mStream.status() == QDataStream::Ok && magic == TraceEventLog::FILE_MAGIC && version == TraceEventLog::FILE_VERSION;
+}
+
+bool TraceEventLogReader::next()
+{
+    if (mStream.atEnd()) {
+        return false;
+    }
+
+    quint8 type;
+    quint32 expressionCount;
+    mStream >> type >> expressionCount;
+
+    bool ok = mStream.status() == QDataStream::Ok;
+    for (quint32 i = 0; ok && i < expressionCount; i++) {
+        ok = mExpressions.readRecord();
+    }
+
+    if (!ok) {
+        return false;
+    }
+
+    switch (type) {
+    case TraceEventLog::TRACE: {
+        TraceNodePtr trace = TraceCheckpoint::readNode(mStream, mExpressions, ok);
+        if (!ok || trace.isNull()) {
+            return false;
+        }
+
+        mTree = TraceMerger::merge(trace, mTree);
+        return true;
+    }
+
+    case TraceEventLog::MARKER: {
+        QVector<bool> path;
+        mStream >> path;
+
+        TraceNodePtr marker = TraceCheckpoint::readNode(mStream, mExpressions, ok);
+        return ok && !marker.isNull() && applyMarker(path, marker);
+    }
+
+    case TraceEventLog::STATE: {
+        TraceCheckpoint::SearchState state;
+        TraceCheckpoint::readState(mStream, state);
+        if (mStream.status() != QDataStream::Ok) {
+            return false;
+        }
+
+        mSearchState = state;
+        mHasSearchState = true;
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+bool TraceEventLogReader::atEnd() const
+{
+    return mStream.atEnd();
+}
+
+TraceNodePtr TraceEventLogReader::getTree() const
+{
+    return mTree;
+}
+
+quint64 TraceEventLogReader::getBase() const
+{
+    return mBase;
+}
+
+bool TraceEventLogReader::hasSearchState() const
+{
+    return mHasSearchState;
+}
+
+TraceCheckpoint::SearchState TraceEventLogReader::getSearchState() const
+{
+    return mSearchState;
+}
+
+// Follows the path from the root as DepthFirstSearch does (skipping annotations) and replaces the unexplored node
+// at its end with the marker.
+bool TraceEventLogReader::applyMarker(const QVector<bool>& path, TraceNodePtr marker)
+{
+    if (path.isEmpty()) {
+        return false;
+    }
+
+    TraceNodePtr current = mTree;
+    TraceBranchPtr parent;
+
+    for (int i = 0; i < path.size(); i++) {
+        while (!current.dynamicCast<TraceAnnotation>().isNull()) {
+            current = current.dynamicCast<TraceAnnotation>()->next;
+        }
+
+        parent = current.dynamicCast<TraceBranch>();
+        if (parent.isNull()) {
+            return false;
+        }
+
+        current = path.at(i) ? parent->getTrueBranch() : parent->getFalseBranch();
+    }
+
+    if (!TraceVisitor::isImmediatelyUnexplored(current)) {
+        return false;
+    }
+
+    if (path.last()) {
+        parent->setTrueBranch(marker);
+    } else {
+        parent->setFalseBranch(marker);
+    }
+
+    return true;
+}
+
+} // namespace artemis
@@ -0,0 +1,128 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef TRACEEVENTLOG_H
+#define TRACEEVENTLOG_H
+
+#include <QBuffer>
+#include <QDataStream>
+#include <QFile>
+#include <QVector>
+
+#include "concolic/executiontree/tracecheckpoint.h"
+
+namespace artemis
+{
+
+/**
+ *  An append-only log of the changes made to the execution tree during a concolic run, from which the tree can be
+ *  rebuilt (and rendered) after the run, at its final state or at any step in between.
+ *
+ *  The events are the traces merged into the tree and the markers placed on unexplored nodes by the search. Each
+ *  event is written (and flushed) as it happens, at a cost proportional to the event rather than to the tree.
+ *
+ *  File format (QDataStream): magic, version, base, then the events. The base identifies the tree the events apply
+ *  to, the stamp of a checkpoint for its journal or 0 for the empty tree. Each event is its type, the number of expression
+ *  records it adds and those records (see ExpressionSerializer), then for a trace its nodes, for a marker the
+ *  path to the marked node (see DepthFirstSearch::getTargetPath) and the marker node (see TraceCheckpoint), or for
+ *  a search state its fields. Search states are only logged in the journal of a checkpoint.
+ */
+class TraceEventLog
+{
+public:
+    TraceEventLog();
+
+    // Starts a new log in fileName, replacing any existing file.
+    bool open(const QString& fileName, quint64 base = 0);
+    bool isOpen() const;
+    void close();
+
+    void addTrace(TraceNodePtr trace);
+    void addMarker(const QVector<bool>& path, TraceNodePtr marker);
+    void addState(const TraceCheckpoint::SearchState& state);
+
+    // The number of bytes written so far.
+    qint64 size() const;
+
+private:
+    enum EventType {
+        TRACE, MARKER, STATE
+    };
+
+    void writeEvent(EventType type);
+
+    QFile mFile;
+
+    // Each event is built in these buffers. The writer is kept for the whole log, so expressions shared between
+    // events are only written once.
+    QBuffer mNodeBuffer;
+    QBuffer mExpressionBuffer;
+    QDataStream mNodeStream;
+    QDataStream mExpressionStream;
+    QSharedPointer<TraceCheckpoint> mWriter;
+    quint32 mExpressionsWritten;
+
+    friend class TraceEventLogReader;
+
+    static const quint32 FILE_MAGIC = 0x4152544C; // "ARTL"
+    static const quint32 FILE_VERSION = 2;
+};
+
+typedef QSharedPointer<TraceEventLog> TraceEventLogPtr;
+
+/**
+ *  Rebuilds the execution tree from a TraceEventLog one event at a time.
+ *
+ *  A log which was cut short (e.g. by a crash during the run) is read up to its last complete event.
+ */
+class TraceEventLogReader
+{
+public:
+    // The events are applied to tree, or to an empty tree.
+    TraceEventLogReader(const QString& fileName, TraceNodePtr tree = TraceNodePtr());
+
+    bool open();
+
+    // Applies the next event to the tree. Returns false at the end of the log or at a malformed event.
+    bool next();
+
+    // Whether the whole log has been read.
+    bool atEnd() const;
+
+    TraceNodePtr getTree() const;
+
+    // The base the log was opened with, see TraceEventLog.
+    quint64 getBase() const;
+
+    // The last search state read from the log, if any.
+    bool hasSearchState() const;
+    TraceCheckpoint::SearchState getSearchState() const;
+
+private:
+    bool applyMarker(const QVector<bool>& path, TraceNodePtr marker);
+
+    QFile mFile;
+    QDataStream mStream;
+    ExpressionDeserializer mExpressions;
+    TraceNodePtr mTree;
+    quint64 mBase;
+    bool mHasSearchState;
+    TraceCheckpoint::SearchState mSearchState;
+};
+
+} // namespace artemis
+
+#endif // TRACEEVENTLOG_H
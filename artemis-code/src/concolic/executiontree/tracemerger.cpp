@@ -19,19 +19,29 @@
 
 #include "util/loggingutil.h"
 #include "concolic/executiontree/tracedisplay.h"
+#include "concolic/tracestatistics.h"
 
 #include "tracemerger.h"
 
 namespace artemis
 {
 
-TraceNodePtr TraceMerger::merge(TraceNodePtr trace, TraceNodePtr executiontree)
+TraceNodePtr TraceMerger::merge(TraceNodePtr trace, TraceNodePtr executiontree, int* frontierChange)
 {
+    if (frontierChange) {
+        *frontierChange = 0;
+    }
+
     if (trace.isNull()) {
         return executiontree;
     }
 
     if (executiontree.isNull()) {
+        if (frontierChange) {
+            TraceStatistics stats;
+            stats.processTrace(trace);
+            *frontierChange = stats.mNumUnexploredSymBranches;
+        }
         return trace; // replace the entire execution tree with the trace
         statistics()->accumulate("Concolic::ExecutionTree::DistinctTracesExplored", 1);
     }
@@ -45,9 +55,28 @@ TraceNodePtr TraceMerger::merge(TraceNodePtr trace, TraceNodePtr executiontree)
     merger.mCurrentTree = executiontree;
     trace->accept(&merger);
 
+    if (frontierChange) {
+        *frontierChange = merger.mFrontierChange;
+    }
+
     return merger.mCurrentTree;
 }
 
+// Inserts the current trace directly into the tree, in place of the current (unexplored) tree node.
+void TraceMerger::graft()
+{
+    // The frontier gains the unexplored symbolic branches of the new subtree and loses the node it replaces.
+    TraceStatistics stats;
+    stats.processTrace(mCurrentTrace);
+    mFrontierChange += stats.mNumUnexploredSymBranches;
+    if (mParentIsSymbolic && mCurrentTree == TraceUnexplored::getInstance()) {
+        mFrontierChange--;
+    }
+
+    mCurrentTree = mCurrentTrace;
+    statistics()->accumulate("Concolic::ExecutionTree::DistinctTracesExplored", 1);
+}
+
 void TraceMerger::visit(TraceUnexplored* node)
 {
     // Ignore, we can't add any information to the execution tree
@@ -60,8 +89,7 @@ void TraceMerger::visit(TraceEnd* node)
     if (TraceVisitor::isImmediatelyUnexplored(mCurrentTree)) {
 
         // Insert this trace directly into the tree and return
-        mCurrentTree = mCurrentTrace;
-        statistics()->accumulate("Concolic::ExecutionTree::DistinctTracesExplored", 1);
+        graft();
         return;
     }
 
@@ -80,8 +108,7 @@ void TraceMerger::visit(TraceBranch* node)
     if (TraceVisitor::isImmediatelyUnexplored(mCurrentTree)) {
 
         // Insert this trace directly into the tree and return
-        mCurrentTree = mCurrentTrace;
-        statistics()->accumulate("Concolic::ExecutionTree::DistinctTracesExplored", 1);
+        graft();
         return;
     }
 
@@ -116,13 +143,16 @@ void TraceMerger::visit(TraceBranch* node)
 
 
         // Merge the traces for each branch
+        bool symbolic = !TraceVisitor::isImmediatelyConcreteBranch(treeBranch);
 
+        mParentIsSymbolic = symbolic;
         mCurrentTree = treeBranch->getTrueBranch();
         mCurrentTrace = node->getTrueBranch();
         mCurrentTrace->accept(this);
 
         treeBranch->setTrueBranch(mCurrentTree);
 
+        mParentIsSymbolic = symbolic;
         mCurrentTree = treeBranch->getFalseBranch();
         mCurrentTrace = node->getFalseBranch();
         mCurrentTrace->accept(this);
@@ -145,8 +175,7 @@ void TraceMerger::visit(TraceAnnotation* node)
     if (TraceVisitor::isImmediatelyUnexplored(mCurrentTree)) {
 
         // Insert this trace directly into the tree and return
-        mCurrentTree = mCurrentTrace;
-        statistics()->accumulate("Concolic::ExecutionTree::DistinctTracesExplored", 1);
+        graft();
         return;
     }
 
@@ -156,6 +185,7 @@ void TraceMerger::visit(TraceAnnotation* node)
 
         TraceAnnotationPtr treeAnnotation = mCurrentTree.dynamicCast<TraceAnnotation>();
 
+        mParentIsSymbolic = false;
         mCurrentTree = treeAnnotation->next;
         mCurrentTrace = node->next;
         mCurrentTrace->accept(this);
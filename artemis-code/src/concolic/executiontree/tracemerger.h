@@ -34,11 +34,14 @@ namespace artemis
  * Please observe that this function mutates the executiontree, and if it is null it inserts new nodes.
  * Thus, the usage of a pointer to the executiontree pointer.
  *
+ * If frontierChange is given, it is set to the change in the search frontier of the tree (see TraceStatistics),
+ * which is found from the parts of the trace grafted onto the tree without visiting the rest of the tree.
+ *
  */
 class TraceMerger : public TraceVisitor
 {
 public:
-    static TraceNodePtr merge(TraceNodePtr trace, TraceNodePtr executiontree);
+    static TraceNodePtr merge(TraceNodePtr trace, TraceNodePtr executiontree, int* frontierChange = NULL);
 
     void visit(TraceNode* node);
 
@@ -50,11 +53,16 @@ public:
     void reportFailedMerge();
 
 private:
-    TraceMerger() {}
+    TraceMerger() : mFrontierChange(0), mParentIsSymbolic(false) {}
+
+    void graft();
 
     TraceNodePtr mCurrentTree;
     TraceNodePtr mCurrentTrace;
 
+    int mFrontierChange;
+    bool mParentIsSymbolic; // Whether mCurrentTree is a child of a symbolic branch.
+
     TraceNodePtr mStartingTrace;
     TraceNodePtr mStartingTree;
     static const bool mReportFailedMerge = false; // Whether to dump out failed merges for anaysis.
@@ -26,6 +26,7 @@ void TraceVisitor::visit(TraceUnexplored* node)         { visit(static_cast<Trac
 void TraceVisitor::visit(TraceUnexploredUnsat *node)    { visit(static_cast<TraceUnexplored*>(node)); }
 void TraceVisitor::visit(TraceUnexploredUnsolvable *node){visit(static_cast<TraceUnexplored*>(node)); }
 void TraceVisitor::visit(TraceUnexploredMissed *node)   { visit(static_cast<TraceUnexplored*>(node)); }
+void TraceVisitor::visit(TraceUnexploredTimeout *node)  { visit(static_cast<TraceUnexplored*>(node)); }
 
 void TraceVisitor::visit(TraceBranch* node)             { visit(static_cast<TraceNode*>(node)); }
 void TraceVisitor::visit(TraceConcreteBranch* node)     { visit(static_cast<TraceBranch*>(node)); }
@@ -33,6 +33,7 @@ class TraceUnexplored;
 class TraceUnexploredUnsat;
 class TraceUnexploredUnsolvable;
 class TraceUnexploredMissed;
+class TraceUnexploredTimeout;
 class TraceAnnotation;
 class TraceAlert;
 class TraceDomModification;
@@ -76,6 +77,7 @@ public:
     virtual void visit(TraceUnexploredUnsat* node);
     virtual void visit(TraceUnexploredUnsolvable* node);
     virtual void visit(TraceUnexploredMissed* node);
+    virtual void visit(TraceUnexploredTimeout* node);
     virtual void visit(TraceAnnotation* node);
     virtual void visit(TraceAlert* node);
     virtual void visit(TraceDomModification* node);
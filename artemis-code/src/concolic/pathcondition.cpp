@@ -29,7 +29,8 @@
 namespace artemis
 {
 
-PathCondition::PathCondition()
+PathCondition::PathCondition() :
+    mConditionsValid(true)
 {
 
 }
@@ -60,7 +61,7 @@ void PathCondition::visit(TraceNode* node)
 void PathCondition::visit(TraceSymbolicBranch* node)
 {
     bool outcome = TraceVisitor::isImmediatelyUnexplored(node->getFalseBranch());
-    mConditions.append(QPair<Symbolic::Expression*, bool>(node->getSymbolicCondition(), outcome));
+    addCondition(node->getSymbolicCondition(), outcome);
 
     qDebug() << "ADD CONDITION " << outcome << node->getSymbolicCondition();
 
@@ -101,26 +102,44 @@ void PathCondition::visit(TraceEnd* node)
 
 void PathCondition::addCondition(Symbolic::Expression* condition, bool outcome)
 {
-    mConditions.append(qMakePair(condition, outcome));
+    mLast = ConditionCellPtr(new ConditionCell(condition, outcome, mLast));
+    mConditionsValid = false;
 }
 
 const QPair<Symbolic::Expression*, bool> PathCondition::get(int index)
 {
-    return mConditions.at(index);
+    return conditions().at(index);
 }
 
 uint PathCondition::size()
 {
-    return mConditions.size();
+    return mLast ? mLast->size : 0;
+}
+
+const QVector<QPair<Symbolic::Expression*, bool> >& PathCondition::conditions()
+{
+    if (!mConditionsValid) {
+        mConditions.resize(size());
+
+        int index = size();
+        for (ConditionCellPtr cell = mLast; cell; cell = cell->previous) {
+            mConditions[--index] = qMakePair(cell->condition, cell->outcome);
+        }
+
+        mConditionsValid = true;
+    }
+
+    return mConditions;
 }
 
 std::string PathCondition::toStatisticsString()
 {
     std::stringstream sstrm;
+    const QVector<QPair<Symbolic::Expression*, bool> >& pc = conditions();
 
-    for (int i = 0; i < mConditions.size(); i++) {
+    for (int i = 0; i < pc.size(); i++) {
         ExpressionPrinter printer;
-        mConditions.at(i).first->accept(&printer);
+        pc.at(i).first->accept(&printer);
 
         sstrm << "PC[" << i << "]: " << printer.getResult() << std::endl;
     }
@@ -131,12 +150,13 @@ std::string PathCondition::toStatisticsString()
 std::string PathCondition::toStatisticsValuesString(bool includeBranching)
 {
     std::stringstream sstrm;
+    const QVector<QPair<Symbolic::Expression*, bool> >& pc = conditions();
 
-    for (int i = 0; i < mConditions.size(); i++) {
+    for (int i = 0; i < pc.size(); i++) {
         ExpressionValuePrinter printer;
-        mConditions.at(i).first->accept(&printer);
+        pc.at(i).first->accept(&printer);
 
-        if (includeBranching && !mConditions.at(i).second) {
+        if (includeBranching && !pc.at(i).second) {
             sstrm << "PC[" << i << "]: (" << printer.getResult() << " == false)" << std::endl;
         } else {
             sstrm << "PC[" << i << "]: " << printer.getResult() << std::endl;
@@ -150,9 +170,10 @@ QMap<QString, Symbolic::SourceIdentifierMethod> PathCondition::freeVariables()
 {
     ExpressionFreeVariableLister lister;
     QMap<QString, Symbolic::SourceIdentifierMethod> vars;
+    const QVector<QPair<Symbolic::Expression*, bool> >& pc = conditions();
 
-    for (int i = 0; i < mConditions.size(); i++) {
-        mConditions.at(i).first->accept(&lister);
+    for (int i = 0; i < pc.size(); i++) {
+        pc.at(i).first->accept(&lister);
         // N.B. QMap::unite does not remove duplicates, so we can't use that.
         foreach(QString var, lister.getResult().keys()){
             vars.insert(var, lister.getResult().value(var));
@@ -165,8 +186,9 @@ QMap<QString, Symbolic::SourceIdentifierMethod> PathCondition::freeVariables()
 
 void PathCondition::negateLastCondition()
 {
-    if (mConditions.size() > 0) {
-        mConditions.last().second = !mConditions.last().second;
+    if (mLast) {
+        mLast = ConditionCellPtr(new ConditionCell(mLast->condition, !mLast->outcome, mLast->previous));
+        mConditionsValid = false;
     }
 }
 
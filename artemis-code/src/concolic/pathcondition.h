@@ -18,7 +18,9 @@
 
 #include <QList>
 #include <QPair>
+#include <QSharedData>
 #include <QSharedPointer>
+#include <QVector>
 
 #include "JavaScriptCore/symbolic/expr.h"
 
@@ -31,6 +33,13 @@
 namespace artemis
 {
 
+/**
+ * The conditions along one path through the execution tree, in order from the root.
+ *
+ * The conditions are stored as an immutable list linked from the last condition back to the first. Copies of a
+ * path condition share the list, and adding or negating a condition only allocates a new last cell, so a copy is
+ * O(1) however long the path is. This is what lets the search save and restore its position cheaply.
+ */
 class PathCondition : public TraceVisitor
 {
 
@@ -59,7 +68,45 @@ public:
     void negateLastCondition();
 
 private:
-    QList<QPair<Symbolic::Expression*, bool> > mConditions;
+    struct ConditionCell : public QSharedData {
+        ConditionCell(Symbolic::Expression* condition, bool outcome, QExplicitlySharedDataPointer<ConditionCell> previous)
+            : condition(condition)
+            , outcome(outcome)
+            , previous(previous)
+            , size(previous ? previous->size + 1 : 1)
+        {
+        }
+
+        // Releases the cells only referenced from this one in a loop, as a recursive release of a long path
+        // condition would overflow the stack.
+        ~ConditionCell()
+        {
+            QExplicitlySharedDataPointer<ConditionCell> cell = previous;
+            previous.reset();
+
+            while (cell && cell->ref == 1) {
+                QExplicitlySharedDataPointer<ConditionCell> next = cell->previous;
+                cell->previous.reset();
+                cell = next;
+            }
+        }
+
+        Symbolic::Expression* condition;
+        bool outcome;
+        QExplicitlySharedDataPointer<ConditionCell> previous;
+        uint size;
+    };
+
+    // Cells are shared between copies of a path condition and never changed once they are linked.
+    typedef QExplicitlySharedDataPointer<ConditionCell> ConditionCellPtr;
+
+    const QVector<QPair<Symbolic::Expression*, bool> >& conditions();
+
+    ConditionCellPtr mLast;
+
+    // The conditions in order, rebuilt from the cells on the first indexed access after a change.
+    QVector<QPair<Symbolic::Expression*, bool> > mConditions;
+    bool mConditionsValid;
 };
 
 typedef QSharedPointer<PathCondition> PathConditionPtr;
@@ -27,6 +27,7 @@ DepthFirstSearch::DepthFirstSearch(TraceNodePtr tree, unsigned int depthLimit) :
     mTree(tree),
     mDepthLimit(depthLimit),
     mCurrentDepth(0),
+    mRetryBudget(0),
     mIsPreviousRun(false)
 {
     mCurrentPC = PathConditionPtr(new PathCondition());
@@ -107,6 +108,11 @@ PathConditionPtr DepthFirstSearch::getTargetPC()
     return mCurrentPC;
 }
 
+QVector<bool> DepthFirstSearch::getTargetPath()
+{
+    return mCurrentPath;
+}
+
 void DepthFirstSearch::setDepthLimit(unsigned int depth)
 {
     mDepthLimit = depth;
@@ -117,6 +123,11 @@ unsigned int DepthFirstSearch::getDepthLimit()
     return mDepthLimit;
 }
 
+void DepthFirstSearch::setRetryBudget(uint retryBudget)
+{
+    mRetryBudget = retryBudget;
+}
+
 // Reset the search to the beginning of the tree.
 void DepthFirstSearch::restartSearch()
 {
@@ -124,6 +135,7 @@ void DepthFirstSearch::restartSearch()
     mParentStack.clear();
     mCurrentDepth = 0;
     mCurrentPC = PathConditionPtr(new PathCondition());
+    mCurrentPath.clear();
 }
 
 
@@ -151,18 +163,21 @@ void DepthFirstSearch::visit(TraceConcreteBranch *node)
 
     }else if(isImmediatelyUnexplored(node->getFalseBranch())){
         // Then we treat this node as a pass-through to the 'true' subtree
+        mCurrentPath.append(true);
         node->getTrueBranch()->accept(this);
 
     }else if(isImmediatelyUnexplored(node->getTrueBranch())){
         // Then we treat this node as a pass-through to the 'false' subtree
+        mCurrentPath.append(false);
         node->getFalseBranch()->accept(this);
 
     }else{
         // Both branches are explored, so we must search each in turn.
-        mParentStack.push(SavedPosition(node, mCurrentDepth, *mCurrentPC));
+        mParentStack.push(SavedPosition(node, mCurrentDepth, *mCurrentPC, mCurrentPath.size()));
         //mCurrentDepth++; // Do not increase depth for concrete branches.
         mPreviousParent = node;
         mPreviousDirection = false; // We are always taking the false branch to begin with.
+        mCurrentPath.append(false);
         node->getFalseBranch()->accept(this);
     }
 }
@@ -174,10 +189,11 @@ void DepthFirstSearch::visit(TraceSymbolicBranch *node)
     // This allows us to stop the search once we find a node we would like to explore.
     // The depth limit is also enforced here.
     if(mCurrentDepth < mDepthLimit){
-        mParentStack.push(SavedPosition(node, mCurrentDepth, *mCurrentPC));
+        mParentStack.push(SavedPosition(node, mCurrentDepth, *mCurrentPC, mCurrentPath.size()));
         mCurrentDepth++;
         mPreviousParent = node;
         mPreviousDirection = false;
+        mCurrentPath.append(false);
         mCurrentPC->addCondition(node->getSymbolicCondition(), false); // We are always taking the false branch here.
         node->getFalseBranch()->accept(this);
     }else{
@@ -210,6 +226,16 @@ void DepthFirstSearch::visit(TraceUnexploredUnsolvable *node)
     continueFromLeaf();
 }
 
+void DepthFirstSearch::visit(TraceUnexploredTimeout *node)
+{
+    // A node which timed out is only worth another attempt once the solver has been given a larger budget.
+    if(node->getBudget() < mRetryBudget){
+        mFoundTarget = true;
+    }else{
+        continueFromLeaf();
+    }
+}
+
 void DepthFirstSearch::visit(TraceAnnotation *node)
 {
     // Skip all annotations, which are only relevant to classification and not searching.
@@ -257,6 +283,8 @@ TraceNodePtr DepthFirstSearch::nextAfterLeaf()
     // Keep the previous parent information up-to-date when branching from the stack.
     mPreviousParent = parent.node;
     mPreviousDirection = true;
+    mCurrentPath.resize(parent.pathLength);
+    mCurrentPath.append(true);
 
     return parent.node->getTrueBranch();
 }
@@ -287,6 +315,17 @@ bool DepthFirstSearch::overUnexploredNode()
     return isImmediatelyUnexplored(current);
 }
 
+bool DepthFirstSearch::overFrontierNode()
+{
+    // This method can only be called once we have started a search.
+    assert(mIsPreviousRun);
+
+    TraceNodePtr current = mPreviousDirection ? mPreviousParent->getTrueBranch() : mPreviousParent->getFalseBranch();
+
+    // Only the plain unexplored marker counts, as in TraceStatistics.
+    return dynamic_cast<TraceSymbolicBranch*>(mPreviousParent) != NULL && current == TraceUnexplored::getInstance();
+}
+
 void DepthFirstSearch::markNodeUnsat()
 {
     // This method can only be called once we have started a search.
@@ -338,6 +377,23 @@ void DepthFirstSearch::markNodeMissed()
     }
 }
 
+void DepthFirstSearch::markNodeTimeout(uint budget)
+{
+    // This method can only be called once we have started a search.
+    assert(mIsPreviousRun);
+
+    // Replace the current node with TraceUnexploredTimeout.
+    if(mPreviousDirection){
+        // Replace the true branch of mPreviousParent.
+        assert(isImmediatelyUnexplored(mPreviousParent->getTrueBranch()));
+        mPreviousParent->setTrueBranch(TraceNodePtr(new TraceUnexploredTimeout(budget)));
+    }else{
+        // Replace the false branch of mPreviousParent.
+        assert(isImmediatelyUnexplored(mPreviousParent->getFalseBranch()));
+        mPreviousParent->setFalseBranch(TraceNodePtr(new TraceUnexploredTimeout(budget)));
+    }
+}
+
 
 
 
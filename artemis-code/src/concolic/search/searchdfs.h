@@ -19,6 +19,7 @@
 
 #include <QStack>
 #include <QPair>
+#include <QVector>
 
 #include "search.h"
 #include "concolic/pathcondition.h"
@@ -53,6 +54,10 @@ public:
     // Retrieves the PC of any target node which was selected.
     PathConditionPtr getTargetPC();
 
+    // Retrieves the directions taken at each branch (concrete or symbolic) from the root to the target node.
+    // Like the PC, this stays valid until the next call to chooseNextTarget(), so it also locates marked nodes.
+    QVector<bool> getTargetPath();
+
     // The depth limit for our DFS.
     void setDepthLimit(unsigned int depth);
     unsigned int getDepthLimit();
@@ -63,9 +68,16 @@ public:
     // When over an unexplored node, we may mark it as "attempted but failed to explore".
     // This can be used in later "passes" of the search to avoid wasting time on unreachable nodes.
     bool overUnexploredNode();
+    // Whether the node is still part of the search frontier (see TraceStatistics), which marking it removes it from.
+    bool overFrontierNode();
     void markNodeUnsat();
     void markNodeUnsolvable();
     void markNodeMissed();
+    void markNodeTimeout(uint budget);
+
+    // Nodes which timed out with a solver budget below retryBudget are selected again, as they may be solvable
+    // with the current budget. By default timed out nodes are skipped like the other markers.
+    void setRetryBudget(uint retryBudget);
 
     // The visitor part which does the actual searching.
     void visit(TraceNode* node);            // Abstract nodes. An error if we reach this.
@@ -75,6 +87,7 @@ public:
     void visit(TraceUnexploredMissed* node);
     void visit(TraceUnexploredUnsat* node);
     void visit(TraceUnexploredUnsolvable* node);
+    void visit(TraceUnexploredTimeout* node);
     void visit(TraceAnnotation* node);      // Ignore all annotations.
     void visit(TraceEnd* node);             // Stop searching at *any* end node.
 
@@ -86,9 +99,15 @@ private:
     unsigned int mDepthLimit;
     unsigned int mCurrentDepth;
 
+    // Timed out nodes are targets again if their budget was below this (see setRetryBudget).
+    unsigned int mRetryBudget;
+
     // The PC which is accumulated as we move down the tree.
     PathConditionPtr mCurrentPC;
 
+    // The branch directions taken to reach the current position, including the pass-throughs at concrete branches.
+    QVector<bool> mCurrentPath;
+
     // Stores whether or not the iteration is finished.
     bool mFoundTarget;
 
@@ -103,14 +122,16 @@ private:
 
     // A stack of the ancestor branch nodes to the current position in the search.
     // Each ancestor node is paired with its depth in the tree and the PC up to that point.
+    // Path conditions share their common prefix, so saving and restoring a PC here does not copy its conditions.
     // This is used for backtracking during the DFS.
     // N.B. We could avoid this if we included parent pointers in the tree, but this would involve some iterative traversal, going against the idea of using a visitor in the first place!
     struct SavedPosition {
         SavedPosition(){}
-        SavedPosition(TraceBranch* node, unsigned int depth, PathCondition condition) : node(node), depth(depth), condition(condition) {}
+        SavedPosition(TraceBranch* node, unsigned int depth, PathCondition condition, int pathLength) : node(node), depth(depth), condition(condition), pathLength(pathLength) {}
         TraceBranch* node;
         unsigned int depth;
         PathCondition condition; // Condition to reach this node, not including the symbolic condition of this particular node if it is symbolic.
+        int pathLength; // Length of mCurrentPath at this node. The path is always an extension of it, so it is truncated rather than saved.
     };
     QStack<SavedPosition> mParentStack;
 
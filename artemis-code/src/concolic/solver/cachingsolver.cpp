@@ -0,0 +1,271 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QFile>
+#include <QStringList>
+
+#include "expressionevaluator.h"
+#include "expressionkeyprinter.h"
+
+#include "cachingsolver.h"
+
+namespace artemis
+{
+
+CachingSolver::CachingSolver(SolverPtr solver, int capacity)
+    : Solver()
+    , mSolver(solver)
+    , mCapacity(capacity)
+{
+    mQueries = statistics()->counter("Concolic::Solver::Cache::Queries");
+    mUnsatSubsetHits = statistics()->counter("Concolic::Solver::Cache::UnsatSubsetHits");
+    mSatSupersetHits = statistics()->counter("Concolic::Solver::Cache::SatSupersetHits");
+    mModelEvaluationHits = statistics()->counter("Concolic::Solver::Cache::ModelEvaluationHits");
+    mMisses = statistics()->counter("Concolic::Solver::Cache::Misses");
+}
+
+SolutionPtr CachingSolver::solve(PathConditionPtr pc)
+{
+    QVector<int> conjuncts = conjunctsOf(pc);
+
+    SolutionPtr cached = lookup(pc, conjuncts);
+    if (!cached.isNull()) {
+        return cached;
+    }
+
+    recordQuery(mMisses);
+
+    mSolver->setTimeout(mTimeout);
+    SolutionPtr solution = mSolver->solve(pc);
+
+    if (solution->isSolved()) {
+        insert(conjuncts, solution);
+    } else if (solution->isUnsat()) {
+        insert(conjuncts, SolutionPtr());
+    }
+
+    return solution;
+}
+
+SolutionPtr CachingSolver::lookup(PathConditionPtr pc, const QVector<int>& conjuncts)
+{
+    foreach (const Entry& entry, mEntries) {
+        if (entry.solution.isNull() &&
+                std::includes(conjuncts.begin(), conjuncts.end(), entry.conjuncts.begin(), entry.conjuncts.end())) {
+            recordQuery(mUnsatSubsetHits);
+            return SolutionPtr(new Solution(false, true));
+        }
+    }
+
+    foreach (const Entry& entry, mEntries) {
+        if (!entry.solution.isNull() &&
+                std::includes(entry.conjuncts.begin(), entry.conjuncts.end(), conjuncts.begin(), conjuncts.end())) {
+            recordQuery(mSatSupersetHits);
+            return entry.solution;
+        }
+    }
+
+    // Newer models are tried first, they come from PCs closer to the current position in the search.
+    for (int i = mEntries.size() - 1; i >= 0; i--) {
+        SolutionPtr solution = mEntries.at(i).solution;
+
+        if (!solution.isNull() && ExpressionEvaluator(solution->getSymbols()).satisfies(pc)) {
+            recordQuery(mModelEvaluationHits);
+            insert(conjuncts, solution);
+            return solution;
+        }
+    }
+
+    return SolutionPtr();
+}
+
+void CachingSolver::insert(const QVector<int>& conjuncts, SolutionPtr solution)
+{
+    Entry entry;
+    entry.conjuncts = conjuncts;
+    entry.solution = solution;
+    mEntries.append(entry);
+
+    while (mEntries.size() > mCapacity) {
+        mEntries.removeFirst();
+    }
+
+    statistics()->set("Concolic::Solver::Cache::Entries", mEntries.size());
+}
+
+void CachingSolver::recordQuery(StatsCounter& outcome)
+{
+    mQueries.add(1);
+    outcome.add(1);
+
+    int hits = mQueries.value() - mMisses.value();
+    statistics()->set("Concolic::Solver::Cache::HitRatePercent", 100 * hits / mQueries.value());
+}
+
+QVector<int> CachingSolver::conjunctsOf(PathConditionPtr pc)
+{
+    QVector<int> conjuncts;
+    conjuncts.reserve(pc->size());
+
+    for (uint i = 0; i < pc->size(); i++) {
+        ExpressionKeyPrinter printer;
+        pc->get(i).first->accept(&printer);
+
+        QString key = QString(pc->get(i).second ? "T:" : "F:") + QString::fromStdString(printer.getResult());
+        conjuncts.append(internConjunct(key));
+    }
+
+    std::sort(conjuncts.begin(), conjuncts.end());
+    conjuncts.erase(std::unique(conjuncts.begin(), conjuncts.end()), conjuncts.end());
+
+    return conjuncts;
+}
+
+int CachingSolver::internConjunct(const QString& key)
+{
+    QHash<QString, int>::const_iterator iter = mConjunctIds.find(key);
+    if (iter != mConjunctIds.end()) {
+        return iter.value();
+    }
+
+    int id = mConjunctKeys.size();
+    mConjunctKeys.append(key);
+    mConjunctIds.insert(key, id);
+    return id;
+}
+
+int CachingSolver::size() const
+{
+    return mEntries.size();
+}
+
+/*
+ *  File format (QDataStream): magic, version, site, number of entries, then for each entry
+ *      unsat flag, conjunct keys, [number of symbols, then for each symbol: name, kind, boolean, integer, string].
+ *  Conjuncts are saved by key, as ids are only meaningful within one run.
+ */
+
+bool CachingSolver::save(const QString& fileName, const QString& site) const
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QDataStream out(&file);
+    out << FILE_MAGIC << FILE_VERSION << site << (quint32)mEntries.size();
+
+    foreach (const Entry& entry, mEntries) {
+        QStringList keys;
+        foreach (int id, entry.conjuncts) {
+            keys.append(mConjunctKeys.at(id));
+        }
+
+        out << entry.solution.isNull() << keys;
+
+        if (entry.solution.isNull()) {
+            continue;
+        }
+
+        const QHash<QString, Symbolvalue>& symbols = entry.solution->getSymbols();
+        out << (quint32)symbols.size();
+
+        QHash<QString, Symbolvalue>::const_iterator iter = symbols.begin();
+        for (; iter != symbols.end(); iter++) {
+            const Symbolvalue& value = iter.value();
+            out << iter.key()
+                << (qint32)value.kind
+                << (value.kind == Symbolic::BOOL && value.u.boolean)
+                << (qint32)(value.kind == Symbolic::INT ? value.u.integer : 0)
+                << QByteArray(value.string.data(), value.string.size());
+        }
+    }
+
+    return out.status() == QDataStream::Ok;
+}
+
+bool CachingSolver::load(const QString& fileName, const QString& site)
+{
+    QFile file(fileName);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+
+    QDataStream in(&file);
+
+    quint32 magic, version, count;
+    QString savedSite;
+    in >> magic >> version >> savedSite >> count;
+
+    if (in.status() != QDataStream::Ok || magic != FILE_MAGIC || version != FILE_VERSION || savedSite != site) {
+        return false;
+    }
+
+    for (quint32 i = 0; i < count; i++) {
+        bool unsat;
+        QStringList keys;
+        in >> unsat >> keys;
+
+        QVector<int> conjuncts;
+        foreach (const QString& key, keys) {
+            conjuncts.append(internConjunct(key));
+        }
+        std::sort(conjuncts.begin(), conjuncts.end());
+
+        SolutionPtr solution;
+
+        if (!unsat) {
+            solution = SolutionPtr(new Solution(true, false));
+
+            quint32 symbolCount;
+            in >> symbolCount;
+
+            for (quint32 j = 0; j < symbolCount && in.status() == QDataStream::Ok; j++) {
+                QString name;
+                qint32 kind, integer;
+                bool boolean;
+                QByteArray string;
+                in >> name >> kind >> boolean >> integer >> string;
+
+                Symbolvalue value;
+                value.found = true;
+                value.kind = (Symbolic::Type)kind;
+                if (value.kind == Symbolic::BOOL) {
+                    value.u.boolean = boolean;
+                } else {
+                    value.u.integer = integer;
+                }
+                value.string = std::string(string.constData(), string.size());
+
+                solution->insertSymbol(name, value);
+            }
+        }
+
+        if (in.status() != QDataStream::Ok) {
+            return false;
+        }
+
+        insert(conjuncts, solution);
+    }
+
+    return true;
+}
+
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CACHINGSOLVER_H
+#define CACHINGSOLVER_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QVector>
+
+#include "statistics/statsstorage.h"
+
+#include "solver.h"
+
+namespace artemis
+{
+
+/*
+ *  A counterexample cache in front of another solver, reusing earlier results for related PCs as in KLEE.
+ *
+ *  A PC is treated as a set of conjuncts, each a condition together with its outcome. A query is answered without
+ *  the solver if:
+ *      * a cached UNSAT set is a subset of it (the query is UNSAT as well),
+ *      * a cached SAT set is a superset of it (the model of the superset satisfies the query),
+ *      * any cached model satisfies it when evaluated concretely with the ExpressionEvaluator.
+ *  Otherwise the query is forwarded and a SAT or UNSAT result is cached. Errors and timeouts are never cached.
+ *
+ *  Conjuncts are identified by their printed form, so entries can be saved and reused by a later run of the same site.
+ *  At most capacity entries are kept in memory, the oldest entries are evicted first.
+ */
+
+class CachingSolver : public Solver
+{
+public:
+
+    CachingSolver(SolverPtr solver, int capacity = DEFAULT_CAPACITY);
+
+    SolutionPtr solve(PathConditionPtr pc);
+
+    // Entries are only loaded from a file saved for the same site. Both return false if the file could not be used.
+    bool load(const QString& fileName, const QString& site);
+    bool save(const QString& fileName, const QString& site) const;
+
+    int size() const;
+
+    static const int DEFAULT_CAPACITY = 1024;
+
+private:
+    struct Entry {
+        QVector<int> conjuncts; // Sorted conjunct ids.
+        SolutionPtr solution; // NULL for an UNSAT entry.
+    };
+
+    QVector<int> conjunctsOf(PathConditionPtr pc);
+    int internConjunct(const QString& key);
+
+    SolutionPtr lookup(PathConditionPtr pc, const QVector<int>& conjuncts);
+    void insert(const QVector<int>& conjuncts, SolutionPtr solution);
+    void recordQuery(StatsCounter& outcome);
+
+    SolverPtr mSolver;
+    int mCapacity;
+
+    QList<Entry> mEntries; // Oldest first.
+
+    QHash<QString, int> mConjunctIds;
+    QList<QString> mConjunctKeys;
+
+    StatsCounter mQueries;
+    StatsCounter mUnsatSubsetHits;
+    StatsCounter mSatSupersetHits;
+    StatsCounter mModelEvaluationHits;
+    StatsCounter mMisses;
+
+    static const quint32 FILE_MAGIC = 0x41525443; // "ARTC"
+    static const quint32 FILE_VERSION = 1;
+};
+
+typedef QSharedPointer<CachingSolver> CachingSolverPtr;
+
+}
+
+#endif // CACHINGSOLVER_H
@@ -0,0 +1,191 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "wtf/ExportMacros.h"
+#include "wtf/Vector.h"
+#include "JavaScriptCore/runtime/JSExportMacros.h"
+#include "wtf/Platform.h"
+#include "wtf/BumpPointerAllocator.h"
+#include "JavaScriptCore/runtime/UString.h"
+#include "JavaScriptCore/yarr/Yarr.h"
+#include "JavaScriptCore/yarr/YarrPattern.h"
+#include "JavaScriptCore/yarr/YarrInterpreter.h"
+
+#include "concreteregex.h"
+
+namespace artemis
+{
+
+QHash<QString, ConcreteRegexPtr> ConcreteRegex::mCache;
+
+ConcreteRegex::ConcreteRegex(const QString& pattern, bool ignoreCase, bool multiline)
+    : mAllocator(new WTF::BumpPointerAllocator())
+    , mBytecode(NULL)
+    , mSubpatterns(0)
+{
+    JSC::UString source(reinterpret_cast<const UChar*>(pattern.utf16()), pattern.length());
+
+    const char* error = 0;
+    JSC::Yarr::YarrPattern yarrPattern(source, ignoreCase, multiline, &error);
+
+    if (error) {
+        return;
+    }
+
+    mSubpatterns = yarrPattern.m_numSubpatterns;
+    mBytecode = JSC::Yarr::byteCompile(yarrPattern, mAllocator).leakPtr();
+}
+
+ConcreteRegex::~ConcreteRegex()
+{
+    delete mBytecode;
+    delete mAllocator;
+}
+
+ConcreteRegexPtr ConcreteRegex::compile(const QString& pattern, bool ignoreCase, bool multiline)
+{
+    QString key = QString(ignoreCase ? "i" : "") + (multiline ? "m" : "") + "/" + pattern;
+
+    QHash<QString, ConcreteRegexPtr>::const_iterator iter = mCache.find(key);
+    if (iter != mCache.end()) {
+        return iter.value();
+    }
+
+    // The patterns come from the analysed pages, so the cache is simply dropped once it is full.
+    if (mCache.size() >= MAX_CACHE_SIZE) {
+        mCache.clear();
+    }
+
+    ConcreteRegexPtr regex = ConcreteRegexPtr(new ConcreteRegex(pattern, ignoreCase, multiline));
+    mCache.insert(key, regex);
+    return regex;
+}
+
+ConcreteRegexPtr ConcreteRegex::compileLiteral(const QString& literal, bool* global)
+{
+    int end = literal.lastIndexOf('/');
+
+    if (!literal.startsWith('/') || end < 1) {
+        *global = false;
+        return compile(literal);
+    }
+
+    QString flags = literal.mid(end + 1);
+    *global = flags.contains('g');
+
+    return compile(literal.mid(1, end - 1), flags.contains('i'), flags.contains('m'));
+}
+
+bool ConcreteRegex::match(const QString& subject, int start, QVector<int>& captures) const
+{
+    if (!isValid() || start > subject.length()) {
+        return false;
+    }
+
+    QVector<unsigned> output((mSubpatterns + 1) * 2);
+    unsigned result = JSC::Yarr::interpret(mBytecode, reinterpret_cast<const UChar*>(subject.utf16()),
+                                           subject.length(), start, output.data());
+
+    if (result == JSC::Yarr::offsetNoMatch) {
+        return false;
+    }
+
+    captures.resize(output.size());
+    for (int i = 0; i < output.size(); i += 2) {
+        bool matched = output.at(i) != JSC::Yarr::offsetNoMatch && output.at(i + 1) != JSC::Yarr::offsetNoMatch;
+        captures[i] = matched ? (int)output.at(i) : -1;
+        captures[i + 1] = matched ? (int)output.at(i + 1) : -1;
+    }
+
+    return true;
+}
+
+QString ConcreteRegex::replace(const QString& subject, const QString& replacement, bool global) const
+{
+    QString result;
+    QVector<int> captures;
+    int position = 0;
+    int searchFrom = 0;
+
+    while (match(subject, searchFrom, captures)) {
+        int matchStart = captures.at(0);
+        int matchEnd = captures.at(1);
+
+        result += subject.mid(position, matchStart - position);
+
+        for (int i = 0; i < replacement.length(); i++) {
+            QChar c = replacement.at(i);
+
+            if (c != '$' || i + 1 == replacement.length()) {
+                result += c;
+                continue;
+            }
+
+            QChar next = replacement.at(i + 1);
+
+            if (next == '$') {
+                result += '$';
+                i++;
+            } else if (next == '&') {
+                result += subject.mid(matchStart, matchEnd - matchStart);
+                i++;
+            } else if (next == '`') {
+                result += subject.left(matchStart);
+                i++;
+            } else if (next == '\'') {
+                result += subject.mid(matchEnd);
+                i++;
+            } else if (next.isDigit()) {
+                // $nn is used if it names a subpattern, and otherwise $n.
+                int group = next.digitValue();
+                int length = 2;
+
+                if (i + 2 < replacement.length() && replacement.at(i + 2).isDigit()) {
+                    int twoDigits = group * 10 + replacement.at(i + 2).digitValue();
+                    if (twoDigits >= 1 && twoDigits <= mSubpatterns) {
+                        group = twoDigits;
+                        length = 3;
+                    }
+                }
+
+                if (group < 1 || group > mSubpatterns) {
+                    result += c;
+                    continue;
+                }
+
+                if (captures.at(2 * group) >= 0) {
+                    result += subject.mid(captures.at(2 * group), captures.at(2 * group + 1) - captures.at(2 * group));
+                }
+                i += length - 1;
+            } else {
+                result += c;
+            }
+        }
+
+        position = matchEnd;
+
+        if (!global) {
+            break;
+        }
+
+        // An empty match must not be found again at the same position.
+        searchFrom = matchEnd == matchStart ? matchEnd + 1 : matchEnd;
+    }
+
+    return result + subject.mid(position);
+}
+
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef CONCRETEREGEX_H
+#define CONCRETEREGEX_H
+
+#include <QHash>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+
+namespace JSC {
+namespace Yarr {
+struct BytecodePattern;
+}
+}
+
+namespace WTF {
+class BumpPointerAllocator;
+}
+
+namespace artemis
+{
+
+class ConcreteRegex;
+typedef QSharedPointer<ConcreteRegex> ConcreteRegexPtr;
+
+/**
+ *  A JavaScript regular expression matched with the YARR interpreter, as used by the concrete execution.
+ *
+ *  Compiled expressions are cached by pattern and flags, as the same few expressions are evaluated many times.
+ */
+class ConcreteRegex
+{
+public:
+    ~ConcreteRegex();
+
+    static ConcreteRegexPtr compile(const QString& pattern, bool ignoreCase = false, bool multiline = false);
+
+    // Compiles a literal of the form /pattern/flags, as given by RegExp.prototype.toString.
+    static ConcreteRegexPtr compileLiteral(const QString& literal, bool* global);
+
+    inline bool isValid() const {
+        return mBytecode != NULL;
+    }
+
+    inline int subpatternCount() const {
+        return mSubpatterns;
+    }
+
+    // Finds the first match at or after start. On a match, captures holds the start and end offsets of the match
+    // followed by those of each subpattern, or -1 for the subpatterns which did not take part in the match.
+    bool match(const QString& subject, int start, QVector<int>& captures) const;
+
+    // String.prototype.replace with this expression and a replacement string (ECMA-262 15.5.4.11).
+    QString replace(const QString& subject, const QString& replacement, bool global) const;
+
+private:
+    ConcreteRegex(const QString& pattern, bool ignoreCase, bool multiline);
+
+    WTF::BumpPointerAllocator* mAllocator;
+    JSC::Yarr::BytecodePattern* mBytecode;
+    int mSubpatterns;
+
+    static QHash<QString, ConcreteRegexPtr> mCache;
+    static const int MAX_CACHE_SIZE = 256;
+};
+
+}
+
+#endif // CONCRETEREGEX_H
@@ -122,14 +122,14 @@ void CVC4ConstraintWriter::visit(Symbolic::StringBinaryOperation* stringbinaryop
         return;
     }
 
-    stringbinaryoperation->getLhs()->accept(this);
+    visitSubexpression(stringbinaryoperation->getLhs());
     std::string lhs = mExpressionBuffer;
     if(!checkType(Symbolic::STRING)){
         error("String operation with incorrectly typed LHS");
         return;
     }
 
-    stringbinaryoperation->getRhs()->accept(this);
+    visitSubexpression(stringbinaryoperation->getRhs());
     std::string rhs = mExpressionBuffer;
     if(!checkType(Symbolic::STRING)){
         error("String operation with incorrectly typed RHS");
@@ -145,7 +145,7 @@ void CVC4ConstraintWriter::visit(Symbolic::StringBinaryOperation* stringbinaryop
 void CVC4ConstraintWriter::visit(Symbolic::StringCoercion* stringcoercion, void* args)
 {
     CoercionPromise promise(Symbolic::STRING);
-    stringcoercion->getExpression()->accept(this);
+    visitSubexpression(stringcoercion->getExpression());
 
     if (!promise.isCoerced) {
         coercetype(mExpressionType, Symbolic::STRING, mExpressionBuffer); // Sets mExpressionBuffer and Type.
@@ -154,7 +154,7 @@ void CVC4ConstraintWriter::visit(Symbolic::StringCoercion* stringcoercion, void*
 
 void CVC4ConstraintWriter::visit(Symbolic::StringCharAt* stringcharat, void* arg)
 {
-    stringcharat->getSource()->accept(this);
+    visitSubexpression(stringcharat->getSource());
     if(!checkType(Symbolic::STRING)){
         error("String char at operation on non-string");
         return;
@@ -177,7 +177,7 @@ void CVC4ConstraintWriter::visit(Symbolic::StringRegexReplace* obj, void* args)
       * Support the negative case.
       */
 
-    obj->getSource()->accept(this);
+    visitSubexpression(obj->getSource());
 
     if(!checkType(Symbolic::STRING)){
         error("StringRegexReplace operation on non-string");
@@ -213,7 +213,7 @@ void CVC4ConstraintWriter::visit(Symbolic::StringRegexReplace* obj, void* args)
 
 void CVC4ConstraintWriter::visit(Symbolic::StringReplace* replace, void* args)
 {
-    replace->getSource()->accept(this);
+    visitSubexpression(replace->getSource());
 
     if(!checkType(Symbolic::STRING)){
         error("String replace operation on non-string");
@@ -234,7 +234,7 @@ void CVC4ConstraintWriter::visit(Symbolic::StringReplace* replace, void* args)
  */
 void CVC4ConstraintWriter::visit(Symbolic::StringRegexSubmatch* obj, void* args)
 {
-    obj->getSource()->accept(this);
+    visitSubexpression(obj->getSource());
 
     if(!checkType(Symbolic::STRING)){
         error("String char at operation on non-string");
@@ -250,7 +250,7 @@ void CVC4ConstraintWriter::visit(Symbolic::StringRegexSubmatch* obj, void* args)
 
 void CVC4ConstraintWriter::visit(Symbolic::StringRegexSubmatchIndex* obj, void* args)
 {
-    obj->getSource()->accept(this);
+    visitSubexpression(obj->getSource());
 
     if(!checkType(Symbolic::STRING)){
         error("String submatch index operation on non-string");
@@ -286,7 +286,7 @@ void CVC4ConstraintWriter::visit(Symbolic::StringRegexSubmatchArray* exp, void*
       *
       */
 
-    exp->getSource()->accept(this);
+    visitSubexpression(exp->getSource());
 
     if(!checkType(Symbolic::STRING)){
         error("String regex submation operation on non-string");
@@ -320,7 +320,7 @@ void CVC4ConstraintWriter::visit(Symbolic::StringRegexSubmatchArray* exp, void*
 
 void CVC4ConstraintWriter::visit(Symbolic::StringRegexSubmatchArrayAt* exp, void* arg)
 {
-    exp->getMatch()->accept(this);
+    visitSubexpression(exp->getMatch());
 
     if(!checkType(Symbolic::OBJECT)){
         error("Array match operation (@) on non-object");
@@ -341,7 +341,7 @@ void CVC4ConstraintWriter::visit(Symbolic::StringRegexSubmatchArrayAt* exp, void
 
 void CVC4ConstraintWriter::visit(Symbolic::StringRegexSubmatchArrayMatch* exp, void* arg)
 {
-    exp->getMatch()->accept(this);
+    visitSubexpression(exp->getMatch());
 
     if(!checkType(Symbolic::OBJECT)){
         error("Array match operation (match value) on non-object");
@@ -371,14 +371,14 @@ void CVC4ConstraintWriter::visit(Symbolic::ObjectBinaryOperation* obj, void* arg
         ")", ") false)"
     };
 
-    obj->getLhs()->accept(this);
+    visitSubexpression(obj->getLhs());
     std::string lhs = mExpressionBuffer;
     if(!checkType(Symbolic::OBJECT)){
         error("Object operation with incorrectly typed LHS");
         return;
     }
 
-    obj->getRhs()->accept(this);
+    visitSubexpression(obj->getRhs());
     std::string rhs = mExpressionBuffer;
     if(!checkType(Symbolic::OBJECT)){
         error("Object operation with incorrectly typed RHS");
@@ -393,7 +393,7 @@ void CVC4ConstraintWriter::visit(Symbolic::ObjectBinaryOperation* obj, void* arg
 
 void CVC4ConstraintWriter::visit(Symbolic::StringLength* stringlength, void* args)
 {
-    stringlength->getString()->accept(this);
+    visitSubexpression(stringlength->getString());
     if(!checkType(Symbolic::STRING)){
         error("String length operation on non-string");
         return;
@@ -251,7 +251,34 @@ std::string visitPatternTerm(const JSC::Yarr::PatternTerm* term, bool& bol, bool
     return result.str();
 }
 
-std::string CVC4RegexCompiler::compile(const std::string &javaScriptRegex, bool& bol, bool& eol)
+std::map<std::string, CVC4RegexCompiler::CompiledRegex> CVC4RegexCompiler::m_cache;
+
+std::string CVC4RegexCompiler::compile(const std::string& javaScriptRegex, bool& bol, bool& eol)
+{
+    std::map<std::string, CompiledRegex>::iterator iter = m_cache.find(javaScriptRegex);
+
+    if (iter == m_cache.end()) {
+        CompiledRegex compiled;
+
+        try {
+            compiled.term = compileUncached(javaScriptRegex, compiled.bol, compiled.eol);
+        } catch (CVC4RegexCompilerException ex) {
+            compiled.error = ex.what();
+        }
+
+        iter = m_cache.insert(std::make_pair(javaScriptRegex, compiled)).first;
+    }
+
+    if (!iter->second.error.empty()) {
+        throw CVC4RegexCompilerException(iter->second.error);
+    }
+
+    bol = iter->second.bol;
+    eol = iter->second.eol;
+    return iter->second.term;
+}
+
+std::string CVC4RegexCompiler::compileUncached(const std::string &javaScriptRegex, bool& bol, bool& eol)
 {
     bol = false;
     eol = false;
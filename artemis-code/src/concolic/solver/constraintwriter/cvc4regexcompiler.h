@@ -17,6 +17,7 @@
 #ifndef CVC4REGEXCOMPILER_H
 #define CVC4REGEXCOMPILER_H
 
+#include <map>
 #include <string>
 
 class CVC4RegexCompilerException {
@@ -47,6 +48,21 @@ public:
 private:
     CVC4RegexCompiler();
 
+    static std::string compileUncached(const std::string& javaScriptRegex, bool& bol, bool& eol);
+
+    /**
+     * Translations are cached by the raw regex (pattern and flags), as the same few patterns are used by most PCs
+     * on a site. Failed translations are cached as well, with their error message.
+     */
+    struct CompiledRegex {
+        std::string term;
+        bool bol;
+        bool eol;
+        std::string error;
+    };
+
+    static std::map<std::string, CompiledRegex> m_cache;
+
 };
 
 #endif // CVC4REGEXCOMPILER_H
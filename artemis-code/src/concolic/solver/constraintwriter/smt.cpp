@@ -18,6 +18,7 @@
 #include <cstdlib>
 #include <iostream>
 #include <ostream>
+#include <set>
 #include <sstream>
 #include <cstdlib>
 #include <math.h>
@@ -33,10 +34,157 @@
 namespace artemis
 {
 
+/**
+ * Counts the uses of each compound subexpression of a PC.
+ *
+ * The subexpressions of an expression are only counted the first time it is used, so this is linear in the number
+ * of distinct nodes. Symbolic values and constants are not counted, as they are atomic in the output anyway, and
+ * neither are the submatch arrays, which CVC4ConstraintWriter already writes once.
+ */
+class SubexpressionCounter : public Symbolic::Visitor
+{
+public:
+    void visit(Symbolic::SymbolicInteger* symbolicinteger, void* arg) {}
+    void visit(Symbolic::ConstantInteger* constantinteger, void* arg) {}
+    void visit(Symbolic::ConstantObject* constantobject, void* arg) {}
+    void visit(Symbolic::SymbolicString* symbolicstring, void* arg) {}
+    void visit(Symbolic::ConstantString* constantstring, void* arg) {}
+    void visit(Symbolic::SymbolicBoolean* symbolicboolean, void* arg) {}
+    void visit(Symbolic::ConstantBoolean* constantboolean, void* arg) {}
+
+    void visit(Symbolic::IntegerBinaryOperation* integerbinaryoperation, void* arg)
+    {
+        if (use(integerbinaryoperation)) {
+            integerbinaryoperation->getLhs()->accept(this);
+            integerbinaryoperation->getRhs()->accept(this);
+        }
+    }
+
+    void visit(Symbolic::IntegerCoercion* integercoercion, void* arg)
+    {
+        if (use(integercoercion)) {
+            integercoercion->getExpression()->accept(this);
+        }
+    }
+
+    void visit(Symbolic::ObjectBinaryOperation* objectbinaryoperation, void* arg)
+    {
+        if (use(objectbinaryoperation)) {
+            objectbinaryoperation->getLhs()->accept(this);
+            objectbinaryoperation->getRhs()->accept(this);
+        }
+    }
+
+    void visit(Symbolic::StringBinaryOperation* stringbinaryoperation, void* arg)
+    {
+        if (use(stringbinaryoperation)) {
+            stringbinaryoperation->getLhs()->accept(this);
+            stringbinaryoperation->getRhs()->accept(this);
+        }
+    }
+
+    void visit(Symbolic::StringCoercion* stringcoercion, void* arg)
+    {
+        if (use(stringcoercion)) {
+            stringcoercion->getExpression()->accept(this);
+        }
+    }
+
+    void visit(Symbolic::StringLength* stringlength, void* arg)
+    {
+        if (use(stringlength)) {
+            stringlength->getString()->accept(this);
+        }
+    }
+
+    void visit(Symbolic::StringReplace* stringreplace, void* arg)
+    {
+        if (use(stringreplace)) {
+            stringreplace->getSource()->accept(this);
+        }
+    }
+
+    void visit(Symbolic::StringCharAt* stringcharat, void* arg)
+    {
+        if (use(stringcharat)) {
+            stringcharat->getSource()->accept(this);
+        }
+    }
+
+    void visit(Symbolic::StringRegexReplace* stringregexreplace, void* arg)
+    {
+        if (use(stringregexreplace)) {
+            stringregexreplace->getSource()->accept(this);
+        }
+    }
+
+    void visit(Symbolic::StringRegexSubmatch* stringregexsubmatch, void* arg)
+    {
+        if (use(stringregexsubmatch)) {
+            stringregexsubmatch->getSource()->accept(this);
+        }
+    }
+
+    void visit(Symbolic::StringRegexSubmatchIndex* stringregexsubmatchindex, void* arg)
+    {
+        if (use(stringregexsubmatchindex)) {
+            stringregexsubmatchindex->getSource()->accept(this);
+        }
+    }
+
+    void visit(Symbolic::StringRegexSubmatchArray* stringregexsubmatcharray, void* arg)
+    {
+        if (mArrays.insert(stringregexsubmatcharray).second) {
+            stringregexsubmatcharray->getSource()->accept(this);
+        }
+    }
+
+    void visit(Symbolic::StringRegexSubmatchArrayAt* stringregexsubmatcharrayat, void* arg)
+    {
+        if (use(stringregexsubmatcharrayat)) {
+            stringregexsubmatcharrayat->getMatch()->accept(this);
+        }
+    }
+
+    void visit(Symbolic::StringRegexSubmatchArrayMatch* stringregexsubmatcharraymatch, void* arg)
+    {
+        if (use(stringregexsubmatcharraymatch)) {
+            stringregexsubmatcharraymatch->getMatch()->accept(this);
+        }
+    }
+
+    void visit(Symbolic::BooleanCoercion* booleancoercion, void* arg)
+    {
+        if (use(booleancoercion)) {
+            booleancoercion->getExpression()->accept(this);
+        }
+    }
+
+    void visit(Symbolic::BooleanBinaryOperation* booleanbinaryoperation, void* arg)
+    {
+        if (use(booleanbinaryoperation)) {
+            booleanbinaryoperation->getLhs()->accept(this);
+            booleanbinaryoperation->getRhs()->accept(this);
+        }
+    }
+
+    std::map<Symbolic::Expression*, unsigned int> mUses;
+
+private:
+    // Returns true on the first use of expression.
+    bool use(Symbolic::Expression* expression)
+    {
+        return ++mUses[expression] == 1;
+    }
+
+    std::set<Symbolic::Expression*> mArrays;
+};
+
 SMTConstraintWriter::SMTConstraintWriter()
     : mExpressionType(Symbolic::TYPEERROR)
     , mError(false)
     , mNextTemporarySequence(0)
+    , mNextSharedSequence(0)
 {
 }
 
@@ -57,13 +205,27 @@ bool SMTConstraintWriter::write(PathConditionPtr pathCondition, std::string outp
 {
     mError = false;
 
+    SubexpressionCounter counter;
+    for (uint i = 0; i < pathCondition->size(); i++) {
+        pathCondition->get(i).first->accept(&counter);
+    }
+
+    mSharedTerms.clear();
+    for (std::map<Symbolic::Expression*, unsigned int>::iterator iter = counter.mUses.begin(); iter != counter.mUses.end(); iter++) {
+        if (iter->second > 1) {
+            mSharedTerms.insert(std::make_pair(iter->first, SharedTerm()));
+        }
+    }
+
+    statistics()->accumulate("Concolic::Solver::SharedSubexpressions", (int)mSharedTerms.size());
+
     mOutput.open(outputFile.data());
 
     preVisitPathConditionsHook();
 
     for (uint i = 0; i < pathCondition->size(); i++) {
 
-        pathCondition->get(i).first->accept(this);
+        visitSubexpression(pathCondition->get(i).first);
         if(!checkType(Symbolic::BOOL) && !checkType(Symbolic::TYPEERROR)){
             error("Writing the PC did not result in a boolean constraint");
         }
@@ -172,7 +334,7 @@ void SMTConstraintWriter::visit(Symbolic::ConstantBoolean* constantboolean, void
 void SMTConstraintWriter::visit(Symbolic::IntegerCoercion* integercoercion, void* args)
 {
     CoercionPromise promise(Symbolic::INT);
-    integercoercion->getExpression()->accept(this, &promise);
+    visitSubexpression(integercoercion->getExpression(), &promise);
 
     if (!promise.isCoerced) {
         coercetype(mExpressionType, Symbolic::INT, mExpressionBuffer); // Sets mExpressionBuffer and Type.
@@ -192,7 +354,7 @@ void SMTConstraintWriter::visit(Symbolic::StringCharAt* stringcharat, void* arg)
 void SMTConstraintWriter::visit(Symbolic::BooleanCoercion* booleancoercion, void* args)
 {
     CoercionPromise promise(Symbolic::BOOL);
-    booleancoercion->getExpression()->accept(this);
+    visitSubexpression(booleancoercion->getExpression());
 
     if (!promise.isCoerced) {
         coercetype(mExpressionType, Symbolic::BOOL, mExpressionBuffer); // Sets mExpressionBuffer and Type.
@@ -212,14 +374,14 @@ void SMTConstraintWriter::visit(Symbolic::IntegerBinaryOperation* integerbinaryo
         ")", ")", ")", ")", ")", ") false)", ")", ")", ")", ")", ")", ") false)", ")"
     };
 
-    integerbinaryoperation->getLhs()->accept(this);
+    visitSubexpression(integerbinaryoperation->getLhs());
     std::string lhs = mExpressionBuffer;
     if(!checkType(Symbolic::INT)){
         error("Integer operation with incorrectly typed LHS");
         return;
     }
 
-    integerbinaryoperation->getRhs()->accept(this);
+    visitSubexpression(integerbinaryoperation->getRhs());
     std::string rhs = mExpressionBuffer;
     if(!checkType(Symbolic::INT)){
         error("Integer operation with incorrectly typed RHS");
@@ -247,14 +409,14 @@ void SMTConstraintWriter::visit(Symbolic::BooleanBinaryOperation* booleanbinaryo
         ")", ") false)", ")", "))"
     };
 
-    booleanbinaryoperation->getLhs()->accept(this);
+    visitSubexpression(booleanbinaryoperation->getLhs());
     std::string lhs = mExpressionBuffer;
     if(!checkType(Symbolic::BOOL)){
         error("Boolean operation with incorrectly typed LHS");
         return;
     }
 
-    booleanbinaryoperation->getRhs()->accept(this);
+    visitSubexpression(booleanbinaryoperation->getRhs());
     std::string rhs = mExpressionBuffer;
     if(!checkType(Symbolic::BOOL)){
         error("Boolean operation with incorrectly typed RHS");
@@ -368,15 +530,57 @@ void SMTConstraintWriter::error(std::string reason)
     }
 }
 
+/** Shared subexpressions **/
+
+void SMTConstraintWriter::visitSubexpression(Symbolic::Expression* expression, void* args)
+{
+    std::map<Symbolic::Expression*, SharedTerm>::iterator iter = mSharedTerms.find(expression);
+
+    if (iter == mSharedTerms.end() || args != NULL) {
+        expression->accept(this, args);
+        return;
+    }
+
+    SharedTerm& shared = iter->second;
+
+    if (!shared.written) {
+        expression->accept(this);
+
+        if (mError) {
+            return;
+        }
+
+        shared.written = true;
+        shared.term = mExpressionBuffer;
+        shared.type = mExpressionType;
+
+        if (!mExpressionBuffer.empty() && mExpressionBuffer[0] == '(' && mExpressionType != Symbolic::TYPEERROR) {
+            std::ostringstream name;
+            name << "SHARED" << mNextSharedSequence++;
+
+            mOutput << "(define-fun " << name.str() << " () " << typeName(mExpressionType) << " " << mExpressionBuffer << ")\n";
+            shared.term = name.str();
+        }
+    }
+
+    mExpressionBuffer = shared.term;
+    mExpressionType = shared.type;
+}
+
 /** Types **/
 
-void SMTConstraintWriter::emitConst(const std::string& identifier, Symbolic::Type type)
+const char* SMTConstraintWriter::typeName(Symbolic::Type type)
 {
     static const char* typeStrings[] = {
         "Int", "Bool", "String", "Bool", "ERROR"
     };
 
-    mOutput << "(declare-const " << identifier << " " << typeStrings[type] << ")\n";
+    return typeStrings[type];
+}
+
+void SMTConstraintWriter::emitConst(const std::string& identifier, Symbolic::Type type)
+{
+    mOutput << "(declare-const " << identifier << " " << typeName(type) << ")\n";
 }
 
 std::string SMTConstraintWriter::emitAndReturnNewTemporary(Symbolic::Type type)
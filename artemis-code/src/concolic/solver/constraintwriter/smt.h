@@ -184,6 +184,33 @@ protected:
     std::string emitAndReturnNewTemporary(Symbolic::Type type);
     void emitConst(const std::string& identifier, Symbolic::Type type);
 
+    static const char* typeName(Symbolic::Type type);
+
+    /**
+     * Subexpressions are visited through visitSubexpression, which writes each subexpression used more than once
+     * in the PC only once. Its term is emitted as a definition (define-fun) the first time it is visited, and later
+     * visits return the defined name. Sharing is keyed on the expression nodes, so it is exact and cheap, and a
+     * string built by a long concatenation chain is written in linear space.
+     *
+     * A subexpression visited with a coercion promise (args) is always visited, as the promise can change its term.
+     */
+    void visitSubexpression(Symbolic::Expression* expression, void* args = NULL);
+
+    struct SharedTerm {
+        bool written;
+        std::string term; // The defined name, or the term itself if it is atomic
+        Symbolic::Type type;
+
+        SharedTerm()
+            : written(false)
+            , type(Symbolic::TYPEERROR)
+        {
+        }
+    };
+
+    std::map<Symbolic::Expression*, SharedTerm> mSharedTerms;
+    unsigned int mNextSharedSequence;
+
     static inline std::string stringfindreplace(const std::string& string, const std::string& search, const std::string& replace);
 
     void error(std::string reason);
@@ -103,14 +103,14 @@ void Z3STRConstraintWriter::visit(Symbolic::StringBinaryOperation* stringbinaryo
         return;
     }
 
-    stringbinaryoperation->getLhs()->accept(this);
+    visitSubexpression(stringbinaryoperation->getLhs());
     std::string lhs = mExpressionBuffer;
     if(!checkType(Symbolic::STRING)){
         error("String operation with incorrectly typed LHS");
         return;
     }
 
-    stringbinaryoperation->getRhs()->accept(this);
+    visitSubexpression(stringbinaryoperation->getRhs());
     std::string rhs = mExpressionBuffer;
     if(!checkType(Symbolic::STRING)){
         error("String operation with incorrectly typed RHS");
@@ -126,7 +126,7 @@ void Z3STRConstraintWriter::visit(Symbolic::StringBinaryOperation* stringbinaryo
 void Z3STRConstraintWriter::visit(Symbolic::StringCoercion* stringcoercion, void* args)
 {
     CoercionPromise promise(Symbolic::STRING);
-    stringcoercion->getExpression()->accept(this);
+    visitSubexpression(stringcoercion->getExpression());
 
     if (!promise.isCoerced) {
         coercetype(mExpressionType, Symbolic::STRING, mExpressionBuffer); // Sets mExpressionBuffer and Type.
@@ -148,7 +148,7 @@ void Z3STRConstraintWriter::visit(Symbolic::StringRegexReplace* regex, void* arg
 
         if (replaceSpaces || replaceNewlines || true) { // TODO: Hack, always filter away these for now
 
-            regex->getSource()->accept(this, args); // send args through, allow local coercions
+            visitSubexpression(regex->getSource(), args); // send args through, allow local coercions
 
             // You could use the following block to prevent certain characters to be used,
             // but this would be problematic wrt. possible coercions, so we just ignore these filtering regexes.
@@ -186,7 +186,7 @@ void Z3STRConstraintWriter::visit(Symbolic::StringRegexReplace* regex, void* arg
 
 void Z3STRConstraintWriter::visit(Symbolic::StringReplace* replace, void* args)
 {
-    replace->getSource()->accept(this);
+    visitSubexpression(replace->getSource());
     if(!checkType(Symbolic::STRING)){
         error("String replace operation on non-string");
         return;
@@ -201,7 +201,7 @@ void Z3STRConstraintWriter::visit(Symbolic::StringReplace* replace, void* args)
 
 void Z3STRConstraintWriter::visit(Symbolic::StringLength* stringlength, void* args)
 {
-    stringlength->getString()->accept(this);
+    visitSubexpression(stringlength->getString());
     if(!checkType(Symbolic::STRING)){
         error("String length operation on non-string");
         return;
@@ -34,7 +34,7 @@ namespace artemis
 {
 
 CVC4Solver::CVC4Solver()
-    : Solver()
+    : ProcessSolver()
 {
 }
 
@@ -55,29 +55,33 @@ void CVC4Solver::emitConstraints(std::ofstream& constraintIndex, const QString&
     QFile::copy("/tmp/cvc4input", QString::fromStdString("/tmp/constraints/") + identifier);
 }
 
-SolutionPtr CVC4Solver::solve(PathConditionPtr pc)
+QString CVC4Solver::getName() const
+{
+    return "CVC4";
+}
+
+SolutionPtr CVC4Solver::prepare(PathConditionPtr pc, SolverProcess* process, QString& program, QStringList& arguments)
 {
     // 0. Emit debug information
 
     QDir().mkdir("/tmp/constraints/");
     QDir constraintsPath = QDir("/tmp/constraints/");
 
-    QString identifier = QDateTime::currentDateTime().toString("dd-MM-yy-hh-mm-ss");
+    mIdentifier = QDateTime::currentDateTime().toString("dd-MM-yy-hh-mm-ss");
 
     int next = 0;
-    while (constraintsPath.exists(identifier)) {
-        if (identifier.contains("--")) {
-            identifier.chop(identifier.size() - identifier.indexOf("--"));
+    while (constraintsPath.exists(mIdentifier)) {
+        if (mIdentifier.contains("--")) {
+            mIdentifier.chop(mIdentifier.size() - mIdentifier.indexOf("--"));
         }
 
-        identifier = identifier + QString("--") + QString::number(next++);
+        mIdentifier = mIdentifier + QString("--") + QString::number(next++);
     }
 
     std::ofstream clog("/tmp/constraintlog", std::ofstream::out | std::ofstream::app);
-    std::ofstream constraintIndex("/tmp/constraintindex", std::ofstream::out | std::ofstream::app);
 
     clog << "********************************************************************************" << std::endl;
-    clog << "Identifier " << identifier.toStdString() << std::endl;
+    clog << "Identifier " << mIdentifier.toStdString() << std::endl;
     clog << "Time: " << QDateTime::currentDateTime().toString("dd-MM-yy-hh-mm-ss").toStdString() << std::endl;
     clog << "PC: " << pc->toStatisticsValuesString(true) << std::endl;
     clog << std::endl;
@@ -114,9 +118,21 @@ SolutionPtr CVC4Solver::solve(PathConditionPtr pc)
     }
 
     // --rewrite-divk enables div and mod by a constant factor
-    std::string cmd = solverpath.filePath(exec).toStdString() + " --lang=smtlib2 /tmp/cvc4input --rewrite-divk > /tmp/cvc4result 2> /tmp/cvc4result";
-    std::system(cmd.data()); // result of command interpreted in step 3
-    // We do not check the return code as it will be an "error" in unsat cases. Error checking is done below.
+    program = solverpath.filePath(exec);
+    arguments << "--lang=smtlib2" << "/tmp/cvc4input" << "--rewrite-divk";
+
+    process->setProcessChannelMode(QProcess::MergedChannels);
+    process->setStandardOutputFile("/tmp/cvc4result");
+
+    return SolutionPtr();
+}
+
+SolutionPtr CVC4Solver::interpret(int exitCode)
+{
+    // We do not check the exit code as it will be an "error" in unsat cases. Error checking is done below.
+
+    std::ofstream clog("/tmp/constraintlog", std::ofstream::out | std::ofstream::app);
+    std::ofstream constraintIndex("/tmp/constraintindex", std::ofstream::out | std::ofstream::app);
 
     // 3. interpret the result
 
@@ -137,7 +153,7 @@ SolutionPtr CVC4Solver::solve(PathConditionPtr pc)
     if (line.compare("unsat") == 0) {
 
         // UNSAT
-        emitConstraints(constraintIndex, identifier, false);
+        emitConstraints(constraintIndex, mIdentifier, false);
 
         statistics()->accumulate("Concolic::Solver::ConstraintsSolvedAsUNSAT", 1);
         clog << "Solved as UNSAT." << std::endl << std::endl;
@@ -179,7 +195,7 @@ SolutionPtr CVC4Solver::solve(PathConditionPtr pc)
 
     // Notice, we interpret sat and unknown internally as sat
 
-    emitConstraints(constraintIndex, identifier, true);
+    emitConstraints(constraintIndex, mIdentifier, true);
 
     std::getline(fp, line); // discard model line
 
@@ -17,7 +17,7 @@
 #ifndef CVC4SOLVER_H
 #define CVC4SOLVER_H
 
-#include "solver.h"
+#include "processsolver.h"
 
 #include <QString>
 
@@ -28,19 +28,24 @@ namespace artemis
  *  Generic symbolic constrint solver interface.
  */
 
-class CVC4Solver : public Solver
+class CVC4Solver : public ProcessSolver
 {
 public:
 
     CVC4Solver();
     ~CVC4Solver();
 
-    SolutionPtr solve(PathConditionPtr pc);
+    QString getName() const;
+    SolutionPtr prepare(PathConditionPtr pc, SolverProcess* process, QString& program, QStringList& arguments);
+    SolutionPtr interpret(int exitCode);
 
 private:
     SolutionPtr emitError(std::ofstream& clog, const std::string& reason);
     void emitConstraints(std::ofstream& constraintIndex, const QString& identifier, bool sat);
 
+    // Identifies the constraints of the current query in the constraint log and index.
+    QString mIdentifier;
+
 };
 
 typedef QSharedPointer<CVC4Solver> CVC4SolverPtr;
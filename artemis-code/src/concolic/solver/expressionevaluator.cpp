@@ -0,0 +1,607 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+#include <limits>
+
+#include "concreteregex.h"
+
+#include "expressionevaluator.h"
+
+#ifdef ARTEMIS
+
+namespace artemis
+{
+
+ConcreteValue::ConcreteValue()
+    : mType(Symbolic::TYPEERROR)
+    , mNumber(0)
+    , mBoolean(false)
+    , mIsNull(false)
+{
+}
+
+ConcreteValue ConcreteValue::fromNumber(double value)
+{
+    ConcreteValue result;
+    result.mType = Symbolic::INT;
+    result.mNumber = value;
+    return result;
+}
+
+ConcreteValue ConcreteValue::fromBoolean(bool value)
+{
+    ConcreteValue result;
+    result.mType = Symbolic::BOOL;
+    result.mBoolean = value;
+    return result;
+}
+
+ConcreteValue ConcreteValue::fromString(const QString& value)
+{
+    ConcreteValue result;
+    result.mType = Symbolic::STRING;
+    result.mString = value;
+    return result;
+}
+
+ConcreteValue ConcreteValue::fromObject(bool isNull)
+{
+    ConcreteValue result;
+    result.mType = Symbolic::OBJECT;
+    result.mIsNull = isNull;
+    return result;
+}
+
+double ConcreteValue::toNumber() const
+{
+    switch (mType) {
+    case Symbolic::INT:
+        return mNumber;
+    case Symbolic::BOOL:
+        return mBoolean ? 1 : 0;
+    case Symbolic::STRING:
+        return stringToNumber(mString);
+    case Symbolic::OBJECT:
+        return mIsNull ? 0 : std::numeric_limits<double>::quiet_NaN();
+    default:
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+}
+
+bool ConcreteValue::toBoolean() const
+{
+    switch (mType) {
+    case Symbolic::INT:
+        return mNumber != 0 && !std::isnan(mNumber);
+    case Symbolic::BOOL:
+        return mBoolean;
+    case Symbolic::STRING:
+        return !mString.isEmpty();
+    case Symbolic::OBJECT:
+        return !mIsNull;
+    default:
+        return false;
+    }
+}
+
+QString ConcreteValue::toString() const
+{
+    switch (mType) {
+    case Symbolic::INT:
+        return numberToString(mNumber);
+    case Symbolic::BOOL:
+        return mBoolean ? "true" : "false";
+    case Symbolic::STRING:
+        return mString;
+    case Symbolic::OBJECT:
+        return mIsNull ? "null" : "[object Object]";
+    default:
+        return QString();
+    }
+}
+
+/**
+ *  Number::toString as in ECMA-262 9.8.1, using the shortest digit string which reads back as the same double.
+ */
+QString ConcreteValue::numberToString(double value)
+{
+    if (std::isnan(value)) {
+        return "NaN";
+    }
+    if (std::isinf(value)) {
+        return value > 0 ? "Infinity" : "-Infinity";
+    }
+    if (value == 0) {
+        return "0";
+    }
+    if (value < 0) {
+        return "-" + numberToString(-value);
+    }
+
+    QString scientific;
+    for (int precision = 0; precision < 17; precision++) {
+        scientific = QString::number(value, 'e', precision);
+        if (scientific.toDouble() == value) {
+            break;
+        }
+    }
+
+    // scientific is d.ddde[+-]xx, split it into the digits and the position of the decimal point.
+    int exponentAt = scientific.indexOf('e');
+    QString digits = scientific.left(exponentAt).remove('.');
+    int point = scientific.mid(exponentAt + 1).toInt() + 1;
+    int length = digits.length();
+
+    if (length <= point && point <= 21) {
+        return digits + QString(point - length, '0');
+    }
+    if (0 < point && point <= 21) {
+        return digits.left(point) + "." + digits.mid(point);
+    }
+    if (-6 < point && point <= 0) {
+        return "0." + QString(-point, '0') + digits;
+    }
+
+    QString mantissa = length == 1 ? digits : digits.left(1) + "." + digits.mid(1);
+    return mantissa + "e" + (point - 1 >= 0 ? "+" : "-") + QString::number(std::abs(point - 1));
+}
+
+/**
+ *  ToNumber applied to the String type as in ECMA-262 9.3.1.
+ */
+double ConcreteValue::stringToNumber(const QString& value)
+{
+    QString trimmed = value.trimmed();
+    double nan = std::numeric_limits<double>::quiet_NaN();
+
+    if (trimmed.isEmpty()) {
+        return 0;
+    }
+
+    if (trimmed == "Infinity" || trimmed == "+Infinity") {
+        return std::numeric_limits<double>::infinity();
+    }
+    if (trimmed == "-Infinity") {
+        return -std::numeric_limits<double>::infinity();
+    }
+
+    bool ok = false;
+
+    if (trimmed.startsWith("0x") || trimmed.startsWith("0X")) {
+        double result = 0;
+        for (int i = 2; i < trimmed.length(); i++) {
+            int digit = QString(trimmed.at(i)).toInt(&ok, 16);
+            if (!ok) {
+                return nan;
+            }
+            result = result * 16 + digit;
+        }
+        return trimmed.length() > 2 ? result : nan;
+    }
+
+    // QString::toDouble also accepts forms such as "nan" and "inf", which are not numeric literals.
+    for (int i = 0; i < trimmed.length(); i++) {
+        QChar c = trimmed.at(i);
+        if (!c.isDigit() && c != '.' && c != 'e' && c != 'E' && c != '+' && c != '-') {
+            return nan;
+        }
+    }
+
+    double result = trimmed.toDouble(&ok);
+    return ok ? result : nan;
+}
+
+ExpressionEvaluator::ExpressionEvaluator(const QHash<QString, Symbolvalue>& assignment)
+    : mAssignment(assignment)
+{
+}
+
+ConcreteValue ExpressionEvaluator::evaluate(Symbolic::Expression* expression)
+{
+    mResult = ConcreteValue();
+    expression->accept(this);
+    return mResult;
+}
+
+bool ExpressionEvaluator::satisfies(PathConditionPtr pc)
+{
+    for (uint i = 0; i < pc->size(); i++) {
+        ConcreteValue value = evaluate(pc->get(i).first);
+
+        if (!value.isKnown() || value.toBoolean() != pc->get(i).second) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+ConcreteValue ExpressionEvaluator::lookup(const std::string& identifier) const
+{
+    QHash<QString, Symbolvalue>::const_iterator iter = mAssignment.find(QString(identifier.c_str()));
+
+    if (iter == mAssignment.end() || !iter.value().found) {
+        return ConcreteValue();
+    }
+
+    switch (iter.value().kind) {
+    case Symbolic::INT:
+        return ConcreteValue::fromNumber(iter.value().u.integer);
+    case Symbolic::BOOL:
+        return ConcreteValue::fromBoolean(iter.value().u.boolean);
+    case Symbolic::STRING:
+        // As injected by ConcolicRuntime::createFormInput.
+        return ConcreteValue::fromString(QString(iter.value().string.c_str()));
+    default:
+        return ConcreteValue();
+    }
+}
+
+/** Symbolic inputs and constants **/
+
+void ExpressionEvaluator::visit(Symbolic::SymbolicInteger* symbolicinteger, void* arg)
+{
+    ConcreteValue value = lookup(symbolicinteger->getSource().getIdentifier());
+    mResult = value.isKnown() ? ConcreteValue::fromNumber(value.toNumber()) : value;
+}
+
+void ExpressionEvaluator::visit(Symbolic::SymbolicString* symbolicstring, void* arg)
+{
+    ConcreteValue value = lookup(symbolicstring->getSource().getIdentifier());
+    mResult = value.isKnown() ? ConcreteValue::fromString(value.toString()) : value;
+}
+
+void ExpressionEvaluator::visit(Symbolic::SymbolicBoolean* symbolicboolean, void* arg)
+{
+    ConcreteValue value = lookup(symbolicboolean->getSource().getIdentifier());
+    mResult = value.isKnown() ? ConcreteValue::fromBoolean(value.toBoolean()) : value;
+}
+
+void ExpressionEvaluator::visit(Symbolic::ConstantInteger* constantinteger, void* arg)
+{
+    mResult = ConcreteValue::fromNumber(constantinteger->getValue());
+}
+
+void ExpressionEvaluator::visit(Symbolic::ConstantString* constantstring, void* arg)
+{
+    mResult = ConcreteValue::fromString(QString(constantstring->getValue()->c_str()));
+}
+
+void ExpressionEvaluator::visit(Symbolic::ConstantBoolean* constantboolean, void* arg)
+{
+    mResult = ConcreteValue::fromBoolean(constantboolean->getValue());
+}
+
+void ExpressionEvaluator::visit(Symbolic::ConstantObject* obj, void* arg)
+{
+    mResult = ConcreteValue::fromObject(obj->getIsnull());
+}
+
+/** Operations **/
+
+void ExpressionEvaluator::visit(Symbolic::IntegerBinaryOperation* integerbinaryoperation, void* arg)
+{
+    ConcreteValue lhs = evaluate(integerbinaryoperation->getLhs());
+    ConcreteValue rhs = evaluate(integerbinaryoperation->getRhs());
+
+    if (!lhs.isKnown() || !rhs.isKnown()) {
+        mResult = ConcreteValue();
+        return;
+    }
+
+    double l = lhs.toNumber();
+    double r = rhs.toNumber();
+
+    switch (integerbinaryoperation->getOp()) {
+    case Symbolic::INT_ADD:
+        mResult = ConcreteValue::fromNumber(l + r);
+        break;
+    case Symbolic::INT_SUBTRACT:
+        mResult = ConcreteValue::fromNumber(l - r);
+        break;
+    case Symbolic::INT_MULTIPLY:
+        mResult = ConcreteValue::fromNumber(l * r);
+        break;
+    case Symbolic::INT_DIVIDE:
+        mResult = ConcreteValue::fromNumber(l / r);
+        break;
+    case Symbolic::INT_MODULO:
+        mResult = ConcreteValue::fromNumber(std::fmod(l, r));
+        break;
+    case Symbolic::INT_EQ:
+    case Symbolic::INT_SEQ:
+        mResult = ConcreteValue::fromBoolean(l == r);
+        break;
+    case Symbolic::INT_NEQ:
+    case Symbolic::INT_SNEQ:
+        mResult = ConcreteValue::fromBoolean(l != r);
+        break;
+    case Symbolic::INT_LEQ:
+        mResult = ConcreteValue::fromBoolean(l <= r);
+        break;
+    case Symbolic::INT_LT:
+        mResult = ConcreteValue::fromBoolean(l < r);
+        break;
+    case Symbolic::INT_GEQ:
+        mResult = ConcreteValue::fromBoolean(l >= r);
+        break;
+    case Symbolic::INT_GT:
+        mResult = ConcreteValue::fromBoolean(l > r);
+        break;
+    default:
+        mResult = ConcreteValue();
+    }
+}
+
+void ExpressionEvaluator::visit(Symbolic::StringBinaryOperation* stringbinaryoperation, void* arg)
+{
+    ConcreteValue lhs = evaluate(stringbinaryoperation->getLhs());
+    ConcreteValue rhs = evaluate(stringbinaryoperation->getRhs());
+
+    if (!lhs.isKnown() || !rhs.isKnown()) {
+        mResult = ConcreteValue();
+        return;
+    }
+
+    QString l = lhs.toString();
+    QString r = rhs.toString();
+
+    // QString compares UTF-16 code units, as JavaScript does.
+    switch (stringbinaryoperation->getOp()) {
+    case Symbolic::CONCAT:
+        mResult = ConcreteValue::fromString(l + r);
+        break;
+    case Symbolic::STRING_EQ:
+    case Symbolic::STRING_SEQ:
+        mResult = ConcreteValue::fromBoolean(l == r);
+        break;
+    case Symbolic::STRING_NEQ:
+    case Symbolic::STRING_SNEQ:
+        mResult = ConcreteValue::fromBoolean(l != r);
+        break;
+    case Symbolic::STRING_LT:
+        mResult = ConcreteValue::fromBoolean(l < r);
+        break;
+    case Symbolic::STRING_LEQ:
+        mResult = ConcreteValue::fromBoolean(l <= r);
+        break;
+    case Symbolic::STRING_GT:
+        mResult = ConcreteValue::fromBoolean(l > r);
+        break;
+    case Symbolic::STRING_GEQ:
+        mResult = ConcreteValue::fromBoolean(l >= r);
+        break;
+    default:
+        mResult = ConcreteValue();
+    }
+}
+
+void ExpressionEvaluator::visit(Symbolic::BooleanBinaryOperation* booleanbinaryoperation, void* arg)
+{
+    ConcreteValue lhs = evaluate(booleanbinaryoperation->getLhs());
+    ConcreteValue rhs = evaluate(booleanbinaryoperation->getRhs());
+
+    if (!lhs.isKnown() || !rhs.isKnown()) {
+        mResult = ConcreteValue();
+        return;
+    }
+
+    switch (booleanbinaryoperation->getOp()) {
+    case Symbolic::BOOL_EQ:
+    case Symbolic::BOOL_SEQ:
+        mResult = ConcreteValue::fromBoolean(lhs.toBoolean() == rhs.toBoolean());
+        break;
+    case Symbolic::BOOL_NEQ:
+    case Symbolic::BOOL_SNEQ:
+        mResult = ConcreteValue::fromBoolean(lhs.toBoolean() != rhs.toBoolean());
+        break;
+    default:
+        mResult = ConcreteValue();
+    }
+}
+
+void ExpressionEvaluator::visit(Symbolic::ObjectBinaryOperation* obj, void* arg)
+{
+    ConcreteValue lhs = evaluate(obj->getLhs());
+    ConcreteValue rhs = evaluate(obj->getRhs());
+
+    // Only comparisons against null are decided, the identity of other objects is not modelled.
+    if (!lhs.isKnown() || !rhs.isKnown() || (!lhs.isNullObject() && !rhs.isNullObject())) {
+        mResult = ConcreteValue();
+        return;
+    }
+
+    bool equal = lhs.isNullObject() == rhs.isNullObject();
+
+    switch (obj->getOp()) {
+    case Symbolic::OBJ_EQ:
+        mResult = ConcreteValue::fromBoolean(equal);
+        break;
+    case Symbolic::OBJ_NEQ:
+        mResult = ConcreteValue::fromBoolean(!equal);
+        break;
+    default:
+        mResult = ConcreteValue();
+    }
+}
+
+/** Coercions **/
+
+void ExpressionEvaluator::visit(Symbolic::IntegerCoercion* integercoercion, void* arg)
+{
+    ConcreteValue value = evaluate(integercoercion->getExpression());
+    mResult = value.isKnown() ? ConcreteValue::fromNumber(value.toNumber()) : value;
+}
+
+void ExpressionEvaluator::visit(Symbolic::StringCoercion* stringcoercion, void* arg)
+{
+    ConcreteValue value = evaluate(stringcoercion->getExpression());
+    mResult = value.isKnown() ? ConcreteValue::fromString(value.toString()) : value;
+}
+
+void ExpressionEvaluator::visit(Symbolic::BooleanCoercion* booleancoercion, void* arg)
+{
+    ConcreteValue value = evaluate(booleancoercion->getExpression());
+    mResult = value.isKnown() ? ConcreteValue::fromBoolean(value.toBoolean()) : value;
+}
+
+/** String operations **/
+
+void ExpressionEvaluator::visit(Symbolic::StringLength* stringlength, void* arg)
+{
+    ConcreteValue value = evaluate(stringlength->getString());
+    mResult = value.isKnown() ? ConcreteValue::fromNumber(value.toString().length()) : value;
+}
+
+void ExpressionEvaluator::visit(Symbolic::StringCharAt* stringcharat, void* arg)
+{
+    ConcreteValue value = evaluate(stringcharat->getSource());
+    mResult = value.isKnown() ? ConcreteValue::fromString(value.toString().mid(stringcharat->getPosition(), 1)) : value;
+}
+
+/**
+ *  String.prototype.replace with a string pattern, which replaces the first occurrence only.
+ */
+void ExpressionEvaluator::visit(Symbolic::StringReplace* stringreplace, void* arg)
+{
+    ConcreteValue value = evaluate(stringreplace->getSource());
+    if (!value.isKnown()) {
+        mResult = value;
+        return;
+    }
+
+    QString source = value.toString();
+    QString pattern = QString(stringreplace->getPattern()->c_str());
+    QString replace = QString(stringreplace->getReplace()->c_str());
+
+    int index = source.indexOf(pattern);
+    if (index < 0) {
+        mResult = ConcreteValue::fromString(source);
+        return;
+    }
+
+    // Expand the replacement patterns of ECMA-262 15.5.4.11 which do not refer to capture groups.
+    QString replacement;
+    for (int i = 0; i < replace.length(); i++) {
+        if (replace.at(i) != '$' || i + 1 == replace.length()) {
+            replacement += replace.at(i);
+            continue;
+        }
+
+        QChar next = replace.at(i + 1);
+        if (next == '$') {
+            replacement += '$';
+        } else if (next == '&') {
+            replacement += pattern;
+        } else if (next == '`') {
+            replacement += source.left(index);
+        } else if (next == '\'') {
+            replacement += source.mid(index + pattern.length());
+        } else {
+            replacement += '$';
+            continue;
+        }
+        i++;
+    }
+
+    mResult = ConcreteValue::fromString(source.left(index) + replacement + source.mid(index + pattern.length()));
+}
+
+/** Regular expressions **/
+
+// The interpreter only records the pattern of the regular expressions used by test, exec, match and search, so they are
+// matched without flags here as well. The replace pattern is a literal including its flags.
+
+void ExpressionEvaluator::visit(Symbolic::StringRegexReplace* stringregexreplace, void* arg)
+{
+    ConcreteValue value = evaluate(stringregexreplace->getSource());
+    bool global;
+    ConcreteRegexPtr regex = ConcreteRegex::compileLiteral(QString(stringregexreplace->getRegexpattern()->c_str()), &global);
+
+    if (!value.isKnown() || !regex->isValid()) {
+        mResult = ConcreteValue();
+        return;
+    }
+
+    mResult = ConcreteValue::fromString(regex->replace(value.toString(), QString(stringregexreplace->getReplace()->c_str()), global));
+}
+
+void ExpressionEvaluator::visit(Symbolic::StringRegexSubmatch* submatch, void* arg)
+{
+    QVector<int> captures;
+    int matched = match(submatch->getSource(), *submatch->getRegexpattern(), captures);
+
+    mResult = matched < 0 ? ConcreteValue() : ConcreteValue::fromBoolean(matched);
+}
+
+void ExpressionEvaluator::visit(Symbolic::StringRegexSubmatchIndex* submatchIndex, void* arg)
+{
+    QVector<int> captures;
+    int matched = match(submatchIndex->getSource(), *submatchIndex->getRegexpattern(), captures);
+
+    mResult = matched < 0 ? ConcreteValue() : ConcreteValue::fromNumber(matched ? captures.at(0) : -1);
+}
+
+void ExpressionEvaluator::visit(Symbolic::StringRegexSubmatchArray* exp, void* arg)
+{
+    // The match array is only used through StringRegexSubmatchArrayAt and StringRegexSubmatchArrayMatch.
+    mResult = ConcreteValue();
+}
+
+void ExpressionEvaluator::visit(Symbolic::StringRegexSubmatchArrayAt* exp, void* arg)
+{
+    QVector<int> captures;
+    int matched = match(exp->getMatch()->getSource(), *exp->getMatch()->getRegexpattern(), captures);
+    int group = exp->getGroup();
+
+    // A group which does not take part in the match is undefined, which is not a string.
+    if (matched <= 0 || group < 0 || 2 * group + 1 >= captures.size() || captures.at(2 * group) < 0) {
+        mResult = ConcreteValue();
+        return;
+    }
+
+    mResult = ConcreteValue::fromString(mMatchSubject.mid(captures.at(2 * group), captures.at(2 * group + 1) - captures.at(2 * group)));
+}
+
+void ExpressionEvaluator::visit(Symbolic::StringRegexSubmatchArrayMatch* exp, void* arg)
+{
+    QVector<int> captures;
+    int matched = match(exp->getMatch()->getSource(), *exp->getMatch()->getRegexpattern(), captures);
+
+    mResult = matched < 0 ? ConcreteValue() : ConcreteValue::fromObject(!matched);
+}
+
+/**
+ *  Matches pattern against the value of source. Returns 1 on a match, 0 if there is none and -1 if either is unknown.
+ *  The matched string is left in mMatchSubject.
+ */
+int ExpressionEvaluator::match(Symbolic::Expression* source, const std::string& pattern, QVector<int>& captures)
+{
+    ConcreteValue value = evaluate(source);
+    ConcreteRegexPtr regex = ConcreteRegex::compile(QString(pattern.c_str()));
+
+    if (!value.isKnown() || !regex->isValid()) {
+        return -1;
+    }
+
+    mMatchSubject = value.toString();
+    return regex->match(mMatchSubject, 0, captures) ? 1 : 0;
+}
+
+}
+
+#endif
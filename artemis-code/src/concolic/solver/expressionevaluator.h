@@ -0,0 +1,132 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXPRESSIONEVALUATOR_H
+#define EXPRESSIONEVALUATOR_H
+
+#include <QHash>
+#include <QString>
+#include <QVector>
+
+#include "JavaScriptCore/symbolic/expr.h"
+#include "JavaScriptCore/symbolic/expression/visitor.h"
+
+#include "concolic/pathcondition.h"
+
+#include "solution.h"
+
+#ifdef ARTEMIS
+
+namespace artemis
+{
+
+/**
+ *  A concrete JavaScript value computed by the ExpressionEvaluator.
+ *
+ *  A value of type TYPEERROR is unknown, e.g. because the expression uses a variable which is not assigned or an
+ *  operation the evaluator does not support. Operations on unknown values are unknown.
+ */
+class ConcreteValue
+{
+public:
+    ConcreteValue();
+
+    static ConcreteValue fromNumber(double value);
+    static ConcreteValue fromBoolean(bool value);
+    static ConcreteValue fromString(const QString& value);
+    static ConcreteValue fromObject(bool isNull);
+
+    inline bool isKnown() const {
+        return mType != Symbolic::TYPEERROR;
+    }
+
+    inline Symbolic::Type getType() const {
+        return mType;
+    }
+
+    inline bool isNullObject() const {
+        return mType == Symbolic::OBJECT && mIsNull;
+    }
+
+    // The JavaScript ToNumber, ToBoolean and ToString conversions.
+    double toNumber() const;
+    bool toBoolean() const;
+    QString toString() const;
+
+    static QString numberToString(double value);
+    static double stringToNumber(const QString& value);
+
+private:
+    Symbolic::Type mType;
+    double mNumber;
+    bool mBoolean;
+    bool mIsNull;
+    QString mString;
+};
+
+/**
+ *  Evaluates symbolic expressions with JavaScript semantics under an assignment of the symbolic inputs, e.g. a
+ *  model returned by a solver. This checks a candidate assignment against a PC without a solver round trip.
+ *
+ *  Regular expressions are matched with the YARR interpreter (see ConcreteRegex).
+ */
+class ExpressionEvaluator : public Symbolic::Visitor
+{
+public:
+    ExpressionEvaluator(const QHash<QString, Symbolvalue>& assignment);
+
+    ConcreteValue evaluate(Symbolic::Expression* expression);
+
+    // True if the assignment is known to give every condition of pc its recorded outcome.
+    bool satisfies(PathConditionPtr pc);
+
+    void visit(Symbolic::ConstantObject* obj, void* arg);
+    void visit(Symbolic::ObjectBinaryOperation* obj, void* arg);
+    void visit(Symbolic::SymbolicInteger* symbolicinteger, void* arg);
+    void visit(Symbolic::ConstantInteger* constantinteger, void* arg);
+    void visit(Symbolic::IntegerBinaryOperation* integerbinaryoperation, void* arg);
+    void visit(Symbolic::IntegerCoercion* integercoercion, void* arg);
+    void visit(Symbolic::SymbolicString* symbolicstring, void* arg);
+    void visit(Symbolic::ConstantString* constantstring, void* arg);
+    void visit(Symbolic::StringBinaryOperation* stringbinaryoperation, void* arg);
+    void visit(Symbolic::StringCoercion* stringcoercion, void* arg);
+    void visit(Symbolic::StringCharAt* stringcharat, void* arg);
+    void visit(Symbolic::StringRegexReplace* stringregexreplace, void* arg);
+    void visit(Symbolic::StringReplace* stringreplace, void* arg);
+    void visit(Symbolic::StringRegexSubmatch* submatch, void* arg);
+    void visit(Symbolic::StringRegexSubmatchIndex* submatchIndex, void* arg);
+    void visit(Symbolic::StringRegexSubmatchArray* exp, void* arg);
+    void visit(Symbolic::StringRegexSubmatchArrayAt* exp, void* arg);
+    void visit(Symbolic::StringRegexSubmatchArrayMatch* exp, void* arg);
+    void visit(Symbolic::SymbolicBoolean* symbolicboolean, void* arg);
+    void visit(Symbolic::ConstantBoolean* constantboolean, void* arg);
+    void visit(Symbolic::BooleanCoercion* booleancoercion, void* arg);
+    void visit(Symbolic::BooleanBinaryOperation* booleanbinaryoperation, void* arg);
+    void visit(Symbolic::StringLength* stringlength, void* arg);
+
+private:
+    ConcreteValue lookup(const std::string& identifier) const;
+    int match(Symbolic::Expression* source, const std::string& pattern, QVector<int>& captures);
+
+    const QHash<QString, Symbolvalue>& mAssignment;
+    ConcreteValue mResult;
+    QString mMatchSubject;
+};
+
+}
+
+#endif
+#endif // EXPRESSIONEVALUATOR_H
@@ -0,0 +1,121 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <iomanip>
+#include <limits>
+
+#include "expressionkeyprinter.h"
+
+#ifdef ARTEMIS
+
+namespace artemis
+{
+
+void ExpressionKeyPrinter::visit(Symbolic::ConstantInteger* constantinteger, void* arg)
+{
+    std::ostringstream doubleStr;
+    doubleStr << std::setprecision(std::numeric_limits<double>::digits10 + 2) << constantinteger->getValue();
+    m_result += doubleStr.str();
+}
+
+void ExpressionKeyPrinter::visit(Symbolic::ConstantString* constantstring, void* arg)
+{
+    appendString(*constantstring->getValue());
+}
+
+void ExpressionKeyPrinter::visit(Symbolic::SymbolicInteger* symbolicinteger, void* arg)
+{
+    m_result += "SymbolicInteger ";
+    appendString(symbolicinteger->getSource().getIdentifier());
+}
+
+void ExpressionKeyPrinter::visit(Symbolic::SymbolicString* symbolicstring, void* arg)
+{
+    m_result += "SymbolicString ";
+    appendString(symbolicstring->getSource().getIdentifier());
+}
+
+void ExpressionKeyPrinter::visit(Symbolic::SymbolicBoolean* symbolicboolean, void* arg)
+{
+    m_result += "SymbolicBoolean ";
+    appendString(symbolicboolean->getSource().getIdentifier());
+}
+
+void ExpressionKeyPrinter::visit(Symbolic::StringRegexReplace* stringregexreplace, void* arg)
+{
+    m_result += "StringRegexReplace( ";
+    stringregexreplace->getSource()->accept(this);
+    m_result += ", ";
+    appendString(*stringregexreplace->getRegexpattern());
+    m_result += ", ";
+    appendString(*stringregexreplace->getReplace());
+    m_result += " )";
+}
+
+void ExpressionKeyPrinter::visit(Symbolic::StringReplace* stringreplace, void* arg)
+{
+    m_result += "StringReplace( ";
+    stringreplace->getSource()->accept(this);
+    m_result += ", ";
+    appendString(*stringreplace->getPattern());
+    m_result += ", ";
+    appendString(*stringreplace->getReplace());
+    m_result += " )";
+}
+
+void ExpressionKeyPrinter::visit(Symbolic::StringRegexSubmatch* stringregexsubmatch, void* arg)
+{
+    m_result += "StringRegexSubmatch( ";
+    stringregexsubmatch->getSource()->accept(this);
+    m_result += ", ";
+    appendString(*stringregexsubmatch->getRegexpattern());
+    m_result += " )";
+}
+
+void ExpressionKeyPrinter::visit(Symbolic::StringRegexSubmatchIndex* stringregexsubmatchindex, void* arg)
+{
+    m_result += "StringRegexSubmatchIndex( ";
+    stringregexsubmatchindex->getSource()->accept(this);
+    m_result += ", ";
+    appendString(*stringregexsubmatchindex->getRegexpattern());
+    m_result += " )";
+}
+
+void ExpressionKeyPrinter::visit(Symbolic::StringRegexSubmatchArray* stringregexsubmatcharray, void* arg)
+{
+    m_result += "StringRegexSubmatchArray( ";
+    stringregexsubmatcharray->getSource()->accept(this);
+    m_result += ", ";
+    appendString(*stringregexsubmatcharray->getRegexpattern());
+    m_result += " )";
+}
+
+// Quoted, with quotes and backslashes escaped, so the end of the string is never ambiguous. Embedded NULs are kept.
+void ExpressionKeyPrinter::appendString(const std::string& value)
+{
+    m_result += '"';
+    for (std::string::const_iterator c = value.begin(); c != value.end(); ++c) {
+        if (*c == '"' || *c == '\\') {
+            m_result += '\\';
+        }
+        m_result += *c;
+    }
+    m_result += '"';
+}
+
+}
+
+#endif
@@ -0,0 +1,60 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXPRESSIONKEYPRINTER_H
+#define EXPRESSIONKEYPRINTER_H
+
+#include "expressionvalueprinter.h"
+
+#ifdef ARTEMIS
+
+namespace artemis
+{
+
+/**
+ *  Prints an expression as a key identifying it structurally. Unlike ExpressionValuePrinter, numbers are printed
+ *  exactly and every string operand (constants, patterns, replacements and input identifiers) is quoted and escaped,
+ *  so distinct expressions never share a key.
+ */
+class ExpressionKeyPrinter : public ExpressionValuePrinter
+{
+
+public:
+
+    void visit(Symbolic::ConstantInteger* constantinteger, void* arg);
+    void visit(Symbolic::ConstantString* constantstring, void* arg);
+
+    void visit(Symbolic::SymbolicInteger* symbolicinteger, void* arg);
+    void visit(Symbolic::SymbolicString* symbolicstring, void* arg);
+    void visit(Symbolic::SymbolicBoolean* symbolicboolean, void* arg);
+
+    void visit(Symbolic::StringRegexReplace* stringregexreplace, void* arg);
+    void visit(Symbolic::StringReplace* stringreplace, void* arg);
+    void visit(Symbolic::StringRegexSubmatch* stringregexsubmatch, void* arg);
+    void visit(Symbolic::StringRegexSubmatchIndex* stringregexsubmatchindex, void* arg);
+    void visit(Symbolic::StringRegexSubmatchArray* stringregexsubmatcharray, void* arg);
+
+    using ExpressionValuePrinter::visit;
+
+private:
+    void appendString(const std::string& value);
+
+};
+
+}
+
+#endif
+#endif // EXPRESSIONKEYPRINTER_H
@@ -0,0 +1,446 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <limits>
+
+#include "expressionserializer.h"
+
+#ifdef ARTEMIS
+
+namespace artemis
+{
+
+ExpressionSerializer::ExpressionSerializer(QDataStream& stream)
+    : mStream(stream)
+{
+}
+
+quint32 ExpressionSerializer::write(Symbolic::Expression* expression)
+{
+    QHash<Symbolic::Expression*, quint32>::const_iterator iter = mIndices.find(expression);
+    if (iter != mIndices.end()) {
+        return iter.value();
+    }
+
+    // The visitor writes the subexpressions, then the record itself.
+    expression->accept(this);
+
+    quint32 index = mIndices.size();
+    mIndices.insert(expression, index);
+    return index;
+}
+
+void ExpressionSerializer::writeSource(const Symbolic::SymbolicSource& source)
+{
+    mStream << (qint32)source.getType() << (qint32)source.getIdentifierMethod() << QByteArray(source.getIdentifier().c_str());
+}
+
+QByteArray ExpressionSerializer::bytes(const std::string* string)
+{
+    return QByteArray(string->data(), string->size());
+}
+
+/** Symbolic values and constants **/
+
+void ExpressionSerializer::visit(Symbolic::SymbolicInteger* symbolicinteger, void* arg)
+{
+    mStream << (quint8)SYMBOLIC_INTEGER;
+    writeSource(symbolicinteger->getSource());
+}
+
+void ExpressionSerializer::visit(Symbolic::SymbolicString* symbolicstring, void* arg)
+{
+    mStream << (quint8)SYMBOLIC_STRING;
+    writeSource(symbolicstring->getSource());
+}
+
+void ExpressionSerializer::visit(Symbolic::SymbolicBoolean* symbolicboolean, void* arg)
+{
+    mStream << (quint8)SYMBOLIC_BOOLEAN;
+    writeSource(symbolicboolean->getSource());
+}
+
+void ExpressionSerializer::visit(Symbolic::ConstantInteger* constantinteger, void* arg)
+{
+    mStream << (quint8)CONSTANT_INTEGER << constantinteger->getValue();
+}
+
+void ExpressionSerializer::visit(Symbolic::ConstantString* constantstring, void* arg)
+{
+    mStream << (quint8)CONSTANT_STRING << bytes(constantstring->getValue());
+}
+
+void ExpressionSerializer::visit(Symbolic::ConstantBoolean* constantboolean, void* arg)
+{
+    mStream << (quint8)CONSTANT_BOOLEAN << constantboolean->getValue();
+}
+
+void ExpressionSerializer::visit(Symbolic::ConstantObject* constantobject, void* arg)
+{
+    mStream << (quint8)CONSTANT_OBJECT << constantobject->getIsnull();
+}
+
+/** Operations **/
+
+void ExpressionSerializer::visit(Symbolic::IntegerBinaryOperation* integerbinaryoperation, void* arg)
+{
+    quint32 lhs = write(integerbinaryoperation->getLhs());
+    quint32 rhs = write(integerbinaryoperation->getRhs());
+    mStream << (quint8)INTEGER_BINARY_OPERATION << lhs << (qint32)integerbinaryoperation->getOp() << rhs;
+}
+
+void ExpressionSerializer::visit(Symbolic::StringBinaryOperation* stringbinaryoperation, void* arg)
+{
+    quint32 lhs = write(stringbinaryoperation->getLhs());
+    quint32 rhs = write(stringbinaryoperation->getRhs());
+    mStream << (quint8)STRING_BINARY_OPERATION << lhs << (qint32)stringbinaryoperation->getOp() << rhs;
+}
+
+void ExpressionSerializer::visit(Symbolic::BooleanBinaryOperation* booleanbinaryoperation, void* arg)
+{
+    quint32 lhs = write(booleanbinaryoperation->getLhs());
+    quint32 rhs = write(booleanbinaryoperation->getRhs());
+    mStream << (quint8)BOOLEAN_BINARY_OPERATION << lhs << (qint32)booleanbinaryoperation->getOp() << rhs;
+}
+
+void ExpressionSerializer::visit(Symbolic::ObjectBinaryOperation* objectbinaryoperation, void* arg)
+{
+    quint32 lhs = write(objectbinaryoperation->getLhs());
+    quint32 rhs = write(objectbinaryoperation->getRhs());
+    mStream << (quint8)OBJECT_BINARY_OPERATION << lhs << (qint32)objectbinaryoperation->getOp() << rhs;
+}
+
+void ExpressionSerializer::visit(Symbolic::IntegerCoercion* integercoercion, void* arg)
+{
+    quint32 expression = write(integercoercion->getExpression());
+    mStream << (quint8)INTEGER_COERCION << expression;
+}
+
+void ExpressionSerializer::visit(Symbolic::StringCoercion* stringcoercion, void* arg)
+{
+    quint32 expression = write(stringcoercion->getExpression());
+    mStream << (quint8)STRING_COERCION << expression;
+}
+
+void ExpressionSerializer::visit(Symbolic::BooleanCoercion* booleancoercion, void* arg)
+{
+    quint32 expression = write(booleancoercion->getExpression());
+    mStream << (quint8)BOOLEAN_COERCION << expression;
+}
+
+void ExpressionSerializer::visit(Symbolic::StringLength* stringlength, void* arg)
+{
+    quint32 string = write(stringlength->getString());
+    mStream << (quint8)STRING_LENGTH << string;
+}
+
+void ExpressionSerializer::visit(Symbolic::StringReplace* stringreplace, void* arg)
+{
+    quint32 source = write(stringreplace->getSource());
+    mStream << (quint8)STRING_REPLACE << source << bytes(stringreplace->getPattern()) << bytes(stringreplace->getReplace());
+}
+
+void ExpressionSerializer::visit(Symbolic::StringCharAt* stringcharat, void* arg)
+{
+    quint32 source = write(stringcharat->getSource());
+    mStream << (quint8)STRING_CHAR_AT << source << (quint32)stringcharat->getPosition();
+}
+
+void ExpressionSerializer::visit(Symbolic::StringRegexReplace* stringregexreplace, void* arg)
+{
+    quint32 source = write(stringregexreplace->getSource());
+    mStream << (quint8)STRING_REGEX_REPLACE << source << bytes(stringregexreplace->getRegexpattern()) << bytes(stringregexreplace->getReplace());
+}
+
+void ExpressionSerializer::visit(Symbolic::StringRegexSubmatch* stringregexsubmatch, void* arg)
+{
+    quint32 source = write(stringregexsubmatch->getSource());
+    mStream << (quint8)STRING_REGEX_SUBMATCH << source << bytes(stringregexsubmatch->getRegexpattern());
+}
+
+void ExpressionSerializer::visit(Symbolic::StringRegexSubmatchIndex* stringregexsubmatchindex, void* arg)
+{
+    quint32 source = write(stringregexsubmatchindex->getSource());
+    mStream << (quint8)STRING_REGEX_SUBMATCH_INDEX << source << bytes(stringregexsubmatchindex->getRegexpattern());
+}
+
+void ExpressionSerializer::visit(Symbolic::StringRegexSubmatchArray* stringregexsubmatcharray, void* arg)
+{
+    quint32 source = write(stringregexsubmatcharray->getSource());
+    mStream << (quint8)STRING_REGEX_SUBMATCH_ARRAY << source << bytes(stringregexsubmatcharray->getRegexpattern());
+}
+
+void ExpressionSerializer::visit(Symbolic::StringRegexSubmatchArrayAt* stringregexsubmatcharrayat, void* arg)
+{
+    quint32 match = write(stringregexsubmatcharrayat->getMatch());
+    mStream << (quint8)STRING_REGEX_SUBMATCH_ARRAY_AT << match << (qint32)stringregexsubmatcharrayat->getGroup();
+}
+
+void ExpressionSerializer::visit(Symbolic::StringRegexSubmatchArrayMatch* stringregexsubmatcharraymatch, void* arg)
+{
+    quint32 match = write(stringregexsubmatcharraymatch->getMatch());
+    mStream << (quint8)STRING_REGEX_SUBMATCH_ARRAY_MATCH << match;
+}
+
+/** Reading **/
+
+// Counts down from the top of the range, the symbolic interpreter counts up from 0.
+unsigned int ExpressionDeserializer::mNextArrayIdentifier = std::numeric_limits<unsigned int>::max();
+
+ExpressionDeserializer::ExpressionDeserializer(QDataStream& stream)
+    : mStream(stream)
+{
+}
+
+Symbolic::Expression* ExpressionDeserializer::get(quint32 index) const
+{
+    return index < (quint32)mExpressions.size() ? mExpressions.at(index) : NULL;
+}
+
+Symbolic::SymbolicSource ExpressionDeserializer::readSource(bool& ok)
+{
+    qint32 type, method;
+    QByteArray identifier;
+    mStream >> type >> method >> identifier;
+
+    ok = ok && inRange(type, Symbolic::INPUT) && inRange(method, Symbolic::ELEMENT_ID);
+
+    return Symbolic::SymbolicSource((Symbolic::SourceType)type, (Symbolic::SourceIdentifierMethod)method,
+                                    std::string(identifier.constData(), identifier.size()));
+}
+
+std::string* ExpressionDeserializer::readString()
+{
+    QByteArray string;
+    mStream >> string;
+
+    return new std::string(string.constData(), string.size());
+}
+
+// The subexpressions are cast as in the symbolic interpreter, which does not keep to the static expression types.
+template <typename T>
+T* ExpressionDeserializer::readChild(bool& ok)
+{
+    quint32 index;
+    mStream >> index;
+
+    Symbolic::Expression* child = get(index);
+    ok = ok && child != NULL;
+
+    return (T*)child;
+}
+
+// Submatch arrays are really downcast by the expressions using them, so their children must be arrays.
+Symbolic::StringRegexSubmatchArray* ExpressionDeserializer::readArrayChild(bool& ok)
+{
+    quint32 index;
+    mStream >> index;
+
+    ok = ok && index < (quint32)mKinds.size() && mKinds.at(index) == ExpressionSerializer::STRING_REGEX_SUBMATCH_ARRAY;
+
+    return ok ? (Symbolic::StringRegexSubmatchArray*)mExpressions.at(index) : NULL;
+}
+
+// Whether value is a valid enumerator of an enum running from 0 to last, such as the operators, which are used to
+// index tables.
+bool ExpressionDeserializer::inRange(qint32 value, qint32 last)
+{
+    return value >= 0 && value <= last;
+}
+
+bool ExpressionDeserializer::readRecord()
+{
+    quint8 kind;
+    mStream >> kind;
+
+    bool ok = true;
+    qint32 op;
+    Symbolic::Expression* result = NULL;
+
+    switch (kind) {
+    case ExpressionSerializer::SYMBOLIC_INTEGER:
+        result = new Symbolic::SymbolicInteger(readSource(ok));
+        break;
+
+    case ExpressionSerializer::SYMBOLIC_STRING:
+        result = new Symbolic::SymbolicString(readSource(ok));
+        break;
+
+    case ExpressionSerializer::SYMBOLIC_BOOLEAN:
+        result = new Symbolic::SymbolicBoolean(readSource(ok));
+        break;
+
+    case ExpressionSerializer::CONSTANT_INTEGER: {
+        double value;
+        mStream >> value;
+        result = new Symbolic::ConstantInteger(value);
+        break;
+    }
+
+    case ExpressionSerializer::CONSTANT_STRING:
+        result = new Symbolic::ConstantString(readString());
+        break;
+
+    case ExpressionSerializer::CONSTANT_BOOLEAN: {
+        bool value;
+        mStream >> value;
+        result = new Symbolic::ConstantBoolean(value);
+        break;
+    }
+
+    case ExpressionSerializer::CONSTANT_OBJECT: {
+        bool isNull;
+        mStream >> isNull;
+        result = new Symbolic::ConstantObject(isNull);
+        break;
+    }
+
+    case ExpressionSerializer::INTEGER_BINARY_OPERATION: {
+        Symbolic::IntegerExpression* lhs = readChild<Symbolic::IntegerExpression>(ok);
+        mStream >> op;
+        Symbolic::IntegerExpression* rhs = readChild<Symbolic::IntegerExpression>(ok);
+        if (!ok || !inRange(op, Symbolic::INT_SEQ)) {
+            return false;
+        }
+        result = new Symbolic::IntegerBinaryOperation(lhs, (Symbolic::IntegerBinaryOp)op, rhs);
+        break;
+    }
+
+    case ExpressionSerializer::STRING_BINARY_OPERATION: {
+        Symbolic::StringExpression* lhs = readChild<Symbolic::StringExpression>(ok);
+        mStream >> op;
+        Symbolic::StringExpression* rhs = readChild<Symbolic::StringExpression>(ok);
+        if (!ok || !inRange(op, Symbolic::STRING_SNEQ)) {
+            return false;
+        }
+        result = new Symbolic::StringBinaryOperation(lhs, (Symbolic::StringBinaryOp)op, rhs);
+        break;
+    }
+
+    case ExpressionSerializer::BOOLEAN_BINARY_OPERATION: {
+        Symbolic::BooleanExpression* lhs = readChild<Symbolic::BooleanExpression>(ok);
+        mStream >> op;
+        Symbolic::BooleanExpression* rhs = readChild<Symbolic::BooleanExpression>(ok);
+        if (!ok || !inRange(op, Symbolic::BOOL_SNEQ)) {
+            return false;
+        }
+        result = new Symbolic::BooleanBinaryOperation(lhs, (Symbolic::BooleanBinaryOp)op, rhs);
+        break;
+    }
+
+    case ExpressionSerializer::OBJECT_BINARY_OPERATION: {
+        Symbolic::ObjectExpression* lhs = readChild<Symbolic::ObjectExpression>(ok);
+        mStream >> op;
+        Symbolic::ObjectExpression* rhs = readChild<Symbolic::ObjectExpression>(ok);
+        if (!ok || !inRange(op, Symbolic::OBJ_NEQ)) {
+            return false;
+        }
+        result = new Symbolic::ObjectBinaryOperation(lhs, (Symbolic::ObjectBinaryOp)op, rhs);
+        break;
+    }
+
+    case ExpressionSerializer::INTEGER_COERCION:
+        result = new Symbolic::IntegerCoercion(readChild<Symbolic::Expression>(ok));
+        break;
+
+    case ExpressionSerializer::STRING_COERCION:
+        result = new Symbolic::StringCoercion(readChild<Symbolic::Expression>(ok));
+        break;
+
+    case ExpressionSerializer::BOOLEAN_COERCION:
+        result = new Symbolic::BooleanCoercion(readChild<Symbolic::Expression>(ok));
+        break;
+
+    case ExpressionSerializer::STRING_LENGTH:
+        result = new Symbolic::StringLength(readChild<Symbolic::StringExpression>(ok));
+        break;
+
+    case ExpressionSerializer::STRING_REPLACE: {
+        Symbolic::StringExpression* source = readChild<Symbolic::StringExpression>(ok);
+        std::string* pattern = readString();
+        result = new Symbolic::StringReplace(source, pattern, readString());
+        break;
+    }
+
+    case ExpressionSerializer::STRING_CHAR_AT: {
+        Symbolic::StringExpression* source = readChild<Symbolic::StringExpression>(ok);
+        quint32 position;
+        mStream >> position;
+        result = new Symbolic::StringCharAt(source, position);
+        break;
+    }
+
+    case ExpressionSerializer::STRING_REGEX_REPLACE: {
+        Symbolic::StringExpression* source = readChild<Symbolic::StringExpression>(ok);
+        std::string* pattern = readString();
+        result = new Symbolic::StringRegexReplace(source, pattern, readString());
+        break;
+    }
+
+    case ExpressionSerializer::STRING_REGEX_SUBMATCH: {
+        Symbolic::StringExpression* source = readChild<Symbolic::StringExpression>(ok);
+        result = new Symbolic::StringRegexSubmatch(source, readString());
+        break;
+    }
+
+    case ExpressionSerializer::STRING_REGEX_SUBMATCH_INDEX: {
+        Symbolic::StringExpression* source = readChild<Symbolic::StringExpression>(ok);
+        result = new Symbolic::StringRegexSubmatchIndex(source, readString());
+        break;
+    }
+
+    case ExpressionSerializer::STRING_REGEX_SUBMATCH_ARRAY: {
+        Symbolic::StringExpression* source = readChild<Symbolic::StringExpression>(ok);
+        result = new Symbolic::StringRegexSubmatchArray(mNextArrayIdentifier--, source, readString());
+        break;
+    }
+
+    case ExpressionSerializer::STRING_REGEX_SUBMATCH_ARRAY_AT: {
+        Symbolic::StringRegexSubmatchArray* match = readArrayChild(ok);
+        qint32 group;
+        mStream >> group;
+        if (!ok) {
+            return false;
+        }
+        result = new Symbolic::StringRegexSubmatchArrayAt(match, group);
+        break;
+    }
+
+    case ExpressionSerializer::STRING_REGEX_SUBMATCH_ARRAY_MATCH: {
+        Symbolic::StringRegexSubmatchArray* match = readArrayChild(ok);
+        if (!ok) {
+            return false;
+        }
+        result = new Symbolic::StringRegexSubmatchArrayMatch(match);
+        break;
+    }
+
+    default:
+        return false;
+    }
+
+    if (!ok || mStream.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    mExpressions.append(result);
+    mKinds.append(kind);
+    return true;
+}
+
+}
+
+#endif
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXPRESSIONSERIALIZER_H
+#define EXPRESSIONSERIALIZER_H
+
+#include <QDataStream>
+#include <QHash>
+#include <QVector>
+
+#include "JavaScriptCore/symbolic/expr.h"
+#include "JavaScriptCore/symbolic/expression/visitor.h"
+
+#ifdef ARTEMIS
+
+namespace artemis
+{
+
+/**
+ *  Writes symbolic expressions to a QDataStream as a table of records, which ExpressionDeserializer reads back.
+ *
+ *  Each distinct expression node is written once, after its subexpressions, and is referred to by its index in the
+ *  table. Shared subexpressions (which are common between the conditions of a PC) are therefore stored once.
+ *  Records are only written for expressions not written before, so a stream can interleave expression records
+ *  with other data, as long as it is read back in the same order.
+ *
+ *  Record: kind (quint8), then the fields of the expression, with subexpressions as table indices (quint32).
+ */
+class ExpressionSerializer : public Symbolic::Visitor
+{
+public:
+    ExpressionSerializer(QDataStream& stream);
+
+    // Writes the records for expression and any new subexpressions. Returns the index of expression.
+    quint32 write(Symbolic::Expression* expression);
+
+    // The number of records written so far.
+    inline quint32 size() const {
+        return mIndices.size();
+    }
+
+    void visit(Symbolic::SymbolicInteger* symbolicinteger, void* arg);
+    void visit(Symbolic::ConstantInteger* constantinteger, void* arg);
+    void visit(Symbolic::IntegerBinaryOperation* integerbinaryoperation, void* arg);
+    void visit(Symbolic::IntegerCoercion* integercoercion, void* arg);
+    void visit(Symbolic::ConstantObject* constantobject, void* arg);
+    void visit(Symbolic::ObjectBinaryOperation* objectbinaryoperation, void* arg);
+    void visit(Symbolic::SymbolicString* symbolicstring, void* arg);
+    void visit(Symbolic::ConstantString* constantstring, void* arg);
+    void visit(Symbolic::StringBinaryOperation* stringbinaryoperation, void* arg);
+    void visit(Symbolic::StringCoercion* stringcoercion, void* arg);
+    void visit(Symbolic::StringLength* stringlength, void* arg);
+    void visit(Symbolic::StringReplace* stringreplace, void* arg);
+    void visit(Symbolic::StringCharAt* stringcharat, void* arg);
+    void visit(Symbolic::StringRegexReplace* stringregexreplace, void* arg);
+    void visit(Symbolic::StringRegexSubmatch* stringregexsubmatch, void* arg);
+    void visit(Symbolic::StringRegexSubmatchIndex* stringregexsubmatchindex, void* arg);
+    void visit(Symbolic::StringRegexSubmatchArray* stringregexsubmatcharray, void* arg);
+    void visit(Symbolic::StringRegexSubmatchArrayAt* stringregexsubmatcharrayat, void* arg);
+    void visit(Symbolic::StringRegexSubmatchArrayMatch* stringregexsubmatcharraymatch, void* arg);
+    void visit(Symbolic::SymbolicBoolean* symbolicboolean, void* arg);
+    void visit(Symbolic::ConstantBoolean* constantboolean, void* arg);
+    void visit(Symbolic::BooleanCoercion* booleancoercion, void* arg);
+    void visit(Symbolic::BooleanBinaryOperation* booleanbinaryoperation, void* arg);
+
+    // The record kinds, in the order of the Symbolic::Visitor interface.
+    enum Kind {
+        SYMBOLIC_INTEGER, CONSTANT_INTEGER, INTEGER_BINARY_OPERATION, INTEGER_COERCION,
+        CONSTANT_OBJECT, OBJECT_BINARY_OPERATION,
+        SYMBOLIC_STRING, CONSTANT_STRING, STRING_BINARY_OPERATION, STRING_COERCION, STRING_LENGTH, STRING_REPLACE,
+        STRING_CHAR_AT, STRING_REGEX_REPLACE, STRING_REGEX_SUBMATCH, STRING_REGEX_SUBMATCH_INDEX,
+        STRING_REGEX_SUBMATCH_ARRAY, STRING_REGEX_SUBMATCH_ARRAY_AT, STRING_REGEX_SUBMATCH_ARRAY_MATCH,
+        SYMBOLIC_BOOLEAN, CONSTANT_BOOLEAN, BOOLEAN_COERCION, BOOLEAN_BINARY_OPERATION,
+        KIND_COUNT
+    };
+
+private:
+    void writeSource(const Symbolic::SymbolicSource& source);
+    static QByteArray bytes(const std::string* string);
+
+    QDataStream& mStream;
+    QHash<Symbolic::Expression*, quint32> mIndices;
+};
+
+/**
+ *  Reads the expression records written by an ExpressionSerializer.
+ *
+ *  The recreated expressions are never freed, like those created by the symbolic interpreter. Submatch arrays are
+ *  given new identifiers from the top of the identifier range, so they never clash with arrays created in this run.
+ */
+class ExpressionDeserializer
+{
+public:
+    ExpressionDeserializer(QDataStream& stream);
+
+    // Reads one record, returns false if it is malformed (e.g. an operator out of range, or a reference to a
+    // missing record or to a record of the wrong kind).
+    bool readRecord();
+
+    // Returns the expression with the given index, or NULL if there is none.
+    Symbolic::Expression* get(quint32 index) const;
+
+private:
+    Symbolic::SymbolicSource readSource(bool& ok);
+    std::string* readString();
+
+    template <typename T>
+    T* readChild(bool& ok);
+    Symbolic::StringRegexSubmatchArray* readArrayChild(bool& ok);
+
+    static bool inRange(qint32 value, qint32 last);
+
+    QDataStream& mStream;
+    QVector<Symbolic::Expression*> mExpressions;
+    QVector<quint8> mKinds; // The record kind of each expression.
+
+    static unsigned int mNextArrayIdentifier;
+};
+
+}
+
+#endif
+#endif // EXPRESSIONSERIALIZER_H
@@ -0,0 +1,513 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+
+#include <QList>
+#include <QPair>
+#include <QSet>
+
+#include "expressionfreevariablelister.h"
+#include "expressionkeyprinter.h"
+
+#include "expressionsimplifier.h"
+
+#ifdef ARTEMIS
+
+namespace artemis
+{
+
+ExpressionSimplifier::ExpressionSimplifier()
+{
+    mConditionsIn = statistics()->counter("Concolic::Solver::Simplifier::ConditionsIn");
+    mConditionsOut = statistics()->counter("Concolic::Solver::Simplifier::ConditionsOut");
+    mFolded = statistics()->counter("Concolic::Solver::Simplifier::ExpressionsFolded");
+    mCoercionsRemoved = statistics()->counter("Concolic::Solver::Simplifier::CoercionsRemoved");
+    mDuplicatesRemoved = statistics()->counter("Concolic::Solver::Simplifier::DuplicatesRemoved");
+    mImpliedRemoved = statistics()->counter("Concolic::Solver::Simplifier::ImpliedRemoved");
+    mUnsat = statistics()->counter("Concolic::Solver::Simplifier::Unsat");
+}
+
+PathConditionPtr ExpressionSimplifier::simplify(PathConditionPtr pc)
+{
+    mConditionsIn.add(pc->size());
+
+    QList<QPair<Symbolic::Expression*, bool> > conditions;
+    QList<Rewrite> rewrites;
+    QHash<QString, bool> seen;
+
+    for (uint i = 0; i < pc->size(); i++) {
+        Rewrite rewritten = rewrite(pc->get(i).first);
+        bool outcome = pc->get(i).second != rewritten.conditionNegated;
+
+        if (rewritten.constant) {
+            if (ExpressionEvaluator(mNoInputs).evaluate(rewritten.expression).toBoolean() != outcome) {
+                mUnsat.add(1);
+                return PathConditionPtr();
+            }
+            continue;
+        }
+
+        ExpressionKeyPrinter printer;
+        rewritten.condition->accept(&printer);
+        QString key = QString::fromStdString(printer.getResult());
+
+        if (seen.contains(key)) {
+            if (seen.value(key) != outcome) {
+                mUnsat.add(1);
+                return PathConditionPtr();
+            }
+
+            mDuplicatesRemoved.add(1);
+            continue;
+        }
+
+        seen.insert(key, outcome);
+        conditions.append(qMakePair(rewritten.condition, outcome));
+        rewrites.append(rewritten);
+    }
+
+    // The first condition fixing each input is kept, conditions on only fixed inputs are decided by evaluation.
+    QHash<QString, Symbolvalue> fixed;
+    QSet<int> fixing;
+
+    for (int i = 0; i < conditions.size(); i++) {
+        const Rewrite& rewritten = rewrites.at(i);
+
+        if (rewritten.fixedInput.isEmpty() || !conditions.at(i).second || fixed.contains(rewritten.fixedInput)) {
+            continue;
+        }
+
+        Symbolvalue value;
+        value.found = true;
+        value.kind = Symbolic::STRING;
+        value.string = rewritten.fixedValue.toStdString();
+
+        fixed.insert(rewritten.fixedInput, value);
+        fixing.insert(i);
+    }
+
+    ExpressionEvaluator evaluator(fixed);
+    PathConditionPtr result = PathConditionPtr(new PathCondition());
+
+    for (int i = 0; i < conditions.size(); i++) {
+        Symbolic::Expression* condition = conditions.at(i).first;
+        bool outcome = conditions.at(i).second;
+
+        if (!fixed.isEmpty() && !fixing.contains(i)) {
+            ExpressionFreeVariableLister lister;
+            condition->accept(&lister);
+
+            bool onlyFixed = true;
+            foreach (QString input, lister.getResult().keys()) {
+                onlyFixed = onlyFixed && fixed.contains(input);
+            }
+
+            ConcreteValue value = onlyFixed ? evaluator.evaluate(condition) : ConcreteValue();
+
+            if (value.isKnown()) {
+                if (value.toBoolean() != outcome) {
+                    mUnsat.add(1);
+                    return PathConditionPtr();
+                }
+
+                mImpliedRemoved.add(1);
+                continue;
+            }
+        }
+
+        result->addCondition(condition, outcome);
+    }
+
+    mConditionsOut.add(result->size());
+    return result;
+}
+
+Symbolic::Expression* ExpressionSimplifier::simplify(Symbolic::Expression* expression)
+{
+    return rewrite(expression).expression;
+}
+
+ExpressionSimplifier::Rewrite ExpressionSimplifier::rewrite(Symbolic::Expression* expression)
+{
+    QHash<Symbolic::Expression*, Rewrite>::const_iterator iter = mRewrites.find(expression);
+    if (iter != mRewrites.end()) {
+        return iter.value();
+    }
+
+    expression->accept(this);
+    mRewrites.insert(expression, mResult);
+
+    return mResult;
+}
+
+void ExpressionSimplifier::leaf(Symbolic::Expression* expression, Symbolic::Type type, bool constant)
+{
+    Rewrite result;
+    result.expression = expression;
+    result.type = type;
+    result.constant = constant;
+    result.condition = expression;
+    result.conditionNegated = false;
+
+    mResult = result;
+}
+
+void ExpressionSimplifier::finish(Symbolic::Expression* expression, Symbolic::Type type, bool foldable)
+{
+    if (foldable) {
+        ConcreteValue value = ExpressionEvaluator(mNoInputs).evaluate(expression);
+
+        // NaN and the infinities have no integer constant in the solver input.
+        if (value.isKnown() && (value.getType() != Symbolic::INT || std::isfinite(value.toNumber()))) {
+            mFolded.add(1);
+            leaf(createConstant(value), value.getType(), true);
+            return;
+        }
+    }
+
+    leaf(expression, type, false);
+}
+
+void ExpressionSimplifier::finishComparison(Symbolic::Expression* expression, bool foldable, Symbolic::Expression* negation)
+{
+    finish(expression, Symbolic::BOOL, foldable);
+
+    if (!mResult.constant && negation != NULL) {
+        mResult.condition = negation;
+        mResult.conditionNegated = true;
+    }
+}
+
+Symbolic::Expression* ExpressionSimplifier::createConstant(const ConcreteValue& value)
+{
+    switch (value.getType()) {
+    case Symbolic::INT:
+        return new Symbolic::ConstantInteger(value.toNumber());
+    case Symbolic::STRING:
+        return new Symbolic::ConstantString(new std::string(value.toString().toStdString()));
+    case Symbolic::BOOL:
+        return new Symbolic::ConstantBoolean(value.toBoolean());
+    default:
+        return new Symbolic::ConstantObject(value.isNullObject());
+    }
+}
+
+/** Symbolic inputs and constants **/
+
+void ExpressionSimplifier::visit(Symbolic::SymbolicInteger* symbolicinteger, void* arg)
+{
+    leaf(symbolicinteger, Symbolic::INT, false);
+}
+
+void ExpressionSimplifier::visit(Symbolic::SymbolicString* symbolicstring, void* arg)
+{
+    leaf(symbolicstring, Symbolic::STRING, false);
+    mResult.input = QString(symbolicstring->getSource().getIdentifier().c_str());
+}
+
+void ExpressionSimplifier::visit(Symbolic::SymbolicBoolean* symbolicboolean, void* arg)
+{
+    leaf(symbolicboolean, Symbolic::BOOL, false);
+}
+
+void ExpressionSimplifier::visit(Symbolic::ConstantInteger* constantinteger, void* arg)
+{
+    leaf(constantinteger, Symbolic::INT, true);
+}
+
+void ExpressionSimplifier::visit(Symbolic::ConstantString* constantstring, void* arg)
+{
+    leaf(constantstring, Symbolic::STRING, true);
+}
+
+void ExpressionSimplifier::visit(Symbolic::ConstantBoolean* constantboolean, void* arg)
+{
+    leaf(constantboolean, Symbolic::BOOL, true);
+}
+
+void ExpressionSimplifier::visit(Symbolic::ConstantObject* obj, void* arg)
+{
+    leaf(obj, Symbolic::OBJECT, true);
+}
+
+/** Operations **/
+
+// The subexpressions are cast as in the symbolic interpreter, which does not keep to the static expression types.
+
+void ExpressionSimplifier::visit(Symbolic::IntegerBinaryOperation* integerbinaryoperation, void* arg)
+{
+    Rewrite lhs = rewrite(integerbinaryoperation->getLhs());
+    Rewrite rhs = rewrite(integerbinaryoperation->getRhs());
+    Symbolic::IntegerBinaryOp op = integerbinaryoperation->getOp();
+    bool foldable = lhs.constant && rhs.constant;
+
+    Symbolic::Expression* result = integerbinaryoperation;
+    if (lhs.expression != integerbinaryoperation->getLhs() || rhs.expression != integerbinaryoperation->getRhs()) {
+        result = new Symbolic::IntegerBinaryOperation((Symbolic::IntegerExpression*)lhs.expression, op, (Symbolic::IntegerExpression*)rhs.expression);
+    }
+
+    switch (op) {
+    case Symbolic::INT_ADD:
+    case Symbolic::INT_SUBTRACT:
+    case Symbolic::INT_MULTIPLY:
+    case Symbolic::INT_DIVIDE:
+    case Symbolic::INT_MODULO:
+        finish(result, Symbolic::INT, foldable);
+        break;
+    case Symbolic::INT_NEQ:
+    case Symbolic::INT_SNEQ:
+        finishComparison(result, foldable, foldable ? NULL :
+                         new Symbolic::IntegerBinaryOperation((Symbolic::IntegerExpression*)lhs.expression,
+                                                              op == Symbolic::INT_NEQ ? Symbolic::INT_EQ : Symbolic::INT_SEQ,
+                                                              (Symbolic::IntegerExpression*)rhs.expression));
+        break;
+    default:
+        finishComparison(result, foldable, NULL);
+    }
+}
+
+void ExpressionSimplifier::visit(Symbolic::StringBinaryOperation* stringbinaryoperation, void* arg)
+{
+    Rewrite lhs = rewrite(stringbinaryoperation->getLhs());
+    Rewrite rhs = rewrite(stringbinaryoperation->getRhs());
+    Symbolic::StringBinaryOp op = stringbinaryoperation->getOp();
+    bool foldable = lhs.constant && rhs.constant;
+
+    Symbolic::Expression* result = stringbinaryoperation;
+    if (lhs.expression != stringbinaryoperation->getLhs() || rhs.expression != stringbinaryoperation->getRhs()) {
+        result = new Symbolic::StringBinaryOperation((Symbolic::StringExpression*)lhs.expression, op, (Symbolic::StringExpression*)rhs.expression);
+    }
+
+    switch (op) {
+    case Symbolic::CONCAT:
+        finish(result, Symbolic::STRING, foldable);
+        return;
+    case Symbolic::STRING_NEQ:
+    case Symbolic::STRING_SNEQ:
+        finishComparison(result, foldable, foldable ? NULL :
+                         new Symbolic::StringBinaryOperation((Symbolic::StringExpression*)lhs.expression,
+                                                             op == Symbolic::STRING_NEQ ? Symbolic::STRING_EQ : Symbolic::STRING_SEQ,
+                                                             (Symbolic::StringExpression*)rhs.expression));
+        break;
+    case Symbolic::STRING_EQ:
+    case Symbolic::STRING_SEQ:
+        finishComparison(result, foldable, NULL);
+        break;
+    default:
+        finishComparison(result, foldable, NULL);
+        return;
+    }
+
+    // Both operands are strings, so the (in)equality fixes the input if the other operand is a constant.
+    if (!mResult.constant) {
+        if (!lhs.input.isEmpty() && rhs.constant && rhs.type == Symbolic::STRING) {
+            mResult.fixedInput = lhs.input;
+            mResult.fixedValue = QString(((Symbolic::ConstantString*)rhs.expression)->getValue()->c_str());
+        } else if (!rhs.input.isEmpty() && lhs.constant && lhs.type == Symbolic::STRING) {
+            mResult.fixedInput = rhs.input;
+            mResult.fixedValue = QString(((Symbolic::ConstantString*)lhs.expression)->getValue()->c_str());
+        }
+    }
+}
+
+void ExpressionSimplifier::visit(Symbolic::BooleanBinaryOperation* booleanbinaryoperation, void* arg)
+{
+    Rewrite lhs = rewrite(booleanbinaryoperation->getLhs());
+    Rewrite rhs = rewrite(booleanbinaryoperation->getRhs());
+    Symbolic::BooleanBinaryOp op = booleanbinaryoperation->getOp();
+    bool foldable = lhs.constant && rhs.constant;
+    bool negated = op == Symbolic::BOOL_NEQ || op == Symbolic::BOOL_SNEQ;
+
+    Symbolic::Expression* result = booleanbinaryoperation;
+    if (lhs.expression != booleanbinaryoperation->getLhs() || rhs.expression != booleanbinaryoperation->getRhs()) {
+        result = new Symbolic::BooleanBinaryOperation((Symbolic::BooleanExpression*)lhs.expression, op, (Symbolic::BooleanExpression*)rhs.expression);
+    }
+
+    finishComparison(result, foldable, NULL);
+    if (mResult.constant) {
+        return;
+    }
+
+    // A comparison with a boolean constant is equivalent to the other operand, or its negation.
+    const Rewrite* constant = lhs.constant && lhs.type == Symbolic::BOOL ? &lhs : (rhs.constant && rhs.type == Symbolic::BOOL ? &rhs : NULL);
+    const Rewrite* other = constant == &lhs ? &rhs : &lhs;
+
+    if (constant != NULL && other->type == Symbolic::BOOL) {
+        bool value = ((Symbolic::ConstantBoolean*)constant->expression)->getValue();
+
+        mResult.condition = other->condition;
+        mResult.conditionNegated = other->conditionNegated != (value == negated);
+        mResult.fixedInput = other->fixedInput;
+        mResult.fixedValue = other->fixedValue;
+
+    } else if (negated) {
+        mResult.condition = new Symbolic::BooleanBinaryOperation((Symbolic::BooleanExpression*)lhs.expression,
+                                                                 op == Symbolic::BOOL_NEQ ? Symbolic::BOOL_EQ : Symbolic::BOOL_SEQ,
+                                                                 (Symbolic::BooleanExpression*)rhs.expression);
+        mResult.conditionNegated = true;
+    }
+}
+
+void ExpressionSimplifier::visit(Symbolic::ObjectBinaryOperation* obj, void* arg)
+{
+    Rewrite lhs = rewrite(obj->getLhs());
+    Rewrite rhs = rewrite(obj->getRhs());
+    bool foldable = lhs.constant && rhs.constant;
+
+    Symbolic::Expression* result = obj;
+    if (lhs.expression != obj->getLhs() || rhs.expression != obj->getRhs()) {
+        result = new Symbolic::ObjectBinaryOperation((Symbolic::ObjectExpression*)lhs.expression, obj->getOp(), (Symbolic::ObjectExpression*)rhs.expression);
+    }
+
+    finishComparison(result, foldable, foldable || obj->getOp() != Symbolic::OBJ_NEQ ? NULL :
+                     new Symbolic::ObjectBinaryOperation((Symbolic::ObjectExpression*)lhs.expression, Symbolic::OBJ_EQ,
+                                                         (Symbolic::ObjectExpression*)rhs.expression));
+}
+
+/** Coercions **/
+
+void ExpressionSimplifier::visit(Symbolic::IntegerCoercion* integercoercion, void* arg)
+{
+    Rewrite inner = rewrite(integercoercion->getExpression());
+
+    if (inner.type == Symbolic::INT) {
+        mCoercionsRemoved.add(1);
+        mResult = inner;
+        return;
+    }
+
+    finish(inner.expression == integercoercion->getExpression() ? integercoercion : new Symbolic::IntegerCoercion(inner.expression),
+           Symbolic::INT, inner.constant);
+}
+
+void ExpressionSimplifier::visit(Symbolic::StringCoercion* stringcoercion, void* arg)
+{
+    Rewrite inner = rewrite(stringcoercion->getExpression());
+
+    if (inner.type == Symbolic::STRING) {
+        mCoercionsRemoved.add(1);
+        mResult = inner;
+        return;
+    }
+
+    finish(inner.expression == stringcoercion->getExpression() ? stringcoercion : new Symbolic::StringCoercion(inner.expression),
+           Symbolic::STRING, inner.constant);
+}
+
+void ExpressionSimplifier::visit(Symbolic::BooleanCoercion* booleancoercion, void* arg)
+{
+    Rewrite inner = rewrite(booleancoercion->getExpression());
+
+    if (inner.type == Symbolic::BOOL) {
+        mCoercionsRemoved.add(1);
+        mResult = inner;
+        return;
+    }
+
+    finish(inner.expression == booleancoercion->getExpression() ? booleancoercion : new Symbolic::BooleanCoercion(inner.expression),
+           Symbolic::BOOL, inner.constant);
+}
+
+/** String operations **/
+
+void ExpressionSimplifier::visit(Symbolic::StringLength* stringlength, void* arg)
+{
+    Rewrite string = rewrite(stringlength->getString());
+
+    finish(string.expression == stringlength->getString() ? stringlength :
+           new Symbolic::StringLength((Symbolic::StringExpression*)string.expression),
+           Symbolic::INT, string.constant);
+}
+
+void ExpressionSimplifier::visit(Symbolic::StringCharAt* stringcharat, void* arg)
+{
+    Rewrite source = rewrite(stringcharat->getSource());
+
+    finish(source.expression == stringcharat->getSource() ? stringcharat :
+           new Symbolic::StringCharAt((Symbolic::StringExpression*)source.expression, stringcharat->getPosition()),
+           Symbolic::STRING, source.constant);
+}
+
+void ExpressionSimplifier::visit(Symbolic::StringReplace* stringreplace, void* arg)
+{
+    Rewrite source = rewrite(stringreplace->getSource());
+
+    finish(source.expression == stringreplace->getSource() ? stringreplace :
+           new Symbolic::StringReplace((Symbolic::StringExpression*)source.expression, stringreplace->getPattern(), stringreplace->getReplace()),
+           Symbolic::STRING, source.constant);
+}
+
+void ExpressionSimplifier::visit(Symbolic::StringRegexReplace* stringregexreplace, void* arg)
+{
+    Rewrite source = rewrite(stringregexreplace->getSource());
+
+    finish(source.expression == stringregexreplace->getSource() ? stringregexreplace :
+           new Symbolic::StringRegexReplace((Symbolic::StringExpression*)source.expression,
+                                            stringregexreplace->getRegexpattern(), stringregexreplace->getReplace()),
+           Symbolic::STRING, source.constant);
+}
+
+void ExpressionSimplifier::visit(Symbolic::StringRegexSubmatch* submatch, void* arg)
+{
+    Rewrite source = rewrite(submatch->getSource());
+
+    finish(source.expression == submatch->getSource() ? submatch :
+           new Symbolic::StringRegexSubmatch((Symbolic::StringExpression*)source.expression, submatch->getRegexpattern()),
+           Symbolic::BOOL, source.constant);
+}
+
+void ExpressionSimplifier::visit(Symbolic::StringRegexSubmatchIndex* submatchIndex, void* arg)
+{
+    Rewrite source = rewrite(submatchIndex->getSource());
+
+    finish(source.expression == submatchIndex->getSource() ? submatchIndex :
+           new Symbolic::StringRegexSubmatchIndex((Symbolic::StringExpression*)source.expression, submatchIndex->getRegexpattern()),
+           Symbolic::INT, source.constant);
+}
+
+void ExpressionSimplifier::visit(Symbolic::StringRegexSubmatchArray* exp, void* arg)
+{
+    Rewrite source = rewrite(exp->getSource());
+
+    // The array is shared by its uses, which see the same rewritten array as it is memoised. It is never folded itself,
+    // but its uses are if the source is constant.
+    leaf(source.expression == exp->getSource() ? exp :
+         new Symbolic::StringRegexSubmatchArray(exp->getIdentifier(), (Symbolic::StringExpression*)source.expression, exp->getRegexpattern()),
+         Symbolic::TYPEERROR, source.constant);
+}
+
+void ExpressionSimplifier::visit(Symbolic::StringRegexSubmatchArrayAt* exp, void* arg)
+{
+    Rewrite match = rewrite(exp->getMatch());
+
+    finish(match.expression == exp->getMatch() ? exp :
+           new Symbolic::StringRegexSubmatchArrayAt((Symbolic::StringRegexSubmatchArray*)match.expression, exp->getGroup()),
+           Symbolic::STRING, match.constant);
+}
+
+void ExpressionSimplifier::visit(Symbolic::StringRegexSubmatchArrayMatch* exp, void* arg)
+{
+    Rewrite match = rewrite(exp->getMatch());
+
+    finish(match.expression == exp->getMatch() ? exp :
+           new Symbolic::StringRegexSubmatchArrayMatch((Symbolic::StringRegexSubmatchArray*)match.expression),
+           Symbolic::OBJECT, match.constant);
+}
+
+}
+
+#endif
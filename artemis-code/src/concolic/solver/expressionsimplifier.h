@@ -0,0 +1,130 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef EXPRESSIONSIMPLIFIER_H
+#define EXPRESSIONSIMPLIFIER_H
+
+#include <QHash>
+#include <QString>
+
+#include "JavaScriptCore/symbolic/expr.h"
+#include "JavaScriptCore/symbolic/expression/visitor.h"
+
+#include "concolic/pathcondition.h"
+#include "statistics/statsstorage.h"
+
+#include "expressionevaluator.h"
+#include "solution.h"
+
+#ifdef ARTEMIS
+
+namespace artemis
+{
+
+/**
+ *  Rewrites path conditions into smaller equivalent ones before they are given to a solver.
+ *
+ *  Expressions are rewritten bottom up:
+ *      * subexpressions without symbolic inputs are folded into constants (with JavaScript semantics),
+ *      * coercions of expressions which already have the target type are removed.
+ *  Conditions of the PC are then normalised and pruned:
+ *      * negated comparisons (x != y) are asserted as their positive form with the opposite outcome,
+ *      * comparisons with constant booleans (e == true) are asserted as e,
+ *      * constant and duplicate conditions are removed,
+ *      * if an input is fixed by an equality (x == "c"), conditions on only fixed inputs are evaluated and removed.
+ *  A PC containing a condition which is contradicted this way is unsatisfiable.
+ *
+ *  Rewritten expressions are memoised by the original expression. Like the original expressions they are never freed,
+ *  so the simplifier should be kept for the whole run and each expression is rewritten only once.
+ */
+class ExpressionSimplifier : public Symbolic::Visitor
+{
+public:
+    ExpressionSimplifier();
+
+    // Returns the simplified PC, or NULL if pc was found to be unsatisfiable.
+    PathConditionPtr simplify(PathConditionPtr pc);
+
+    Symbolic::Expression* simplify(Symbolic::Expression* expression);
+
+    void visit(Symbolic::ConstantObject* obj, void* arg);
+    void visit(Symbolic::ObjectBinaryOperation* obj, void* arg);
+    void visit(Symbolic::SymbolicInteger* symbolicinteger, void* arg);
+    void visit(Symbolic::ConstantInteger* constantinteger, void* arg);
+    void visit(Symbolic::IntegerBinaryOperation* integerbinaryoperation, void* arg);
+    void visit(Symbolic::IntegerCoercion* integercoercion, void* arg);
+    void visit(Symbolic::SymbolicString* symbolicstring, void* arg);
+    void visit(Symbolic::ConstantString* constantstring, void* arg);
+    void visit(Symbolic::StringBinaryOperation* stringbinaryoperation, void* arg);
+    void visit(Symbolic::StringCoercion* stringcoercion, void* arg);
+    void visit(Symbolic::StringCharAt* stringcharat, void* arg);
+    void visit(Symbolic::StringRegexReplace* stringregexreplace, void* arg);
+    void visit(Symbolic::StringReplace* stringreplace, void* arg);
+    void visit(Symbolic::StringRegexSubmatch* submatch, void* arg);
+    void visit(Symbolic::StringRegexSubmatchIndex* submatchIndex, void* arg);
+    void visit(Symbolic::StringRegexSubmatchArray* exp, void* arg);
+    void visit(Symbolic::StringRegexSubmatchArrayAt* exp, void* arg);
+    void visit(Symbolic::StringRegexSubmatchArrayMatch* exp, void* arg);
+    void visit(Symbolic::SymbolicBoolean* symbolicboolean, void* arg);
+    void visit(Symbolic::ConstantBoolean* constantboolean, void* arg);
+    void visit(Symbolic::BooleanCoercion* booleancoercion, void* arg);
+    void visit(Symbolic::BooleanBinaryOperation* booleanbinaryoperation, void* arg);
+    void visit(Symbolic::StringLength* stringlength, void* arg);
+
+private:
+    struct Rewrite {
+        Symbolic::Expression* expression;
+        Symbolic::Type type; // The JavaScript type of the value, TYPEERROR for a match array.
+        bool constant;
+
+        // As a condition, expression is equivalent to condition, with the opposite outcome if conditionNegated.
+        Symbolic::Expression* condition;
+        bool conditionNegated;
+
+        // Set if expression is a symbolic string input.
+        QString input;
+
+        // Set if condition is of the form input == "value".
+        QString fixedInput;
+        QString fixedValue;
+    };
+
+    Rewrite rewrite(Symbolic::Expression* expression);
+
+    void leaf(Symbolic::Expression* expression, Symbolic::Type type, bool constant);
+    void finish(Symbolic::Expression* expression, Symbolic::Type type, bool foldable);
+    void finishComparison(Symbolic::Expression* expression, bool foldable, Symbolic::Expression* negation);
+
+    static Symbolic::Expression* createConstant(const ConcreteValue& value);
+
+    QHash<Symbolic::Expression*, Rewrite> mRewrites;
+    Rewrite mResult;
+
+    const QHash<QString, Symbolvalue> mNoInputs;
+
+    StatsCounter mConditionsIn;
+    StatsCounter mConditionsOut;
+    StatsCounter mFolded;
+    StatsCounter mCoercionsRemoved;
+    StatsCounter mDuplicatesRemoved;
+    StatsCounter mImpliedRemoved;
+    StatsCounter mUnsat;
+};
+
+}
+
+#endif
+#endif // EXPRESSIONSIMPLIFIER_H
@@ -32,11 +32,16 @@
 namespace artemis
 {
 
-KaluzaSolver::KaluzaSolver(): Solver() {
+KaluzaSolver::KaluzaSolver(): ProcessSolver() {
 
 }
 
-SolutionPtr KaluzaSolver::solve(PathConditionPtr pc)
+QString KaluzaSolver::getName() const
+{
+    return "Kaluza";
+}
+
+SolutionPtr KaluzaSolver::prepare(PathConditionPtr pc, SolverProcess* process, QString& program, QStringList& arguments)
 {
 
     // 1. translate pc to something solvable using the translator
@@ -67,9 +72,17 @@ SolutionPtr KaluzaSolver::solve(PathConditionPtr pc)
         return SolutionPtr(new Solution(false, false));
     }
 
-    int result = std::system(solverpath.filePath("artemiskaluza.sh").toStdString().data());
+    program = solverpath.filePath("artemiskaluza.sh");
+
+    // The script writes its result to /tmp/kaluza-result and its output is only informative.
+    process->setProcessChannelMode(QProcess::ForwardedChannels);
 
-    if (result != 0) {
+    return SolutionPtr();
+}
+
+SolutionPtr KaluzaSolver::interpret(int exitCode)
+{
+    if (exitCode != 0) {
         statistics()->accumulate("Concolic::Solver::ConstraintsNotSolved", 1);
         return SolutionPtr(new Solution(false, false));
     }
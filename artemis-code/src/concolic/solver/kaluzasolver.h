@@ -17,18 +17,20 @@
 #ifndef KALUZASOLVER_H
 #define KALUZASOLVER_H
 
-#include "solver.h"
+#include "processsolver.h"
 
 namespace artemis
 {
 
-class KaluzaSolver : public Solver
+class KaluzaSolver : public ProcessSolver
 {
 public:
 
     KaluzaSolver();
 
-    SolutionPtr solve(PathConditionPtr pc);
+    QString getName() const;
+    SolutionPtr prepare(PathConditionPtr pc, SolverProcess* process, QString& program, QStringList& arguments);
+    SolutionPtr interpret(int exitCode);
 
 };
 
@@ -0,0 +1,367 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cmath>
+
+#include <QSet>
+
+#include "expressionevaluator.h"
+#include "expressionprinter.h"
+
+#include "localsearchsolver.h"
+
+namespace artemis
+{
+
+/*
+ *  Collects the string and number constants of an expression, which are the most likely values to satisfy it.
+ *  The printer is only used for its traversal of the expression.
+ */
+class ConstantCollector : public ExpressionPrinter
+{
+public:
+    void visit(Symbolic::ConstantString* constantstring, void* arg)
+    {
+        mConstants.insert(QString(constantstring->getValue()->c_str()));
+    }
+
+    void visit(Symbolic::ConstantInteger* constantinteger, void* arg)
+    {
+        double value = constantinteger->getValue();
+
+        mConstants.insert(ConcreteValue::numberToString(value));
+        mConstants.insert(ConcreteValue::numberToString(value + 1));
+        mConstants.insert(ConcreteValue::numberToString(value - 1));
+
+        // Strings of around this length, for conditions on the length of an input.
+        if (value >= 0 && value <= MAX_LENGTH && std::floor(value) == value) {
+            mConstants.insert(QString((int)value, 'a'));
+            mConstants.insert(QString((int)value + 1, 'a'));
+        }
+    }
+
+    using ExpressionPrinter::visit;
+
+    QSet<QString> mConstants;
+
+    static const int MAX_LENGTH = 64;
+};
+
+/*
+ *  Collects the type of each free variable from the symbolic leaves of an expression. The form inputs are injected
+ *  according to their type (e.g. checkboxes are only checked or unchecked), so each variable is searched in its own
+ *  domain. A variable used with more than one type is marked as conflicting.
+ */
+class VariableKindCollector : public ExpressionPrinter
+{
+public:
+    VariableKindCollector()
+        : mConflicting(false)
+    {
+    }
+
+    void visit(Symbolic::SymbolicInteger* symbolicinteger, void* arg)
+    {
+        record(symbolicinteger->getSource().getIdentifier(), Symbolic::INT);
+    }
+
+    void visit(Symbolic::SymbolicString* symbolicstring, void* arg)
+    {
+        record(symbolicstring->getSource().getIdentifier(), Symbolic::STRING);
+    }
+
+    void visit(Symbolic::SymbolicBoolean* symbolicboolean, void* arg)
+    {
+        record(symbolicboolean->getSource().getIdentifier(), Symbolic::BOOL);
+    }
+
+    using ExpressionPrinter::visit;
+
+    QHash<QString, Symbolic::Type> mKinds;
+    bool mConflicting;
+
+private:
+    void record(const std::string& identifier, Symbolic::Type kind)
+    {
+        QString variable = QString(identifier.c_str());
+
+        if (mKinds.contains(variable) && mKinds.value(variable) != kind) {
+            mConflicting = true;
+        }
+        mKinds.insert(variable, kind);
+    }
+};
+
+LocalSearchSolver::LocalSearchSolver(SolverPtr solver, int budget)
+    : Solver()
+    , mSolver(solver)
+    , mBudget(budget)
+{
+    mQueries = statistics()->counter("Concolic::Solver::LocalSearch::Queries");
+    mSolved = statistics()->counter("Concolic::Solver::LocalSearch::Solved");
+    mEvaluations = statistics()->counter("Concolic::Solver::LocalSearch::Evaluations");
+}
+
+SolutionPtr LocalSearchSolver::solve(PathConditionPtr pc)
+{
+    QStringList variables = pc->freeVariables().keys();
+
+    if (mBudget > 0 && !variables.isEmpty()) {
+        mQueries.add(1);
+
+        ConstantCollector collector;
+        VariableKindCollector kinds;
+        for (uint i = 0; i < pc->size(); i++) {
+            pc->get(i).first->accept(&collector);
+            pc->get(i).first->accept(&kinds);
+        }
+        QStringList constants = collector.mConstants.toList();
+        constants.sort();
+
+        if (kinds.mConflicting) {
+            mSolver->setTimeout(mTimeout);
+            return mSolver->solve(pc);
+        }
+
+        QList<Assignment> seeds;
+        seeds.append(Assignment());
+        seeds.append(mSeeds);
+
+        int evaluations = 0;
+
+        foreach (Assignment seed, seeds) {
+            Assignment start;
+            foreach (QString variable, variables) {
+                Symbolic::Type kind = kinds.mKinds.value(variable, Symbolic::STRING);
+
+                if (seed.contains(variable) && seed.value(variable).kind == kind) {
+                    start.insert(variable, seed.value(variable));
+                } else {
+                    start.insert(variable, initialValue(kind));
+                }
+            }
+
+            SolutionPtr solution = search(pc, variables, constants, start, evaluations);
+
+            if (!solution.isNull()) {
+                mEvaluations.add(evaluations);
+                mSolved.add(1);
+                return solution;
+            }
+
+            if (evaluations >= mBudget) {
+                break;
+            }
+        }
+
+        mEvaluations.add(evaluations);
+    }
+
+    mSolver->setTimeout(mTimeout);
+    return mSolver->solve(pc);
+}
+
+SolutionPtr LocalSearchSolver::search(PathConditionPtr pc, const QStringList& variables, const QStringList& constants, Assignment current, int& evaluations)
+{
+    uint currentScore = score(pc, current);
+    evaluations++;
+
+    while (currentScore < pc->size() && evaluations < mBudget) {
+        Assignment best = current;
+        uint bestScore = currentScore;
+
+        foreach (QString variable, variables) {
+            foreach (Symbolvalue candidate, mutate(current.value(variable), constants)) {
+                if (evaluations >= mBudget || bestScore == pc->size()) {
+                    break;
+                }
+
+                Assignment next = current;
+                next.insert(variable, candidate);
+
+                uint nextScore = score(pc, next);
+                evaluations++;
+
+                if (nextScore > bestScore) {
+                    best = next;
+                    bestScore = nextScore;
+                }
+            }
+        }
+
+        if (bestScore == currentScore) {
+            return SolutionPtr(); // A local maximum.
+        }
+
+        current = best;
+        currentScore = bestScore;
+    }
+
+    if (currentScore < pc->size()) {
+        return SolutionPtr();
+    }
+
+    SolutionPtr solution = SolutionPtr(new Solution(true, false));
+    foreach (QString variable, variables) {
+        solution->insertSymbol(variable, current.value(variable));
+    }
+    return solution;
+}
+
+uint LocalSearchSolver::score(PathConditionPtr pc, const Assignment& assignment)
+{
+    ExpressionEvaluator evaluator(assignment);
+    uint satisfied = 0;
+
+    for (uint i = 0; i < pc->size(); i++) {
+        ConcreteValue value = evaluator.evaluate(pc->get(i).first);
+
+        if (value.isKnown() && value.toBoolean() == pc->get(i).second) {
+            satisfied++;
+        }
+    }
+
+    return satisfied;
+}
+
+QList<Symbolvalue> LocalSearchSolver::mutate(const Symbolvalue& value, const QStringList& constants)
+{
+    QList<Symbolvalue> candidates;
+
+    switch (value.kind) {
+    case Symbolic::BOOL:
+        candidates.append(boolValue(!value.u.boolean));
+        break;
+
+    case Symbolic::INT: {
+        // Integer inputs (e.g. the selected index of a select box) take the integral constants of the PC.
+        QList<int> integers;
+        foreach (QString constant, constants) {
+            bool ok;
+            int integer = constant.toInt(&ok);
+            if (ok) {
+                integers.append(integer);
+            }
+        }
+        integers.append(0);
+        integers.append(value.u.integer + 1);
+        integers.append(value.u.integer - 1);
+
+        QSet<int> seen;
+        seen.insert(value.u.integer);
+        foreach (int integer, integers) {
+            if (!seen.contains(integer)) {
+                seen.insert(integer);
+                candidates.append(intValue(integer));
+            }
+        }
+        break;
+    }
+
+    default:
+        foreach (QString candidate, mutateString(QString(value.string.c_str()), constants)) {
+            candidates.append(stringValue(candidate));
+        }
+    }
+
+    return candidates;
+}
+
+QStringList LocalSearchSolver::mutateString(const QString& value, const QStringList& constants)
+{
+    QStringList candidates;
+
+    candidates.append(constants);
+    candidates.append("");
+
+    foreach (QString constant, constants) {
+        if (!value.isEmpty() && !constant.isEmpty()) {
+            candidates.append(value + constant);
+            candidates.append(constant + value);
+        }
+    }
+
+    // Single character edits.
+    for (int i = 0; i < value.length() && i < 16; i++) {
+        candidates.append(QString(value).remove(i, 1));
+    }
+    candidates.append(value + "a");
+    candidates.append(value + "0");
+
+    candidates.removeDuplicates();
+    candidates.removeAll(value);
+
+    return candidates;
+}
+
+void LocalSearchSolver::addSeed(SolutionPtr solution)
+{
+    Assignment seed;
+
+    QHash<QString, Symbolvalue>::const_iterator iter = solution->getSymbols().begin();
+    for (; iter != solution->getSymbols().end(); iter++) {
+        if (iter.value().kind == Symbolic::STRING || iter.value().kind == Symbolic::BOOL ||
+                iter.value().kind == Symbolic::INT) {
+            seed.insert(iter.key(), iter.value());
+        }
+    }
+
+    mSeeds.prepend(seed);
+    while (mSeeds.size() > MAX_SEEDS) {
+        mSeeds.removeLast();
+    }
+}
+
+Symbolvalue LocalSearchSolver::stringValue(const QString& value)
+{
+    Symbolvalue result;
+    result.found = true;
+    result.kind = Symbolic::STRING;
+    result.string = value.toStdString();
+    return result;
+}
+
+Symbolvalue LocalSearchSolver::boolValue(bool value)
+{
+    Symbolvalue result;
+    result.found = true;
+    result.kind = Symbolic::BOOL;
+    result.u.boolean = value;
+    return result;
+}
+
+Symbolvalue LocalSearchSolver::intValue(int value)
+{
+    Symbolvalue result;
+    result.found = true;
+    result.kind = Symbolic::INT;
+    result.u.integer = value;
+    return result;
+}
+
+Symbolvalue LocalSearchSolver::initialValue(Symbolic::Type kind)
+{
+    switch (kind) {
+    case Symbolic::BOOL:
+        return boolValue(false);
+    case Symbolic::INT:
+        return intValue(0);
+    default:
+        return stringValue("");
+    }
+}
+
+}
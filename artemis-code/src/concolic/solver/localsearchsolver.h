@@ -0,0 +1,85 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef LOCALSEARCHSOLVER_H
+#define LOCALSEARCHSOLVER_H
+
+#include <QHash>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+#include "statistics/statsstorage.h"
+
+#include "solver.h"
+
+namespace artemis
+{
+
+/*
+ *  A "mutate and check" pre-solver in front of another solver.
+ *
+ *  Starting from the empty input and the most recently injected inputs, the free variables of the PC are mutated with
+ *  the constants of the PC and single character edits, and each candidate is checked concretely with the
+ *  ExpressionEvaluator. The search greedily climbs on the number of satisfied conditions. If no candidate satisfies the
+ *  whole PC within the evaluation budget, the PC is forwarded to the backend.
+ *
+ *  Each free variable is mutated in the domain of its type in the PC: strings, booleans (checkboxes) or integers
+ *  (select box indices). PCs using a variable with more than one type are forwarded to the backend directly.
+ */
+
+class LocalSearchSolver : public Solver
+{
+public:
+
+    LocalSearchSolver(SolverPtr solver, int budget = DEFAULT_BUDGET);
+
+    SolutionPtr solve(PathConditionPtr pc);
+
+    // Records an injected solution as a starting point for later searches.
+    void addSeed(SolutionPtr solution);
+
+    static const int DEFAULT_BUDGET = 500;
+
+private:
+    typedef QHash<QString, Symbolvalue> Assignment;
+
+    SolutionPtr search(PathConditionPtr pc, const QStringList& variables, const QStringList& constants, Assignment current, int& evaluations);
+    uint score(PathConditionPtr pc, const Assignment& assignment);
+    QList<Symbolvalue> mutate(const Symbolvalue& value, const QStringList& constants);
+    QStringList mutateString(const QString& value, const QStringList& constants);
+
+    static Symbolvalue stringValue(const QString& value);
+    static Symbolvalue boolValue(bool value);
+    static Symbolvalue intValue(int value);
+    static Symbolvalue initialValue(Symbolic::Type kind);
+
+    SolverPtr mSolver;
+    int mBudget;
+
+    QList<Assignment> mSeeds; // Newest first.
+    static const int MAX_SEEDS = 4;
+
+    StatsCounter mQueries;
+    StatsCounter mSolved;
+    StatsCounter mEvaluations;
+};
+
+typedef QSharedPointer<LocalSearchSolver> LocalSearchSolverPtr;
+
+}
+
+#endif // LOCALSEARCHSOLVER_H
@@ -0,0 +1,228 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <assert.h>
+
+#include <QElapsedTimer>
+
+#include "portfoliosolver.h"
+
+namespace artemis
+{
+
+PortfolioSolver::PortfolioSolver(const QList<ProcessSolverPtr>& solvers)
+    : Solver()
+    , mSolvers(solvers)
+{
+    assert(!solvers.isEmpty());
+
+    foreach (ProcessSolverPtr solver, mSolvers) {
+        QString prefix = "Concolic::Solver::Portfolio::" + solver->getName() + "::";
+
+        BackendStatistics stats;
+        stats.runs = statistics()->counter(prefix + "Runs");
+        stats.wins = statistics()->counter(prefix + "Wins");
+        stats.failures = statistics()->counter(prefix + "Failures");
+        stats.killed = statistics()->counter(prefix + "Killed");
+        stats.totalLatency = statistics()->counter(prefix + "TotalLatencyMs");
+        mStatistics.append(stats);
+    }
+
+    mOutcomeCounters.append(statistics()->counter("Concolic::Solver::ConstraintsWritten"));
+    mOutcomeCounters.append(statistics()->counter("Concolic::Solver::ConstraintsNotWritten"));
+    mOutcomeCounters.append(statistics()->counter("Concolic::Solver::ConstraintsSolved"));
+    mOutcomeCounters.append(statistics()->counter("Concolic::Solver::ConstraintsSolvedAsUNSAT"));
+    mOutcomeCounters.append(statistics()->counter("Concolic::Solver::ConstraintsNotSolved"));
+}
+
+SolutionPtr PortfolioSolver::solve(PathConditionPtr pc)
+{
+    statistics()->accumulate("Concolic::Solver::Portfolio::Queries", 1);
+
+    // The backends are prepared one at a time, as they share the constraint log, and then all run at once.
+    // processes[i] is the running process of backend i, or NULL once it has finished or could not be started.
+    QList<SolverProcess*> processes;
+    SolutionPtr firstFailure;
+    int firstFailureBackend = -1;
+    int running = 0;
+
+    // outcomes[i] holds the outcome counter updates made by backend i, see takeOutcomes.
+    QList<QList<int> > outcomes;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int i = 0; i < mSolvers.size(); i++) {
+        SolverProcess* process = new SolverProcess();
+        QString program;
+        QStringList arguments;
+
+        mStatistics[i].runs.add(1);
+
+        QList<int> before = outcomeValues();
+        SolutionPtr failure = mSolvers.at(i)->prepare(pc, process, program, arguments);
+        outcomes.append(QList<int>());
+        takeOutcomes(before, outcomes[i]);
+
+        if (failure.isNull()) {
+            process->start(program, arguments);
+
+            if (!process->waitForStarted()) {
+                failure = SolutionPtr(new Solution(false, false, QString("Could not start %1: %2").arg(mSolvers.at(i)->getName()).arg(process->errorString())));
+            }
+        }
+
+        if (!failure.isNull()) {
+            delete process;
+            process = NULL;
+
+            recordFinished(i, false, timer.elapsed());
+            if (firstFailure.isNull()) {
+                firstFailure = failure;
+                firstFailureBackend = i;
+            }
+        } else {
+            running++;
+        }
+
+        processes.append(process);
+    }
+
+    SolutionPtr result;
+    int resultBackend = -1;
+
+    while (running > 0 && result.isNull() && (mTimeout == 0 || timer.elapsed() < mTimeout)) {
+        for (int i = 0; i < processes.size() && result.isNull(); i++) {
+            SolverProcess* process = processes.at(i);
+
+            if (process == NULL || !process->waitForFinished(POLL_INTERVAL)) {
+                continue;
+            }
+
+            processes[i] = NULL;
+            running--;
+
+            SolutionPtr solution;
+            if (process->exitStatus() == QProcess::NormalExit) {
+                QList<int> before = outcomeValues();
+                solution = mSolvers.at(i)->interpret(process->exitCode());
+                takeOutcomes(before, outcomes[i]);
+            } else {
+                solution = SolutionPtr(new Solution(false, false, QString("%1 crashed").arg(mSolvers.at(i)->getName())));
+            }
+
+            delete process;
+
+            bool decided = solution->isSolved() || solution->isUnsat();
+            recordFinished(i, decided, timer.elapsed());
+
+            if (decided) {
+                result = solution;
+                resultBackend = i;
+            } else if (firstFailure.isNull()) {
+                firstFailure = solution;
+                firstFailureBackend = i;
+            }
+        }
+    }
+
+    // A backend still running when the budget ran out might have decided the PC given more time.
+    if (result.isNull() && running > 0) {
+        for (int i = 0; i < processes.size() && resultBackend < 0; i++) {
+            if (processes.at(i) != NULL) {
+                resultBackend = i;
+            }
+        }
+
+        statistics()->accumulate("Concolic::Solver::ConstraintsTimedOut", 1);
+        result = SolutionPtr(new Solution(false, false, QString("No solver decided the constraints within %1 ms").arg(mTimeout), true));
+    }
+
+    // Kill the backends which lost the race or ran out of time, and update the win rates.
+    for (int i = 0; i < processes.size(); i++) {
+        SolverProcess* process = processes.at(i);
+
+        if (process != NULL) {
+            process->killGroup();
+            process->waitForFinished(-1);
+            delete process;
+
+            mStatistics[i].killed.add(1);
+        }
+
+        QString prefix = "Concolic::Solver::Portfolio::" + mSolvers.at(i)->getName() + "::";
+        statistics()->set(prefix + "WinRatePercent", mStatistics.at(i).wins.value() * 100 / mStatistics.at(i).runs.value());
+    }
+
+    if (result.isNull()) {
+        resultBackend = firstFailureBackend;
+    }
+
+    if (resultBackend >= 0) {
+        accountOutcomes(outcomes.at(resultBackend));
+    }
+
+    return result.isNull() ? firstFailure : result;
+}
+
+QList<int> PortfolioSolver::outcomeValues() const
+{
+    QList<int> values;
+    foreach (const StatsCounter& counter, mOutcomeCounters) {
+        values.append(counter.value());
+    }
+    return values;
+}
+
+/*
+ * Moves the outcome counter updates made since before was taken from the global counters to taken.
+ */
+void PortfolioSolver::takeOutcomes(const QList<int>& before, QList<int>& taken)
+{
+    if (taken.isEmpty()) {
+        for (int i = 0; i < mOutcomeCounters.size(); i++) {
+            taken.append(0);
+        }
+    }
+
+    for (int i = 0; i < mOutcomeCounters.size(); i++) {
+        int delta = mOutcomeCounters.at(i).value() - before.at(i);
+        mOutcomeCounters[i].add(-delta);
+        taken[i] += delta;
+    }
+}
+
+void PortfolioSolver::accountOutcomes(const QList<int>& taken)
+{
+    for (int i = 0; i < mOutcomeCounters.size(); i++) {
+        mOutcomeCounters[i].add(taken.at(i));
+    }
+}
+
+void PortfolioSolver::recordFinished(int backend, bool won, qint64 latency)
+{
+    BackendStatistics& stats = mStatistics[backend];
+
+    if (won) {
+        stats.wins.add(1);
+    } else {
+        stats.failures.add(1);
+    }
+
+    stats.totalLatency.add((int)latency);
+}
+
+} // namespace artemis
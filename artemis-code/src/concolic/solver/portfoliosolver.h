@@ -0,0 +1,79 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PORTFOLIOSOLVER_H
+#define PORTFOLIOSOLVER_H
+
+#include <QList>
+
+#include "statistics/statsstorage.h"
+
+#include "processsolver.h"
+
+namespace artemis
+{
+
+/*
+ *  Runs several solver backends concurrently on the same PC.
+ *
+ *  The first backend to decide the PC as SAT or UNSAT wins, and the backends still running are killed. If no backend
+ *  decides the PC within the time budget, a timeout is returned while any backend is still running, and otherwise the
+ *  error from the first backend to fail.
+ *
+ *  Per-backend runs, wins, failures, kills and win rates are recorded under Concolic::Solver::Portfolio::<backend>, along
+ *  with the total latency of the runs which finished, so queries can later be routed to the backend likely to win.
+ *  The global solver statistics (constraints written, solved, ...) only count the backend whose result is returned.
+ */
+
+class PortfolioSolver : public Solver
+{
+public:
+
+    PortfolioSolver(const QList<ProcessSolverPtr>& solvers);
+
+    SolutionPtr solve(PathConditionPtr pc);
+
+private:
+    struct BackendStatistics {
+        StatsCounter runs;
+        StatsCounter wins;
+        StatsCounter failures;
+        StatsCounter killed;
+        StatsCounter totalLatency;
+    };
+
+    void recordFinished(int backend, bool won, qint64 latency);
+
+    // The backends update the global Concolic::Solver::* outcome counters themselves. While racing, their updates are
+    // taken back out of the counters and kept per backend, so only the backend whose result is returned is counted.
+    QList<int> outcomeValues() const;
+    void takeOutcomes(const QList<int>& before, QList<int>& taken);
+    void accountOutcomes(const QList<int>& taken);
+
+    QList<StatsCounter> mOutcomeCounters;
+
+    QList<ProcessSolverPtr> mSolvers;
+    QList<BackendStatistics> mStatistics;
+
+    // How long to wait on one running backend before checking the next, in milliseconds.
+    static const int POLL_INTERVAL = 5;
+};
+
+typedef QSharedPointer<PortfolioSolver> PortfolioSolverPtr;
+
+}
+
+#endif // PORTFOLIOSOLVER_H
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <signal.h>
+#include <unistd.h>
+
+#include "statistics/statsstorage.h"
+
+#include "processsolver.h"
+
+namespace artemis
+{
+
+SolverProcess::SolverProcess()
+    : QProcess()
+{
+}
+
+void SolverProcess::setupChildProcess()
+{
+    setpgid(0, 0);
+}
+
+void SolverProcess::killGroup()
+{
+    if (state() != QProcess::NotRunning) {
+        ::kill(-pid(), SIGKILL);
+    }
+}
+
+ProcessSolver::ProcessSolver()
+    : Solver()
+{
+}
+
+SolutionPtr ProcessSolver::solve(PathConditionPtr pc)
+{
+    SolverProcess process;
+    QString program;
+    QStringList arguments;
+
+    SolutionPtr error = prepare(pc, &process, program, arguments);
+    if (!error.isNull()) {
+        return error;
+    }
+
+    process.start(program, arguments);
+
+    if (!process.waitForFinished(mTimeout > 0 ? (int)mTimeout : -1) && process.state() != QProcess::NotRunning) {
+        process.killGroup();
+        process.waitForFinished(-1);
+
+        statistics()->accumulate("Concolic::Solver::ConstraintsTimedOut", 1);
+        return SolutionPtr(new Solution(false, false, QString("%1 timed out after %2 ms").arg(getName()).arg(mTimeout), true));
+    }
+
+    if (process.exitStatus() != QProcess::NormalExit || process.error() == QProcess::FailedToStart) {
+        statistics()->accumulate("Concolic::Solver::ConstraintsNotSolved", 1);
+        return SolutionPtr(new Solution(false, false, QString("Could not run %1: %2").arg(getName()).arg(process.errorString())));
+    }
+
+    return interpret(process.exitCode());
+}
+
+} // namespace artemis
@@ -0,0 +1,77 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PROCESSSOLVER_H
+#define PROCESSSOLVER_H
+
+#include <QProcess>
+#include <QString>
+#include <QStringList>
+
+#include "solver.h"
+
+namespace artemis
+{
+
+/*
+ *  A process running an external solver.
+ *
+ *  The solver is started in its own process group, so killing it also kills any processes it started itself
+ *  (Z3-str.py runs Z3 as a child process).
+ */
+
+class SolverProcess : public QProcess
+{
+public:
+    SolverProcess();
+
+    void killGroup();
+
+protected:
+    void setupChildProcess();
+};
+
+/*
+ *  A solver backend which solves a PC by running an external solver process.
+ *
+ *  solve() is split into writing the solver input, running the process and reading its result, so that the
+ *  PortfolioSolver can run several backends at once. Backends must therefore use their own input and result files.
+ */
+
+class ProcessSolver : public Solver
+{
+public:
+
+    ProcessSolver();
+
+    SolutionPtr solve(PathConditionPtr pc);
+
+    virtual QString getName() const = 0;
+
+    // Writes the solver input for pc and sets up the program, arguments and output files of the solver process.
+    // Returns a failed solution if the solver can not be run, and NULL otherwise.
+    virtual SolutionPtr prepare(PathConditionPtr pc, SolverProcess* process, QString& program, QStringList& arguments) = 0;
+
+    // Reads the result of a process set up by prepare() which has exited normally.
+    virtual SolutionPtr interpret(int exitCode) = 0;
+
+};
+
+typedef QSharedPointer<ProcessSolver> ProcessSolverPtr;
+
+}
+
+#endif // PROCESSSOLVER_H
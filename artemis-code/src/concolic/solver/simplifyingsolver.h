@@ -0,0 +1,50 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SIMPLIFYINGSOLVER_H
+#define SIMPLIFYINGSOLVER_H
+
+#include "expressionsimplifier.h"
+#include "solver.h"
+
+namespace artemis
+{
+
+/*
+ *  Simplifies each PC with the ExpressionSimplifier before it is given to another solver.
+ *
+ *  PCs found to be unsatisfiable while simplifying are answered directly.
+ */
+
+class SimplifyingSolver : public Solver
+{
+public:
+
+    SimplifyingSolver(SolverPtr solver);
+
+    SolutionPtr solve(PathConditionPtr pc);
+
+private:
+    SolverPtr mSolver;
+
+#ifdef ARTEMIS
+    ExpressionSimplifier mSimplifier;
+#endif
+};
+
+}
+
+#endif // SIMPLIFYINGSOLVER_H
@@ -25,9 +25,10 @@
 namespace artemis
 {
 
-Solution::Solution(bool success, bool unsat, QString unsolvableReason) :
+Solution::Solution(bool success, bool unsat, QString unsolvableReason, bool timeout) :
     mSuccess(success),
     mUnsat(unsat),
+    mTimeout(timeout),
     mUnsolvableReason(unsolvableReason)
 {
 }
@@ -42,6 +43,11 @@ bool Solution::isUnsat() const
     return mUnsat;
 }
 
+bool Solution::isTimeout() const
+{
+    return mTimeout;
+}
+
 void Solution::insertSymbol(QString symbol, Symbolvalue value)
 {
     mSymbols.insert(symbol, value);
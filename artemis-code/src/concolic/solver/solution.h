@@ -44,13 +44,20 @@ class Solution
 {
 
 public:
-    Solution(bool success, bool unsat, QString unsolvableReason = "");
+    Solution(bool success, bool unsat, QString unsolvableReason = "", bool timeout = false);
 
     bool isSolved() const;
     bool isUnsat() const;
+
+    // The solver gave up when its time budget ran out, so the PC may still be solvable with a larger budget.
+    bool isTimeout() const;
     void insertSymbol(QString symbol, Symbolvalue value);
     Symbolvalue findSymbol(QString symbol);
 
+    inline const QHash<QString, Symbolvalue>& getSymbols() const {
+        return mSymbols;
+    }
+
     void toStatistics();
 
     QString getUnsolvableReason() { return mUnsolvableReason; }
@@ -58,6 +65,7 @@ public:
 private:
     bool mSuccess;
     bool mUnsat;
+    bool mTimeout;
     QHash<QString, Symbolvalue> mSymbols;
     QString mUnsolvableReason; // Should be set whenever !mSuccess && !mUnsat.
 };
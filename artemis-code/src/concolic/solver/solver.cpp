@@ -20,7 +20,18 @@ namespace artemis
 {
 
 Solver::Solver()
+    : mTimeout(0)
 {
 }
 
+void Solver::setTimeout(uint timeout)
+{
+    mTimeout = timeout;
+}
+
+uint Solver::getTimeout() const
+{
+    return mTimeout;
+}
+
 } // namespace artemis
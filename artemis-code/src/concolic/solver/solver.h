@@ -39,6 +39,14 @@ public:
 
     virtual SolutionPtr solve(PathConditionPtr pc) = 0;
 
+    // The time budget of a single query in milliseconds, or 0 for no limit.
+    // A query which runs out of time is stopped and returns a timeout solution.
+    void setTimeout(uint timeout);
+    uint getTimeout() const;
+
+protected:
+    uint mTimeout;
+
 };
 
 typedef QSharedPointer<Solver> SolverPtr;
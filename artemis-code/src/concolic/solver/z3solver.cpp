@@ -33,11 +33,16 @@
 namespace artemis
 {
 
-Z3Solver::Z3Solver(): Solver() {
+Z3Solver::Z3Solver(): ProcessSolver() {
 
 }
 
-SolutionPtr Z3Solver::solve(PathConditionPtr pc)
+QString Z3Solver::getName() const
+{
+    return "Z3-str";
+}
+
+SolutionPtr Z3Solver::prepare(PathConditionPtr pc, SolverProcess* process, QString& program, QStringList& arguments)
 {
     std::ofstream constraintLog("/tmp/constraintlog", std::ofstream::out | std::ofstream::app);
 
@@ -74,16 +79,20 @@ SolutionPtr Z3Solver::solve(PathConditionPtr pc)
         return SolutionPtr(new Solution(false, false, "Could not find Z3-str.py."));
     }
 
-    std::string cmd = solverpath.filePath("Z3-str.py").toStdString() + " /tmp/z3input > /tmp/z3result";
-    int result = std::system(cmd.data());
+    program = solverpath.filePath("Z3-str.py");
+    arguments << "/tmp/z3input";
 
-    if (result != 0) {
-        QString error;
-        if(result == -1){
-            error = QString("Call to std::system(Z3-str.py) failed with error %1: %2").arg(errno).arg(strerror(errno));
-        }else{
-            error = QString("Call to Z3-str.py returned code %1").arg(result);
-        }
+    process->setStandardOutputFile("/tmp/z3result");
+
+    return SolutionPtr();
+}
+
+SolutionPtr Z3Solver::interpret(int exitCode)
+{
+    std::ofstream constraintLog("/tmp/constraintlog", std::ofstream::out | std::ofstream::app);
+
+    if (exitCode != 0) {
+        QString error = QString("Call to Z3-str.py returned code %1").arg(exitCode);
         constraintLog << error.toStdString() << std::endl << std::endl;
         statistics()->accumulate("Concolic::Solver::ConstraintsNotSolved", 1);
         return SolutionPtr(new Solution(false, false, error));
@@ -100,18 +109,26 @@ SolutionPtr Z3Solver::solve(PathConditionPtr pc)
     std::ifstream fp("/tmp/z3result");
 
     if (fp.is_open()) {
-        statistics()->accumulate("Concolic::Solver::ConstraintsSolved", 1);
-
         std::getline(fp, line); // discard decoractive line
         std::getline(fp, line); // load sat line
 
-        if (line.compare(">> SAT") != 0) {
-            // UNSAT
+        if (line.compare(">> UNSAT") == 0) {
+            statistics()->accumulate("Concolic::Solver::ConstraintsSolved", 1);
             statistics()->accumulate("Concolic::Solver::ConstraintsSolvedAsUNSAT", 1);
             constraintLog << "Solved as UNSAT." << std::endl << std::endl;
             return SolutionPtr(new Solution(false, true));
         }
 
+        // Anything else (an error, "unknown" or a truncated file) decides nothing, so it must not prune the branch.
+        if (line.compare(">> SAT") != 0) {
+            QString error = QString("Z3-str did not decide the constraints: %1").arg(line.c_str());
+            statistics()->accumulate("Concolic::Solver::ConstraintsNotSolved", 1);
+            constraintLog << error.toStdString() << std::endl << std::endl;
+            return SolutionPtr(new Solution(false, false, error));
+        }
+
+        statistics()->accumulate("Concolic::Solver::ConstraintsSolved", 1);
+
         std::getline(fp, line); // discard decoractive line
 
         constraintLog << "Solved as:\n";
@@ -17,7 +17,7 @@
 #ifndef Z3SOLVER_H
 #define Z3SOLVER_H
 
-#include "solver.h"
+#include "processsolver.h"
 
 namespace artemis
 {
@@ -26,13 +26,15 @@ namespace artemis
  *  Generic symbolic constrint solver interface.
  */
 
-class Z3Solver : public Solver
+class Z3Solver : public ProcessSolver
 {
 public:
 
     Z3Solver();
 
-    SolutionPtr solve(PathConditionPtr pc);
+    QString getName() const;
+    SolutionPtr prepare(PathConditionPtr pc, SolverProcess* process, QString& program, QStringList& arguments);
+    SolutionPtr interpret(int exitCode);
 
 };
 
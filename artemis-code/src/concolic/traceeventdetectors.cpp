@@ -73,10 +73,13 @@ void TraceBranchDetector::slBranch(bool jump, Symbolic::Expression* condition, u
     // This is a slight hack as we count nodes multiple times here (on different runs) but then we decrement the
     // counter again for any duplicate nodes when the trace is merged into the tree.
     if(mTraceBuilder->isRecording()) {
+        static StatsCounter concreteBranches = statistics()->counter("Concolic::ExecutionTree::ConcreteBranchesTotal");
+        static StatsCounter symbolicBranches = statistics()->counter("Concolic::ExecutionTree::SymbolicBranchesTotal");
+
         if(condition == NULL) {
-            statistics()->accumulate("Concolic::ExecutionTree::ConcreteBranchesTotal", 1);
+            concreteBranches.add(1);
         }else{
-            statistics()->accumulate("Concolic::ExecutionTree::SymbolicBranchesTotal", 1);
+            symbolicBranches.add(1);
         }
     }
 }
@@ -139,6 +142,11 @@ void TracePageLoadDetector::slPageLoad(QUrl url)
 
 /* DOM Modification Detector */
 
+TraceDomModDetector::TraceDomModDetector() :
+    mTokeniser(indicators)
+{
+}
+
 void TraceDomModDetector::slDomModified(QString start, QString end)
 {
     // Create the node.
@@ -161,69 +169,59 @@ void TraceDomModDetector::slDomModified(QString start, QString end)
 // Returns a pair or the amount of modification and the list of indicator words which were added.
 QPair<double, QMap<int, int> > TraceDomModDetector::computeMetrics(QString start, QString end)
 {
-    QStringList startTokens = tokenise(start);
-    QStringList endTokens = tokenise(end);
+    // Both DOMs must be tokenised with the same IDs, so the table is only cleared between comparisons.
+    if (mTokeniser.numTokens() >= MAX_INTERNED_TOKENS) {
+        mTokeniser.clear();
+    }
 
-    //Log::debug(startTokens.join("\n").toStdString());
+    QVector<domtokenid_t> startTokens = mTokeniser.tokenise(start);
+    QVector<domtokenid_t> endTokens = mTokeniser.tokenise(end);
 
-    QPair<int, QStringList> result = findInsertions(startTokens, endTokens);
+    QPair<int, QList<domtokenid_t> > result = findInsertions(startTokens, endTokens);
 
     Log::debug(QString("Edit distance between DOMs: %1").arg(result.first).toStdString());
-    //Log::debug("Inserted words:");
-    //Log::debug(result.second.join("\n").toStdString());
 
     // Compute the metric of "amount modified". This is not a true percentage, and can even be over 100!
-    double modified = 100.0 * (double)result.first / startTokens.length();
-    Log::debug(QString("Amount modified: %2/%3 = %1%").arg(modified).arg((double)result.first).arg((double)startTokens.length()).toStdString());
+    double modified = 100.0 * (double)result.first / startTokens.size();
+    Log::debug(QString("Amount modified: %2/%3 = %1%").arg(modified).arg((double)result.first).arg((double)startTokens.size()).toStdString());
 
     // Check whether any of the inserted words are in our "indicators" list.
+    // The tokeniser has already matched each distinct token against the list, so this is a lookup per insertion.
     QMap<int,int> matches;
-    int j;
-    foreach(QString inserted, result.second) {
-        for(j = 0; j < indicators.length(); j++) {
-            if(inserted.compare(indicators.at(j), Qt::CaseInsensitive) == 0) {
-                matches.insert(j, 1 + matches.value(j, 0));
-                Log::debug(QString("On list: %1").arg(inserted).toStdString());
-            }
+    foreach(domtokenid_t inserted, result.second) {
+        int j = mTokeniser.indicatorIndex(inserted);
+        if(j >= 0) {
+            matches.insert(j, 1 + matches.value(j, 0));
+            Log::debug(QString("On list: %1").arg(mTokeniser.getToken(inserted)).toStdString());
         }
     }
 
     return QPair<double,QMap<int,int> >(modified, matches);
 }
 
-// Splits a DOM string into tokens.
-// We split on whitespace and a few HTML characters which will get the text into decently small chunks.
-// Also split on a bunch of punctuation to increase the chance we islate the important words
-// It is not super-important exactly how we define the tokens.
-QStringList TraceDomModDetector::tokenise(QString dom)
-{
-    QRegExp delimiters("\\s+|<|>|\"|'|:|\\.|,|!|\\?|/|;|-");
-    return dom.split(delimiters, QString::SkipEmptyParts);
-}
-
 // Take two tokenised streams and compute the edit distance (and edits).
-QPair<int, QStringList> TraceDomModDetector::findInsertions(QStringList start, QStringList end)
+QPair<int, QList<domtokenid_t> > TraceDomModDetector::findInsertions(const QVector<domtokenid_t>& start, const QVector<domtokenid_t>& end)
 {
     int i,j;
     // This is a pretty simple implementation for now.
     // I am also only using insertions and deletions (no substitutions). This is because we want a list of what was added and removed, so substitutions are not interesting (and would just add something to both lists anyway).
 
     // Create an array of the distances between each pair of subsequences. Pre-fill with 0s.
-    QVector<QVector<int> > distance(start.length()+1, QVector<int>(end.length()+1, 0));
+    QVector<QVector<int> > distance(start.size()+1, QVector<int>(end.size()+1, 0));
 
     // Pre-fill edges with counts 0,1,2,3,...
-    for(i = 1; i <= start.length(); i++) {
+    for(i = 1; i <= start.size(); i++) {
         distance[i][0] = i;
     }
-    for(j = 1; j <= end.length(); j++) {
+    for(j = 1; j <= end.size(); j++) {
         distance[0][j] = j;
     }
 
     // Fill in the matrix row-by-row.
-    for(j = 1; j <= end.length(); j++) {
-        for(i = 1; i <= start.length(); i++) {
-            // If the strings match at this point, then we don't need to do anything. N.B. String indexing is off by one from matrix indexing.
-            if(start.at(i-1).compare(end.at(j-1)) == 0){
+    for(j = 1; j <= end.size(); j++) {
+        for(i = 1; i <= start.size(); i++) {
+            // If the tokens match at this point, then we don't need to do anything. N.B. Token indexing is off by one from matrix indexing.
+            if(start.at(i-1) == end.at(j-1)){
                 distance[i][j] = distance[i-1][j-1];
             }else{
                 // Otherwise, we choose whichever of a deletion or insertion is cheapest.
@@ -233,15 +231,15 @@ QPair<int, QStringList> TraceDomModDetector::findInsertions(QStringList start, Q
     }
 
     // Now the edit distance is:
-    int editDistance = distance[start.length()][end.length()];
+    int editDistance = distance[start.size()][end.size()];
 
 
     // To work out the actual edits, we need to backtrack through the table.
     // We start at the bottom right of the matrix and look for cells with the same or one-lower cost which we can move to.
     // In this case we are not really interested in the exact solution, just a list of what was added.
-    QStringList insertedWords;
-    i = start.length();
-    j = end.length();
+    QList<domtokenid_t> insertedWords;
+    i = start.size();
+    j = end.size();
     while(i > 0 || j > 0) {
         // If the diagonally-backwards cell d[i-1,j-1] has the same value as d[i,j] and it's the lowes adjacent cell then it is a match which we can ignore.
         if(i > 0 && j > 0 && distance[i][j] == distance[i-1][j-1] && distance[i-1][j-1] <= distance[i-1][j] && distance[i-1][j-1] <= distance[i][j-1]){
@@ -261,7 +259,7 @@ QPair<int, QStringList> TraceDomModDetector::findInsertions(QStringList start, Q
         }
     }
 
-    return QPair<int, QStringList>(editDistance, insertedWords);
+    return QPair<int, QList<domtokenid_t> >(editDistance, insertedWords);
 }
 
 // The definition of which words we consider interesting indicators of an error.
@@ -22,6 +22,7 @@
 #include <QPair>
 
 #include "concolic/executiontree/tracenodes.h"
+#include "concolic/domtokeniser.h"
 
 #ifndef TRACEEVENTDETECTORS_H
 #define TRACEEVENTDETECTORS_H
@@ -127,13 +128,21 @@ class TraceDomModDetector : public TraceEventDetector
 {
     Q_OBJECT
 
+public:
+    TraceDomModDetector();
+
 public slots:
     void slDomModified(QString start, QString end);
 
 private:
-    static QPair<double, QMap<int, int> > computeMetrics(QString start, QString end);
-    static QStringList tokenise(QString dom);
-    static QPair<int, QStringList> findInsertions(QStringList start, QStringList end);
+    QPair<double, QMap<int, int> > computeMetrics(QString start, QString end);
+    static QPair<int, QList<domtokenid_t> > findInsertions(const QVector<domtokenid_t>& start, const QVector<domtokenid_t>& end);
+
+    // Token IDs are kept across iterations, so the same words are not re-interned or re-matched against the indicators.
+    // Pages which keep generating new words (ids, timestamps, ...) would grow it without bound, so it is cleared once
+    // it holds MAX_INTERNED_TOKENS tokens.
+    DomTokeniser mTokeniser;
+    static const uint MAX_INTERNED_TOKENS = 1 << 16;
 
     static QList<QString> getIndicators();
 
@@ -36,6 +36,7 @@ void TraceStatistics::processTrace(TraceNodePtr trace)
     mNumSymBranches = 0;
     mNumAlerts = 0;
     mNumFunctionCalls = 0;
+    mNumUnexploredSymBranches = 0;
 
     // Run the visitor
     trace->accept(this);
@@ -86,6 +87,15 @@ void TraceStatistics::visit(TraceSymbolicBranch *node)
     mNumNodes++;
     mNumBranches++;
     mNumSymBranches++;
+
+    // Only the plain unexplored marker counts, nodes which were attempted are marked with the other types.
+    if (node->getFalseBranch() == TraceUnexplored::getInstance()) {
+        mNumUnexploredSymBranches++;
+    }
+    if (node->getTrueBranch() == TraceUnexplored::getInstance()) {
+        mNumUnexploredSymBranches++;
+    }
+
     node->getFalseBranch()->accept(this);
     node->getTrueBranch()->accept(this);
 }
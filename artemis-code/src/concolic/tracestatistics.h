@@ -40,6 +40,7 @@ public:
     int mNumSymBranches;
     int mNumAlerts;
     int mNumFunctionCalls;
+    int mNumUnexploredSymBranches; // Unexplored (and not yet attempted) children of symbolic branches, i.e. the search frontier.
 
     void processTrace(TraceNodePtr trace);
 
@@ -18,9 +18,12 @@
 
 namespace artemis {
 
-CodeBlockInfo::CodeBlockInfo(QString functionName, size_t bytecodeSize) :
+CodeBlockInfo::CodeBlockInfo(QString functionName, size_t bytecodeSize, uint index) :
     mFunctionName(functionName),
-    mBytecodeSize(bytecodeSize)
+    mBytecodeSize(bytecodeSize),
+    mIndex(index),
+    mCoveredBytecodes(bytecodeSize),
+    mNumCoveredBytecodes(0)
 {
 }
 
@@ -29,19 +32,19 @@ size_t CodeBlockInfo::getBytecodeSize() const
     return mBytecodeSize;
 }
 
-size_t CodeBlockInfo::numCoveredBytecodes() const
+uint CodeBlockInfo::getIndex() const
 {
-    return mCoveredBytecodes.size();
+    return mIndex;
 }
 
-codeblockid_t CodeBlockInfo::getId(unsigned int sourceOffset, const QString& url, int startline)
+size_t CodeBlockInfo::numCoveredBytecodes() const
 {
-    return sourceOffset * 7 + qHash(url) + 37 * startline;
+    return mNumCoveredBytecodes;
 }
 
-void CodeBlockInfo::setBytecodeCovered(uint bytecodeOffset)
+codeblockid_t CodeBlockInfo::getId(unsigned int sourceOffset, const QString& url, int startline)
 {
-    mCoveredBytecodes.insert(bytecodeOffset);
+    return sourceOffset * 7 + qHash(url) + 37 * startline;
 }
 
 }
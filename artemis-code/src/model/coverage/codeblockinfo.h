@@ -18,7 +18,7 @@
 #define CODEBLOCKINFO_H
 
 #include <QString>
-#include <QSet>
+#include <QBitArray>
 
 namespace artemis {
 
@@ -28,10 +28,19 @@ class CodeBlockInfo
 {
 
 public:
-    CodeBlockInfo(QString functionName, size_t bytecodeSize);
+    CodeBlockInfo(QString functionName, size_t bytecodeSize, uint index);
 
     size_t getBytecodeSize() const;
-    void setBytecodeCovered(uint bytecodeOffset);
+    uint getIndex() const;
+
+    inline void setBytecodeCovered(uint bytecodeOffset)
+    {
+        if (bytecodeOffset < mBytecodeSize && !mCoveredBytecodes.testBit(bytecodeOffset)) {
+            mCoveredBytecodes.setBit(bytecodeOffset);
+            mNumCoveredBytecodes++;
+        }
+    }
+
     size_t numCoveredBytecodes() const;
 
     static codeblockid_t getId(unsigned sourceOffset, const QString& url, int startline);
@@ -39,7 +48,12 @@ public:
 private:
     QString mFunctionName;
     size_t mBytecodeSize;
-    QSet<uint> mCoveredBytecodes;
+    uint mIndex;
+
+    // One bit per instruction slot, indexed by bytecode offset. The popcount is
+    // kept in mNumCoveredBytecodes so that prioritizers can read it in O(1).
+    QBitArray mCoveredBytecodes;
+    size_t mNumCoveredBytecodes;
 
 };
 
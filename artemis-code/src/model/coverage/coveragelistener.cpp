@@ -30,7 +30,8 @@ namespace artemis
 CoverageListener::CoverageListener(const QSet<QUrl>& ignoredUrls) :
     QObject(NULL),
     mIgnoredUrls(ignoredUrls),
-    mInputBeingExecuted(-1)
+    mInputBeingExecuted(-1),
+    mInputBeingExecutedCodeBlocks(NULL)
 {
     mIgnoredUrls.insert(DONT_MEASURE_COVERAGE);
 }
@@ -61,17 +62,22 @@ float CoverageListener::getBytecodeCoverage(QSharedPointer<const BaseInput> inpu
 
     uint hashcode = inputEvent->hashCode();
 
-    if (!mInputToCodeBlockMap.contains(hashcode)) {
+    QMap<int, QBitArray>::const_iterator iter = mInputToCodeBlockMap.constFind(hashcode);
+    if (iter == mInputToCodeBlockMap.constEnd()) {
         return 0;
     }
 
+    const QBitArray& codeBlocks = iter.value();
+
     size_t totalBytecodes = 0;
     size_t executedBytecodes = 0;
 
-    foreach (codeblockid_t codeBlockID, mInputToCodeBlockMap.value(hashcode)->toList()) {
-        QSharedPointer<CodeBlockInfo> codeBlockInfo =  mCodeBlocks.value(codeBlockID);
-        totalBytecodes += codeBlockInfo->getBytecodeSize();
-        executedBytecodes += codeBlockInfo->numCoveredBytecodes();
+    for (int index = 0; index < codeBlocks.size(); ++index) {
+        if (codeBlocks.testBit(index)) {
+            const CodeBlockInfo* codeBlockInfo = mCodeBlockIndex.at(index).data();
+            totalBytecodes += codeBlockInfo->getBytecodeSize();
+            executedBytecodes += codeBlockInfo->numCoveredBytecodes();
+        }
     }
 
     float coverage = 0;
@@ -88,14 +94,19 @@ float CoverageListener::getBytecodeCoverage(QSharedPointer<const BaseInput> inpu
 void CoverageListener::notifyStartingEvent(QSharedPointer<const BaseInput> inputEvent)
 {
     mInputBeingExecuted = inputEvent->hashCode();
-    if (!mInputToCodeBlockMap.contains(mInputBeingExecuted)) {
-        mInputToCodeBlockMap.insert(mInputBeingExecuted, new QSet<codeblockid_t>());
+
+    QMap<int, QBitArray>::iterator iter = mInputToCodeBlockMap.find(mInputBeingExecuted);
+    if (iter == mInputToCodeBlockMap.end()) {
+        iter = mInputToCodeBlockMap.insert(mInputBeingExecuted, QBitArray(mCodeBlockIndex.size()));
     }
+
+    mInputBeingExecutedCodeBlocks = &iter.value();
 }
 
 void CoverageListener::notifyStartingLoad()
 {
     mInputBeingExecuted = -1;
+    mInputBeingExecutedCodeBlocks = NULL;
 }
 
 void CoverageListener::slJavascriptScriptParsed(QString sourceCode, QSource* source)
@@ -118,8 +129,8 @@ void CoverageListener::slJavascriptScriptParsed(QString sourceCode, QSource* sou
 
 void CoverageListener::slJavascriptStatementExecuted(uint linenumber, QSource* source)
 {
-
-    statistics()->accumulate("WebKit::coverage::covered", 1);
+    static StatsCounter coveredStatements = statistics()->counter("WebKit::coverage::covered");
+    coveredStatements.add(1);
 
     sourceid_t sourceID = SourceInfo::getId(source->getUrl(), source->getStartLine());
     SourceInfoPtr sourceInfo = mSources.value(sourceID, SourceInfoPtr(NULL));
@@ -137,12 +148,22 @@ void CoverageListener::slJavascriptFunctionCalled(QString functionName, size_t b
 
     codeblockid_t codeBlockID = CodeBlockInfo::getId(sourceOffset, source->getUrl(), source->getStartLine());
 
-    if (!mCodeBlocks.contains(codeBlockID)) {
-        mCodeBlocks.insert(codeBlockID, QSharedPointer<CodeBlockInfo>(new CodeBlockInfo(functionName, bytecodeSize)));
+    QHash<codeblockid_t, QSharedPointer<CodeBlockInfo> >::const_iterator iter = mCodeBlocks.constFind(codeBlockID);
+
+    if (iter == mCodeBlocks.constEnd()) {
+        QSharedPointer<CodeBlockInfo> codeBlockInfo(new CodeBlockInfo(functionName, bytecodeSize, mCodeBlockIndex.size()));
+        mCodeBlockIndex.append(codeBlockInfo);
+        iter = mCodeBlocks.insert(codeBlockID, codeBlockInfo);
     }
 
-    if (mInputBeingExecuted != -1) {
-        mInputToCodeBlockMap.value(mInputBeingExecuted)->insert(codeBlockID);
+    if (mInputBeingExecutedCodeBlocks != NULL) {
+        uint index = iter.value()->getIndex();
+
+        if (index >= (uint)mInputBeingExecutedCodeBlocks->size()) {
+            mInputBeingExecutedCodeBlocks->resize(mCodeBlockIndex.size());
+        }
+
+        mInputBeingExecutedCodeBlocks->setBit(index);
     }
 
 }
@@ -151,10 +172,11 @@ void CoverageListener::slJavascriptBytecodeExecuted(const ByteCodeInfoStruct& bi
 {
 
     codeblockid_t codeBlockID = CodeBlockInfo::getId(sourceOffset, source->getUrl(), source->getStartLine());
-    QSharedPointer<CodeBlockInfo> codeBlockInfo = mCodeBlocks.value(codeBlockID, QSharedPointer<CodeBlockInfo>(NULL));
 
-    if (!codeBlockInfo.isNull()) {
-        codeBlockInfo->setBytecodeCovered(binfo.bytecodeOffset);
+    QHash<codeblockid_t, QSharedPointer<CodeBlockInfo> >::const_iterator iter = mCodeBlocks.constFind(codeBlockID);
+
+    if (iter != mCodeBlocks.constEnd()) {
+        iter.value()->setBytecodeCovered(binfo.bytecodeOffset);
     }
 
     sourceid_t sourceID = SourceInfo::getId(source->getUrl(), source->getStartLine());
@@ -172,6 +194,29 @@ void CoverageListener::slJavascriptBytecodeExecuted(const ByteCodeInfoStruct& bi
 
 }
 
+/**
+ * The concrete instructions of a basic block, reported together by the interpreter.
+ */
+void CoverageListener::slJavascriptBytecodeRangeExecuted(const QList<ByteCodeInfoStruct>& binfos, uint sourceOffset, QSource* source)
+{
+    codeblockid_t codeBlockID = CodeBlockInfo::getId(sourceOffset, source->getUrl(), source->getStartLine());
+    QSharedPointer<CodeBlockInfo> codeBlockInfo = mCodeBlocks.value(codeBlockID);
+
+    sourceid_t sourceID = SourceInfo::getId(source->getUrl(), source->getStartLine());
+    SourceInfoPtr sourceInfo = mSources.value(sourceID, SourceInfoPtr(NULL));
+
+    foreach (const ByteCodeInfoStruct& binfo, binfos) {
+        if (!codeBlockInfo.isNull()) {
+            codeBlockInfo->setBytecodeCovered(binfo.bytecodeOffset);
+        }
+
+        if (!sourceInfo.isNull()) {
+            sourceInfo->setRangeCovered(binfo.divot, binfo.startOffset, binfo.endOffset);
+            sourceInfo->setLineCovered(binfo.linenumber);
+        }
+    }
+}
+
 QString CoverageListener::toString() const
 {
     QString output;
@@ -179,8 +224,12 @@ QString CoverageListener::toString() const
     foreach (int inputHash, mInputToCodeBlockMap.keys()) {
         output += "Input(" + QString::number(inputHash) + ")\n";
 
-        foreach (codeblockid_t codeBlockID, mInputToCodeBlockMap.value(inputHash)->toList()) {
-            output += "  CodeBlockID (" + QString::number(codeBlockID) + ") size = " + QString::number(mCodeBlocks.value(codeBlockID)->getBytecodeSize()) + "\n";
+        const QBitArray& codeBlocks = mInputToCodeBlockMap[inputHash];
+
+        for (int index = 0; index < codeBlocks.size(); ++index) {
+            if (codeBlocks.testBit(index)) {
+                output += "  CodeBlock (" + QString::number(index) + ") size = " + QString::number(mCodeBlockIndex.at(index)->getBytecodeSize()) + "\n";
+            }
         }
     }
 
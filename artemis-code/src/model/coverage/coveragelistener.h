@@ -22,7 +22,9 @@
 #include <QObject>
 #include <QUrl>
 #include <QMap>
+#include <QHash>
 #include <QSet>
+#include <QBitArray>
 #include <QSharedPointer>
 #include <QWebExecutionListener>
 #include <QSource>
@@ -60,15 +62,19 @@ private:
 
     QSet<QUrl> mIgnoredUrls;
 
-    // (inputHashCode -> set<codeBlockID>
-    QMap<int, QSet<codeblockid_t>* > mInputToCodeBlockMap;
+    // (inputHashCode -> bitset over CodeBlockInfo::getIndex())
+    QMap<int, QBitArray> mInputToCodeBlockMap;
     int mInputBeingExecuted;
+    QBitArray* mInputBeingExecutedCodeBlocks;
 
     // (sourceID -> SourceInfo)
     QMap<sourceid_t, SourceInfoPtr> mSources;
 
     // (codeBlockID -> CodeBlockInfo)
-    QMap<codeblockid_t, QSharedPointer<CodeBlockInfo> > mCodeBlocks;
+    QHash<codeblockid_t, QSharedPointer<CodeBlockInfo> > mCodeBlocks;
+
+    // (CodeBlockInfo::getIndex() -> CodeBlockInfo)
+    QList<QSharedPointer<CodeBlockInfo> > mCodeBlockIndex;
 
 
 public slots:
@@ -76,6 +82,7 @@ public slots:
     void slJavascriptScriptParsed(QString sourceCode, QSource* source);
     void slJavascriptFunctionCalled(QString functionName, size_t bytecodeSize, uint functionStartLine, uint sourceOffset, QSource* source);
     void slJavascriptBytecodeExecuted(const ByteCodeInfoStruct& binfo, uint sourceOffset, QSource* source);
+    void slJavascriptBytecodeRangeExecuted(const QList<ByteCodeInfoStruct>& binfos, uint sourceOffset, QSource* source);
     void slJavascriptStatementExecuted(uint linenumber, QSource* source);
 
 };
@@ -54,7 +54,8 @@ void JavascriptStatistics::slJavascriptPropertyRead(QString propertyName, intptr
         return;
     }
 
-    statistics()->accumulate("WebKit::readproperties", 1);
+    static StatsCounter readProperties = statistics()->counter("WebKit::readproperties");
+    readProperties.add(1);
 
     if (mInputBeingExecuted != 0) {
         mPropertyReadSet.value(mInputBeingExecuted)->insert(propertyName);
@@ -67,7 +68,8 @@ void JavascriptStatistics::slJavascriptPropertyWritten(QString propertyName, int
         return;
     }
 
-    statistics()->accumulate("WebKit::writtenproperties", 1);
+    static StatsCounter writtenProperties = statistics()->counter("WebKit::writtenproperties");
+    writtenProperties.add(1);
 
     if (mInputBeingExecuted != 0) {
         mPropertyWriteSet.value(mInputBeingExecuted)->insert(propertyName);
@@ -17,6 +17,7 @@
 #include "ajaxrequestlistener.h"
 #include <QNetworkAccessManager>
 #include <QNetworkRequest>
+#include <QNetworkReply>
 
 
 namespace artemis
@@ -33,6 +34,12 @@ QNetworkReply* AjaxRequestListener::createRequest(Operation op, const QNetworkRe
     //super call
     QNetworkReply* reply = QNetworkAccessManager::createRequest(op, req, outgoingData);
 
+    if (!reply->isFinished()) {
+        mPendingReplies.insert(reply);
+        QObject::connect(reply, SIGNAL(finished()), this, SLOT(slReplyFinished()));
+        QObject::connect(reply, SIGNAL(destroyed(QObject*)), this, SLOT(slReplyDestroyed(QObject*)));
+    }
+
     if (op == GetOperation)
         { emit this->pageGet(req.url()); }
     else if (op == PostOperation)
@@ -41,4 +48,21 @@ QNetworkReply* AjaxRequestListener::createRequest(Operation op, const QNetworkRe
     return reply;
 }
 
+void AjaxRequestListener::slReplyFinished()
+{
+    removePendingReply(sender());
+}
+
+void AjaxRequestListener::slReplyDestroyed(QObject* reply)
+{
+    removePendingReply(reply);
+}
+
+void AjaxRequestListener::removePendingReply(QObject* reply)
+{
+    if (mPendingReplies.remove(reply) && mPendingReplies.isEmpty()) {
+        emit sigNetworkIdle();
+    }
+}
+
 }
@@ -18,6 +18,7 @@
 #define AJAXREQUESTLISTENER_H
 #include <QNetworkAccessManager>
 #include <QUrl>
+#include <QSet>
 namespace artemis
 {
 
@@ -30,10 +31,23 @@ public:
     explicit AjaxRequestListener(QObject* parent = 0);
     QNetworkReply* createRequest(Operation op, const QNetworkRequest& req, QIODevice* outgoingData = 0);
 
+    inline bool hasPendingRequests() const {
+        return !mPendingReplies.isEmpty();
+    }
+
+private:
+    void removePendingReply(QObject* reply);
+
+    QSet<QObject*> mPendingReplies;
+
 signals:
     void pageGet(QUrl url);
     void pagePost(QUrl url);
-public slots:
+    void sigNetworkIdle();
+
+private slots:
+    void slReplyFinished();
+    void slReplyDestroyed(QObject* reply);
 
 };
 
@@ -16,6 +16,7 @@
 
 #include <QDebug>
 #include <QWebFrame>
+#include <QWebSettings>
 
 #include "artemisglobals.h"
 #include "statistics/statsstorage.h"
@@ -28,14 +29,54 @@ namespace artemis
 
 ArtemisWebPage::ArtemisWebPage() :
     QWebPage(NULL),
-    mAcceptNavigation(true) // Unless we are in manual mode and choose otherwise, we accept all navigation.
+    mAcceptNavigation(true), // Unless we are in manual mode and choose otherwise, we accept all navigation.
+    mResolvedElementsFrame(NULL),
+    mResolvedElementsTreeVersion(0)
 {
+    QObject::connect(this, SIGNAL(loadStarted()), this, SLOT(slClearResolvedElements()));
 }
 
+/**
+ * Gives every form field without an id the id ARTEMISID-<form index>-<field index>.
+ * This is done through the DOM directly, as it runs before every input.
+ */
 void ArtemisWebPage::updateFormIdentifiers()
 {
-    QString js = "for (var i = 0; i < document.forms.length; i++) { var form = document.forms[i]; for (var j = 0; j < form.elements.length; j++) { var element = form.elements[j]; if (element.id == \"\" || element.id.indexOf(\"ARTEMISID\") != -1) {element.id = \"ARTEMISID-\" + i + \"-\" + j;} }}";
-    currentFrame()->documentElement().evaluateJavaScript(js, DONT_MEASURE_COVERAGE, true);
+    currentFrame()->assignFormFieldIds("ARTEMISID");
+}
+
+/**
+ * Prepares the page to run without a view, in a viewport of a fixed size.
+ *
+ * Layout is only done when the geometry of the page is needed, e.g. for QWebElement::geometry() or to dispatch a mouse
+ * event, and accelerated compositing is disabled. A page without a view is never painted, so images are not decoded
+ * beyond their size either.
+ */
+void ArtemisWebPage::setHeadless(const QSize& viewport)
+{
+    setViewportSize(viewport);
+    setLayoutOnDemand(true);
+    settings()->setAttribute(QWebSettings::AcceleratedCompositingEnabled, false);
+}
+
+QHash<QString, QWebElement>& ArtemisWebPage::resolvedElements(QWebFrame* frame)
+{
+    quint64 treeVersion = frame->domTreeVersion();
+
+    if (frame != mResolvedElementsFrame || treeVersion != mResolvedElementsTreeVersion) {
+        mResolvedElements.clear();
+        mResolvedElementsFrame = frame;
+        mResolvedElementsTreeVersion = treeVersion;
+    }
+
+    return mResolvedElements;
+}
+
+void ArtemisWebPage::slClearResolvedElements()
+{
+    mResolvedElements.clear();
+    mResolvedElementsFrame = NULL;
+    mResolvedElementsTreeVersion = 0;
 }
 
 void ArtemisWebPage::javaScriptAlert(QWebFrame* frame, const QString& msg)
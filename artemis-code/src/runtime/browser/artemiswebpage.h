@@ -18,6 +18,8 @@
 #define ARTEMISWEBPAGE_H
 
 #include <QWebPage>
+#include <QWebElement>
+#include <QHash>
 #include <QString>
 #include <QSharedPointer>
 #include <QNetworkRequest>
@@ -48,6 +50,16 @@ public:
      */
     void updateFormIdentifiers();
 
+    void setHeadless(const QSize& viewport);
+
+    /**
+     * Elements resolved by DOM element descriptors in frame, see DOMElementDescriptor::getElement.
+     *
+     * Only the elements of the current DOM tree version of a single frame are kept. The table is emptied when another
+     * frame or tree version is asked for, or a new page starts loading, so it never keeps an earlier document alive.
+     */
+    QHash<QString, QWebElement>& resolvedElements(QWebFrame* frame);
+
     void javaScriptAlert(QWebFrame* frame, const QString& msg);
     bool javaScriptConfirm(QWebFrame* frame, const QString& msg);
     void javaScriptConsoleMessage(const QString& message, int lineNumber, const QString& sourceID);
@@ -58,6 +70,14 @@ public:
 protected:
     virtual bool acceptNavigationRequest(QWebFrame *frame, const QNetworkRequest &request, NavigationType type);
 
+private slots:
+    void slClearResolvedElements();
+
+private:
+    QWebFrame* mResolvedElementsFrame;
+    quint64 mResolvedElementsTreeVersion;
+    QHash<QString, QWebElement> mResolvedElements;
+
 signals:
     void sigJavascriptAlert(QWebFrame* frame, QString msg);
     void sigNavigationRequest(QWebFrame *frame, const QNetworkRequest &request, QWebPage::NavigationType type);
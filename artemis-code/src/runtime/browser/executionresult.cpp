@@ -27,11 +27,6 @@ ExecutionResult::ExecutionResult()
     mStateHash = 0;
 }
 
-QString ExecutionResult::getPageContents() const
-{
-    return mPageContents;
-}
-
 QList<int> ExecutionResult::getAjaxCallbackHandlers() const
 {
     return mAjaxCallbackHandlers;
@@ -63,6 +58,11 @@ long ExecutionResult::getPageStateHash() const
 
 }
 
+PageStateFingerprint ExecutionResult::getPageStateFingerprint() const
+{
+    return mStateFingerprint;
+}
+
 bool ExecutionResult::isDomModified() const
 {
     return mModifiedDom;
@@ -28,6 +28,7 @@
 #include "runtime/input/forms/formfielddescriptor.h"
 #include "runtime/browser/timer.h"
 #include "runtime/browser/ajax/ajaxrequest.h"
+#include "runtime/pagestate/pagestateabstraction.h"
 
 namespace artemis
 {
@@ -43,7 +44,7 @@ public:
 
     bool isDomModified() const;
     long getPageStateHash() const;
-    QString getPageContents() const;
+    PageStateFingerprint getPageStateFingerprint() const;
 
     QSet<QSharedPointer<AjaxRequest> > getAjaxRequests() const;
     QList<int> getAjaxCallbackHandlers() const;
@@ -64,7 +65,7 @@ private:
 
     bool mModifiedDom;
     long mStateHash;
-    QString mPageContents;
+    PageStateFingerprint mStateFingerprint;
 
     QSet<QSharedPointer<AjaxRequest> > mAjaxRequest;
     QList<int> mAjaxCallbackHandlers;
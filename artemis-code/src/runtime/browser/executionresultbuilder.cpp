@@ -29,19 +29,35 @@ namespace artemis
 ExecutionResultBuilder::ExecutionResultBuilder(ArtemisWebPagePtr page) : QObject(NULL)
 {
     mPage = page;
+    mDomSnapshotsEnabled = true;
     reset();
 }
 
+void ExecutionResultBuilder::setDomSnapshotsEnabled(bool enabled)
+{
+    mDomSnapshotsEnabled = enabled;
+}
+
+void ExecutionResultBuilder::setPageStateAbstraction(PageStateAbstractionConstPtr abstraction)
+{
+    mPageStateAbstraction = abstraction;
+}
+
 void ExecutionResultBuilder::reset()
 {
     mResult = QSharedPointer<ExecutionResult>(new ExecutionResult());
     mElementPointers.clear();
+    mPageStateHashAfterLoad = 0;
     mPageStateAfterLoad = QString("");
 }
 
 void ExecutionResultBuilder::notifyPageLoaded()
 {
-    mPageStateAfterLoad = mPage->mainFrame()->toHtml();
+    mPageStateHashAfterLoad = mPage->mainFrame()->domStateHash();
+
+    if (mDomSnapshotsEnabled) {
+        mPageStateAfterLoad = mPage->mainFrame()->toHtml();
+    }
 }
 
 void ExecutionResultBuilder::notifyStartingEvent()
@@ -59,12 +75,19 @@ QSharedPointer<ExecutionResult> ExecutionResultBuilder::getResult()
     registerFromFieldsIntoResult();
     registerEventHandlersIntoResult();
 
-    mResult->mPageContents = mPage->mainFrame()->toHtml();
-    mResult->mStateHash = qHash(mResult->mPageContents);
-    mResult->mModifiedDom = mResult->mPageContents.localeAwareCompare(mPageStateAfterLoad) != 0;
+    // The DOM state hash is maintained by WebCore as the DOM is mutated, so neither check serialises the page.
+    quint64 pageStateHash = mPage->mainFrame()->domStateHash();
+    mResult->mStateHash = (long)pageStateHash;
+    mResult->mModifiedDom = pageStateHash != mPageStateHashAfterLoad;
+
+    if (mPageStateAbstraction.isNull()) {
+        mResult->mStateFingerprint = PageStateFingerprint(pageStateHash, pageStateHash);
+    } else {
+        mResult->mStateFingerprint = mPageStateAbstraction->fingerprint(mPage->mainFrame(), mResult->mEventHandlers);
+    }
 
-    if(mResult->mModifiedDom){
-        emit sigDomModified(mPageStateAfterLoad, mResult->mPageContents);
+    if(mResult->mModifiedDom && mDomSnapshotsEnabled){
+        emit sigDomModified(mPageStateAfterLoad, mPage->mainFrame()->toHtml());
     }
 
     return mResult;
@@ -247,7 +270,8 @@ void ExecutionResultBuilder::slAjaxRequestInitiated(QUrl u, QString postData)
 
 void ExecutionResultBuilder::slJavascriptConstantStringEncountered(QString constant)
 {
-    statistics()->accumulate("WebKit::jsconstants", 1);
+    static StatsCounter constants = statistics()->counter("WebKit::jsconstants");
+    constants.add(1);
     mResult->mJavascriptConstantsObservedForLastEvent.insert(constant);
 }
 
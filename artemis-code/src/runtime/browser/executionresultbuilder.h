@@ -26,6 +26,7 @@
 
 #include "runtime/browser/executionresult.h"
 #include "runtime/browser/artemiswebpage.h"
+#include "runtime/pagestate/pagestateabstraction.h"
 
 namespace artemis
 {
@@ -57,6 +58,13 @@ public:
     void notifyStartingLoad();
     QSharedPointer<ExecutionResult> getResult();
 
+    // Serialise the DOM after load and at the end of each execution, for sigDomModified.
+    // The state hash and isDomModified() do not need the serialisation.
+    void setDomSnapshotsEnabled(bool enabled);
+
+    // Fingerprint the page with the given abstraction instead of using the DOM state hash.
+    void setPageStateAbstraction(PageStateAbstractionConstPtr abstraction);
+
 private:
     void registerFromFieldsIntoResult();
     void registerEventHandlersIntoResult();
@@ -66,8 +74,13 @@ private:
 
     QSharedPointer<ExecutionResult> mResult;
     ArtemisWebPagePtr mPage;
+
+    bool mDomSnapshotsEnabled;
+    quint64 mPageStateHashAfterLoad;
     QString mPageStateAfterLoad;
 
+    PageStateAbstractionConstPtr mPageStateAbstraction;
+
     QList<QPair<QWebElement*, QString> > mElementPointers;
 
 public slots:
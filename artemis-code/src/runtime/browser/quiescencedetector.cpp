@@ -0,0 +1,105 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include <QApplication>
+#include <QEventLoop>
+#include <QTimer>
+#include <QWebFrame>
+
+#include "statistics/statsstorage.h"
+
+#include "quiescencedetector.h"
+
+namespace artemis
+{
+
+QuiescenceDetector::QuiescenceDetector(QObject* parent, ArtemisWebPagePtr page, AjaxRequestListener* network,
+                                       QWebExecutionListener* listener, uint horizon) :
+    QObject(parent),
+    mPage(page),
+    mNetwork(network),
+    mListener(listener),
+    mHorizon(horizon / 1000.0),
+    mNavigated(false)
+{
+    QObject::connect(mPage.data(), SIGNAL(loadStarted()), this, SLOT(slLoadStarted()));
+}
+
+void QuiescenceDetector::settle()
+{
+    double horizon = mListener->virtualTime() + mHorizon;
+    uint timersFired = 0;
+
+    mNavigated = false;
+
+    while (true) {
+        QApplication::processEvents();
+
+        if (mPage->mainFrame()->flushPendingLayout()) {
+            statistics()->accumulate("WebKit::quiescence::layouts-flushed", 1);
+        }
+
+        // A navigation replaces the page, so there is nothing left to wait for.
+        if (mNavigated) {
+            break;
+        }
+
+        if (mNetwork->hasPendingRequests()) {
+            if (!waitForNetwork()) {
+                statistics()->accumulate("WebKit::quiescence::network-timeouts", 1);
+                break;
+            }
+            continue;
+        }
+
+        if (timersFired < MAX_TIMER_FIRES && mListener->fireNextVirtualTimer(horizon)) {
+            timersFired++;
+            continue;
+        }
+
+        break;
+    }
+
+    if (timersFired == MAX_TIMER_FIRES) {
+        statistics()->accumulate("WebKit::quiescence::timer-limit-reached", 1);
+    }
+
+    statistics()->accumulate("WebKit::quiescence::timers-fired", timersFired);
+}
+
+bool QuiescenceDetector::waitForNetwork()
+{
+    QEventLoop loop;
+    QTimer timeout;
+
+    timeout.setSingleShot(true);
+    QObject::connect(&timeout, SIGNAL(timeout()), &loop, SLOT(quit()));
+    QObject::connect(mNetwork, SIGNAL(sigNetworkIdle()), &loop, SLOT(quit()));
+    QObject::connect(mPage.data(), SIGNAL(loadStarted()), &loop, SLOT(quit()));
+
+    timeout.start(NETWORK_TIMEOUT);
+    loop.exec();
+
+    return timeout.isActive();
+}
+
+void QuiescenceDetector::slLoadStarted()
+{
+    mNavigated = true;
+}
+
+}
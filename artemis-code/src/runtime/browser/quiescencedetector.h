@@ -0,0 +1,76 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef QUIESCENCEDETECTOR_H
+#define QUIESCENCEDETECTOR_H
+
+#include <QObject>
+#include <QSharedPointer>
+#include <QtWebKit/qwebexecutionlistener.h>
+
+#include "runtime/browser/ajax/ajaxrequestlistener.h"
+#include "artemiswebpage.h"
+
+namespace artemis
+{
+
+/**
+ * Decides when a page load or an event has finished, without waiting for timers in real time.
+ *
+ * The page is quiescent when no network requests are pending, layout is up to date and no virtual timer is due
+ * within the horizon. Until then, settle() waits for the network, flushes layout and advances virtual time to the
+ * next timer, in that order. The horizon is counted from the virtual time at which settle() is called, so timers
+ * scheduled further ahead are left for the input generator to fire as TimerInputs.
+ *
+ * Requires virtual time to be enabled in the execution listener before the page is loaded.
+ */
+class QuiescenceDetector : public QObject
+{
+    Q_OBJECT
+
+public:
+    QuiescenceDetector(QObject* parent, ArtemisWebPagePtr page, AjaxRequestListener* network,
+                       QWebExecutionListener* listener, uint horizon);
+
+    void settle();
+
+    // True if a new page started loading during the last settle().
+    bool navigated() const {
+        return mNavigated;
+    }
+
+private:
+    bool waitForNetwork();
+
+    ArtemisWebPagePtr mPage;
+    AjaxRequestListener* mNetwork;
+    QWebExecutionListener* mListener;
+    double mHorizon; // seconds of virtual time
+
+    bool mNavigated;
+
+    // Bounds the work done by a polling loop with a short interval and a long horizon.
+    static const uint MAX_TIMER_FIRES = 1000;
+    static const int NETWORK_TIMEOUT = 30000; // ms
+
+private slots:
+    void slLoadStarted();
+};
+
+}
+
+#endif // QUIESCENCEDETECTOR_H
@@ -46,7 +46,8 @@ WebKitExecutor::WebKitExecutor(QObject* parent,
                                bool enableConstantStringInstrumentation,
                                bool enablePropertyAccessInstrumentation) :
     QObject(parent),
-    mNextOpCanceled(false), mKeepOpen(false)
+    mNextOpCanceled(false), mKeepOpen(false), mQuiescenceDetector(NULL),
+    mSettling(false)
 {
 
     mPresetFields = presetFields;
@@ -91,6 +92,8 @@ WebKitExecutor::WebKitExecutor(QObject* parent,
                      mCoverageListener.data(), SLOT(slJavascriptStatementExecuted(uint, QSource*)));
     QObject::connect(mWebkitListener, SIGNAL(sigJavascriptBytecodeExecuted(const ByteCodeInfoStruct, uint, QSource*)),
                      mCoverageListener.data(), SLOT(slJavascriptBytecodeExecuted(const ByteCodeInfoStruct, uint, QSource*)));
+    QObject::connect(mWebkitListener, SIGNAL(sigJavascriptBytecodeRangeExecuted(const QList<ByteCodeInfoStruct>, uint, QSource*)),
+                     mCoverageListener.data(), SLOT(slJavascriptBytecodeRangeExecuted(const QList<ByteCodeInfoStruct>, uint, QSource*)));
     QObject::connect(mWebkitListener, SIGNAL(sigJavascriptFunctionCalled(QString, size_t, uint, uint, QSource*)),
                      mCoverageListener.data(), SLOT(slJavascriptFunctionCalled(QString, size_t, uint, uint, QSource*)));
 
@@ -203,6 +206,10 @@ void WebKitExecutor::executeSequence(ExecutableConfigurationConstPtr conf, bool
     mWebkitListener->beginSymbolicSession();
     mWebkitListener->clearAjaxCallbacks(); // reset the ajax callback ids
 
+    if (mQuiescenceDetector) {
+        mWebkitListener->resetVirtualTime();
+    }
+
     mKeepOpen = keepOpen;
 
     mPage->mainFrame()->load(conf->getUrl());
@@ -231,6 +238,12 @@ void WebKitExecutor::slNAMFinished(QNetworkReply* reply){
 
 void WebKitExecutor::slLoadFinished(bool ok)
 {
+    if (mSettling) {
+        // A navigation started by the current sequence finished loading while it was settling, see settle().
+        qDebug() << "Page load during the current sequence ignored";
+        return;
+    }
+
     if(mNextOpCanceled){
         mNextOpCanceled = false;
         qDebug() << "Page load canceled";
@@ -244,6 +257,11 @@ void WebKitExecutor::slLoadFinished(bool ok)
             return;
         }        
     }
+
+    if (mQuiescenceDetector) {
+        settle();
+    }
+
     mResultBuilder->notifyPageLoaded();
 
     // Populate forms (preset)
@@ -260,18 +278,16 @@ void WebKitExecutor::slLoadFinished(bool ok)
 
         // TODO this code should be merged together with the code in forminputcollection.cpp
 
-        QString setValue = QString("this.value = \"") +  mPresetFields[f] + "\";";
-        elm.evaluateJavaScript(setValue);
+        if (!elm.setFormValue(mPresetFields[f])) {
+            QString setValue = QString("this.value = \"") +  mPresetFields[f] + "\";";
+            elm.evaluateJavaScript(setValue);
+        }
 
         //elm.setAttribute("value", mPresetFields[f]);
 
         if (elm.attribute("type", "") == "checkbox" || elm.attribute("type", "") == "radio") {
             // all non-empty values are translated into checked
-            if (mPresetFields[f] == "") {
-                elm.evaluateJavaScript("this.checked = false;");
-            } else {
-                elm.evaluateJavaScript("this.checked = true;");
-            }
+            elm.setFormChecked(mPresetFields[f] != "");
         }
     }
 
@@ -291,6 +307,15 @@ void WebKitExecutor::slLoadFinished(bool ok)
         mPage->updateFormIdentifiers();
 
         input->apply(this->mPage, this->mWebkitListener);
+
+        if (mQuiescenceDetector) {
+            settle();
+
+            // The remaining inputs belong to the page which is being replaced.
+            if (mQuiescenceDetector->navigated()) {
+                break;
+            }
+        }
     }
 
     if (!mKeepOpen) {
@@ -316,6 +341,42 @@ ArtemisWebPagePtr WebKitExecutor::getPage()
     return mPage;
 }
 
+void WebKitExecutor::setDomModificationTraceEnabled(bool enabled)
+{
+    mResultBuilder->setDomSnapshotsEnabled(enabled);
+}
+
+void WebKitExecutor::setPageStateAbstraction(PageStateAbstractionConstPtr abstraction)
+{
+    mResultBuilder->setPageStateAbstraction(abstraction);
+}
+
+/**
+ * Runs the page timers on virtual time. After the page load and after every input, timers due within horizon ms
+ * of virtual time are fired until the page is quiescent, see QuiescenceDetector.
+ * Must be called before the first page load.
+ */
+void WebKitExecutor::enableVirtualTime(uint horizon)
+{
+    mWebkitListener->enableVirtualTime();
+    mQuiescenceDetector = new QuiescenceDetector(this, mPage, mAjaxListener, mWebkitListener, horizon);
+}
+
+/**
+ * Waits for the page to become quiescent.
+ *
+ * The detector runs the event loop, so a navigation started by the current sequence can finish loading while
+ * slLoadFinished is still executing it. That load is ignored, as it would be without virtual time, where the next
+ * call to executeSequence cancels the pending navigation. The sequence stops at the navigation (see
+ * QuiescenceDetector::navigated).
+ */
+void WebKitExecutor::settle()
+{
+    mSettling = true;
+    mQuiescenceDetector->settle();
+    mSettling = false;
+}
+
 TraceBuilder* WebKitExecutor::getTraceBuilder()
 {
     return mTraceBuilder;
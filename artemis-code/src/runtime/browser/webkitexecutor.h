@@ -36,6 +36,7 @@
 #include "executionresult.h"
 #include "executionresultbuilder.h"
 #include "artemiswebpage.h"
+#include "quiescencedetector.h"
 
 #include "concolic/executiontree/tracebuilder.h"
 #include "concolic/traceeventdetectors.h"
@@ -69,6 +70,10 @@ public:
 
     TraceBuilder* getTraceBuilder();
 
+    void setDomModificationTraceEnabled(bool enabled);
+    void setPageStateAbstraction(PageStateAbstractionConstPtr abstraction);
+    void enableVirtualTime(uint horizon);
+
     QWebExecutionListener* mWebkitListener; // TODO should not be public
 
 private:
@@ -89,6 +94,12 @@ private:
 
     TraceBuilder* mTraceBuilder;
 
+    QuiescenceDetector* mQuiescenceDetector; // NULL unless virtual time is enabled
+
+    // settle() runs the event loop from inside slLoadFinished, a load finishing meanwhile is ignored.
+    void settle();
+    bool mSettling;
+
 signals:
     void sigExecutedSequence(ExecutableConfigurationConstPtr conf, QSharedPointer<ExecutionResult> res);
     void sigAbortedExecution(QString reason);
@@ -51,15 +51,32 @@ DOMElementDescriptor::DOMElementDescriptor(QWebElement* elm) :
         //setFramePath(elm);
         setElementPath(elm);
     }
+
+    if (mIsDocument) {
+        mResolveKey = "document";
+    } else if (mIsBody) {
+        mResolveKey = "body";
+    } else {
+        foreach (int index, mElementPath) {
+            mResolveKey += "/" + QString::number(index);
+        }
+    }
 }
 
 QWebElement DOMElementDescriptor::getElement(ArtemisWebPagePtr page) const
 {
     QWebFrame* frame = selectFrame(page);
-    QWebElement elm = selectElement(frame);
 
-    Q_ASSERT(elm != NULL_WEB_ELEMENT);
-    return elm;
+    // The page only keeps elements of the current DOM tree version, so the descriptor never holds on to a document.
+    QHash<QString, QWebElement>& resolvedElements = page->resolvedElements(frame);
+    QHash<QString, QWebElement>::iterator iter = resolvedElements.find(mResolveKey);
+
+    if (iter == resolvedElements.end()) {
+        iter = resolvedElements.insert(mResolveKey, selectElement(frame));
+    }
+
+    Q_ASSERT(iter.value() != NULL_WEB_ELEMENT);
+    return iter.value();
 }
 
 QWebFrame* DOMElementDescriptor::selectFrame(ArtemisWebPagePtr page) const
@@ -91,34 +108,18 @@ QWebElement DOMElementDescriptor::selectElement(QWebFrame* frame) const
         return body;
     }
 
-    QWebElement current = frame->findFirstElement("body");
-    Q_ASSERT(current != NULL_WEB_ELEMENT);
+    QWebElement body = frame->findFirstElement("body");
+    Q_ASSERT(body != NULL_WEB_ELEMENT);
 
-    foreach(int id, mElementPath) {
-        current = selectNthChild(current, id);
+    QWebElement current = body.elementAtPath(mElementPath);
 
-        if (current == NULL_WEB_ELEMENT) {
-            qDebug() << "ERROR: Invalid DOM element descriptor applied to web page";
-            return QWebElement();
-        }
+    if (current == NULL_WEB_ELEMENT) {
+        qDebug() << "ERROR: Invalid DOM element descriptor applied to web page";
     }
 
     return current;
 }
 
-QWebElement DOMElementDescriptor::selectNthChild(QWebElement elm, int n) const
-{
-    QWebElement currentChild = elm.firstChild();
-
-    int i = 1;
-    while (i < n) {
-        currentChild = currentChild.nextSibling();
-        i++;
-    }
-
-    return currentChild;
-}
-
 /*
 void DOMElementDescriptor::setFramePath(QWebElement* elm)
 {
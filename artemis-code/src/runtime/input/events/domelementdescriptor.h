@@ -18,6 +18,7 @@
 #define DOMELEMENTDESCRIPTOR_H
 
 #include <QSharedPointer>
+#include <QWebElement>
 
 #include "runtime/browser/artemiswebpage.h"
 
@@ -87,7 +88,9 @@ private:
 
     QWebFrame* selectFrame(ArtemisWebPagePtr page) const;
     QWebElement selectElement(QWebFrame* frame) const;
-    QWebElement selectNthChild(QWebElement elm, int n) const;
+
+    // Identifies the element within its frame, resolved elements are cached on the page under this key.
+    QString mResolveKey;
 };
 
 typedef QSharedPointer<DOMElementDescriptor> DOMElementDescriptorPtr;
@@ -49,23 +49,25 @@ void FormInputCollection::writeToPage(ArtemisWebPagePtr page) const
             if (element.attribute("type", "") == "checkbox" || element.attribute("type", "") == "radio") {
                 // all empty and "false" values are translated into unchecked state
                 if (input.second.compare("") == 0 || input.second.compare("false") == 0) {
-                    element.evaluateJavaScript("this.checked = false;");
+                    element.setFormChecked(false);
                     element.setAttribute("value", "");
                 } else {
-                    element.evaluateJavaScript("this.checked = true;");
+                    element.setFormChecked(true);
                     element.setAttribute("value", input.second);
                 }
 
             } else {
 
-                // We do this using JavaScript because some values are only correctly set this way
+                // We set the value property rather than the attribute because some values are only correctly set this way
                 // E.g. if you set the value of a select box then this approach correctly updates the node,
                 // where the setAttribute approach updates the value itself but not the remaining state of the node
 
-                // TODO this is a bit risky, what if this triggers other events?
+                // setFormValue does the same as the JavaScript assignment this.value = ... without parsing a script.
 
-                QString setValue = QString("this.value = \"") + input.second + "\";";
-                element.evaluateJavaScript(setValue);
+                if (!element.setFormValue(input.second)) {
+                    QString setValue = QString("this.value = \"") + input.second + "\";";
+                    element.evaluateJavaScript(setValue);
+                }
 
                 //element.setAttribute("value", input.second);
 
@@ -58,7 +58,11 @@ enum ExportEventSequence{
 };
 
 enum SMTSolver {
-    KALUZA, Z3STR, CVC4
+    KALUZA, Z3STR, CVC4, PORTFOLIO
+};
+
+enum StateAbstraction {
+    STATE_DOM, STATE_STRUCTURE
 };
 
 typedef struct OptionsType {
@@ -68,6 +72,8 @@ typedef struct OptionsType {
         numberSameLength(1),
         recreatePage(false),
         disableStateCheck(true),
+        stateAbstraction(STATE_DOM),
+        stateApproximateDistance(0),
         concolicNegateLastConstraint(false),
         formInputGenerationStrategy(Random),
         prioritizerStrategy(CONSTANT),
@@ -77,10 +83,17 @@ typedef struct OptionsType {
         concolicTreeOutput(TREE_FINAL),
         concolicTreeOutputOverview(false),
         concolicUnlimitedDepth(false),
+        concolicAllEntryPoints(false),
         solver(CVC4),
+        solverTimeout(10000),
+        solverLocalSearchBudget(500),
+        solverSimplify(true),
+        solverQueryCache(true),
         exportEventSequence(DONT_EXPORT),
         reportHeap(NO_CALLS),
-        heapReportFactor(1)
+        heapReportFactor(1),
+        virtualTimeHorizon(-1),
+        headless(false)
     {}
 
     QMap<QString, QString> presetFormfields;
@@ -93,10 +106,14 @@ typedef struct OptionsType {
 
     bool recreatePage;
     bool disableStateCheck;
+    StateAbstraction stateAbstraction;
+    QSet<QString> stateIgnoredAttributes;
+    uint stateApproximateDistance;
     bool concolicNegateLastConstraint;
 
     QString useProxy;
     QString dumpPageStates;
+    QString statisticsJsonFile;
 
     FormInputGenerationStrategies formInputGenerationStrategy;
     PrioritizerStrategies prioritizerStrategy;
@@ -110,7 +127,15 @@ typedef struct OptionsType {
     bool concolicTreeOutputOverview;
     QString concolicEntryPoint;
     bool concolicUnlimitedDepth;
+    bool concolicAllEntryPoints; // Explore every detected entry point, each with its own tree
+    QString concolicCheckpointFile; // The execution tree is saved here, and resumed from here if it exists
+    QString concolicTreeRenderLog; // If set, the graphs are generated from this tree log instead of running an analysis
     SMTSolver solver;
+    uint solverTimeout; // ms per query, 0 for no limit
+    QString solverCacheFile; // Solver results are persisted here if set
+    int solverLocalSearchBudget; // Candidates checked before running the solver, 0 to disable
+    bool solverSimplify;
+    bool solverQueryCache; // Answer queries from the results of earlier queries, see CachingSolver
 
     ExportEventSequence exportEventSequence;
 
@@ -118,6 +143,10 @@ typedef struct OptionsType {
 
     int heapReportFactor;
 
+    int virtualTimeHorizon; // ms, -1 if timers run in real time
+
+    bool headless;
+
 
 } Options;
 
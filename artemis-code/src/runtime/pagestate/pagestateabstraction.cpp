@@ -0,0 +1,191 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <QPair>
+
+#include "pagestateabstraction.h"
+
+namespace artemis
+{
+
+enum FeatureKind {
+    ELEMENT_FEATURE = 1,
+    FORM_VALUE_FEATURE = 2,
+    EVENT_HANDLER_FEATURE = 3
+};
+
+static inline quint64 mix(quint64 h)
+{
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static inline quint64 combine(quint64 seed, quint64 value)
+{
+    return mix(seed ^ (value + 0x9e3779b97f4a7c15ULL + (seed << 6) + (seed >> 2)));
+}
+
+PageStateAbstraction::PageStateAbstraction(const QSet<QString>& ignoredAttributes)
+{
+    foreach(QString attribute, ignoredAttributes) {
+        mIgnoredAttributes.insert(attribute.toLower());
+    }
+
+    // The style attribute is also left out of the DOM state hash maintained by WebCore.
+    mIgnoredAttributes.insert("style");
+}
+
+PageStateFingerprint PageStateAbstraction::fingerprint(QWebFrame* mainFrame, const QList<EventHandlerDescriptorConstPtr>& eventHandlers) const
+{
+    QList<quint64> features;
+
+    QList<QWebFrame*> frames;
+    frames.append(mainFrame);
+
+    while (!frames.isEmpty()) {
+        QWebFrame* frame = frames.takeFirst();
+        frames += frame->childFrames();
+
+        addElementFeatures(frame->documentElement(), 0, features);
+    }
+
+    // The handler set is compared as a set, so registration order does not matter.
+    foreach(EventHandlerDescriptorConstPtr handler, eventHandlers) {
+        features.append(combine(combine(EVENT_HANDLER_FEATURE, qHash(handler->getName())), qHash(handler->xPathToElement())));
+    }
+
+    quint64 hash = 0;
+    foreach(quint64 feature, features) {
+        hash += feature;
+    }
+
+    return PageStateFingerprint(hash, simHash(features));
+}
+
+void PageStateAbstraction::addElementFeatures(const QWebElement& root, uint rootDepth, QList<quint64>& features) const
+{
+    QList<QPair<QWebElement, uint> > worklist;
+    worklist.append(QPair<QWebElement, uint>(root, rootDepth));
+
+    while (!worklist.isEmpty()) {
+        QPair<QWebElement, uint> current = worklist.takeLast();
+        const QWebElement& element = current.first;
+
+        if (element.isNull()) {
+            continue;
+        }
+
+        QString tagName = element.tagName().toLower();
+        quint64 feature = combine(combine(ELEMENT_FEATURE, current.second), qHash(tagName));
+
+        quint64 attributes = 0;
+        foreach(QString name, element.attributeNames()) {
+            QString lowerName = name.toLower();
+            quint64 attribute = qHash(lowerName);
+
+            if (!mIgnoredAttributes.contains(lowerName)) {
+                attribute = combine(attribute, normalisedValueHash(element.attribute(name)));
+            }
+
+            attributes += mix(attribute);
+        }
+
+        feature = combine(feature, attributes);
+        features.append(feature);
+
+        if (tagName == "input" || tagName == "textarea" || tagName == "select") {
+            addFormFieldFeature(element, feature, features);
+        }
+
+        for (QWebElement child = element.firstChild(); !child.isNull(); child = child.nextSibling()) {
+            worklist.append(QPair<QWebElement, uint>(child, current.second + 1));
+        }
+    }
+}
+
+void PageStateAbstraction::addFormFieldFeature(const QWebElement& element, quint64 elementFeature, QList<quint64>& features) const
+{
+    QString type = element.attribute("type").toLower();
+
+    // Read natively, evaluating JavaScript here would show up in the coverage and traces of the page.
+    quint64 value;
+    if (type == "checkbox" || type == "radio") {
+        value = element.formChecked() ? 1 : 0;
+    } else {
+        value = qHash(element.formValue());
+    }
+
+    features.append(combine(combine(FORM_VALUE_FEATURE, elementFeature), value));
+}
+
+/**
+ * Hash of an attribute value where every run of digits is replaced by a single placeholder.
+ */
+quint64 PageStateAbstraction::normalisedValueHash(const QString& value)
+{
+    quint64 hash = 0xcbf29ce484222325ULL;
+    bool inDigits = false;
+
+    for (int i = 0; i < value.length(); i++) {
+        ushort c = value.at(i).unicode();
+
+        if (c >= '0' && c <= '9') {
+            if (inDigits) {
+                continue;
+            }
+
+            inDigits = true;
+            c = '#';
+        } else {
+            inDigits = false;
+        }
+
+        hash = (hash ^ c) * 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+/**
+ * Charikar's SimHash: every bit of the fingerprint is the majority vote of that bit over all features.
+ */
+quint64 PageStateAbstraction::simHash(const QList<quint64>& features)
+{
+    int votes[64] = {0};
+
+    foreach(quint64 feature, features) {
+        quint64 bits = mix(feature);
+
+        for (int i = 0; i < 64; i++) {
+            votes[i] += (bits >> i) & 1 ? 1 : -1;
+        }
+    }
+
+    quint64 result = 0;
+    for (int i = 0; i < 64; i++) {
+        if (votes[i] > 0) {
+            result |= 1ULL << i;
+        }
+    }
+
+    return result;
+}
+
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef PAGESTATEABSTRACTION_H
+#define PAGESTATEABSTRACTION_H
+
+#include <QSet>
+#include <QList>
+#include <QString>
+#include <QSharedPointer>
+#include <QWebFrame>
+#include <QWebElement>
+
+#include "runtime/input/events/eventhandlerdescriptor.h"
+
+namespace artemis
+{
+
+/**
+ * The abstract state of a page after an execution.
+ *
+ * hash identifies the abstract state exactly. simHash is a locality sensitive fingerprint of the same
+ * features, so states differing in a few features have fingerprints with a small Hamming distance.
+ */
+struct PageStateFingerprint {
+
+    PageStateFingerprint() :
+        hash(0),
+        simHash(0)
+    {}
+
+    PageStateFingerprint(quint64 hash, quint64 simHash) :
+        hash(hash),
+        simHash(simHash)
+    {}
+
+    quint64 hash;
+    quint64 simHash;
+};
+
+/**
+ * Maps a concrete page to a PageStateFingerprint which ignores the volatile parts of the page.
+ *
+ * The abstraction consists of the element structure (tag names, attribute names and attribute values),
+ * the values of form fields and the set of registered event handlers. Text content is ignored, as is the
+ * value of any attribute in the ignored set. Digit runs in attribute values are collapsed, so generated
+ * ids, counters and timestamps in attributes do not distinguish states.
+ */
+class PageStateAbstraction
+{
+
+public:
+    PageStateAbstraction(const QSet<QString>& ignoredAttributes);
+
+    inline QString getName() const {
+        return "structure";
+    }
+
+    PageStateFingerprint fingerprint(QWebFrame* mainFrame, const QList<EventHandlerDescriptorConstPtr>& eventHandlers) const;
+
+    static quint64 simHash(const QList<quint64>& features);
+
+private:
+    void addElementFeatures(const QWebElement& element, uint depth, QList<quint64>& features) const;
+    void addFormFieldFeature(const QWebElement& element, quint64 elementFeature, QList<quint64>& features) const;
+
+    static quint64 normalisedValueHash(const QString& value);
+
+    QSet<QString> mIgnoredAttributes;
+};
+
+typedef QSharedPointer<PageStateAbstraction> PageStateAbstractionPtr;
+typedef QSharedPointer<const PageStateAbstraction> PageStateAbstractionConstPtr;
+
+}
+
+#endif // PAGESTATEABSTRACTION_H
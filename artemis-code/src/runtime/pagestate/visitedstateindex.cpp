@@ -0,0 +1,78 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <assert.h>
+
+#include "visitedstateindex.h"
+
+namespace artemis
+{
+
+VisitedStateIndex::VisitedStateIndex(uint maxDistance) :
+    mMaxDistance(maxDistance)
+{
+    assert(maxDistance <= MAX_DISTANCE);
+
+    // The last block absorbs the remainder when 64 is not divisible by the number of blocks.
+    mBlockWidth = 64 / (maxDistance + 1);
+}
+
+VisitResult VisitedStateIndex::visit(const PageStateFingerprint& state)
+{
+    if (mExact.contains(state.hash)) {
+        return VISITED_EXACT;
+    }
+
+    bool approximate = mMaxDistance > 0 && findApproximate(state.simHash);
+
+    // Approximate matches are recorded as well, so later exact repeats of the state are cheap to find.
+    mExact.insert(state.hash);
+
+    if (mMaxDistance > 0) {
+        for (uint block = 0; block <= mMaxDistance; block++) {
+            mBlocks.insert(blockKey(block, state.simHash), state.simHash);
+        }
+    }
+
+    return approximate ? VISITED_APPROXIMATE : NEW_STATE;
+}
+
+bool VisitedStateIndex::findApproximate(quint64 simHash) const
+{
+    for (uint block = 0; block <= mMaxDistance; block++) {
+        quint64 key = blockKey(block, simHash);
+        QMultiHash<quint64, quint64>::const_iterator it = mBlocks.find(key);
+
+        for (; it != mBlocks.end() && it.key() == key; ++it) {
+            if ((uint)__builtin_popcountll(it.value() ^ simHash) <= mMaxDistance) {
+                return true;
+            }
+        }
+    }
+
+    return false;
+}
+
+quint64 VisitedStateIndex::blockKey(uint block, quint64 simHash) const
+{
+    uint shift = block * mBlockWidth;
+    uint width = block == mMaxDistance ? 64 - shift : mBlockWidth;
+    quint64 mask = width == 64 ? ~0ULL : (1ULL << width) - 1;
+
+    return ((simHash >> shift) & mask) * (MAX_DISTANCE + 1) + block;
+}
+
+}
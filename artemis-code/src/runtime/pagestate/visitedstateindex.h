@@ -0,0 +1,69 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef VISITEDSTATEINDEX_H
+#define VISITEDSTATEINDEX_H
+
+#include <QSet>
+#include <QHash>
+
+#include "runtime/pagestate/pagestateabstraction.h"
+
+namespace artemis
+{
+
+enum VisitResult {
+    NEW_STATE, VISITED_EXACT, VISITED_APPROXIMATE
+};
+
+/**
+ * The set of page states visited so far.
+ *
+ * States are matched exactly on their hash. If a maximum distance k > 0 is given, a state is also
+ * considered visited if a visited state has a simHash within Hamming distance k.
+ *
+ * The approximate lookup splits the 64 bit fingerprint into k+1 blocks. Two fingerprints within
+ * distance k agree on at least one whole block, so only the states sharing a block with the query
+ * are compared.
+ */
+class VisitedStateIndex
+{
+
+public:
+    VisitedStateIndex(uint maxDistance);
+
+    VisitResult visit(const PageStateFingerprint& state);
+
+    inline int size() const {
+        return mExact.size();
+    }
+
+    static const uint MAX_DISTANCE = 7;
+
+private:
+    bool findApproximate(quint64 simHash) const;
+    quint64 blockKey(uint block, quint64 simHash) const;
+
+    uint mMaxDistance;
+    uint mBlockWidth;
+
+    QSet<quint64> mExact;
+    QMultiHash<quint64, quint64> mBlocks; // <block key, simHash>
+};
+
+}
+
+#endif // VISITEDSTATEINDEX_H
@@ -31,6 +31,7 @@
 
 #include "statistics/statsstorage.h"
 #include "statistics/writers/pretty.h"
+#include "statistics/writers/json.h"
 
 #include "strategies/inputgenerator/randominputgenerator.h"
 #include "strategies/inputgenerator/event/staticeventparametergenerator.h"
@@ -48,6 +49,7 @@
 #include "concolic/solver/z3solver.h"
 #include "concolic/solver/kaluzasolver.h"
 #include "concolic/solver/cvc4solver.h"
+#include "concolic/solver/portfoliosolver.h"
 #include "concolic/pathcondition.h"
 
 #include "runtime.h"
@@ -103,6 +105,26 @@ Runtime::Runtime(QObject* parent, const Options& options, const QUrl& url) : QOb
                                          enableConstantStringInstrumentation,
                                          enablePropertyAccessInstrumentation);
 
+    // DOM modification annotations are only used by the execution trees in the concolic and demo modes.
+    mWebkitExecutor->setDomModificationTraceEnabled(options.majorMode != AUTOMATED);
+
+    if (options.virtualTimeHorizon >= 0) {
+        mWebkitExecutor->enableVirtualTime(options.virtualTimeHorizon);
+    }
+
+    // The manual mode shows the page, so it always needs a view.
+    if (options.headless && options.majorMode != MANUAL) {
+        mWebkitExecutor->getPage()->setHeadless(QSize(1024, 768));
+    }
+
+    // Code excluded from coverage only needs the per bytecode instrumentation once it touches symbolic values.
+    QSet<QString> uninstrumentedUrls;
+    uninstrumentedUrls.insert(DONT_MEASURE_COVERAGE);
+    foreach(QUrl ignoredUrl, options.coverageIgnoreUrls) {
+        uninstrumentedUrls.insert(ignoredUrl.toString());
+    }
+    mWebkitExecutor->mWebkitListener->setUninstrumentedUrls(uninstrumentedUrls);
+
     if(options.reportHeap != NO_CALLS){
         mWebkitExecutor->mWebkitListener->enableHeapReport(options.reportHeap == NAMED_CALLS, 0, options.heapReportFactor);
     }
@@ -200,6 +222,11 @@ void Runtime::done()
 
     statistics()->accumulate("WebKit::coverage::covered-unique", mAppmodel->getCoverageListener()->getNumCoveredLines());
 
+    QMap<QString, uint> symbolicInstructions = mWebkitExecutor->mWebkitListener->getSymbolicInstructionCounts();
+    foreach (QString opcode, symbolicInstructions.keys()) {
+        statistics()->set("Concolic::SymbolicInstructions::" + opcode, (int)symbolicInstructions.value(opcode));
+    }
+
     // solve the last PC - this is needed by some system tests
     PathConditionPtr pc = PathCondition::createFromTrace(mWebkitExecutor->getTraceBuilder()->trace());
 
@@ -246,6 +273,10 @@ void Runtime::done()
     StatsPrettyWriter::write(statistics());
     Log::info("\n=== Statistics END ===\n\n");
 
+    if (!mOptions.statisticsJsonFile.isEmpty()) {
+        StatsJsonWriter::write(statistics(), mOptions.statisticsJsonFile);
+    }
+
     Log::info("\n=== Last pathconditions ===\n");
     Log::info(pc->toStatisticsString());
     Log::info("=== Last pathconditions END ===\n\n");
@@ -260,17 +291,32 @@ void Runtime::done()
 
 SolverPtr Runtime::getSolver(const Options& options)
 {
+    SolverPtr solver;
+
     switch(options.solver) {
     case Z3STR:
-        return Z3SolverPtr(new Z3Solver());
+        solver = Z3SolverPtr(new Z3Solver());
+        break;
     case KALUZA:
-        return KaluzaSolverPtr(new KaluzaSolver());
+        solver = KaluzaSolverPtr(new KaluzaSolver());
+        break;
     case CVC4:
-        return CVC4SolverPtr(new CVC4Solver());
+        solver = CVC4SolverPtr(new CVC4Solver());
+        break;
+    case PORTFOLIO: {
+        QList<ProcessSolverPtr> solvers;
+        solvers.append(CVC4SolverPtr(new CVC4Solver()));
+        solvers.append(Z3SolverPtr(new Z3Solver()));
+        solver = PortfolioSolverPtr(new PortfolioSolver(solvers));
+        break;
+    }
     default:
         cerr << "Unknown solver selected" << std::endl;
         exit(1);
     }
+
+    solver->setTimeout(options.solverTimeout);
+    return solver;
 }
 
 void Runtime::slAbortedExecution(QString reason)
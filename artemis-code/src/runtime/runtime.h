@@ -58,7 +58,6 @@ protected:
 
     AppModelPtr mAppmodel;
     WebKitExecutor* mWebkitExecutor;
-    set<long> mVisitedStates;
 
     TerminationStrategy* mTerminationStrategy;
     PrioritizerStrategyPtr mPrioritizerStrategy;
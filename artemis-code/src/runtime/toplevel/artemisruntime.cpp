@@ -25,9 +25,20 @@ namespace artemis
 
 ArtemisRuntime::ArtemisRuntime(QObject* parent, const Options& options, const QUrl& url) :
     Runtime(parent, options, url),
-    mEntryPointDetector(mWebkitExecutor->getPage())
+    mEntryPointDetector(mWebkitExecutor->getPage()),
+    mStateAbstractionName("dom"),
+    mVisitedStates(options.stateAbstraction == STATE_STRUCTURE ? options.stateApproximateDistance : 0)
 {
     mIterations = 1;
+
+    if (!options.disableStateCheck && options.stateAbstraction == STATE_STRUCTURE) {
+        PageStateAbstractionConstPtr abstraction = PageStateAbstractionConstPtr(new PageStateAbstraction(options.stateIgnoredAttributes));
+        mStateAbstractionName = abstraction->getName();
+        mWebkitExecutor->setPageStateAbstraction(abstraction);
+    } else if (options.stateApproximateDistance > 0) {
+        Log::warning("Approximate state matching is only supported by the structure abstraction, using exact matching");
+    }
+
     QObject::connect(mWebkitExecutor, SIGNAL(sigExecutedSequence(ExecutableConfigurationConstPtr, QSharedPointer<ExecutionResult>)),
                      this, SLOT(postConcreteExecution(ExecutableConfigurationConstPtr, QSharedPointer<ExecutionResult>)));
 
@@ -85,6 +96,7 @@ void ArtemisRuntime::preConcreteExecution()
     cout.flush();
 
     mIterations++;
+    statistics()->accumulate("Runtime::iterations", 1);
     Log::debug("\n============= New-Iteration =============");
     Log::debug("--------------- WORKLIST ----------------\n");
     Log::debug(mWorklist->toString().toStdString());
@@ -104,16 +116,23 @@ void ArtemisRuntime::postConcreteExecution(ExecutableConfigurationConstPtr confi
 
     if (!mOptions.disableStateCheck) {
 
-        long hash = result->getPageStateHash();
-        if (mVisitedStates.find(hash) != mVisitedStates.end()) {
+        QString statsPrefix = "StateAbstraction::" + mStateAbstractionName + "::";
+
+        VisitResult visit = mVisitedStates.visit(result->getPageStateFingerprint());
+        if (visit != NEW_STATE) {
 
             qDebug() << "Page state has already been seen";
+            statistics()->accumulate(statsPrefix + "pruned-iterations", 1);
+            if (visit == VISITED_APPROXIMATE) {
+                statistics()->accumulate(statsPrefix + "approximate-matches", 1);
+            }
+
             preConcreteExecution();
             return;
         }
 
         qDebug() << "Visiting new state";
-        mVisitedStates.insert(hash);
+        statistics()->accumulate(statsPrefix + "visited-states", 1);
     }
 
     // FormCrawl (generate statistics)
@@ -20,6 +20,7 @@
 #include "runtime/worklist/worklist.h"
 
 #include "runtime/runtime.h"
+#include "runtime/pagestate/visitedstateindex.h"
 #include "concolic/entrypoints.h"
 
 namespace artemis
@@ -49,6 +50,9 @@ protected:
 private:
     int mIterations;
 
+    QString mStateAbstractionName;
+    VisitedStateIndex mVisitedStates;
+
 private slots:
     void postConcreteExecution(ExecutableConfigurationConstPtr configuration, QSharedPointer<ExecutionResult> result);
 
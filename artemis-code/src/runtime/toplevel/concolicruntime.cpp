@@ -17,9 +17,12 @@
 #include <fstream>
 #include <assert.h>
 
+#include <QFileInfo>
+
 #include "util/loggingutil.h"
 #include "concolic/executiontree/tracemerger.h"
 #include "concolic/solver/cvc4solver.h"
+#include "concolic/tracestatistics.h"
 #include "statistics/statsstorage.h"
 
 #include "concolicruntime.h"
@@ -30,6 +33,10 @@ namespace artemis
 
 ConcolicRuntime::ConcolicRuntime(QObject* parent, const Options& options, const QUrl& url)
     : Runtime(parent, options, url)
+    , mResumingFromCheckpoint(false)
+    , mCheckpointSize(0)
+    , mCurrentExploration(0)
+    , mFrontier(0)
     , mNumIterations(0)
 {
     QObject::connect(mWebkitExecutor, SIGNAL(sigExecutedSequence(ExecutableConfigurationConstPtr, QSharedPointer<ExecutionResult>)),
@@ -42,8 +49,11 @@ ConcolicRuntime::ConcolicRuntime(QObject* parent, const Options& options, const
     // renders the site being tested. It is required to have proper geometry in order to click correctly on elements.
     // Without this the "bare" ArtemisWebPage is laid out correctly but the document element has zero size, so any
     // click is outside its boundary and is not recognised.
-    mWebView = ArtemisWebViewPtr(new ArtemisWebView());
-    mWebView->setPage(mWebkitExecutor->getPage().data());
+    // A headless page has a fixed viewport instead (see ArtemisWebPage::setHeadless).
+    if (!options.headless) {
+        mWebView = ArtemisWebViewPtr(new ArtemisWebView());
+        mWebView->setPage(mWebkitExecutor->getPage().data());
+    }
     //mWebView->resize(1000,1000);
     //mWebView->show();
 
@@ -52,6 +62,37 @@ ConcolicRuntime::ConcolicRuntime(QObject* parent, const Options& options, const
     mSearchPasses = 3;
     mSearchPassesUnlimited = mOptions.concolicUnlimitedDepth;
     mSearchFoundTarget = false;
+
+    mSolverBudget = mOptions.solverTimeout;
+    mSolverEscalations = 0;
+    mSolverTimeoutsPending = false;
+
+    mLocalSearchSolver = LocalSearchSolverPtr(new LocalSearchSolver(getSolver(mOptions), mOptions.solverLocalSearchBudget));
+    SolverPtr solver = mLocalSearchSolver;
+    if (mOptions.solverQueryCache) {
+        mSolverCache = CachingSolverPtr(new CachingSolver(mLocalSearchSolver));
+        solver = mSolverCache;
+    }
+    mSolver = mOptions.solverSimplify ? SolverPtr(new SimplifyingSolver(solver)) : solver;
+
+    if (!mOptions.solverCacheFile.isEmpty() && mSolverCache.isNull()) {
+        Log::error("Error: The solver cache file is not used when the query cache is off.");
+    } else if (!mOptions.solverCacheFile.isEmpty() && mSolverCache->load(mOptions.solverCacheFile, url.toString())) {
+        Log::info(QString("Loaded %1 cached solver results.").arg(mSolverCache->size()).toStdString());
+    }
+
+    if (!mOptions.concolicCheckpointFile.isEmpty() && mOptions.concolicAllEntryPoints) {
+        Log::error("Error: Checkpoints are not supported when exploring all entry points, no checkpoint will be used.");
+    } else if (!mOptions.concolicCheckpointFile.isEmpty() && QFile::exists(mOptions.concolicCheckpointFile)) {
+        mSymbolicExecutionGraph = TraceCheckpoint::load(mOptions.concolicCheckpointFile, url.toString(), mCheckpointState);
+        mResumingFromCheckpoint = !mSymbolicExecutionGraph.isNull();
+
+        if (mResumingFromCheckpoint) {
+            Log::info(QString("Resuming from the execution tree of %1 earlier iterations.").arg(mCheckpointState.iterations).toStdString());
+        } else {
+            Log::error(QString("Error: Could not load the execution tree from %1, starting a new tree.").arg(mOptions.concolicCheckpointFile).toStdString());
+        }
+    }
 }
 
 void ConcolicRuntime::run(const QUrl& url)
@@ -64,8 +105,11 @@ void ConcolicRuntime::run(const QUrl& url)
 
     mNextConfiguration = QSharedPointer<ExecutableConfiguration>(new ExecutableConfiguration(QSharedPointer<InputSequence>(new InputSequence()), url));
 
+    QString date = QDateTime::currentDateTime().toString("yyyy-MM-dd-hh-mm-ss");
     mGraphOutputIndex = 1;
-    mGraphOutputNameFormat = QString("tree-%1_%2%3-%4.gv").arg(QDateTime::currentDateTime().toString("yyyy-MM-dd-hh-mm-ss"));
+    mGraphOutputNameFormat = QString("tree-%1_%2%3-%4.gv").arg(date);
+
+    mTreeLogNameFormat = QString("tree-%1%2.log").arg(date);
 
     std::ofstream constraintLog;
     constraintLog.open("/tmp/constraintlog", std::ofstream::out | std::ofstream::app);
@@ -132,8 +176,9 @@ void ConcolicRuntime::postConcreteExecution(ExecutableConfigurationConstPtr conf
         // Sets up the search procedure and tree on the first run (when mRunningWithInitialValues is set).
         mergeTraceIntoTree();
 
-        // Choose the next node to explore
-        chooseNextTargetAndExplore();
+        // Choose the next node to explore, for this or another entry point.
+        mExplorations[mCurrentExploration].iterations++;
+        scheduleNextExploration();
 
     }
 
@@ -145,15 +190,12 @@ void ConcolicRuntime::postConcreteExecution(ExecutableConfigurationConstPtr conf
 
 
 
-// Utility method to output the tree graph at each step.
+// Utility method to output the tree graph.
 void ConcolicRuntime::outputTreeGraph()
 {
-    if(mOptions.concolicTreeOutput == TREE_NONE){
+    if(mOptions.concolicTreeOutput == TREE_NONE || mSymbolicExecutionGraph.isNull()){
         return;
     }
-    // Output the graphs, and if we are in TREE_FINAL mode, then delete the older ones.
-    // We do it like this to make sure there is always an up-to-date version of the tree saved out either for
-    // viewing the progress or in case of crashes.
 
     // We want all the graphs from a certain run to have the same "base" name and an increasing index, so they can be easily grouped.
     QString name = mGraphOutputNameFormat.arg("").arg(mNumIterations).arg(mGraphOutputIndex);
@@ -161,25 +203,60 @@ void ConcolicRuntime::outputTreeGraph()
     Log::debug(QString("CONCOLIC-INFO: Writing tree to file %1").arg(name).toStdString());
     mGraphOutputIndex++;
 
-    QString previous_name = mGraphOutputPreviousName;
-    QString previous_name_min = mGraphOutputOverviewPreviousName;
-
     mTraceDisplay.writeGraphFile(mSymbolicExecutionGraph, name, false);
-    mGraphOutputPreviousName = name;
     if(mOptions.concolicTreeOutputOverview){
         mTraceDisplayOverview.writeGraphFile(mSymbolicExecutionGraph, name_min, false);
-        mGraphOutputOverviewPreviousName = name_min;
     }
+}
 
-    if(mOptions.concolicTreeOutput == TREE_FINAL){
-        // Delete the older graph files.
-        if(!previous_name.isEmpty()){ // Empty if we have not written a graph yet.
-            QFile::remove(previous_name);
-        }
-        if(!previous_name_min.isEmpty()){ // Empty if we have not written a graph yet.
-            QFile::remove(previous_name_min);
+// Replays a tree log, writing a graph after each change to the tree (for TREE_ALL) and of the final tree.
+bool ConcolicRuntime::renderTreeLog(const QString& fileName, const Options& options)
+{
+    TraceEventLogReader reader(fileName);
+    if(!reader.open()){
+        Log::error(QString("Error: Could not read the tree log %1.").arg(fileName).toStdString());
+        return false;
+    }
+
+    QString base = fileName;
+    if(base.endsWith(".log")){
+        base.chop(4);
+    }
+    QString nameFormat = QString("%1_%2%3.gv").arg(base);
+
+    TraceDisplay display;
+    TraceDisplayOverview displayOverview;
+    int step = 0;
+
+    while(reader.next()){
+        step++;
+        if(options.concolicTreeOutput == TREE_ALL){
+            QString name = nameFormat.arg("").arg(step);
+            display.writeGraphFile(reader.getTree(), name, false);
+            if(options.concolicTreeOutputOverview){
+                QString name_min = nameFormat.arg("min_").arg(step);
+                displayOverview.writeGraphFile(reader.getTree(), name_min, false);
+            }
         }
     }
+
+    if(!reader.atEnd()){
+        Log::error(QString("Error: The tree log %1 is incomplete after %2 changes.").arg(fileName).arg(step).toStdString());
+    }
+
+    if(reader.getTree().isNull() || options.concolicTreeOutput == TREE_NONE){
+        return reader.atEnd();
+    }
+
+    QString name = nameFormat.arg("").arg("final");
+    display.writeGraphFile(reader.getTree(), name, false);
+    if(options.concolicTreeOutputOverview){
+        QString name_min = nameFormat.arg("min_").arg("final");
+        displayOverview.writeGraphFile(reader.getTree(), name_min, false);
+    }
+
+    Log::info(QString("Generated the graphs of %1 changes to the tree.").arg(step).toStdString());
+    return reader.atEnd();
 }
 
 
@@ -241,9 +318,8 @@ void ConcolicRuntime::postInitialConcreteExecution(QSharedPointer<ExecutionResul
     QList<FormInputPair > inputs;
     FormInputCollectionPtr formInput = FormInputCollectionPtr(new FormInputCollection(inputs));
 
-    // On the next iteration, we will be running with initial values.
+    // On the next iteration, we will be running with initial values (see Exploration).
     mRunningFirstLoad = false;
-    mRunningWithInitialValues = true;
 
     // If we are using automatic entry-point finding, then detect them here.
     // If we use a manual XPath then we don't need to do anything about entry-points yet, it is dealt with in ClickInput.
@@ -251,15 +327,20 @@ void ConcolicRuntime::postInitialConcreteExecution(QSharedPointer<ExecutionResul
 
         Log::debug("Analysing page entrypoints...");
 
-        // Choose and save the entry point for use in future runs.
-        MockEntryPointDetector detector(mWebkitExecutor->getPage());
-        mEntryPointEvent = detector.choose(result);
-
-        if(mEntryPointEvent){
-            Log::debug(QString("Chose entry point %1").arg(mEntryPointEvent->toString()).toStdString());
-            Log::info(QString("  Entry point: %1").arg(mEntryPointEvent->toString()).toStdString());
-
+        // Choose and save the entry point(s) for use in future runs.
+        QList<EventHandlerDescriptorConstPtr> entryPoints;
+        if(mOptions.concolicAllEntryPoints){
+            EntryPointDetector detector(mWebkitExecutor->getPage());
+            entryPoints = detector.detectAll(result);
         }else{
+            MockEntryPointDetector detector(mWebkitExecutor->getPage());
+            EventHandlerDescriptorConstPtr entryPoint = detector.choose(result);
+            if(entryPoint){
+                entryPoints.append(entryPoint);
+            }
+        }
+
+        if(entryPoints.empty()){
             Log::debug("\n========== No Entry Points ==========");
             Log::debug("Could not find any suitable entry point for the analysis on this page. Exiting.");
             Log::info("No entry points detected.");
@@ -269,10 +350,20 @@ void ConcolicRuntime::postInitialConcreteExecution(QSharedPointer<ExecutionResul
             return;
         }
 
+        foreach(EventHandlerDescriptorConstPtr entryPoint, entryPoints){
+            Log::debug(QString("Chose entry point %1").arg(entryPoint->toString()).toStdString());
+            Log::info(QString("  Entry point: %1").arg(entryPoint->toString()).toStdString());
+            addExploration(entryPoint);
+        }
+
     }else{
         Log::info(QString("  Entry point: %1").arg(mManualEntryPointXPath).toStdString());
+        addExploration(EventHandlerDescriptorConstPtr());
     }
 
+    statistics()->accumulate("Concolic::EntryPoints", mExplorations.size());
+    loadExploration(0);
+
     // Create the new event sequence and set mNextConfiguration.
     setupNextConfiguration(formInput);
 
@@ -281,6 +372,77 @@ void ConcolicRuntime::postInitialConcreteExecution(QSharedPointer<ExecutionResul
 }
 
 
+// Saves the tree and the search state, so the run can be resumed from this point.
+void ConcolicRuntime::saveCheckpoint(bool compact)
+{
+    if(mOptions.concolicCheckpointFile.isEmpty() || mOptions.concolicAllEntryPoints || mSearchStrategy.isNull()){
+        return;
+    }
+
+    TraceCheckpoint::SearchState state;
+    state.iterations = mCheckpointState.iterations + mNumIterations;
+    state.depthLimit = mSearchStrategy->getDepthLimit();
+    state.searchPasses = mSearchPasses;
+    state.solverBudget = mSolverBudget;
+    state.solverEscalations = mSolverEscalations;
+    state.solverTimeoutsPending = mSolverTimeoutsPending;
+
+    // The changes to the tree since the last full save are already in the journal.
+    if(!compact && mCheckpointJournal.isOpen() && mCheckpointJournal.size() < mCheckpointSize){
+        mCheckpointJournal.addState(state);
+        return;
+    }
+
+    mCheckpointJournal.close();
+
+    quint64 stamp;
+    if(!TraceCheckpoint::save(mOptions.concolicCheckpointFile, mUrl.toString(), mSymbolicExecutionGraph, state, &stamp)){
+        Log::error(QString("Error: Could not save the execution tree to %1.").arg(mOptions.concolicCheckpointFile).toStdString());
+        return;
+    }
+
+    mCheckpointSize = QFileInfo(mOptions.concolicCheckpointFile).size();
+
+    QString journalName = TraceCheckpoint::journalFileName(mOptions.concolicCheckpointFile);
+    if(!compact && !mCheckpointJournal.open(journalName, stamp)){
+        Log::error(QString("Error: Could not open the checkpoint journal %1, the checkpoint will be saved in full.").arg(journalName).toStdString());
+    }
+}
+
+void ConcolicRuntime::logTrace(TraceNodePtr trace)
+{
+    mTreeLog->addTrace(trace);
+    mCheckpointJournal.addTrace(trace);
+}
+
+// Called before the search marks its target, as the frontier is updated from the node which is replaced.
+void ConcolicRuntime::logMarker(TraceNodePtr marker)
+{
+    if(mSearchStrategy->overFrontierNode()){
+        mFrontier--;
+    }
+
+    mTreeLog->addMarker(mSearchStrategy->getTargetPath(), marker);
+    mCheckpointJournal.addMarker(mSearchStrategy->getTargetPath(), marker);
+}
+
+// Restores the search state saved with the checkpoint.
+// The search itself restarts from the root, the explored, unsat, unsolvable and timed out nodes it has already
+// visited are all recorded in the tree, so it continues with the remaining unexplored nodes.
+void ConcolicRuntime::resumeSearchState()
+{
+    mSearchStrategy->setDepthLimit(mCheckpointState.depthLimit);
+    mSearchPasses = mCheckpointState.searchPasses;
+    mSolverBudget = mCheckpointState.solverBudget;
+    mSolverEscalations = mCheckpointState.solverEscalations;
+    mSolverTimeoutsPending = mCheckpointState.solverTimeoutsPending;
+
+    if(mSolverEscalations > 0){
+        mSearchStrategy->setRetryBudget(mSolverBudget);
+    }
+}
+
+
 // Creates the tree and sets up the search procedure and merges new traces into the tree.
 void ConcolicRuntime::mergeTraceIntoTree()
 {
@@ -299,6 +461,9 @@ void ConcolicRuntime::mergeTraceIntoTree()
         Log::info("  Recorded trace was classified as UNKNOWN.");
     }
 
+    // Logged before merging, as merging may link the trace into the tree.
+    logTrace(trace);
+
 
     // Now we must merge this trace into the tree.
     if(mRunningWithInitialValues){
@@ -306,25 +471,38 @@ void ConcolicRuntime::mergeTraceIntoTree()
         // We can't just begin with an empty tree and merge every trace in, as the search procedure needs a
         // pointer to the tree, which will be replaced in that case.
         // If this is a problem, we could just introduce a header node for trees.
-        mSymbolicExecutionGraph = trace;
-        mSearchStrategy = DepthFirstSearchPtr(new DepthFirstSearch(mSymbolicExecutionGraph));
-        mRunningWithInitialValues = false;
+        if(mResumingFromCheckpoint){
+            int frontierChange;
+            mSymbolicExecutionGraph = TraceMerger::merge(trace, mSymbolicExecutionGraph, &frontierChange);
+            mFrontier += frontierChange;
+            mSearchStrategy = DepthFirstSearchPtr(new DepthFirstSearch(mSymbolicExecutionGraph));
+            resumeSearchState();
+        }else{
+            TraceStatistics stats;
+            stats.processTrace(trace);
+            mFrontier = stats.mNumUnexploredSymBranches;
 
-        statistics()->accumulate("Concolic::ExecutionTree::DistinctTracesExplored", 1);
+            mSymbolicExecutionGraph = trace;
+            mSearchStrategy = DepthFirstSearchPtr(new DepthFirstSearch(mSymbolicExecutionGraph));
+            statistics()->accumulate("Concolic::ExecutionTree::DistinctTracesExplored", 1);
+        }
+        mRunningWithInitialValues = false;
     }else{
         // A normal run.
         // Merge trace with tracegraph
-        mSymbolicExecutionGraph = TraceMerger::merge(trace, mSymbolicExecutionGraph);
+        int frontierChange;
+        mSymbolicExecutionGraph = TraceMerger::merge(trace, mSymbolicExecutionGraph, &frontierChange);
+        mFrontier += frontierChange;
 
         // Check if we actually explored the intended target.
         if(mSearchStrategy->overUnexploredNode()){
+            logMarker(TraceUnexploredMissed::getInstance());
             mSearchStrategy->markNodeMissed();
             Log::info("  Recorded trace did not take the expected path.");
         }
     }
 
-    // Dump the current state of the tree to a file.
-    outputTreeGraph();
+    saveCheckpoint();
 }
 
 
@@ -476,8 +654,8 @@ void ConcolicRuntime::exploreNextTarget()
     Log::debug(varList.join(", ").toStdString());
 
     // Try to solve this PC to get some concrete input.
-    SolverPtr solver = getSolver(mOptions);
-    SolutionPtr solution = solver->solve(target);
+    mSolver->setTimeout(mSolverBudget);
+    SolutionPtr solution = mSolver->solve(target);
 
     if(solution->isSolved()) {
         Log::debug("Solved the target PC:");
@@ -486,6 +664,8 @@ void ConcolicRuntime::exploreNextTarget()
         // Print this solution
         printSolution(solution, varList);
 
+        mLocalSearchSolver->addSeed(solution);
+
 
         QSharedPointer<FormInputCollection> formInput = createFormInput(freeVariables, solution);
         setupNextConfiguration(formInput);
@@ -497,17 +677,23 @@ void ConcolicRuntime::exploreNextTarget()
         // Mark the current node as unsolvable.
         // If it was solved but unsatisfiable, then mark it as UNSAT instead.
         if(solution->isUnsat()){
+            logMarker(TraceUnexploredUnsat::getInstance());
             mSearchStrategy->markNodeUnsat();
             Log::info("  Constraint is UNSAT.");
+        }else if(solution->isTimeout()){
+            logMarker(TraceNodePtr(new TraceUnexploredTimeout(mSolverBudget)));
+            mSearchStrategy->markNodeTimeout(mSolverBudget);
+            mSolverTimeoutsPending = true;
+            Log::info(QString("  Solver timed out after %1 ms.").arg(mSolverBudget).toStdString());
         }else{
+            logMarker(TraceUnexploredUnsolvable::getInstance());
             mSearchStrategy->markNodeUnsolvable();
             Log::info("  Could not solve constraint:");
             Log::info(QString("    %1").arg(solution->getUnsolvableReason()).toStdString());
         }
         Log::debug("Skipping this target!");
 
-        // Dump the current state of the tree to a file.
-        outputTreeGraph();
+        saveCheckpoint();
 
         // Skip this node and move on to the next.
         chooseNextTargetAndExplore();
@@ -538,20 +724,184 @@ void ConcolicRuntime::chooseNextTargetAndExplore()
         mSearchStrategy->restartSearch();
         chooseNextTargetAndExplore();
 
+    }else if (mSolverTimeoutsPending && mSolverBudget > 0 && mSolverEscalations < MAX_SOLVER_ESCALATIONS){
+        // Everything cheaper has been tried, so give the solver more time on the nodes where it timed out.
+        mSolverTimeoutsPending = false;
+        mSolverEscalations++;
+        mSolverBudget *= SOLVER_ESCALATION_FACTOR;
+        statistics()->accumulate("Concolic::Solver::BudgetEscalations", 1);
+
+        Log::debug("\n============= Finished DFS ==============");
+        Log::info(QString("Finished this pass of the tree. Retrying timed out constraints with %1 ms.").arg(mSolverBudget).toStdString());
+
+        mSearchStrategy->setRetryBudget(mSolverBudget);
+        mSearchStrategy->restartSearch();
+        chooseNextTargetAndExplore();
+
     }else{
         Log::debug("\n============= Finished DFS ==============");
         Log::info("Finished serach of the tree.");
 
+        // Continues with any other entry points, or finishes the analysis if there are none left.
+        mExplorations[mCurrentExploration].finished = true;
+        scheduleNextExploration();
+    }
+}
+
+
+// Creates the tree log and search state for a new entry point. All explorations start from the search settings set
+// up in the constructor.
+void ConcolicRuntime::addExploration(EventHandlerDescriptorConstPtr entryPoint)
+{
+    Exploration exploration;
+    exploration.entryPoint = entryPoint;
+    exploration.tree = mSymbolicExecutionGraph; // Null unless it was loaded from a checkpoint.
+    exploration.searchPasses = mSearchPasses;
+    exploration.solverBudget = mSolverBudget;
+    exploration.treeLog = TraceEventLogPtr(new TraceEventLog());
+
+    // Counted once here, afterwards the frontier is kept up to date as the tree changes.
+    if(!exploration.tree.isNull()){
+        TraceStatistics stats;
+        stats.processTrace(exploration.tree);
+        exploration.frontier = stats.mNumUnexploredSymBranches;
+    }
+
+    if(mOptions.concolicTreeOutput != TREE_NONE){
+        exploration.treeLogName = mTreeLogNameFormat.arg(mOptions.concolicAllEntryPoints ? QString("-ep%1").arg(mExplorations.size() + 1) : QString(""));
+        if(!exploration.treeLog->open(exploration.treeLogName)){
+            Log::error(QString("Error: Could not open the tree log %1.").arg(exploration.treeLogName).toStdString());
+        }else if(mResumingFromCheckpoint){
+            // The log starts from the resumed tree, as if it were the first trace.
+            exploration.treeLog->addTrace(exploration.tree);
+        }
+    }
+
+    mExplorations.append(exploration);
+}
+
+void ConcolicRuntime::storeExploration()
+{
+    Exploration& exploration = mExplorations[mCurrentExploration];
+    exploration.entryPoint = mEntryPointEvent;
+    exploration.tree = mSymbolicExecutionGraph;
+    exploration.search = mSearchStrategy;
+    exploration.treeLog = mTreeLog;
+    exploration.treeLogName = mTreeLogName;
+    exploration.runningWithInitialValues = mRunningWithInitialValues;
+    exploration.searchPasses = mSearchPasses;
+    exploration.searchFoundTarget = mSearchFoundTarget;
+    exploration.solverBudget = mSolverBudget;
+    exploration.solverEscalations = mSolverEscalations;
+    exploration.solverTimeoutsPending = mSolverTimeoutsPending;
+    exploration.frontier = mFrontier;
+}
+
+void ConcolicRuntime::loadExploration(int index)
+{
+    mCurrentExploration = index;
+
+    const Exploration& exploration = mExplorations.at(index);
+    mEntryPointEvent = exploration.entryPoint;
+    mSymbolicExecutionGraph = exploration.tree;
+    mSearchStrategy = exploration.search;
+    mTreeLog = exploration.treeLog;
+    mTreeLogName = exploration.treeLogName;
+    mRunningWithInitialValues = exploration.runningWithInitialValues;
+    mSearchPasses = exploration.searchPasses;
+    mSearchFoundTarget = exploration.searchFoundTarget;
+    mSolverBudget = exploration.solverBudget;
+    mSolverEscalations = exploration.solverEscalations;
+    mSolverTimeoutsPending = exploration.solverTimeoutsPending;
+    mFrontier = exploration.frontier;
+}
+
+// Chooses the entry point to explore next and continues its exploration.
+void ConcolicRuntime::scheduleNextExploration()
+{
+    storeExploration();
+
+    int next = chooseExploration(mExplorations);
+
+    if(next < 0){
         mWebkitExecutor->detach();
         done();
         return;
     }
+
+    if(next != mCurrentExploration){
+        loadExploration(next);
+        statistics()->accumulate("Concolic::EntryPointSwitches", 1);
+        Log::info(QString("Switching to entry point %1 of %2 (%3 unexplored branches).").arg(next + 1).arg(mExplorations.size()).arg(mExplorations.at(next).frontier).toStdString());
+    }
+
+    if(mRunningWithInitialValues){
+        // The first run of an entry point uses the initial values, which seeds its tree.
+        QList<FormInputPair> inputs;
+        setupNextConfiguration(FormInputCollectionPtr(new FormInputCollection(inputs)));
+        preConcreteExecution();
+    }else{
+        chooseNextTargetAndExplore();
+    }
 }
 
 
+// Returns the index of the exploration to continue with, or -1 if they are all finished.
+// Entry points which have not run yet go first, then the one with the most unexplored symbolic branches, so the
+// iterations go where most of the tree is left to explore. Ties go to the entry point which has had fewer iterations.
+int ConcolicRuntime::chooseExploration(const QList<Exploration>& explorations)
+{
+    int next = -1;
+    for(int i = 0; i < explorations.size(); i++){
+        const Exploration& candidate = explorations.at(i);
+        if(candidate.finished){
+            continue;
+        }
+        if(next < 0){
+            next = i;
+            continue;
+        }
+
+        const Exploration& best = explorations.at(next);
+        if(best.runningWithInitialValues){
+            continue;
+        }
+        if(candidate.runningWithInitialValues
+                || candidate.frontier > best.frontier
+                || (candidate.frontier == best.frontier && candidate.iterations < best.iterations)){
+            next = i;
+        }
+    }
+    return next;
+}
+
 void ConcolicRuntime::done()
 {
     statistics()->accumulate("Concolic::Iterations", mNumIterations);
+
+    if (!mOptions.solverCacheFile.isEmpty() && !mSolverCache.isNull() && !mSolverCache->save(mOptions.solverCacheFile, mUrl.toString())) {
+        Log::error(QString("Error: Could not save the solver results to %1.").arg(mOptions.solverCacheFile).toStdString());
+    }
+
+    // Saved in full, so the final checkpoint is a single file.
+    saveCheckpoint(true);
+
+    // Write the final tree of each entry point. The logs are only kept if the graphs of the intermediate trees were asked for.
+    if(!mExplorations.empty()){
+        storeExploration();
+    }
+    for(int i = 0; i < mExplorations.size(); i++){
+        loadExploration(i);
+
+        outputTreeGraph();
+        mTreeLog->close();
+        if(mOptions.concolicTreeOutput == TREE_FINAL){
+            QFile::remove(mTreeLogName);
+        }else if(mOptions.concolicTreeOutput == TREE_ALL){
+            Log::info(QString("The tree at each iteration can be generated from %1 with --concolic-tree-render.").arg(mTreeLogName).toStdString());
+        }
+    }
+
     Runtime::done();
 }
 
@@ -22,11 +22,16 @@
 #include "concolic/executiontree/tracenodes.h"
 #include "concolic/search/searchdfs.h"
 #include "concolic/solver/solver.h"
+#include "concolic/solver/cachingsolver.h"
+#include "concolic/solver/localsearchsolver.h"
+#include "concolic/solver/simplifyingsolver.h"
 #include "concolic/entrypoints.h"
 #include "concolic/mockentrypointdetector.h"
 #include "concolic/executiontree/traceprinter.h"
 #include "concolic/executiontree/tracedisplay.h"
 #include "concolic/executiontree/tracedisplayoverview.h"
+#include "concolic/executiontree/tracecheckpoint.h"
+#include "concolic/executiontree/traceeventlog.h"
 #include "concolic/traceclassifier.h"
 
 #include "runtime/input/dominput.h"
@@ -77,6 +82,9 @@ public:
     void run(const QUrl& url);
     void done();
 
+    // Generates the graphs chosen by options.concolicTreeOutput from a tree log written by an earlier run.
+    static bool renderTreeLog(const QString& fileName, const Options& options);
+
 protected:
     void preConcreteExecution();
 
@@ -97,6 +105,20 @@ protected:
     bool mSearchPassesUnlimited; // Whether to limit the number of passes we do at all. If true, we search until there are no unexplored nodes remaining.
     bool mSearchFoundTarget;
 
+    // The solver time budget per query in ms (0 for no limit). When the search is finished and some queries timed out,
+    // the budget is escalated and the timed out nodes are searched again.
+    uint mSolverBudget;
+    int mSolverEscalations;
+    bool mSolverTimeoutsPending;
+    static const int MAX_SOLVER_ESCALATIONS = 2;
+    static const uint SOLVER_ESCALATION_FACTOR = 4;
+
+    // Shared by all queries of the run, so results can be reused between related PCs (see CachingSolver).
+    // The PCs are simplified before they are looked up in the cache.
+    SolverPtr mSolver;
+    CachingSolverPtr mSolverCache; // NULL if the query cache is off
+    LocalSearchSolverPtr mLocalSearchSolver; // Between the cache and the configured solver.
+
     // For now, we can choose between entry points specified by XPath (with --concolic-button) or the built-in EP finding.
     // If an XPath has been give, we want to skip the entry point finding run completely and use a different method for injecting clicks.
     // If mManualEntryPoint is set, then we use mEntryPointXPath and skip the first iteration, otherwise we use mEntryPointEvent.
@@ -106,13 +128,31 @@ protected:
     TraceClassifier mTraceClassifier;
 
     // Method and variables for generating a graphviz graph of the execution tree.
+    // Only the final tree is written during the run. The changes to the tree are logged as they happen instead,
+    // so the graph of any iteration can be generated afterwards (see renderTreeLog).
     void outputTreeGraph();
     TraceDisplay mTraceDisplay;
     TraceDisplayOverview mTraceDisplayOverview;
     QString mGraphOutputNameFormat;
     int mGraphOutputIndex;
-    QString mGraphOutputPreviousName;
-    QString mGraphOutputOverviewPreviousName;
+    TraceEventLogPtr mTreeLog;
+    QString mTreeLogName;
+    QString mTreeLogNameFormat;
+
+    // The tree and search state are saved after each iteration if --concolic-checkpoint is given.
+    // If a checkpoint was loaded, the first trace is merged into its tree instead of starting a new one.
+    // The changes since the last full save are appended to its journal, and the checkpoint is saved in full again
+    // once the journal has grown larger than it, so each save costs about as much as the changes it records.
+    void saveCheckpoint(bool compact = false);
+    void resumeSearchState();
+    bool mResumingFromCheckpoint;
+    TraceCheckpoint::SearchState mCheckpointState;
+    TraceEventLog mCheckpointJournal;
+    qint64 mCheckpointSize;
+
+    // Record a change to the tree in the tree log and the checkpoint journal.
+    void logTrace(TraceNodePtr trace);
+    void logMarker(TraceNodePtr marker);
 
     // Helper methods for postConcreteExecution.
     void setupNextConfiguration(QSharedPointer<FormInputCollection> formInput);
@@ -126,6 +166,42 @@ protected:
 
     QSet<QSharedPointer<const FormFieldDescriptor> > mFormFields;
 
+    // Each entry point is explored with its own tree and search state (several with --concolic-all-entry-points).
+    // The members above hold the state of the exploration which is currently running, the others are kept here and
+    // swapped in when they are scheduled. The first load, the form fields and the solvers are shared by all of them.
+    struct Exploration
+    {
+        Exploration() : runningWithInitialValues(true), searchPasses(0), searchFoundTarget(false), solverBudget(0), solverEscalations(0), solverTimeoutsPending(false), frontier(0), iterations(0), finished(false) {}
+        EventHandlerDescriptorConstPtr entryPoint;
+        TraceNodePtr tree;
+        DepthFirstSearchPtr search;
+        TraceEventLogPtr treeLog;
+        QString treeLogName;
+        bool runningWithInitialValues;
+        int searchPasses;
+        bool searchFoundTarget;
+        uint solverBudget;
+        int solverEscalations;
+        bool solverTimeoutsPending;
+        int frontier; // See mFrontier.
+        int iterations;
+        bool finished;
+    };
+    QList<Exploration> mExplorations;
+    int mCurrentExploration;
+
+    void addExploration(EventHandlerDescriptorConstPtr entryPoint);
+    void storeExploration();
+    void loadExploration(int index);
+    void scheduleNextExploration();
+    static int chooseExploration(const QList<Exploration>& explorations);
+
+    // The search frontier of the current tree, i.e. its unexplored children of symbolic branches (see TraceStatistics).
+    // It is kept up to date as traces are merged and markers placed, so the scheduler never has to count it.
+    int mFrontier;
+
+    friend class ConcolicRuntimeTest;
+
     // State
     int mNumIterations;
 
@@ -20,19 +20,50 @@
 namespace artemis
 {
 
-StatsStorage::StatsStorage()
+StatsStorage::StatsStorage() :
+    mCountersInLastBlock(COUNTER_BLOCK_SIZE)
 {
 }
 
-void StatsStorage::accumulate(QString key, int value)
+StatsStorage::~StatsStorage()
+{
+    foreach(int* block, mCounterBlocks) {
+        delete[] block;
+    }
+}
+
+int* StatsStorage::slot(const QString& key)
 {
-    value += this->intStorage.value(key, 0);
+    QHash<QString, int*>::const_iterator it = this->intStorage.constFind(key);
+    if (it != this->intStorage.constEnd()) {
+        return it.value();
+    }
+
+    if (mCountersInLastBlock == COUNTER_BLOCK_SIZE) {
+        mCounterBlocks.append(new int[COUNTER_BLOCK_SIZE]);
+        mCountersInLastBlock = 0;
+    }
+
+    int* value = &mCounterBlocks.last()[mCountersInLastBlock++];
+    *value = 0;
+
     this->intStorage.insert(key, value);
+    return value;
+}
+
+StatsCounter StatsStorage::counter(const QString& key)
+{
+    return StatsCounter(slot(key));
+}
+
+void StatsStorage::accumulate(QString key, int value)
+{
+    *slot(key) += value;
 }
 
 void StatsStorage::set(QString key, int value)
 {
-    this->intStorage.insert(key, value);
+    *slot(key) = value;
 }
 
 void StatsStorage::set(QString key, bool value)
@@ -17,18 +17,59 @@
 #ifndef STATSSTORAGE_H
 #define STATSSTORAGE_H
 
+#include <string>
+
 #include <QHash>
+#include <QList>
+#include <QString>
 
 namespace artemis
 {
 
+/**
+ * Handle to an integer statistic registered with StatsStorage::counter.
+ *
+ * Use this on hot paths instead of accumulate, which builds a QString key and looks it up on every call.
+ * A handle stays valid for the lifetime of the storage, and shares its value with the string keyed API.
+ */
+class StatsCounter
+{
+
+    friend class StatsStorage;
+
+public:
+    StatsCounter() :
+        mValue(0)
+    {}
+
+    inline void add(int value) {
+        *mValue += value;
+    }
+
+    inline int value() const {
+        return *mValue;
+    }
+
+private:
+    explicit StatsCounter(int* value) :
+        mValue(value)
+    {}
+
+    int* mValue;
+};
+
 class StatsStorage
 {
 
     friend class StatsPrettyWriter;
+    friend class StatsJsonWriter;
 
 public:
     StatsStorage();
+    ~StatsStorage();
+
+    StatsCounter counter(const QString& key);
+
     void accumulate(QString key, int value);
     void set(QString key, int value);
     void set(QString key, bool value);
@@ -36,7 +77,14 @@ public:
     void set(QString key, const std::string& value);
 
 private:
-    QHash<QString, int> intStorage;
+    int* slot(const QString& key);
+
+    // Counters are allocated in fixed size blocks, so handles are never invalidated by new registrations.
+    static const int COUNTER_BLOCK_SIZE = 256;
+    QList<int*> mCounterBlocks;
+    int mCountersInLastBlock;
+
+    QHash<QString, int*> intStorage;
     QHash<QString, QString> stringStorage;
 };
 
@@ -0,0 +1,78 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <QMap>
+#include <QStringList>
+
+#include "util/fileutil.h"
+#include "json.h"
+
+namespace artemis
+{
+
+StatsJsonWriter::StatsJsonWriter() {}
+
+void StatsJsonWriter::write(const StatsStorage* stats, QString fileName)
+{
+    QMap<QString, QString> entries;
+
+    QHashIterator<QString, int*> i(stats->intStorage);
+
+    while (i.hasNext()) {
+        i.next();
+        entries.insert(i.key(), QString::number(*i.value()));
+    }
+
+    QHashIterator<QString, QString> j(stats->stringStorage);
+
+    while (j.hasNext()) {
+        j.next();
+        entries.insert(j.key(), quote(j.value()));
+    }
+
+    QStringList members;
+    QMapIterator<QString, QString> k(entries);
+
+    while (k.hasNext()) {
+        k.next();
+        members.append(quote(k.key()) + ": " + k.value());
+    }
+
+    writeStringToFile(fileName, "{\n    " + members.join(",\n    ") + "\n}\n");
+}
+
+QString StatsJsonWriter::quote(QString value)
+{
+    QString result = "\"";
+
+    for (int i = 0; i < value.length(); i++) {
+        QChar c = value.at(i);
+
+        if (c == '"' || c == '\\') {
+            result.append('\\').append(c);
+        } else if (c == '\n') {
+            result.append("\\n");
+        } else if (c.unicode() < 0x20) {
+            result.append(QString("\\u%1").arg(c.unicode(), 4, 16, QChar('0')));
+        } else {
+            result.append(c);
+        }
+    }
+
+    return result.append('"');
+}
+
+}
@@ -0,0 +1,46 @@
+/*
+ * Copyright 2012 Aarhus University
+ *
+ * Licensed under the GNU General Public License, Version 3 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *          http://www.gnu.org/licenses/gpl-3.0.html
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STATISTICS_JSON_WRITER_H
+#define STATISTICS_JSON_WRITER_H
+
+#include <QString>
+
+#include "../statsstorage.h"
+
+namespace artemis
+{
+
+/**
+ * Writes the statistics as a single JSON object with the keys in sorted order.
+ * Integer statistics are written as numbers and all other statistics as strings.
+ */
+class StatsJsonWriter
+{
+
+public:
+
+    static void write(const StatsStorage* stats, QString fileName);
+
+private:
+    StatsJsonWriter();
+
+    static QString quote(QString value);
+};
+
+}
+
+#endif // STATISTICS_JSON_WRITER_H
@@ -30,11 +30,11 @@ StatsPrettyWriter::StatsPrettyWriter() {}
 void StatsPrettyWriter::write(const StatsStorage* stats)
 {
 
-    QHashIterator<QString, int> i(stats->intStorage);
+    QHashIterator<QString, int*> i(stats->intStorage);
 
     while (i.hasNext()) {
         i.next();
-        Log::info(i.key().toStdString()+": "+QString::number(i.value()).toStdString());
+        Log::info(i.key().toStdString()+": "+QString::number(*i.value()).toStdString());
     }
 
     QHashIterator<QString, QString> j(stats->stringStorage);
@@ -0,0 +1,135 @@
+#!/usr/bin/env python
+
+"""
+Times Artemis runs which stress a single component, so a change to that component can be compared end to end.
+
+Each benchmark is run RUNS times and the fastest wall clock time is reported, together with the statistics which
+show that the runs did the same amount of work. Results are appended to component_results-<timestamp>.csv, run the
+script before and after a change to compare them.
+
+The micro benchmarks run the disabled benchmark cases of the unit tests (tests/unit/unit must be built), which time
+a single data structure on inputs taken from the fixtures. Their statistics are the timings in microseconds.
+
+Benchmarks:
+    coverage    Random testing of jquery-simple. Every executed bytecode is recorded in the coverage bitsets.
+    coverage-micro
+                Covering the code blocks of jquery.js in CodeBlockInfo bitsets and in the QSets they replaced.
+    dom         Concolic testing of the DOM modification fixtures. Every trace tokenises the DOM before and after.
+    dom-micro   Tokenising a 1 MB snapshot made of the fixture pages, with DomTokeniser (target: tokenise_us < 1000)
+                and with the QRegExp split it replaced.
+    search      Concolic testing of depth-limit without a depth limit. The search walks a deep execution tree.
+
+Usage:
+    component_benchmarks.py [<benchmark> ...]   Run the given benchmarks, or all of them.
+"""
+
+import os
+import subprocess
+import sys
+import tempfile
+import time
+from xml.etree import ElementTree
+
+from harness.artemis import execute_artemis
+
+FIXTURE_ROOT = os.path.join(os.path.dirname(os.path.realpath(__file__)), 'fixtures/')
+UNIT_EXEC = os.path.join(os.path.dirname(os.path.realpath(__file__)), '../unit/unit')
+
+RUNS = 3
+
+
+def coverage_benchmark():
+    return execute_artemis('component_coverage', FIXTURE_ROOT + 'jquery-simple/index.html',
+                           iterations=100,
+                           strategy_form_input='random',
+                           strategy_priority='constant')
+
+
+def run_unit_benchmark(test_filter):
+    """Runs the disabled unit test cases matching test_filter and returns the properties they recorded."""
+    output = os.path.join(tempfile.gettempdir(), 'artemis-unit-benchmark.xml')
+    env = dict(os.environ, ARTEMIS_FIXTURES=FIXTURE_ROOT)
+
+    subprocess.check_call([UNIT_EXEC,
+                           '--gtest_also_run_disabled_tests',
+                           '--gtest_filter=%s' % test_filter,
+                           '--gtest_output=xml:%s' % output], env=env)
+
+    report = {}
+    for testcase in ElementTree.parse(output).getroot().iter('testcase'):
+        report.update(testcase.attrib)
+    return report
+
+
+def coverage_micro_benchmark():
+    return run_unit_benchmark('CodeBlockInfoBenchmark.*')
+
+
+def dom_micro_benchmark():
+    return run_unit_benchmark('DomTokeniserBenchmark.*')
+
+
+def dom_benchmark():
+    report = {}
+    for fixture in ['dom-modification.html', 'dom-modification-2.html']:
+        result = execute_artemis('component_dom_' + fixture.replace('.', '_'), FIXTURE_ROOT + 'concolic/' + fixture,
+                                 iterations=0,
+                                 major_mode='concolic')
+        for key in ['Concolic::Iterations', 'Concolic::ExecutionTree::InterestingDomModifications']:
+            report[key] = report.get(key, 0) + int(result.get(key, 0))
+    return report
+
+
+def search_benchmark():
+    return execute_artemis('component_search', FIXTURE_ROOT + 'concolic/depth-limit.html',
+                           iterations=0,
+                           major_mode='concolic',
+                           concolic_unlimited_depth=True)
+
+
+BENCHMARKS = [
+    ('coverage', coverage_benchmark, ['Runtime::iterations', 'WebKit::coverage::covered']),
+    ('coverage-micro', coverage_micro_benchmark, ['code_blocks', 'qset_us', 'bitset_us']),
+    ('dom', dom_benchmark, ['Concolic::Iterations', 'Concolic::ExecutionTree::InterestingDomModifications']),
+    ('dom-micro', dom_micro_benchmark, ['snapshot_chars', 'first_us', 'tokenise_us', 'regex_us']),
+    ('search', search_benchmark, ['Concolic::Iterations', 'Concolic::Solver::ConstraintsSolved']),
+]
+
+
+def run_benchmark(benchmark):
+    best_t = None
+    report = None
+
+    for run in range(RUNS):
+        start_t = time.time()
+        report = benchmark()
+        elapsed_t = time.time() - start_t
+
+        if best_t is None or elapsed_t < best_t:
+            best_t = elapsed_t
+
+    return best_t, report
+
+
+def run_component_benchmarks(names):
+    file_name = 'component_results-%s.csv' % int(time.time())
+    with open(file_name, 'w') as fp:
+        fp.write("Benchmark,Time (s),Statistics\n")
+
+    for name, benchmark, keys in BENCHMARKS:
+        if names and name not in names:
+            continue
+
+        print("Starting benchmark: %s" % name)
+        best_t, report = run_benchmark(benchmark)
+        stats = ' '.join('%s=%s' % (key, report.get(key, '-')) for key in keys)
+        print("%s: %.2f s (%s)" % (name, best_t, stats))
+
+        with open(file_name, 'a') as fp:
+            fp.write("%s,%.3f,%s\n" % (name, best_t, stats))
+
+    return file_name
+
+
+if __name__ == '__main__':
+    print("Results written to %s" % run_component_benchmarks(sys.argv[1:]))
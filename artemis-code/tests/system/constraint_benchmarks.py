@@ -0,0 +1,108 @@
+#!/usr/bin/env python
+
+"""
+Compares the solver input written with and without constraint simplification (--smt-simplify).
+
+The concolic fixtures are explored twice, and the constraint files CVC4Solver saves to /tmp/constraints are collected
+for each run. For both corpora the number of files, their size, the number of asserts and the time CVC4 takes to
+solve them are reported.
+
+Usage:
+    constraint_benchmarks.py                    Run the fixtures and compare the collected corpora.
+    constraint_benchmarks.py <before> <after>   Compare two existing corpora (e.g. saved copies of /tmp/constraints).
+"""
+
+import os
+import re
+import shutil
+import subprocess
+import sys
+import time
+
+from harness.artemis import execute_artemis
+
+FIXTURE_ROOT = os.path.join(os.path.dirname(os.path.realpath(__file__)), 'fixtures/concolic/')
+CONSTRAINTS_DIR = '/tmp/constraints'
+CVC4_BINARY = 'contrib/CVC4/cvc4-2014-03-01-x86_64-linux-opt'
+
+
+def collect_corpus(simplify, target_dir):
+    """Runs every concolic fixture with simplification on or off and moves the written constraints to target_dir.
+
+    The query cache and local search are off, so CVC4 sees every query in both runs and the simplifier is the only
+    difference between the two corpora.
+    """
+    if os.path.exists(CONSTRAINTS_DIR):
+        shutil.rmtree(CONSTRAINTS_DIR)
+    if os.path.exists(target_dir):
+        shutil.rmtree(target_dir)
+
+    for filename in sorted(os.listdir(FIXTURE_ROOT)):
+        if not filename.endswith('.html'):
+            continue
+
+        print("Exploring %s (simplification %s)" % (filename, simplify))
+        execute_artemis('constraints_%s_%s' % (simplify, filename.replace('.', '_')),
+                        "%s%s" % (FIXTURE_ROOT, filename),
+                        iterations=0,
+                        major_mode='concolic',
+                        smt_simplify=simplify,
+                        smt_query_cache='off',
+                        smt_local_search=0)
+
+    if os.path.exists(CONSTRAINTS_DIR):
+        shutil.move(CONSTRAINTS_DIR, target_dir)
+    else:
+        os.mkdir(target_dir)
+
+
+def solve_time(path):
+    cvc4 = os.path.join(os.environ['ARTEMISDIR'], CVC4_BINARY)
+
+    start_t = time.time()
+    with open(os.devnull, 'w') as devnull:
+        subprocess.call([cvc4, '--lang=smtlib2', path, '--rewrite-divk'], stdout=devnull, stderr=devnull)
+    return time.time() - start_t
+
+
+def measure_corpus(corpus_dir):
+    files = [os.path.join(corpus_dir, f) for f in sorted(os.listdir(corpus_dir))]
+
+    result = {'files': len(files), 'bytes': 0, 'asserts': 0, 'solve_time': 0.0}
+
+    for path in files:
+        with open(path) as fp:
+            content = fp.read()
+
+        result['bytes'] += len(content)
+        result['asserts'] += len(re.findall(r'\(assert ', content))
+        result['solve_time'] += solve_time(path)
+
+    return result
+
+
+def compare_corpora(before_dir, after_dir):
+    before = measure_corpus(before_dir)
+    after = measure_corpus(after_dir)
+
+    file_name = 'constraint_results-%s.csv' % int(time.time())
+    with open(file_name, 'w') as fp:
+        fp.write("Measure,Without simplification,With simplification,Ratio\n")
+
+        for measure in ['files', 'bytes', 'asserts', 'solve_time']:
+            ratio = float(after[measure]) / before[measure] if before[measure] else 0
+            print("%s: %s -> %s (%.3f)" % (measure, before[measure], after[measure], ratio))
+            fp.write("%s,%s,%s,%.3f\n" % (measure, before[measure], after[measure], ratio))
+
+    return file_name
+
+
+if __name__ == '__main__':
+    if len(sys.argv) == 3:
+        before_dir, after_dir = sys.argv[1], sys.argv[2]
+    else:
+        before_dir, after_dir = '/tmp/constraints-unsimplified', '/tmp/constraints-simplified'
+        collect_corpus('off', before_dir)
+        collect_corpus('on', after_dir)
+
+    print("Results written to %s" % compare_corpora(before_dir, after_dir))
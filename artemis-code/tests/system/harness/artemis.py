@@ -31,6 +31,7 @@ def execute_artemis(execution_uuid, url, iterations=1,
                     output_parent_dir=OUTPUT_DIR,
                     ignore_artemis_crash=False, # Suppresses the exception thrown by a non-zero return code and returns whatever information it can.
                     verbosity=None,
+                    headless=False,
                     **kwargs):
     output_dir = os.path.join(output_parent_dir, execution_uuid)
 
@@ -61,9 +62,11 @@ def execute_artemis(execution_uuid, url, iterations=1,
         args.append('-v')
         args.append('all')
 
+    # Options without a value are passed as key=True.
     for key in kwargs:
         args.append('--%s' % key.replace('_', '-'))
-        args.append(str(kwargs[key]))
+        if kwargs[key] is not True:
+            args.append(str(kwargs[key]))
 
     if exclude is not None:
         for file in exclude:
@@ -88,6 +91,9 @@ def execute_artemis(execution_uuid, url, iterations=1,
         args.append('--concolic-button')
         args.append(concolic_button)
 
+    if headless:
+        args.append('--headless')
+
     cmd = [ARTEMIS_EXEC] + [url] + args
 
     if dryrun:
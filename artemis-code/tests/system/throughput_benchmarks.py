@@ -0,0 +1,82 @@
+#!/usr/bin/env python
+
+"""
+Compares the iteration throughput of random testing on the legacy benchmarks with and without --headless.
+
+Each benchmark is run for ITERATIONS iterations with a view and then headless. The iterations per second of both runs
+and the speedup are written to throughput_results-<timestamp>.csv.
+
+Usage:
+    throughput_benchmarks.py
+"""
+
+WEBSERVER_PORT = 8001
+WEBSERVER_ROOT = './fixtures/legacy-benchmarks/'
+WEBSERVER_URL = 'http://localhost:%s' % WEBSERVER_PORT
+
+ITERATIONS = 100
+
+import time
+from harness.environment import WebServer
+from harness.artemis import execute_artemis
+
+
+def iterations_per_second(name, path, exclude, headless):
+    url = WEBSERVER_URL + "/" + path
+    start_t = time.time()
+    report = execute_artemis(name, url,
+                             iterations=ITERATIONS,
+                             strategy_form_input='random',
+                             strategy_priority='constant',
+                             exclude=exclude,
+                             headless=headless)
+    end_t = time.time()
+
+    iterations = report.get('Runtime::iterations', ITERATIONS)
+    return float(iterations) / (end_t - start_t)
+
+
+def run_throughput_benchmarks(benchmarks):
+    file_name = 'throughput_results-%s.csv' % int(time.time())
+    with open(file_name, 'w') as fp:
+        fp.write("Benchmark,Iterations/s: view,Iterations/s: headless,Speedup\n")
+
+    for benchmark in benchmarks:
+        exclude = map(lambda e: WEBSERVER_URL + "/" + e, benchmark['exclude']) if "exclude" in benchmark else []
+        name = benchmark['name']
+        path = benchmark['path']
+
+        print("Starting testing: %s" % name)
+        before = iterations_per_second(name, path, exclude, False)
+        after = iterations_per_second(name, path, exclude, True)
+        print("%s: %.2f -> %.2f iterations/s" % (name, before, after))
+
+        with open(file_name, 'a') as fp:
+            fp.write("%s,%.3f,%.3f,%.3f\n" % (name, before, after, after / before))
+
+    return file_name
+
+
+if __name__ == '__main__':
+    server = WebServer(WEBSERVER_ROOT, WEBSERVER_PORT)
+    benchmarks = [
+        {"name": "3dmodel", "path": "3dmodel/index.html"},
+        {"name": "ajax-poller", "path": "ajax-poller/ajax-poller.php"},
+        {"name": "ball-pool", "path": "ball_pool/index.html", "exclude": ["ball_pool/js/box2d.js",
+                                                                          "ball_pool/js/protoclass.js"]},
+        {"name": "dragable-boxes", "path": "dragable-boxes/dragable-boxes.html"},
+        {"name": "dynamic-articles", "path": "dynamicArticles/index.html"},
+        {"name": "fractal-viewer", "path": "fractal_viewer/index.html",
+         "exclude": ['fractal_viewer/js/lib/jquery-1.3.js']},
+        {"name": "homeostasis", "path": "homeostasis/index.html"},
+        {"name": "pacman", "path": "pacman/index.html",
+         "exclude": ["pacman/src/js/pacman10-hp.2.js",
+                     "pacman/src/js/pacman10-hp.js"]},
+        {"name": "htmledit", "path": "htmledit/demo_full.html",
+         "exclude": ["htmledit/htmlbox.min.js",
+                     "htmledit/htmlbox.undoredomanager.js",
+                     "htmledit/jquery-1.3.2.min.js"]},
+        {"name": "ajaxtabs", "path": "ajaxtabs/demo.htm"}
+    ]
+    print("Results written to %s" % run_throughput_benchmarks(benchmarks))
+    del server
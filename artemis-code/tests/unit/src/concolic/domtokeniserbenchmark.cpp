@@ -0,0 +1,87 @@
+#include <QDir>
+#include <QDirIterator>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRegExp>
+#include <QStringList>
+
+#include "include/gtest/gtest.h"
+
+#include "concolic/domtokeniser.h"
+
+namespace artemis
+{
+
+/*
+ * Times DomTokeniser on a 1 MB DOM snapshot, which should take well under a millisecond once its tokens are
+ * interned, and the QRegExp split it replaced on the same snapshot.
+ *
+ * Disabled in the unit test run. tests/system/component_benchmarks.py runs it with ARTEMIS_FIXTURES set to the
+ * system test fixtures and reads the timings (in microseconds) from the recorded properties.
+ */
+
+// The pages of the fixtures, repeated until the snapshot has at least size characters.
+static QString domSnapshot(const QString& fixtures, int size)
+{
+    QStringList fileNames;
+    QDirIterator it(fixtures, QStringList() << "*.html", QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        fileNames.append(it.next());
+    }
+    fileNames.sort();
+
+    QString pages;
+    foreach (QString fileName, fileNames) {
+        QFile file(fileName);
+        if (file.open(QIODevice::ReadOnly)) {
+            pages.append(QString::fromUtf8(file.readAll()));
+        }
+    }
+
+    QString snapshot;
+    while (!pages.isEmpty() && snapshot.size() < size) {
+        snapshot.append(pages);
+    }
+    return snapshot;
+}
+
+TEST(DomTokeniserBenchmark, DISABLED_TOKENISES_A_1MB_SNAPSHOT) {
+    QString fixtures = QString::fromLocal8Bit(qgetenv("ARTEMIS_FIXTURES"));
+    ASSERT_FALSE(fixtures.isEmpty()) << "ARTEMIS_FIXTURES must point to tests/system/fixtures.";
+
+    QString snapshot = domSnapshot(fixtures, 1024 * 1024);
+    ASSERT_FALSE(snapshot.isEmpty()) << "No pages found in " << fixtures.toStdString();
+
+    DomTokeniser tokeniser(QList<QString>() << "error" << "invalid" << "success");
+    QElapsedTimer timer;
+
+    // The first pass interns the tokens, later passes only look them up, as for the DOMs of later iterations.
+    timer.start();
+    int tokens = tokeniser.tokenise(snapshot).size();
+    qint64 firstTime = timer.nsecsElapsed();
+
+    const int passes = 10;
+    qint64 bestTime = -1;
+    for (int pass = 0; pass < passes; pass++) {
+        timer.restart();
+        tokeniser.tokenise(snapshot);
+        qint64 time = timer.nsecsElapsed();
+        if (bestTime < 0 || time < bestTime) {
+            bestTime = time;
+        }
+    }
+
+    timer.restart();
+    int regexTokens = snapshot.split(QRegExp("\\s+|<|>|\"|'|:|\\.|,|!|\\?|/|;|-"), QString::SkipEmptyParts).size();
+    qint64 regexTime = timer.nsecsElapsed();
+
+    ASSERT_EQ(regexTokens, tokens);
+
+    RecordProperty("snapshot_chars", snapshot.size());
+    RecordProperty("tokens", tokens);
+    RecordProperty("first_us", (int)(firstTime / 1000));
+    RecordProperty("tokenise_us", (int)(bestTime / 1000));
+    RecordProperty("regex_us", (int)(regexTime / 1000));
+}
+
+}
@@ -0,0 +1,86 @@
+#include <QRegExp>
+#include <QStringList>
+
+#include "include/gtest/gtest.h"
+
+#include "concolic/domtokeniser.h"
+
+namespace artemis
+{
+
+static QStringList regexTokenise(const QString& dom)
+{
+    QRegExp delimiters("\\s+|<|>|\"|'|:|\\.|,|!|\\?|/|;|-");
+    return dom.split(delimiters, QString::SkipEmptyParts);
+}
+
+static QStringList toStrings(const DomTokeniser& tokeniser, const QVector<domtokenid_t>& tokens)
+{
+    QStringList result;
+    foreach (domtokenid_t token, tokens) {
+        result.append(tokeniser.getToken(token));
+    }
+    return result;
+}
+
+TEST(DomTokeniserTest, MATCHES_REGEX_TOKENISER) {
+    DomTokeniser tokeniser(QList<QString>());
+    QString dom = QString::fromUtf8("<p class='x'>Hello, world!\tThis-is a\u00A0test; of/the \"tokeniser\"?</p>");
+
+    ASSERT_EQ(regexTokenise(dom), toStrings(tokeniser, tokeniser.tokenise(dom)));
+}
+
+TEST(DomTokeniserTest, INTERNS_TOKENS) {
+    DomTokeniser tokeniser(QList<QString>());
+    QVector<domtokenid_t> tokens = tokeniser.tokenise("foo bar foo");
+
+    ASSERT_EQ(3, tokens.size());
+    ASSERT_EQ(tokens.at(0), tokens.at(2));
+    ASSERT_NE(tokens.at(0), tokens.at(1));
+    ASSERT_EQ(2u, tokeniser.numTokens());
+}
+
+TEST(DomTokeniserTest, INDICATORS_ARE_CASE_INSENSITIVE) {
+    QList<QString> indicators;
+    indicators.append("Error");
+    indicators.append("Invalid");
+
+    DomTokeniser tokeniser(indicators);
+    QVector<domtokenid_t> tokens = tokeniser.tokenise("ERROR: invalid Errors");
+
+    ASSERT_EQ(0, tokeniser.indicatorIndex(tokens.at(0)));
+    ASSERT_EQ(1, tokeniser.indicatorIndex(tokens.at(1)));
+    ASSERT_EQ(-1, tokeniser.indicatorIndex(tokens.at(2)));
+}
+
+TEST(DomTokeniserTest, CLEAR_DROPS_INTERNED_TOKENS) {
+    QList<QString> indicators;
+    indicators.append("error");
+
+    DomTokeniser tokeniser(indicators);
+    tokeniser.tokenise("foo bar error");
+    ASSERT_EQ(3u, tokeniser.numTokens());
+
+    tokeniser.clear();
+    ASSERT_EQ(0u, tokeniser.numTokens());
+
+    // Tokens are interned again from the start, and still matched against the indicators.
+    QVector<domtokenid_t> tokens = tokeniser.tokenise("Error baz");
+    ASSERT_EQ(2u, tokeniser.numTokens());
+    ASSERT_EQ(0u, tokens.at(0));
+    ASSERT_EQ(0, tokeniser.indicatorIndex(tokens.at(0)));
+    ASSERT_EQ(QString("baz"), tokeniser.getToken(tokens.at(1)));
+}
+
+TEST(DomTokeniserTest, MATCHES_REGEX_TOKENISER_AFTER_GROWING) {
+    // More distinct words than the initial table holds.
+    QString dom;
+    for (int i = 0; i < 3000; i++) {
+        dom += QString("<span id='w%1'>w%2</span>").arg(i).arg(i % 7);
+    }
+
+    DomTokeniser tokeniser(QList<QString>());
+    ASSERT_EQ(regexTokenise(dom), toStrings(tokeniser, tokeniser.tokenise(dom)));
+}
+
+}
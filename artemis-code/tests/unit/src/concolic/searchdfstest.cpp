@@ -0,0 +1,166 @@
+#include <QList>
+
+#include "include/gtest/gtest.h"
+
+#include "concolic/executiontree/tracenodes.h"
+#include "concolic/pathcondition.h"
+#include "concolic/search/searchdfs.h"
+
+#include <JavaScriptCore/symbolic/expr.h>
+
+namespace artemis
+{
+
+// Builds a chain of symbolic branches where each false branch continues the chain and each true branch is a leaf.
+// The true branch of the branch at unexploredDepth is left unexplored, all other leaves are ends.
+static TraceNodePtr buildComb(const QList<Symbolic::Expression*>& conditions, int unexploredDepth)
+{
+    TraceNodePtr tree = TraceNodePtr(new TraceEndSuccess());
+
+    for (int depth = conditions.size() - 1; depth >= 0; depth--) {
+        QSharedPointer<TraceSymbolicBranch> branch = QSharedPointer<TraceSymbolicBranch>(new TraceSymbolicBranch(conditions.at(depth)));
+        branch->setFalseBranch(tree);
+
+        if (depth == unexploredDepth) {
+            branch->setTrueBranch(TraceUnexplored::getInstance());
+        } else {
+            branch->setTrueBranch(TraceNodePtr(new TraceEndSuccess()));
+        }
+
+        tree = branch;
+    }
+
+    return tree;
+}
+
+static QList<Symbolic::Expression*> createConditions(int count)
+{
+    QList<Symbolic::Expression*> conditions;
+    for (int i = 0; i < count; i++) {
+        conditions.append(new Symbolic::ConstantBoolean(true));
+    }
+    return conditions;
+}
+
+TEST(PathConditionTest, COPIES_ARE_INDEPENDENT) {
+    QList<Symbolic::Expression*> conditions = createConditions(3);
+
+    PathCondition pc;
+    pc.addCondition(conditions.at(0), true);
+    pc.addCondition(conditions.at(1), false);
+
+    PathCondition copy = pc;
+    copy.negateLastCondition();
+    copy.addCondition(conditions.at(2), true);
+
+    ASSERT_EQ(2u, pc.size());
+    ASSERT_EQ(conditions.at(1), pc.get(1).first);
+    ASSERT_FALSE(pc.get(1).second);
+
+    ASSERT_EQ(3u, copy.size());
+    ASSERT_EQ(conditions.at(0), copy.get(0).first);
+    ASSERT_TRUE(copy.get(1).second);
+    ASSERT_EQ(conditions.at(2), copy.get(2).first);
+
+    qDeleteAll(conditions);
+}
+
+TEST(SearchDfsTest, FINDS_DEEPEST_UNEXPLORED_NODE) {
+    QList<Symbolic::Expression*> conditions = createConditions(10);
+    DepthFirstSearch search(buildComb(conditions, 9), 10);
+
+    ASSERT_TRUE(search.chooseNextTarget());
+
+    PathConditionPtr pc = search.getTargetPC();
+    ASSERT_EQ(10u, pc->size());
+    for (int i = 0; i < 9; i++) {
+        ASSERT_EQ(conditions.at(i), pc->get(i).first);
+        ASSERT_FALSE(pc->get(i).second);
+    }
+    ASSERT_TRUE(pc->get(9).second);
+
+    qDeleteAll(conditions);
+}
+
+TEST(SearchDfsTest, RETRIES_TIMEOUTS_WITH_LARGER_BUDGET) {
+    QList<Symbolic::Expression*> conditions = createConditions(3);
+    DepthFirstSearch search(buildComb(conditions, 2), 3);
+
+    ASSERT_TRUE(search.chooseNextTarget());
+    search.markNodeTimeout(100);
+    ASSERT_FALSE(search.chooseNextTarget());
+
+    search.setRetryBudget(100);
+    search.restartSearch();
+    ASSERT_FALSE(search.chooseNextTarget());
+
+    search.setRetryBudget(400);
+    search.restartSearch();
+    ASSERT_TRUE(search.chooseNextTarget());
+    ASSERT_EQ(3u, search.getTargetPC()->size());
+    ASSERT_TRUE(search.getTargetPC()->get(2).second);
+
+    qDeleteAll(conditions);
+}
+
+TEST(SearchDfsTest, ONLY_UNATTEMPTED_TARGETS_ARE_ON_THE_FRONTIER) {
+    QList<Symbolic::Expression*> conditions = createConditions(4);
+    DepthFirstSearch search(buildComb(conditions, 2), 4);
+
+    ASSERT_TRUE(search.chooseNextTarget());
+    ASSERT_TRUE(search.overFrontierNode());
+    search.markNodeTimeout(100);
+    ASSERT_FALSE(search.overFrontierNode());
+
+    // A timed out node which is retried already left the frontier when it was marked.
+    search.setRetryBudget(400);
+    search.restartSearch();
+    ASSERT_TRUE(search.chooseNextTarget());
+    ASSERT_TRUE(search.overUnexploredNode());
+    ASSERT_FALSE(search.overFrontierNode());
+
+    qDeleteAll(conditions);
+}
+
+TEST(SearchDfsTest, FINDS_TARGET_AT_THE_TOP_OF_A_DEEP_TREE) {
+    const int depth = 2000;
+    QList<Symbolic::Expression*> conditions = createConditions(depth);
+    DepthFirstSearch search(buildComb(conditions, 0), depth);
+
+    // The only unexplored node is below the root, so the whole tree is walked and backtracked before it is found.
+    ASSERT_TRUE(search.chooseNextTarget());
+
+    PathConditionPtr pc = search.getTargetPC();
+    ASSERT_EQ(1u, pc->size());
+    ASSERT_EQ(conditions.at(0), pc->get(0).first);
+    ASSERT_TRUE(pc->get(0).second);
+
+    ASSERT_FALSE(search.chooseNextTarget());
+
+    qDeleteAll(conditions);
+}
+
+TEST(PathConditionTest, RELEASES_LONG_CONDITIONS) {
+    Symbolic::ConstantBoolean condition(true);
+
+    PathConditionPtr pc = PathConditionPtr(new PathCondition());
+    PathConditionPtr prefix;
+
+    // Long enough to overflow the stack if the conditions were released recursively.
+    for (int i = 0; i < 1000000; i++) {
+        pc->addCondition(&condition, true);
+        if (i == 500000) {
+            prefix = PathConditionPtr(new PathCondition(*pc));
+        }
+    }
+
+    pc.clear();
+
+    // The shared prefix outlives the longer condition.
+    ASSERT_EQ(500001u, prefix->size());
+    ASSERT_EQ(&condition, prefix->get(500000).first);
+
+    prefix.clear();
+}
+
+}
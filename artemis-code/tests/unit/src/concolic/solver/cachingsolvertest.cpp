@@ -0,0 +1,163 @@
+#include <QDir>
+
+#include "include/gtest/gtest.h"
+
+#include "concolic/solver/cachingsolver.h"
+#include "concolic/pathcondition.h"
+#include "solvertest.h"
+
+#include <JavaScriptCore/symbolic/expr.h>
+
+namespace artemis
+{
+
+TEST(CachingSolverTest, UNSAT_SUBSET_IS_REUSED) {
+    Symbolic::Expression* a = stringEquals(input("SYM_IN_a"), "x");
+    Symbolic::Expression* b = stringEquals(input("SYM_IN_b"), "y");
+
+    QSharedPointer<StubSolver> backend = QSharedPointer<StubSolver>(new StubSolver(SolutionPtr(new Solution(false, true))));
+    CachingSolver solver(backend);
+
+    PathConditionPtr pc = PathConditionPtr(new PathCondition());
+    pc->addCondition(a, true);
+    ASSERT_TRUE(solver.solve(pc)->isUnsat());
+
+    PathConditionPtr extended = PathConditionPtr(new PathCondition(*pc));
+    extended->addCondition(b, false);
+    ASSERT_TRUE(solver.solve(extended)->isUnsat());
+
+    ASSERT_EQ(1, backend->mQueries);
+}
+
+TEST(CachingSolverTest, STRING_OPERANDS_ARE_PART_OF_THE_KEY) {
+    // Both would print as StringRegexReplace( SYM_IN_a, "a", "b", "c" ) without escaping.
+    Symbolic::Expression* a = stringEquals(new Symbolic::StringRegexReplace(input("SYM_IN_a"), new std::string("a\", \"b"), new std::string("c")), "z");
+    Symbolic::Expression* b = stringEquals(new Symbolic::StringRegexReplace(input("SYM_IN_a"), new std::string("a"), new std::string("b\", \"c")), "z");
+
+    QSharedPointer<StubSolver> backend = QSharedPointer<StubSolver>(new StubSolver(SolutionPtr(new Solution(false, true))));
+    CachingSolver solver(backend);
+
+    PathConditionPtr first = PathConditionPtr(new PathCondition());
+    first->addCondition(a, true);
+    ASSERT_TRUE(solver.solve(first)->isUnsat());
+
+    PathConditionPtr second = PathConditionPtr(new PathCondition());
+    second->addCondition(b, true);
+    solver.solve(second);
+
+    ASSERT_EQ(2, backend->mQueries);
+}
+
+TEST(CachingSolverTest, SAT_SUPERSET_IS_REUSED) {
+    // Separately allocated but equal conditions share a key.
+    Symbolic::Expression* a = stringEquals(input("SYM_IN_a"), "x");
+    Symbolic::Expression* aCopy = stringEquals(input("SYM_IN_a"), "x");
+    Symbolic::Expression* b = stringEquals(input("SYM_IN_b"), "y");
+
+    QSharedPointer<StubSolver> backend = QSharedPointer<StubSolver>(new StubSolver(model("SYM_IN_a", "x")));
+    CachingSolver solver(backend);
+
+    PathConditionPtr pc = PathConditionPtr(new PathCondition());
+    pc->addCondition(a, true);
+    pc->addCondition(b, false);
+    ASSERT_TRUE(solver.solve(pc)->isSolved());
+
+    PathConditionPtr prefix = PathConditionPtr(new PathCondition());
+    prefix->addCondition(aCopy, true);
+    ASSERT_TRUE(solver.solve(prefix)->isSolved());
+
+    ASSERT_EQ(1, backend->mQueries);
+}
+
+TEST(CachingSolverTest, CACHED_MODELS_ARE_EVALUATED) {
+    Symbolic::StringExpression* name = input("SYM_IN_name");
+
+    QSharedPointer<StubSolver> backend = QSharedPointer<StubSolver>(new StubSolver(model("SYM_IN_name", "user")));
+    CachingSolver solver(backend);
+
+    PathConditionPtr pc = PathConditionPtr(new PathCondition());
+    pc->addCondition(stringEquals(name, "admin"), false);
+    ASSERT_TRUE(solver.solve(pc)->isSolved());
+
+    // "user" is also different from "root", so the cached model answers this query.
+    PathConditionPtr other = PathConditionPtr(new PathCondition());
+    other->addCondition(stringEquals(name, "root"), false);
+    SolutionPtr solution = solver.solve(other);
+
+    ASSERT_TRUE(solution->isSolved());
+    ASSERT_EQ(std::string("user"), solution->findSymbol("SYM_IN_name").string);
+    ASSERT_EQ(1, backend->mQueries);
+
+    // But not this one.
+    PathConditionPtr negated = PathConditionPtr(new PathCondition());
+    negated->addCondition(stringEquals(name, "root"), true);
+    solver.solve(negated);
+
+    ASSERT_EQ(2, backend->mQueries);
+}
+
+TEST(CachingSolverTest, ERRORS_ARE_NOT_CACHED) {
+    QSharedPointer<StubSolver> backend = QSharedPointer<StubSolver>(new StubSolver(SolutionPtr(new Solution(false, false, "", true))));
+    CachingSolver solver(backend);
+
+    PathConditionPtr pc = PathConditionPtr(new PathCondition());
+    pc->addCondition(stringEquals(input("SYM_IN_a"), "x"), true);
+
+    ASSERT_TRUE(solver.solve(pc)->isTimeout());
+    ASSERT_TRUE(solver.solve(pc)->isTimeout());
+    ASSERT_EQ(2, backend->mQueries);
+    ASSERT_EQ(0, solver.size());
+}
+
+TEST(CachingSolverTest, EVICTS_OLDEST_ENTRIES) {
+    QSharedPointer<StubSolver> backend = QSharedPointer<StubSolver>(new StubSolver(SolutionPtr(new Solution(false, true))));
+    CachingSolver solver(backend, 2);
+
+    for (int i = 0; i < 3; i++) {
+        PathConditionPtr pc = PathConditionPtr(new PathCondition());
+        pc->addCondition(stringEquals(input("SYM_IN_a"), QString::number(i).toStdString()), true);
+        solver.solve(pc);
+    }
+
+    ASSERT_EQ(2, solver.size());
+}
+
+TEST(CachingSolverTest, PERSISTS_ENTRIES_FOR_THE_SAME_SITE) {
+    QString fileName = QDir::temp().filePath("artemis-cachingsolvertest.cache");
+
+    Symbolic::Expression* a = stringEquals(input("SYM_IN_a"), "quote\" and \\ backslash");
+    Symbolic::Expression* b = stringEquals(input("SYM_IN_b"), "y");
+
+    QSharedPointer<StubSolver> backend = QSharedPointer<StubSolver>(new StubSolver(model("SYM_IN_a", "x")));
+    CachingSolver solver(backend);
+
+    PathConditionPtr sat = PathConditionPtr(new PathCondition());
+    sat->addCondition(a, false);
+    solver.solve(sat);
+
+    backend->mResult = SolutionPtr(new Solution(false, true));
+    PathConditionPtr unsat = PathConditionPtr(new PathCondition());
+    unsat->addCondition(b, true);
+    solver.solve(unsat);
+
+    ASSERT_TRUE(solver.save(fileName, "http://localhost/site"));
+
+    CachingSolver otherSite(backend);
+    ASSERT_FALSE(otherSite.load(fileName, "http://localhost/other"));
+    ASSERT_EQ(0, otherSite.size());
+
+    QSharedPointer<StubSolver> fresh = QSharedPointer<StubSolver>(new StubSolver(SolutionPtr(new Solution(false, false, "failed"))));
+    CachingSolver loaded(fresh);
+    ASSERT_TRUE(loaded.load(fileName, "http://localhost/site"));
+    ASSERT_EQ(2, loaded.size());
+
+    SolutionPtr solution = loaded.solve(sat);
+    ASSERT_TRUE(solution->isSolved());
+    ASSERT_EQ(std::string("x"), solution->findSymbol("SYM_IN_a").string);
+    ASSERT_TRUE(loaded.solve(unsat)->isUnsat());
+    ASSERT_EQ(0, fresh->mQueries);
+
+    QFile::remove(fileName);
+}
+
+}
@@ -0,0 +1,43 @@
+#include <QVector>
+
+#include "include/gtest/gtest.h"
+
+#include "concolic/solver/concreteregex.h"
+
+namespace artemis
+{
+
+TEST(ConcreteRegexTest, MATCHES_WITH_CAPTURES) {
+    ConcreteRegexPtr regex = ConcreteRegex::compile("(\\d+)-(x)?");
+    ASSERT_TRUE(regex->isValid());
+    ASSERT_EQ(2, regex->subpatternCount());
+
+    QVector<int> captures;
+    ASSERT_TRUE(regex->match("ab12-", 0, captures));
+    ASSERT_EQ(2, captures.at(0));
+    ASSERT_EQ(5, captures.at(1));
+    ASSERT_EQ(2, captures.at(2));
+    ASSERT_EQ(4, captures.at(3));
+    ASSERT_EQ(-1, captures.at(4));
+
+    ASSERT_FALSE(regex->match("ab-", 0, captures));
+    ASSERT_FALSE(ConcreteRegex::compile("(")->isValid());
+}
+
+TEST(ConcreteRegexTest, REPLACES_LIKE_JAVASCRIPT) {
+    bool global;
+
+    ConcreteRegexPtr regex = ConcreteRegex::compileLiteral("/a(b)/g", &global);
+    ASSERT_TRUE(global);
+    ASSERT_EQ(QString("[b$ab]c[b$ab]"), regex->replace("abcab", "[$1$$$&]", global));
+    ASSERT_EQ(QString("[b$ab]cab"), regex->replace("abcab", "[$1$$$&]", false));
+
+    regex = ConcreteRegex::compileLiteral("/x*/g", &global);
+    ASSERT_EQ(QString("-a-b-"), regex->replace("ab", "-", global));
+
+    regex = ConcreteRegex::compileLiteral("/B/i", &global);
+    ASSERT_FALSE(global);
+    ASSERT_EQ(QString("a_c"), regex->replace("abc", "_", global));
+}
+
+}
@@ -0,0 +1,60 @@
+#include <QDir>
+#include <QFile>
+
+#include "include/gtest/gtest.h"
+
+#include "concolic/solver/constraintwriter/cvc4.h"
+#include "concolic/pathcondition.h"
+
+#include <JavaScriptCore/symbolic/expr.h>
+
+namespace artemis
+{
+
+static QString writeConstraints(PathConditionPtr pc)
+{
+    QString path = QDir::temp().filePath("artemis-cvc4constraintwritertest");
+
+    CVC4ConstraintWriter writer;
+    EXPECT_TRUE(writer.write(pc, path.toStdString()));
+
+    QFile file(path);
+    file.open(QIODevice::ReadOnly);
+    QString result = QString(file.readAll());
+    file.remove();
+
+    return result;
+}
+
+TEST(CVC4ConstraintWriterTest, SHARED_SUBEXPRESSIONS_ARE_DEFINED_ONCE) {
+    Symbolic::StringExpression* value = new Symbolic::SymbolicString(Symbolic::SymbolicSource(Symbolic::INPUT, Symbolic::INPUT_NAME, "x"));
+    PathConditionPtr pc = PathConditionPtr(new PathCondition());
+
+    // A string built by a concatenation loop, with a condition on each step.
+    const int steps = 50;
+    for (int i = 0; i < steps; i++) {
+        value = new Symbolic::StringBinaryOperation(value, Symbolic::CONCAT, new Symbolic::ConstantString(new std::string("a")));
+        pc->addCondition(new Symbolic::StringBinaryOperation(value, Symbolic::STRING_EQ, new Symbolic::ConstantString(new std::string("b"))), false);
+    }
+
+    QString constraints = writeConstraints(pc);
+
+    ASSERT_EQ(steps - 1, constraints.count("(define-fun "));
+    ASSERT_EQ(steps, constraints.count("(str.++ "));
+    ASSERT_EQ(steps, constraints.count("(assert "));
+}
+
+TEST(CVC4ConstraintWriterTest, SINGLE_USES_ARE_INLINED) {
+    Symbolic::StringExpression* x = new Symbolic::SymbolicString(Symbolic::SymbolicSource(Symbolic::INPUT, Symbolic::INPUT_NAME, "x"));
+
+    PathConditionPtr pc = PathConditionPtr(new PathCondition());
+    pc->addCondition(new Symbolic::IntegerBinaryOperation(new Symbolic::StringLength(x), Symbolic::INT_GT, new Symbolic::ConstantInteger(2)), true);
+    pc->addCondition(new Symbolic::StringBinaryOperation(x, Symbolic::STRING_EQ, new Symbolic::ConstantString(new std::string("abc"))), true);
+
+    QString constraints = writeConstraints(pc);
+
+    ASSERT_EQ(0, constraints.count("(define-fun "));
+    ASSERT_TRUE(constraints.contains("(assert (= (> (str.len x) 2) true))"));
+}
+
+}
@@ -138,5 +138,20 @@ TEST(CVC4RegexTest, CHAR_CLASS_W) {
     ASSERT_EQ("(re.or (re.range \"0\" \"9\") (re.range \"A\" \"Z\") (re.range \"a\" \"z\") \"_\")", result);
 }
 
+TEST(CVC4RegexTest, CACHED_TRANSLATIONS) {
+    bool bol, eol = false;
+    std::string first = CVC4RegexCompiler::compile("^ab", bol, eol);
+    ASSERT_EQ(bol, true);
+
+    bol = false;
+    eol = true;
+    std::string second = CVC4RegexCompiler::compile("^ab", bol, eol);
+    ASSERT_EQ(first, second);
+    ASSERT_EQ(bol, true);
+    ASSERT_EQ(eol, false);
+
+    ASSERT_THROW(CVC4RegexCompiler::compile("\\bword", bol, eol), CVC4RegexCompilerException);
+    ASSERT_THROW(CVC4RegexCompiler::compile("\\bword", bol, eol), CVC4RegexCompilerException);
+}
 
 }
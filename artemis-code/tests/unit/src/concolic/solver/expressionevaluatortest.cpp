@@ -0,0 +1,79 @@
+#include <cmath>
+#include <limits>
+
+#include "include/gtest/gtest.h"
+
+#include "concolic/solver/expressionevaluator.h"
+#include "concolic/pathcondition.h"
+#include "solvertest.h"
+
+#include <JavaScriptCore/symbolic/expr.h>
+
+namespace artemis
+{
+
+TEST(ExpressionEvaluatorTest, NUMBER_TO_STRING) {
+    ASSERT_EQ(QString("0"), ConcreteValue::numberToString(-0.0));
+    ASSERT_EQ(QString("12"), ConcreteValue::numberToString(12));
+    ASSERT_EQ(QString("-2.5"), ConcreteValue::numberToString(-2.5));
+    ASSERT_EQ(QString("0.1"), ConcreteValue::numberToString(0.1));
+    ASSERT_EQ(QString("0.000001"), ConcreteValue::numberToString(1e-6));
+    ASSERT_EQ(QString("1e-7"), ConcreteValue::numberToString(1e-7));
+    ASSERT_EQ(QString("100000000000000000000"), ConcreteValue::numberToString(1e20));
+    ASSERT_EQ(QString("1e+21"), ConcreteValue::numberToString(1e21));
+    ASSERT_EQ(QString("1.5e+300"), ConcreteValue::numberToString(1.5e300));
+    ASSERT_EQ(QString("NaN"), ConcreteValue::numberToString(std::numeric_limits<double>::quiet_NaN()));
+    ASSERT_EQ(QString("-Infinity"), ConcreteValue::numberToString(-std::numeric_limits<double>::infinity()));
+}
+
+TEST(ExpressionEvaluatorTest, STRING_TO_NUMBER) {
+    ASSERT_EQ(0, ConcreteValue::stringToNumber(""));
+    ASSERT_EQ(0, ConcreteValue::stringToNumber("  "));
+    ASSERT_EQ(12, ConcreteValue::stringToNumber(" 12\n"));
+    ASSERT_EQ(-0.5, ConcreteValue::stringToNumber("-.5"));
+    ASSERT_EQ(31, ConcreteValue::stringToNumber("0x1F"));
+    ASSERT_EQ(1000, ConcreteValue::stringToNumber("1e3"));
+    ASSERT_TRUE(std::isinf(ConcreteValue::stringToNumber("Infinity")));
+    ASSERT_TRUE(std::isnan(ConcreteValue::stringToNumber("12px")));
+    ASSERT_TRUE(std::isnan(ConcreteValue::stringToNumber("inf")));
+}
+
+TEST(ExpressionEvaluatorTest, CHECKS_MODEL_AGAINST_PC) {
+    Symbolic::StringExpression* name = input("SYM_IN_name");
+
+    PathConditionPtr pc = PathConditionPtr(new PathCondition());
+    pc->addCondition(stringEquals(name, "admin"), false);
+    pc->addCondition(new Symbolic::IntegerBinaryOperation(new Symbolic::StringLength(name), Symbolic::INT_GT,
+                                                          new Symbolic::ConstantInteger(3)), true);
+
+    ASSERT_TRUE(ExpressionEvaluator(model("SYM_IN_name", "user")->getSymbols()).satisfies(pc));
+    ASSERT_FALSE(ExpressionEvaluator(model("SYM_IN_name", "admin")->getSymbols()).satisfies(pc));
+    ASSERT_FALSE(ExpressionEvaluator(model("SYM_IN_name", "abc")->getSymbols()).satisfies(pc));
+
+    // Unassigned variables make the PC unknown rather than false.
+    ASSERT_FALSE(ExpressionEvaluator(model("SYM_IN_other", "user")->getSymbols()).satisfies(pc));
+}
+
+TEST(ExpressionEvaluatorTest, EVALUATES_REGULAR_EXPRESSIONS) {
+    Symbolic::StringRegexSubmatchArray* match = new Symbolic::StringRegexSubmatchArray(0, input("SYM_IN_name"), new std::string("^id-(\\d+)$"));
+    Symbolic::Expression* group = new Symbolic::StringRegexSubmatchArrayAt(match, 1);
+    Symbolic::Expression* isMatch = new Symbolic::StringRegexSubmatchArrayMatch(match);
+    Symbolic::Expression* index = new Symbolic::StringRegexSubmatchIndex(input("SYM_IN_name"), new std::string("\\d"));
+    Symbolic::Expression* test = new Symbolic::StringRegexSubmatch(input("SYM_IN_name"), new std::string("^id"));
+
+    SolutionPtr id = model("SYM_IN_name", "id-42");
+    ExpressionEvaluator matching(id->getSymbols());
+    ASSERT_EQ(QString("42"), matching.evaluate(group).toString());
+    ASSERT_TRUE(matching.evaluate(isMatch).toBoolean());
+    ASSERT_EQ(3, matching.evaluate(index).toNumber());
+    ASSERT_TRUE(matching.evaluate(test).toBoolean());
+
+    SolutionPtr name = model("SYM_IN_name", "name");
+    ExpressionEvaluator other(name->getSymbols());
+    ASSERT_FALSE(other.evaluate(group).isKnown());
+    ASSERT_TRUE(other.evaluate(isMatch).isNullObject());
+    ASSERT_EQ(-1, other.evaluate(index).toNumber());
+    ASSERT_FALSE(other.evaluate(test).toBoolean());
+}
+
+}
@@ -0,0 +1,39 @@
+#include "include/gtest/gtest.h"
+
+#include "concolic/solver/expressionserializer.h"
+
+#include <JavaScriptCore/symbolic/expr.h>
+
+namespace artemis
+{
+
+static void writeSymbolicInteger(QDataStream& out)
+{
+    out << (quint8)ExpressionSerializer::SYMBOLIC_INTEGER << (qint32)Symbolic::INPUT << (qint32)Symbolic::INPUT_NAME << QByteArray("count");
+}
+
+TEST(ExpressionDeserializerTest, REJECTS_OUT_OF_RANGE_OPERATORS) {
+    QByteArray records;
+    QDataStream out(&records, QIODevice::WriteOnly);
+    writeSymbolicInteger(out);
+    out << (quint8)ExpressionSerializer::INTEGER_BINARY_OPERATION << (quint32)0 << (qint32)(Symbolic::INT_SEQ + 1) << (quint32)0;
+
+    QDataStream in(records);
+    ExpressionDeserializer expressions(in);
+    ASSERT_TRUE(expressions.readRecord());
+    ASSERT_FALSE(expressions.readRecord());
+}
+
+TEST(ExpressionDeserializerTest, REJECTS_CHILDREN_OF_THE_WRONG_KIND) {
+    QByteArray records;
+    QDataStream out(&records, QIODevice::WriteOnly);
+    writeSymbolicInteger(out);
+    out << (quint8)ExpressionSerializer::STRING_REGEX_SUBMATCH_ARRAY_MATCH << (quint32)0;
+
+    QDataStream in(records);
+    ExpressionDeserializer expressions(in);
+    ASSERT_TRUE(expressions.readRecord());
+    ASSERT_FALSE(expressions.readRecord());
+}
+
+}
@@ -0,0 +1,127 @@
+#include "include/gtest/gtest.h"
+
+#include "concolic/solver/expressionkeyprinter.h"
+#include "concolic/solver/expressionsimplifier.h"
+#include "concolic/solver/simplifyingsolver.h"
+#include "concolic/pathcondition.h"
+#include "solvertest.h"
+
+#include <JavaScriptCore/symbolic/expr.h>
+
+namespace artemis
+{
+
+static std::string key(Symbolic::Expression* expression)
+{
+    ExpressionKeyPrinter printer;
+    expression->accept(&printer);
+    return printer.getResult();
+}
+
+TEST(ExpressionSimplifierTest, FOLDS_CONSTANTS) {
+    ExpressionSimplifier simplifier;
+
+    Symbolic::Expression* sum = new Symbolic::IntegerBinaryOperation(new Symbolic::ConstantInteger(2), Symbolic::INT_ADD, new Symbolic::ConstantInteger(3));
+    ASSERT_EQ(key(new Symbolic::ConstantInteger(5)), key(simplifier.simplify(sum)));
+
+    Symbolic::Expression* concat = new Symbolic::StringBinaryOperation(input("x"), Symbolic::STRING_EQ,
+                                                                       new Symbolic::StringBinaryOperation(constant("a"), Symbolic::CONCAT, constant("b")));
+    ASSERT_EQ(key(new Symbolic::StringBinaryOperation(input("x"), Symbolic::STRING_EQ, constant("ab"))), key(simplifier.simplify(concat)));
+
+    // Division by zero is not folded, as there is no constant for the result.
+    Symbolic::Expression* division = new Symbolic::IntegerBinaryOperation(new Symbolic::ConstantInteger(1), Symbolic::INT_DIVIDE, new Symbolic::ConstantInteger(0));
+    ASSERT_EQ(division, simplifier.simplify(division));
+}
+
+TEST(ExpressionSimplifierTest, REMOVES_COERCIONS) {
+    ExpressionSimplifier simplifier;
+
+    Symbolic::Expression* coerced = new Symbolic::StringBinaryOperation(new Symbolic::StringCoercion(input("x")),
+                                                                        Symbolic::STRING_EQ, constant("a"));
+    ASSERT_EQ(key(new Symbolic::StringBinaryOperation(input("x"), Symbolic::STRING_EQ, constant("a"))), key(simplifier.simplify(coerced)));
+
+    Symbolic::Expression* numeric = new Symbolic::IntegerCoercion(input("x"));
+    ASSERT_EQ(numeric, simplifier.simplify(numeric));
+}
+
+TEST(ExpressionSimplifierTest, REMOVES_CONSTANT_AND_DUPLICATE_CONDITIONS) {
+    ExpressionSimplifier simplifier;
+    Symbolic::StringExpression* x = input("x");
+
+    PathConditionPtr pc = PathConditionPtr(new PathCondition());
+    pc->addCondition(new Symbolic::ConstantBoolean(true), true);
+    pc->addCondition(new Symbolic::StringBinaryOperation(x, Symbolic::STRING_NEQ, constant("a")), false);
+    pc->addCondition(new Symbolic::StringBinaryOperation(x, Symbolic::STRING_EQ, constant("a")), true);
+    pc->addCondition(new Symbolic::BooleanBinaryOperation((Symbolic::BooleanExpression*)new Symbolic::StringBinaryOperation(x, Symbolic::STRING_EQ, constant("a")),
+                                                          Symbolic::BOOL_EQ, new Symbolic::ConstantBoolean(false)), false);
+
+    PathConditionPtr simplified = simplifier.simplify(pc);
+
+    ASSERT_FALSE(simplified.isNull());
+    ASSERT_EQ(1u, simplified->size());
+    ASSERT_EQ(key(new Symbolic::StringBinaryOperation(x, Symbolic::STRING_EQ, constant("a"))), key(simplified->get(0).first));
+    ASSERT_TRUE(simplified->get(0).second);
+}
+
+TEST(ExpressionSimplifierTest, DETECTS_CONTRADICTIONS) {
+    ExpressionSimplifier simplifier;
+    Symbolic::StringExpression* x = input("x");
+
+    PathConditionPtr folded = PathConditionPtr(new PathCondition());
+    folded->addCondition(new Symbolic::ConstantBoolean(false), true);
+    ASSERT_TRUE(simplifier.simplify(folded).isNull());
+
+    PathConditionPtr negated = PathConditionPtr(new PathCondition());
+    negated->addCondition(new Symbolic::StringBinaryOperation(x, Symbolic::STRING_EQ, constant("a")), true);
+    negated->addCondition(new Symbolic::StringBinaryOperation(x, Symbolic::STRING_NEQ, constant("a")), true);
+    ASSERT_TRUE(simplifier.simplify(negated).isNull());
+
+    PathConditionPtr fixed = PathConditionPtr(new PathCondition());
+    fixed->addCondition(new Symbolic::StringBinaryOperation(x, Symbolic::STRING_EQ, constant("a")), true);
+    fixed->addCondition(new Symbolic::StringBinaryOperation(x, Symbolic::STRING_EQ, constant("b")), true);
+    ASSERT_TRUE(simplifier.simplify(fixed).isNull());
+}
+
+TEST(ExpressionSimplifierTest, PRUNES_CONDITIONS_ON_FIXED_INPUTS) {
+    ExpressionSimplifier simplifier;
+    Symbolic::StringExpression* x = input("x");
+    Symbolic::StringExpression* y = input("y");
+
+    PathConditionPtr pc = PathConditionPtr(new PathCondition());
+    pc->addCondition(new Symbolic::StringBinaryOperation(x, Symbolic::STRING_EQ, constant("ab")), true);
+    pc->addCondition(new Symbolic::IntegerBinaryOperation(new Symbolic::StringLength(x), Symbolic::INT_EQ, new Symbolic::ConstantInteger(2)), true);
+    pc->addCondition(new Symbolic::StringBinaryOperation(x, Symbolic::STRING_EQ, y), true);
+
+    PathConditionPtr simplified = simplifier.simplify(pc);
+
+    ASSERT_FALSE(simplified.isNull());
+    ASSERT_EQ(2u, simplified->size());
+    ASSERT_EQ(pc->get(0).first, simplified->get(0).first);
+    ASSERT_EQ(pc->get(2).first, simplified->get(1).first);
+
+    PathConditionPtr contradicted = PathConditionPtr(new PathCondition());
+    contradicted->addCondition(pc->get(0).first, true);
+    contradicted->addCondition(new Symbolic::IntegerBinaryOperation(new Symbolic::StringLength(x), Symbolic::INT_GT, new Symbolic::ConstantInteger(2)), true);
+    ASSERT_TRUE(simplifier.simplify(contradicted).isNull());
+}
+
+TEST(SimplifyingSolverTest, ANSWERS_UNSAT_WITHOUT_BACKEND) {
+    QSharedPointer<StubSolver> backend = QSharedPointer<StubSolver>(new StubSolver());
+    SimplifyingSolver solver(backend);
+
+    PathConditionPtr unsat = PathConditionPtr(new PathCondition());
+    unsat->addCondition(new Symbolic::StringBinaryOperation(constant("a"), Symbolic::STRING_EQ, constant("b")), true);
+
+    ASSERT_TRUE(solver.solve(unsat)->isUnsat());
+    ASSERT_TRUE(backend->mLastPC.isNull());
+
+    PathConditionPtr pc = PathConditionPtr(new PathCondition());
+    pc->addCondition(new Symbolic::StringBinaryOperation(input("x"), Symbolic::STRING_EQ, constant("b")), true);
+    pc->addCondition(new Symbolic::ConstantBoolean(true), true);
+
+    solver.solve(pc);
+    ASSERT_FALSE(backend->mLastPC.isNull());
+    ASSERT_EQ(1u, backend->mLastPC->size());
+}
+
+}
@@ -0,0 +1,83 @@
+#include "include/gtest/gtest.h"
+
+#include "concolic/solver/expressionevaluator.h"
+#include "concolic/solver/localsearchsolver.h"
+#include "concolic/pathcondition.h"
+#include "solvertest.h"
+
+#include <JavaScriptCore/symbolic/expr.h>
+
+namespace artemis
+{
+
+TEST(LocalSearchSolverTest, SOLVES_WITH_CONSTANTS_AND_EDITS) {
+    Symbolic::StringExpression* name = input("SYM_IN_name");
+
+    PathConditionPtr pc = PathConditionPtr(new PathCondition());
+    pc->addCondition(new Symbolic::IntegerBinaryOperation(new Symbolic::StringLength(name), Symbolic::INT_GT,
+                                                          new Symbolic::ConstantInteger(3)), true);
+    pc->addCondition(new Symbolic::StringBinaryOperation(new Symbolic::StringCharAt(name, 0), Symbolic::STRING_EQ,
+                                                         constant("b")), true);
+
+    QSharedPointer<StubSolver> backend = QSharedPointer<StubSolver>(new StubSolver());
+    LocalSearchSolver solver(backend);
+
+    SolutionPtr solution = solver.solve(pc);
+
+    ASSERT_TRUE(solution->isSolved());
+    ASSERT_EQ(0, backend->mQueries);
+    ASSERT_TRUE(ExpressionEvaluator(solution->getSymbols()).satisfies(pc));
+}
+
+TEST(LocalSearchSolverTest, STARTS_FROM_SEEDS) {
+    PathConditionPtr pc = PathConditionPtr(new PathCondition());
+    pc->addCondition(new Symbolic::StringRegexSubmatch(input("SYM_IN_name"), new std::string("world$")), true);
+
+    QSharedPointer<StubSolver> backend = QSharedPointer<StubSolver>(new StubSolver());
+    LocalSearchSolver solver(backend);
+
+    ASSERT_FALSE(solver.solve(pc)->isSolved());
+    ASSERT_EQ(1, backend->mQueries);
+
+    solver.addSeed(model("SYM_IN_name", "hello world"));
+
+    SolutionPtr solution = solver.solve(pc);
+    ASSERT_TRUE(solution->isSolved());
+    ASSERT_EQ(std::string("hello world"), solution->findSymbol("SYM_IN_name").string);
+    ASSERT_EQ(1, backend->mQueries);
+}
+
+TEST(LocalSearchSolverTest, SEARCHES_BOOLEAN_AND_INTEGER_INPUTS_IN_THEIR_DOMAINS) {
+    Symbolic::SymbolicBoolean* checked = new Symbolic::SymbolicBoolean(Symbolic::SymbolicSource(Symbolic::INPUT, Symbolic::INPUT_NAME, "SYM_IN_checked"));
+    Symbolic::SymbolicInteger* index = new Symbolic::SymbolicInteger(Symbolic::SymbolicSource(Symbolic::INPUT, Symbolic::INPUT_NAME, "SYM_IN_index"));
+
+    PathConditionPtr pc = PathConditionPtr(new PathCondition());
+    pc->addCondition(checked, true);
+    pc->addCondition(new Symbolic::IntegerBinaryOperation(index, Symbolic::INT_EQ, new Symbolic::ConstantInteger(2)), true);
+
+    QSharedPointer<StubSolver> backend = QSharedPointer<StubSolver>(new StubSolver());
+    LocalSearchSolver solver(backend);
+
+    SolutionPtr solution = solver.solve(pc);
+    ASSERT_TRUE(solution->isSolved());
+    ASSERT_EQ(0, backend->mQueries);
+
+    // The values are injected according to their kind, so they must not come back as (truthy) strings.
+    ASSERT_EQ(Symbolic::BOOL, solution->findSymbol("SYM_IN_checked").kind);
+    ASSERT_TRUE(solution->findSymbol("SYM_IN_checked").u.boolean);
+    ASSERT_EQ(Symbolic::INT, solution->findSymbol("SYM_IN_index").kind);
+    ASSERT_EQ(2, solution->findSymbol("SYM_IN_index").u.integer);
+}
+
+TEST(LocalSearchSolverTest, ZERO_BUDGET_FORWARDS_EVERYTHING) {
+    PathConditionPtr pc = PathConditionPtr(new PathCondition());
+    pc->addCondition(stringEquals(input("SYM_IN_name"), "admin"), true);
+
+    QSharedPointer<StubSolver> backend = QSharedPointer<StubSolver>(new StubSolver());
+    LocalSearchSolver solver(backend, 0);
+
+    ASSERT_FALSE(solver.solve(pc)->isSolved());
+    ASSERT_EQ(1, backend->mQueries);
+}
+
+}
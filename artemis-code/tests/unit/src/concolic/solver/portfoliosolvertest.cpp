@@ -0,0 +1,105 @@
+#include <QElapsedTimer>
+
+#include "include/gtest/gtest.h"
+
+#include "concolic/solver/portfoliosolver.h"
+#include "concolic/pathcondition.h"
+#include "solvertest.h"
+
+namespace artemis
+{
+
+TEST(PortfolioSolverTest, PROCESS_SOLVER_TIMES_OUT) {
+    FakeSolver solver("FakeStuck", "sleep 30", SolutionPtr(new Solution(true, false)));
+    solver.setTimeout(200);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    SolutionPtr solution = solver.solve(PathConditionPtr(new PathCondition()));
+
+    ASSERT_TRUE(solution->isTimeout());
+    ASSERT_FALSE(solution->isSolved());
+    ASSERT_LT(timer.elapsed(), 10000);
+}
+
+TEST(PortfolioSolverTest, FIRST_DECISION_WINS) {
+    QList<ProcessSolverPtr> solvers;
+    solvers.append(ProcessSolverPtr(new FakeSolver("FakeSlow", "sleep 30", SolutionPtr(new Solution(true, false)))));
+    solvers.append(ProcessSolverPtr(new FakeSolver("FakeFast", "true", SolutionPtr(new Solution(false, true)))));
+
+    PortfolioSolver solver(solvers);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    SolutionPtr solution = solver.solve(PathConditionPtr(new PathCondition()));
+
+    ASSERT_TRUE(solution->isUnsat());
+    ASSERT_LT(timer.elapsed(), 10000);
+    ASSERT_EQ(1, statistics()->counter("Concolic::Solver::Portfolio::FakeFast::Wins").value());
+    ASSERT_EQ(1, statistics()->counter("Concolic::Solver::Portfolio::FakeSlow::Killed").value());
+}
+
+TEST(PortfolioSolverTest, FAILURES_DO_NOT_WIN) {
+    QList<ProcessSolverPtr> solvers;
+    solvers.append(ProcessSolverPtr(new FakeSolver("FakeFailing", "true", SolutionPtr(new Solution(false, false, "failed")))));
+    solvers.append(ProcessSolverPtr(new FakeSolver("FakeDeciding", "sleep 1", SolutionPtr(new Solution(true, false)))));
+
+    PortfolioSolver solver(solvers);
+    SolutionPtr solution = solver.solve(PathConditionPtr(new PathCondition()));
+
+    ASSERT_TRUE(solution->isSolved());
+    ASSERT_EQ(1, statistics()->counter("Concolic::Solver::Portfolio::FakeFailing::Failures").value());
+}
+
+TEST(PortfolioSolverTest, RETURNS_FIRST_FAILURE_WHEN_UNDECIDED) {
+    QList<ProcessSolverPtr> solvers;
+    solvers.append(ProcessSolverPtr(new FakeSolver("FakeFirst", "sleep 1", SolutionPtr(new Solution(false, false, "first")))));
+    solvers.append(ProcessSolverPtr(new FakeSolver("FakeSecond", "true", SolutionPtr(new Solution(false, false, "second")))));
+
+    PortfolioSolver solver(solvers);
+    SolutionPtr solution = solver.solve(PathConditionPtr(new PathCondition()));
+
+    ASSERT_FALSE(solution->isSolved());
+    ASSERT_FALSE(solution->isUnsat());
+    ASSERT_EQ(QString("second"), solution->getUnsolvableReason());
+}
+
+TEST(PortfolioSolverTest, TIMES_OUT_WHILE_UNDECIDED) {
+    QList<ProcessSolverPtr> solvers;
+    solvers.append(ProcessSolverPtr(new FakeSolver("FakeFailingEarly", "true", SolutionPtr(new Solution(false, false, "failed")))));
+    solvers.append(ProcessSolverPtr(new FakeSolver("FakeStuckLong", "sleep 30", SolutionPtr(new Solution(true, false)))));
+
+    PortfolioSolver solver(solvers);
+    solver.setTimeout(200);
+
+    SolutionPtr solution = solver.solve(PathConditionPtr(new PathCondition()));
+
+    ASSERT_TRUE(solution->isTimeout());
+    ASSERT_EQ(1, statistics()->counter("Concolic::Solver::Portfolio::FakeStuckLong::Killed").value());
+}
+
+TEST(PortfolioSolverTest, ONLY_THE_RETURNED_RESULT_IS_COUNTED) {
+    QList<ProcessSolverPtr> solvers;
+    solvers.append(ProcessSolverPtr(new FakeSolver("FakeCountedFailing", "true", SolutionPtr(new Solution(false, false, "failed")))));
+    solvers.append(ProcessSolverPtr(new FakeSolver("FakeCountedDeciding", "sleep 1", SolutionPtr(new Solution(true, false)))));
+
+    StatsCounter written = statistics()->counter("Concolic::Solver::ConstraintsWritten");
+    StatsCounter solved = statistics()->counter("Concolic::Solver::ConstraintsSolved");
+    StatsCounter notSolved = statistics()->counter("Concolic::Solver::ConstraintsNotSolved");
+
+    int writtenBefore = written.value();
+    int solvedBefore = solved.value();
+    int notSolvedBefore = notSolved.value();
+
+    PortfolioSolver solver(solvers);
+    SolutionPtr solution = solver.solve(PathConditionPtr(new PathCondition()));
+
+    ASSERT_TRUE(solution->isSolved());
+    ASSERT_EQ(writtenBefore + 1, written.value());
+    ASSERT_EQ(solvedBefore + 1, solved.value());
+    ASSERT_EQ(notSolvedBefore, notSolved.value());
+}
+
+}
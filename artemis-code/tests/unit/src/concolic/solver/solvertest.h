@@ -0,0 +1,116 @@
+#ifndef SOLVERTEST_H
+#define SOLVERTEST_H
+
+#include <string>
+
+#include <QString>
+#include <QStringList>
+
+#include "concolic/solver/processsolver.h"
+#include "concolic/solver/solver.h"
+#include "concolic/pathcondition.h"
+#include "statistics/statsstorage.h"
+
+#include <JavaScriptCore/symbolic/expr.h>
+
+namespace artemis
+{
+
+/*
+ * Backends and expressions shared by the solver tests.
+ */
+
+// A backend which counts its queries, records the last PC it was given and always returns the same result.
+class StubSolver : public Solver
+{
+public:
+    StubSolver(SolutionPtr result = SolutionPtr(new Solution(false, false, "unsolved")))
+        : mResult(result)
+        , mQueries(0)
+    {
+    }
+
+    SolutionPtr solve(PathConditionPtr pc)
+    {
+        mQueries++;
+        mLastPC = pc;
+        return mResult;
+    }
+
+    SolutionPtr mResult;
+    int mQueries;
+    PathConditionPtr mLastPC;
+};
+
+// A backend which runs a shell command and then reports a fixed result. Like the real backends, it updates the global
+// solver statistics.
+class FakeSolver : public ProcessSolver
+{
+public:
+    FakeSolver(QString name, QString command, SolutionPtr result)
+        : mName(name)
+        , mCommand(command)
+        , mResult(result)
+    {
+    }
+
+    QString getName() const
+    {
+        return mName;
+    }
+
+    SolutionPtr prepare(PathConditionPtr pc, SolverProcess* process, QString& program, QStringList& arguments)
+    {
+        program = "/bin/sh";
+        arguments << "-c" << mCommand;
+        statistics()->accumulate("Concolic::Solver::ConstraintsWritten", 1);
+        return SolutionPtr();
+    }
+
+    SolutionPtr interpret(int exitCode)
+    {
+        if (mResult->isSolved() || mResult->isUnsat()) {
+            statistics()->accumulate("Concolic::Solver::ConstraintsSolved", 1);
+        } else {
+            statistics()->accumulate("Concolic::Solver::ConstraintsNotSolved", 1);
+        }
+        return mResult;
+    }
+
+private:
+    QString mName;
+    QString mCommand;
+    SolutionPtr mResult;
+};
+
+inline Symbolic::StringExpression* input(std::string name)
+{
+    return new Symbolic::SymbolicString(Symbolic::SymbolicSource(Symbolic::INPUT, Symbolic::INPUT_NAME, name));
+}
+
+inline Symbolic::StringExpression* constant(std::string value)
+{
+    return new Symbolic::ConstantString(new std::string(value));
+}
+
+inline Symbolic::Expression* stringEquals(Symbolic::StringExpression* lhs, std::string value)
+{
+    return new Symbolic::StringBinaryOperation(lhs, Symbolic::STRING_EQ, constant(value));
+}
+
+// A solution assigning a string value to a single variable.
+inline SolutionPtr model(QString variable, std::string value)
+{
+    Symbolvalue symbol;
+    symbol.found = true;
+    symbol.kind = Symbolic::STRING;
+    symbol.string = value;
+
+    SolutionPtr solution = SolutionPtr(new Solution(true, false));
+    solution->insertSymbol(variable, symbol);
+    return solution;
+}
+
+}
+
+#endif // SOLVERTEST_H
@@ -0,0 +1,39 @@
+#include <fstream>
+
+#include "include/gtest/gtest.h"
+
+#include "concolic/solver/z3solver.h"
+
+namespace artemis
+{
+
+// Z3Solver::interpret reads the result of the solver script from this file.
+static void writeResult(const std::string& result)
+{
+    std::ofstream fp("/tmp/z3result", std::ofstream::out | std::ofstream::trunc);
+    fp << "************************" << std::endl << result << std::endl << "************************" << std::endl;
+}
+
+TEST(Z3SolverTest, READS_UNSAT) {
+    writeResult(">> UNSAT");
+
+    SolutionPtr solution = Z3Solver().interpret(0);
+    ASSERT_FALSE(solution->isSolved());
+    ASSERT_TRUE(solution->isUnsat());
+}
+
+TEST(Z3SolverTest, UNKNOWN_RESULTS_ARE_NOT_UNSAT) {
+    writeResult(">> UNKNOWN");
+
+    SolutionPtr solution = Z3Solver().interpret(0);
+    ASSERT_FALSE(solution->isSolved());
+    ASSERT_FALSE(solution->isUnsat());
+
+    writeResult("");
+
+    solution = Z3Solver().interpret(0);
+    ASSERT_FALSE(solution->isSolved());
+    ASSERT_FALSE(solution->isUnsat());
+}
+
+}
@@ -0,0 +1,176 @@
+#include <QDir>
+
+#include "include/gtest/gtest.h"
+
+#include "concolic/executiontree/tracecheckpoint.h"
+#include "concolic/executiontree/traceeventlog.h"
+#include "concolic/solver/expressionkeyprinter.h"
+
+#include <JavaScriptCore/symbolic/expr.h>
+
+namespace artemis
+{
+
+static std::string printKey(Symbolic::Expression* expression)
+{
+    ExpressionKeyPrinter printer;
+    expression->accept(&printer);
+    return printer.getResult();
+}
+
+static QString checkpointFile()
+{
+    return QDir::temp().filePath("artemis-tracecheckpointtest.tree");
+}
+
+TEST(TraceCheckpointTest, ROUND_TRIPS_TREE) {
+    Symbolic::StringExpression* name = new Symbolic::SymbolicString(Symbolic::SymbolicSource(Symbolic::INPUT, Symbolic::INPUT_NAME, "name"));
+    Symbolic::Expression* isEmpty = new Symbolic::IntegerBinaryOperation(new Symbolic::StringLength(name), Symbolic::INT_EQ, new Symbolic::ConstantInteger(0));
+    Symbolic::Expression* isAdmin = new Symbolic::StringBinaryOperation(name, Symbolic::STRING_EQ, new Symbolic::ConstantString(new std::string("admin")));
+
+    QSharedPointer<TraceAlert> alert = QSharedPointer<TraceAlert>(new TraceAlert());
+    alert->message = "Name is empty";
+    alert->next = TraceNodePtr(new TraceEndFailure());
+
+    QSharedPointer<TraceSymbolicBranch> inner = QSharedPointer<TraceSymbolicBranch>(new TraceSymbolicBranch(isAdmin));
+    inner->setTrueBranch(TraceNodePtr(new TraceUnexploredTimeout(500)));
+    inner->setFalseBranch(TraceNodePtr(new TraceEndSuccess()));
+
+    QSharedPointer<TraceSymbolicBranch> root = QSharedPointer<TraceSymbolicBranch>(new TraceSymbolicBranch(isEmpty));
+    root->setTrueBranch(alert);
+    root->setFalseBranch(inner);
+
+    TraceCheckpoint::SearchState state;
+    state.iterations = 7;
+    state.depthLimit = 10;
+    state.solverBudget = 2000;
+    state.solverEscalations = 1;
+
+    ASSERT_TRUE(TraceCheckpoint::save(checkpointFile(), "http://localhost/site", root, state));
+
+    TraceCheckpoint::SearchState otherState;
+    ASSERT_TRUE(TraceCheckpoint::load(checkpointFile(), "http://localhost/other", otherState).isNull());
+    ASSERT_EQ(0, otherState.iterations);
+
+    TraceCheckpoint::SearchState loadedState;
+    TraceNodePtr loaded = TraceCheckpoint::load(checkpointFile(), "http://localhost/site", loadedState);
+    ASSERT_FALSE(loaded.isNull());
+
+    ASSERT_EQ(7, loadedState.iterations);
+    ASSERT_EQ(10, loadedState.depthLimit);
+    ASSERT_EQ(2000u, loadedState.solverBudget);
+    ASSERT_EQ(1, loadedState.solverEscalations);
+
+    QSharedPointer<TraceSymbolicBranch> loadedRoot = loaded.dynamicCast<TraceSymbolicBranch>();
+    ASSERT_FALSE(loadedRoot.isNull());
+    ASSERT_EQ(printKey(isEmpty), printKey(loadedRoot->getSymbolicCondition()));
+
+    QSharedPointer<TraceAlert> loadedAlert = loadedRoot->getTrueBranch().dynamicCast<TraceAlert>();
+    ASSERT_FALSE(loadedAlert.isNull());
+    ASSERT_EQ(QString("Name is empty"), loadedAlert->message);
+    ASSERT_FALSE(loadedAlert->next.dynamicCast<TraceEndFailure>().isNull());
+
+    QSharedPointer<TraceSymbolicBranch> loadedInner = loadedRoot->getFalseBranch().dynamicCast<TraceSymbolicBranch>();
+    ASSERT_FALSE(loadedInner.isNull());
+    ASSERT_EQ(printKey(isAdmin), printKey(loadedInner->getSymbolicCondition()));
+    ASSERT_FALSE(loadedInner->getFalseBranch().dynamicCast<TraceEndSuccess>().isNull());
+
+    QSharedPointer<TraceUnexploredTimeout> timeout = loadedInner->getTrueBranch().dynamicCast<TraceUnexploredTimeout>();
+    ASSERT_FALSE(timeout.isNull());
+    ASSERT_EQ(500u, timeout->getBudget());
+
+    // The input shared by both conditions is read back as one expression.
+    Symbolic::StringLength* length = (Symbolic::StringLength*)((Symbolic::IntegerBinaryOperation*)loadedRoot->getSymbolicCondition())->getLhs();
+    Symbolic::StringBinaryOperation* comparison = (Symbolic::StringBinaryOperation*)loadedInner->getSymbolicCondition();
+    ASSERT_EQ(length->getString(), comparison->getLhs());
+
+    QFile::remove(checkpointFile());
+}
+
+TEST(TraceCheckpointTest, REJECTS_TRUNCATED_FILE) {
+    Symbolic::Expression* condition = new Symbolic::SymbolicBoolean(Symbolic::SymbolicSource(Symbolic::INPUT, Symbolic::ELEMENT_ID, "agree"));
+
+    QSharedPointer<TraceSymbolicBranch> root = QSharedPointer<TraceSymbolicBranch>(new TraceSymbolicBranch(condition));
+    root->setTrueBranch(TraceUnexploredUnsat::getInstance());
+    root->setFalseBranch(TraceNodePtr(new TraceEndUnknown()));
+
+    ASSERT_TRUE(TraceCheckpoint::save(checkpointFile(), "http://localhost/site", root, TraceCheckpoint::SearchState()));
+
+    QFile file(checkpointFile());
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(file.resize(file.size() - 2));
+    file.close();
+
+    TraceCheckpoint::SearchState state;
+    ASSERT_TRUE(TraceCheckpoint::load(checkpointFile(), "http://localhost/site", state).isNull());
+
+    QFile::remove(checkpointFile());
+}
+
+TEST(TraceCheckpointTest, REPLAYS_THE_JOURNAL) {
+    Symbolic::Expression* condition = new Symbolic::SymbolicBoolean(Symbolic::SymbolicSource(Symbolic::INPUT, Symbolic::ELEMENT_ID, "agree"));
+
+    QSharedPointer<TraceSymbolicBranch> root = QSharedPointer<TraceSymbolicBranch>(new TraceSymbolicBranch(condition));
+    root->setTrueBranch(TraceUnexplored::getInstance());
+    root->setFalseBranch(TraceNodePtr(new TraceEndSuccess()));
+
+    TraceCheckpoint::SearchState state;
+    state.iterations = 1;
+    quint64 stamp;
+    ASSERT_TRUE(TraceCheckpoint::save(checkpointFile(), "http://localhost/site", root, state, &stamp));
+
+    QVector<bool> path;
+    path.append(true);
+    state.iterations = 2;
+
+    TraceEventLog journal;
+    ASSERT_TRUE(journal.open(TraceCheckpoint::journalFileName(checkpointFile()), stamp));
+    journal.addMarker(path, TraceUnexploredUnsat::getInstance());
+    journal.addState(state);
+    journal.close();
+
+    TraceCheckpoint::SearchState loadedState;
+    TraceNodePtr loaded = TraceCheckpoint::load(checkpointFile(), "http://localhost/site", loadedState);
+    ASSERT_FALSE(loaded.isNull());
+    ASSERT_EQ(2, loadedState.iterations);
+
+    QSharedPointer<TraceSymbolicBranch> loadedRoot = loaded.dynamicCast<TraceSymbolicBranch>();
+    ASSERT_FALSE(loadedRoot.isNull());
+    ASSERT_FALSE(loadedRoot->getTrueBranch().dynamicCast<TraceUnexploredUnsat>().isNull());
+
+    // A full save supersedes the journal.
+    ASSERT_TRUE(TraceCheckpoint::save(checkpointFile(), "http://localhost/site", loaded, loadedState));
+    ASSERT_FALSE(QFile::exists(TraceCheckpoint::journalFileName(checkpointFile())));
+
+    QFile::remove(checkpointFile());
+}
+
+TEST(TraceCheckpointTest, IGNORES_THE_JOURNAL_OF_AN_EARLIER_CHECKPOINT) {
+    Symbolic::Expression* condition = new Symbolic::SymbolicBoolean(Symbolic::SymbolicSource(Symbolic::INPUT, Symbolic::ELEMENT_ID, "agree"));
+
+    QSharedPointer<TraceSymbolicBranch> root = QSharedPointer<TraceSymbolicBranch>(new TraceSymbolicBranch(condition));
+    root->setTrueBranch(TraceUnexplored::getInstance());
+    root->setFalseBranch(TraceNodePtr(new TraceEndSuccess()));
+
+    quint64 stamp;
+    ASSERT_TRUE(TraceCheckpoint::save(checkpointFile(), "http://localhost/site", root, TraceCheckpoint::SearchState(), &stamp));
+
+    // As left behind by a crash after the next checkpoint replaced this one, but before its journal was removed.
+    QVector<bool> path;
+    path.append(true);
+
+    TraceEventLog journal;
+    ASSERT_TRUE(journal.open(TraceCheckpoint::journalFileName(checkpointFile()), stamp + 1));
+    journal.addMarker(path, TraceUnexploredUnsat::getInstance());
+    journal.close();
+
+    TraceCheckpoint::SearchState state;
+    TraceNodePtr loaded = TraceCheckpoint::load(checkpointFile(), "http://localhost/site", state);
+    ASSERT_FALSE(loaded.isNull());
+    ASSERT_TRUE(TraceVisitor::isImmediatelyUnexplored(loaded.dynamicCast<TraceSymbolicBranch>()->getTrueBranch()));
+
+    QFile::remove(TraceCheckpoint::journalFileName(checkpointFile()));
+    QFile::remove(checkpointFile());
+}
+
+}
@@ -0,0 +1,114 @@
+#include <QDir>
+
+#include "include/gtest/gtest.h"
+
+#include "concolic/executiontree/traceeventlog.h"
+#include "concolic/search/searchdfs.h"
+
+#include <JavaScriptCore/symbolic/expr.h>
+
+namespace artemis
+{
+
+static Symbolic::Expression* inputCondition(std::string name)
+{
+    return new Symbolic::SymbolicBoolean(Symbolic::SymbolicSource(Symbolic::INPUT, Symbolic::INPUT_NAME, name));
+}
+
+// A trace taking the false branch of a concrete branch, then the given direction of a symbolic branch.
+static TraceNodePtr createTrace(Symbolic::Expression* condition, bool direction)
+{
+    QSharedPointer<TraceSymbolicBranch> symbolic = QSharedPointer<TraceSymbolicBranch>(new TraceSymbolicBranch(condition));
+    QSharedPointer<TraceFunctionCall> call = QSharedPointer<TraceFunctionCall>(new TraceFunctionCall());
+    call->name = "validate";
+    call->next = symbolic;
+
+    if (direction) {
+        symbolic->setTrueBranch(TraceNodePtr(new TraceEndSuccess()));
+    } else {
+        symbolic->setFalseBranch(TraceNodePtr(new TraceEndFailure()));
+    }
+
+    QSharedPointer<TraceConcreteBranch> concrete = QSharedPointer<TraceConcreteBranch>(new TraceConcreteBranch());
+    concrete->setFalseBranch(call);
+
+    return concrete;
+}
+
+TEST(TraceEventLogTest, REPLAYS_TRACES_AND_MARKERS) {
+    QString fileName = QDir::temp().filePath("artemis-traceeventlogtest.log");
+    Symbolic::Expression* condition = inputCondition("agree");
+
+    TraceEventLog log;
+    ASSERT_TRUE(log.open(fileName));
+
+    TraceNodePtr tree = createTrace(condition, false);
+    log.addTrace(tree);
+
+    DepthFirstSearch search(tree, 5);
+    ASSERT_TRUE(search.chooseNextTarget());
+
+    // The path passes through the concrete branch, which the PC does not mention.
+    QVector<bool> path = search.getTargetPath();
+    ASSERT_EQ(2, path.size());
+    ASSERT_FALSE(path.at(0));
+    ASSERT_TRUE(path.at(1));
+    ASSERT_EQ(1u, search.getTargetPC()->size());
+
+    search.markNodeUnsat();
+    log.addMarker(path, TraceUnexploredUnsat::getInstance());
+    log.close();
+
+    TraceEventLogReader reader(fileName);
+    ASSERT_TRUE(reader.open());
+
+    ASSERT_TRUE(reader.next());
+    QSharedPointer<TraceConcreteBranch> concrete = reader.getTree().dynamicCast<TraceConcreteBranch>();
+    ASSERT_FALSE(concrete.isNull());
+
+    QSharedPointer<TraceFunctionCall> call = concrete->getFalseBranch().dynamicCast<TraceFunctionCall>();
+    ASSERT_FALSE(call.isNull());
+    QSharedPointer<TraceSymbolicBranch> symbolic = call->next.dynamicCast<TraceSymbolicBranch>();
+    ASSERT_FALSE(symbolic.isNull());
+    ASSERT_FALSE(symbolic->getTrueBranch().dynamicCast<TraceUnexplored>().isNull());
+
+    ASSERT_TRUE(reader.next());
+    ASSERT_FALSE(symbolic->getTrueBranch().dynamicCast<TraceUnexploredUnsat>().isNull());
+
+    ASSERT_FALSE(reader.next());
+    ASSERT_TRUE(reader.atEnd());
+
+    QFile::remove(fileName);
+}
+
+TEST(TraceEventLogTest, READS_UP_TO_INCOMPLETE_EVENT) {
+    QString fileName = QDir::temp().filePath("artemis-traceeventlogtest.log");
+    Symbolic::Expression* condition = inputCondition("subscribe");
+
+    TraceEventLog log;
+    ASSERT_TRUE(log.open(fileName));
+    log.addTrace(createTrace(condition, false));
+    log.addTrace(createTrace(condition, true));
+    log.close();
+
+    QFile file(fileName);
+    ASSERT_TRUE(file.open(QIODevice::ReadWrite));
+    ASSERT_TRUE(file.resize(file.size() - 1));
+    file.close();
+
+    TraceEventLogReader reader(fileName);
+    ASSERT_TRUE(reader.open());
+    ASSERT_TRUE(reader.next());
+    ASSERT_FALSE(reader.next());
+    ASSERT_FALSE(reader.atEnd());
+
+    // The tree is left as it was after the last complete event.
+    QSharedPointer<TraceConcreteBranch> concrete = reader.getTree().dynamicCast<TraceConcreteBranch>();
+    ASSERT_FALSE(concrete.isNull());
+    QSharedPointer<TraceSymbolicBranch> symbolic = concrete->getFalseBranch().dynamicCast<TraceFunctionCall>()->next.dynamicCast<TraceSymbolicBranch>();
+    ASSERT_FALSE(symbolic->getTrueBranch().dynamicCast<TraceUnexplored>().isNull());
+
+    QFile::remove(fileName);
+}
+
+}
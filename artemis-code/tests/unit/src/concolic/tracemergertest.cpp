@@ -0,0 +1,99 @@
+#include "include/gtest/gtest.h"
+
+#include "concolic/executiontree/tracemerger.h"
+#include "concolic/executiontree/tracenodes.h"
+#include "concolic/tracestatistics.h"
+
+#include <JavaScriptCore/symbolic/expr.h>
+
+namespace artemis
+{
+
+static int frontier(TraceNodePtr tree)
+{
+    TraceStatistics stats;
+    stats.processTrace(tree);
+    return stats.mNumUnexploredSymBranches;
+}
+
+// A symbolic branch with an end in the given direction and the other direction unexplored.
+static QSharedPointer<TraceSymbolicBranch> createBranch(Symbolic::Expression* condition, bool direction)
+{
+    QSharedPointer<TraceSymbolicBranch> branch = QSharedPointer<TraceSymbolicBranch>(new TraceSymbolicBranch(condition));
+    if (direction) {
+        branch->setTrueBranch(TraceNodePtr(new TraceEndSuccess()));
+    } else {
+        branch->setFalseBranch(TraceNodePtr(new TraceEndFailure()));
+    }
+    return branch;
+}
+
+TEST(TraceMergerTest, COUNTS_THE_FRONTIER_OF_A_NEW_TREE) {
+    Symbolic::Expression* condition = new Symbolic::ConstantBoolean(true);
+
+    int frontierChange = -1;
+    TraceNodePtr tree = TraceMerger::merge(createBranch(condition, true), TraceNodePtr(), &frontierChange);
+    ASSERT_EQ(1, frontierChange);
+    ASSERT_EQ(frontier(tree), frontierChange);
+
+    delete condition;
+}
+
+TEST(TraceMergerTest, COUNTS_THE_FRONTIER_CHANGE_OF_A_MERGE) {
+    Symbolic::Expression* outer = new Symbolic::ConstantBoolean(true);
+    Symbolic::Expression* inner = new Symbolic::ConstantBoolean(true);
+
+    TraceNodePtr tree = createBranch(outer, true);
+
+    // The new subtree replaces an unexplored node and adds one of its own.
+    QSharedPointer<TraceSymbolicBranch> trace = QSharedPointer<TraceSymbolicBranch>(new TraceSymbolicBranch(outer));
+    trace->setFalseBranch(createBranch(inner, false));
+
+    int before = frontier(tree);
+    int frontierChange = -1;
+    tree = TraceMerger::merge(trace, tree, &frontierChange);
+    ASSERT_EQ(0, frontierChange);
+    ASSERT_EQ(frontier(tree) - before, frontierChange);
+
+    // Completing the inner branch removes it from the frontier.
+    trace = QSharedPointer<TraceSymbolicBranch>(new TraceSymbolicBranch(outer));
+    trace->setFalseBranch(createBranch(inner, true));
+
+    tree = TraceMerger::merge(trace, tree, &frontierChange);
+    ASSERT_EQ(-1, frontierChange);
+    ASSERT_EQ(0, frontier(tree));
+
+    delete outer;
+    delete inner;
+}
+
+TEST(TraceMergerTest, ONLY_PLAIN_UNEXPLORED_SYMBOLIC_CHILDREN_LEAVE_THE_FRONTIER) {
+    Symbolic::Expression* condition = new Symbolic::ConstantBoolean(true);
+
+    // A node which was already attempted is not on the frontier, nor is the child of a concrete branch.
+    QSharedPointer<TraceSymbolicBranch> symbolic = createBranch(condition, true);
+    symbolic->setFalseBranch(TraceUnexploredMissed::getInstance());
+    QSharedPointer<TraceConcreteBranch> concrete = QSharedPointer<TraceConcreteBranch>(new TraceConcreteBranch());
+    concrete->setFalseBranch(symbolic);
+    TraceNodePtr tree = concrete;
+
+    QSharedPointer<TraceSymbolicBranch> traceSymbolic = QSharedPointer<TraceSymbolicBranch>(new TraceSymbolicBranch(condition));
+    traceSymbolic->setFalseBranch(TraceNodePtr(new TraceEndFailure()));
+    QSharedPointer<TraceConcreteBranch> traceConcrete = QSharedPointer<TraceConcreteBranch>(new TraceConcreteBranch());
+    traceConcrete->setFalseBranch(traceSymbolic);
+
+    int frontierChange = -1;
+    tree = TraceMerger::merge(traceConcrete, tree, &frontierChange);
+    ASSERT_EQ(0, frontierChange);
+
+    traceConcrete = QSharedPointer<TraceConcreteBranch>(new TraceConcreteBranch());
+    traceConcrete->setTrueBranch(TraceNodePtr(new TraceEndSuccess()));
+
+    tree = TraceMerger::merge(traceConcrete, tree, &frontierChange);
+    ASSERT_EQ(0, frontierChange);
+    ASSERT_EQ(0, frontier(tree));
+
+    delete condition;
+}
+
+}
@@ -0,0 +1,40 @@
+#include "include/gtest/gtest.h"
+
+#include "concolic/executiontree/tracenodes.h"
+#include "concolic/tracestatistics.h"
+
+#include <JavaScriptCore/symbolic/expr.h>
+
+namespace artemis
+{
+
+TEST(TraceStatisticsTest, COUNTS_SEARCH_FRONTIER) {
+    Symbolic::Expression* condition = new Symbolic::ConstantBoolean(true);
+
+    // Only the plain unexplored children of symbolic branches are counted. Nodes which were attempted are marked
+    // with the other unexplored types, and concrete branches can not be explored on purpose.
+    QSharedPointer<TraceSymbolicBranch> attempted = QSharedPointer<TraceSymbolicBranch>(new TraceSymbolicBranch(condition));
+    attempted->setTrueBranch(TraceUnexploredUnsat::getInstance());
+    attempted->setFalseBranch(TraceNodePtr(new TraceUnexploredTimeout(100)));
+
+    QSharedPointer<TraceConcreteBranch> concrete = QSharedPointer<TraceConcreteBranch>(new TraceConcreteBranch());
+    concrete->setFalseBranch(attempted);
+
+    QSharedPointer<TraceSymbolicBranch> root = QSharedPointer<TraceSymbolicBranch>(new TraceSymbolicBranch(condition));
+    root->setFalseBranch(concrete);
+
+    TraceStatistics stats;
+    stats.processTrace(root);
+    ASSERT_EQ(3, stats.mNumBranches);
+    ASSERT_EQ(2, stats.mNumSymBranches);
+    ASSERT_EQ(1, stats.mNumUnexploredSymBranches);
+
+    root->setTrueBranch(TraceUnexploredMissed::getInstance());
+
+    stats.processTrace(root);
+    ASSERT_EQ(0, stats.mNumUnexploredSymBranches);
+
+    delete condition;
+}
+
+}
@@ -0,0 +1,102 @@
+#include <QElapsedTimer>
+#include <QFile>
+#include <QList>
+#include <QSet>
+#include <QString>
+
+#include "include/gtest/gtest.h"
+
+#include "model/coverage/codeblockinfo.h"
+
+namespace artemis
+{
+
+/*
+ * Compares the dense bitsets of CodeBlockInfo with the QSet<uint> they replaced.
+ *
+ * Disabled in the unit test run. tests/system/component_benchmarks.py runs it with ARTEMIS_FIXTURES set to the
+ * system test fixtures and reads the timings (in microseconds) from the recorded properties.
+ */
+
+// Approximates the code blocks of a real script by cutting its source at every "function" keyword and assuming one
+// instruction slot per two characters of source.
+static QList<uint> codeBlockSizes(const QString& source)
+{
+    QList<uint> sizes;
+
+    int last = 0;
+    int next = source.indexOf("function", 1);
+    while (next != -1) {
+        sizes.append(qMax(4, (next - last) / 2));
+        last = next;
+        next = source.indexOf("function", last + 1);
+    }
+    sizes.append(qMax(4, (source.length() - last) / 2));
+
+    return sizes;
+}
+
+TEST(CodeBlockInfoBenchmark, DISABLED_QSET_VS_BITSET_JQUERY) {
+    QString fixtures = QString::fromLocal8Bit(qgetenv("ARTEMIS_FIXTURES"));
+    ASSERT_FALSE(fixtures.isEmpty()) << "ARTEMIS_FIXTURES must point to tests/system/fixtures.";
+
+    QFile script(fixtures + "/jquery-simple/jquery.js");
+    ASSERT_TRUE(script.open(QIODevice::ReadOnly)) << "Could not read " << script.fileName().toStdString();
+    QList<uint> sizes = codeBlockSizes(QString::fromUtf8(script.readAll()));
+
+    // Each pass covers the blocks with a different stride, so later passes mostly revisit covered offsets as the
+    // later iterations of a run do.
+    const int passes = 10;
+    QElapsedTimer timer;
+
+    QList<QSet<uint> > sets;
+    for (int block = 0; block < sizes.size(); block++) {
+        sets.append(QSet<uint>());
+    }
+
+    timer.start();
+    for (int pass = 0; pass < passes; pass++) {
+        for (int block = 0; block < sizes.size(); block++) {
+            QSet<uint>& set = sets[block];
+            for (uint offset = 0; offset < sizes.at(block); offset += 1 + (pass % 3)) {
+                set.insert(offset);
+            }
+        }
+    }
+    size_t setCovered = 0;
+    foreach (const QSet<uint>& set, sets) {
+        setCovered += set.size();
+    }
+    qint64 setTime = timer.nsecsElapsed();
+
+    QList<CodeBlockInfo*> infos;
+    for (int block = 0; block < sizes.size(); block++) {
+        infos.append(new CodeBlockInfo("", sizes.at(block), block));
+    }
+
+    timer.restart();
+    for (int pass = 0; pass < passes; pass++) {
+        for (int block = 0; block < sizes.size(); block++) {
+            CodeBlockInfo* info = infos.at(block);
+            for (uint offset = 0; offset < sizes.at(block); offset += 1 + (pass % 3)) {
+                info->setBytecodeCovered(offset);
+            }
+        }
+    }
+    size_t bitsetCovered = 0;
+    foreach (CodeBlockInfo* info, infos) {
+        bitsetCovered += info->numCoveredBytecodes();
+    }
+    qint64 bitsetTime = timer.nsecsElapsed();
+
+    qDeleteAll(infos);
+
+    ASSERT_EQ(setCovered, bitsetCovered);
+
+    RecordProperty("code_blocks", sizes.size());
+    RecordProperty("covered", (int)bitsetCovered);
+    RecordProperty("qset_us", (int)(setTime / 1000));
+    RecordProperty("bitset_us", (int)(bitsetTime / 1000));
+}
+
+}
@@ -0,0 +1,39 @@
+#include <QSet>
+
+#include "include/gtest/gtest.h"
+
+#include "model/coverage/codeblockinfo.h"
+
+namespace artemis
+{
+
+TEST(CodeBlockInfoTest, COVERED_BYTECODES_ARE_COUNTED_ONCE) {
+    CodeBlockInfo info("f", 10, 0);
+
+    info.setBytecodeCovered(0);
+    info.setBytecodeCovered(3);
+    info.setBytecodeCovered(3);
+    info.setBytecodeCovered(9);
+    info.setBytecodeCovered(10); // out of range, ignored
+
+    ASSERT_EQ(10u, info.getBytecodeSize());
+    ASSERT_EQ(3u, info.numCoveredBytecodes());
+}
+
+TEST(CodeBlockInfoTest, COUNT_MATCHES_SET_OF_OFFSETS) {
+    const uint size = 400;
+    CodeBlockInfo info("", size, 0);
+    QSet<uint> offsets;
+
+    // Overlapping strides, so offsets are revisited and cover several words of the bitset.
+    for (uint stride = 1; stride <= 3; stride++) {
+        for (uint offset = 7 * stride; offset < size; offset += stride * 5) {
+            info.setBytecodeCovered(offset);
+            offsets.insert(offset);
+        }
+    }
+
+    ASSERT_EQ((size_t)offsets.size(), info.numCoveredBytecodes());
+}
+
+}
@@ -0,0 +1,82 @@
+#include "include/gtest/gtest.h"
+
+#include "webpagetest.h"
+
+namespace artemis
+{
+
+class DomStateHashTest : public WebPageTest
+{
+protected:
+    void SetUp()
+    {
+        WebPageTest::SetUp();
+        load("<html><body><ul id='list'><li id='a'>first</li><li id='b'>second</li></ul>"
+             "<div id='target'></div><p id='text'>text</p></body></html>");
+        mInitial = frame()->domStateHash();
+    }
+
+    quint64 mInitial;
+};
+
+TEST_F(DomStateHashTest, REORDERING_SIBLINGS_CHANGES_HASH) {
+    // Same nodes, same parent, different order.
+    evaluate("var list = document.getElementById('list'); list.insertBefore(document.getElementById('b'), document.getElementById('a'));");
+    ASSERT_NE(mInitial, frame()->domStateHash());
+
+    evaluate("list.appendChild(document.getElementById('b'));");
+    ASSERT_EQ(mInitial, frame()->domStateHash());
+}
+
+TEST_F(DomStateHashTest, MOVING_A_NODE_CHANGES_HASH) {
+    evaluate("document.getElementById('target').appendChild(document.getElementById('b'));");
+    ASSERT_NE(mInitial, frame()->domStateHash());
+
+    evaluate("document.getElementById('list').appendChild(document.getElementById('b'));");
+    ASSERT_EQ(mInitial, frame()->domStateHash());
+}
+
+TEST_F(DomStateHashTest, ATTRIBUTE_CHANGE_CHANGES_HASH) {
+    quint64 mutations = frame()->domMutationCount();
+
+    evaluate("document.getElementById('target').setAttribute('class', 'error');");
+    ASSERT_NE(mInitial, frame()->domStateHash());
+    ASSERT_LT(mutations, frame()->domMutationCount());
+
+    evaluate("document.getElementById('target').removeAttribute('class');");
+    ASSERT_EQ(mInitial, frame()->domStateHash());
+}
+
+TEST_F(DomStateHashTest, INLINE_STYLE_CHANGE_CHANGES_HASH) {
+    evaluate("document.getElementById('target').style.display = 'none';");
+    quint64 hidden = frame()->domStateHash();
+    ASSERT_NE(mInitial, hidden);
+
+    // Reading the style attribute writes the inline style back to it, which is not a change.
+    quint64 mutations = frame()->domMutationCount();
+    evaluate("document.getElementById('target').getAttribute('style');");
+    ASSERT_EQ(hidden, frame()->domStateHash());
+    ASSERT_EQ(mutations, frame()->domMutationCount());
+
+    evaluate("document.getElementById('target').style.display = '';");
+    ASSERT_EQ(mInitial, frame()->domStateHash());
+
+    evaluate("document.getElementById('target').setAttribute('style', 'display: none;');");
+    ASSERT_EQ(hidden, frame()->domStateHash());
+}
+
+TEST_F(DomStateHashTest, TEXT_CHANGE_CHANGES_HASH) {
+    evaluate("document.getElementById('text').firstChild.data = 'changed';");
+    quint64 changed = frame()->domStateHash();
+    ASSERT_NE(mInitial, changed);
+
+    // Moving the same text to another element is a different state.
+    evaluate("document.getElementById('text').firstChild.data = 'text'; document.getElementById('a').firstChild.data = 'changed';");
+    ASSERT_NE(mInitial, frame()->domStateHash());
+    ASSERT_NE(changed, frame()->domStateHash());
+
+    evaluate("document.getElementById('a').firstChild.data = 'first';");
+    ASSERT_EQ(mInitial, frame()->domStateHash());
+}
+
+}
@@ -0,0 +1,61 @@
+#include <QList>
+#include <QWebElement>
+
+#include "include/gtest/gtest.h"
+
+#include "webpagetest.h"
+
+namespace artemis
+{
+
+class ElementAtPathTest : public WebPageTest
+{
+protected:
+    void SetUp()
+    {
+        WebPageTest::SetUp();
+        load("<html><body>text<div id='first'><span id='inner'></span></div><!-- comment -->"
+             "<p id='second'>text<b id='bold'></b><i id='italic'></i></p></body></html>");
+        mBody = frame()->findFirstElement("body");
+    }
+
+    QList<int> path(int first, int second = 0)
+    {
+        QList<int> result;
+        result << first;
+        if (second > 0) {
+            result << second;
+        }
+        return result;
+    }
+
+    QWebElement mBody;
+};
+
+TEST_F(ElementAtPathTest, EMPTY_PATH_IS_THE_ELEMENT_ITSELF) {
+    ASSERT_EQ(mBody, mBody.elementAtPath(QList<int>()));
+}
+
+TEST_F(ElementAtPathTest, COUNTS_ELEMENT_CHILDREN_ONLY) {
+    // Text and comment nodes between the elements are skipped.
+    ASSERT_EQ(QString("first"), mBody.elementAtPath(path(1)).attribute("id"));
+    ASSERT_EQ(QString("second"), mBody.elementAtPath(path(2)).attribute("id"));
+    ASSERT_EQ(QString("inner"), mBody.elementAtPath(path(1, 1)).attribute("id"));
+    ASSERT_EQ(QString("bold"), mBody.elementAtPath(path(2, 1)).attribute("id"));
+    ASSERT_EQ(QString("italic"), mBody.elementAtPath(path(2, 2)).attribute("id"));
+}
+
+TEST_F(ElementAtPathTest, PATH_LEAVING_THE_TREE_IS_NULL) {
+    ASSERT_TRUE(mBody.elementAtPath(path(3)).isNull());
+    ASSERT_TRUE(mBody.elementAtPath(path(1, 2)).isNull());
+    ASSERT_TRUE(mBody.elementAtPath(path(1, 1) << 1).isNull());
+}
+
+TEST_F(ElementAtPathTest, FOLLOWS_DOM_CHANGES) {
+    evaluate("document.body.insertBefore(document.getElementById('second'), document.getElementById('first'));");
+
+    ASSERT_EQ(QString("second"), mBody.elementAtPath(path(1)).attribute("id"));
+    ASSERT_EQ(QString("inner"), mBody.elementAtPath(path(2, 1)).attribute("id"));
+}
+
+}
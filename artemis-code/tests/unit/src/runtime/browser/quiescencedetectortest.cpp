@@ -0,0 +1,116 @@
+#include <QSharedPointer>
+#include <QtWebKit/qwebexecutionlistener.h>
+
+#include "include/gtest/gtest.h"
+
+#include "runtime/browser/ajax/ajaxrequestlistener.h"
+#include "runtime/browser/quiescencedetector.h"
+
+#include "webpagetest.h"
+
+namespace artemis
+{
+
+/*
+ * Virtual time is enabled for each test and disabled again afterwards, as the clock is shared by every page.
+ */
+class QuiescenceDetectorTest : public WebPageTest
+{
+protected:
+    void SetUp()
+    {
+        WebPageTest::SetUp();
+
+        mListener = QWebExecutionListener::getListener();
+        mListener->enableVirtualTime();
+        mListener->resetVirtualTime();
+
+        mNetwork = new AjaxRequestListener(mPage.data());
+        mPage->setNetworkAccessManager(mNetwork);
+    }
+
+    void TearDown()
+    {
+        WebPageTest::TearDown();
+
+        mListener->disableVirtualTime();
+    }
+
+    QSharedPointer<QuiescenceDetector> detector(uint horizon)
+    {
+        return QSharedPointer<QuiescenceDetector>(new QuiescenceDetector(NULL, mPage, mNetwork, mListener, horizon));
+    }
+
+    QWebExecutionListener* mListener;
+    AjaxRequestListener* mNetwork;
+};
+
+TEST_F(QuiescenceDetectorTest, FIRES_TIMERS_WITHIN_HORIZON) {
+    load("<html><body><script>"
+         "var fired = [];"
+         "setTimeout(function() { fired.push('late'); }, 60000);"
+         "setTimeout(function() { fired.push('early'); setTimeout(function() { fired.push('chained'); }, 1000); }, 5000);"
+         "</script></body></html>");
+
+    detector(10000)->settle();
+
+    ASSERT_EQ(QString("early,chained"), evaluate("fired.join(',')").toString());
+    ASSERT_DOUBLE_EQ(6.0, mListener->virtualTime());
+}
+
+TEST_F(QuiescenceDetectorTest, HORIZON_IS_RELATIVE_TO_SETTLE) {
+    load("<html><body><script>"
+         "var fired = 0;"
+         "setTimeout(function() { fired++; }, 1000);"
+         "setTimeout(function() { fired++; }, 3000);"
+         "</script></body></html>");
+
+    QSharedPointer<QuiescenceDetector> quiescence = detector(2000);
+
+    quiescence->settle();
+    ASSERT_EQ(1, evaluate("fired").toInt());
+
+    quiescence->settle();
+    ASSERT_EQ(2, evaluate("fired").toInt());
+}
+
+TEST_F(QuiescenceDetectorTest, REPEATING_TIMER_IS_BOUNDED) {
+    load("<html><body><script>"
+         "var ticks = 0;"
+         "setInterval(function() { ticks++; }, 10);"
+         "</script></body></html>");
+
+    detector(1000000)->settle();
+
+    // Stops at QuiescenceDetector::MAX_TIMER_FIRES.
+    ASSERT_EQ(1000, evaluate("ticks").toInt());
+}
+
+TEST_F(QuiescenceDetectorTest, NAVIGATION_ENDS_SETTLE) {
+    load("<html><body><script>"
+         "var fired = 0;"
+         "setTimeout(function() { window.location = 'about:blank'; }, 1000);"
+         "setTimeout(function() { fired++; }, 2000);"
+         "</script></body></html>");
+
+    QSharedPointer<QuiescenceDetector> quiescence = detector(10000);
+    quiescence->settle();
+
+    ASSERT_TRUE(quiescence->navigated());
+    ASSERT_DOUBLE_EQ(1.0, mListener->virtualTime());
+}
+
+TEST_F(QuiescenceDetectorTest, RESET_DROPS_PENDING_TIMERS) {
+    load("<html><body><script>"
+         "var fired = 0;"
+         "setTimeout(function() { fired++; }, 1000);"
+         "</script></body></html>");
+
+    mListener->resetVirtualTime();
+    detector(10000)->settle();
+
+    ASSERT_EQ(0, evaluate("fired").toInt());
+    ASSERT_DOUBLE_EQ(0.0, mListener->virtualTime());
+}
+
+}
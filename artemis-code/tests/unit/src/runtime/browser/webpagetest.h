@@ -0,0 +1,66 @@
+#ifndef WEBPAGETEST_H
+#define WEBPAGETEST_H
+
+#include <QApplication>
+#include <QEventLoop>
+#include <QString>
+#include <QVariant>
+#include <QWebFrame>
+
+#include "include/gtest/gtest.h"
+
+#include "runtime/browser/artemiswebpage.h"
+
+namespace artemis
+{
+
+/*
+ * Base fixture for tests which need a page. gtest_main does not create a QApplication, so one is created on first
+ * use and kept for the rest of the run.
+ */
+class WebPageTest : public ::testing::Test
+{
+protected:
+    void SetUp()
+    {
+        static int argc = 1;
+        static char name[] = "unit";
+        static char* argv[] = {name, NULL};
+
+        if (QApplication::instance() == NULL) {
+            new QApplication(argc, argv);
+        }
+
+        mPage = ArtemisWebPagePtr(new ArtemisWebPage());
+    }
+
+    void TearDown()
+    {
+        mPage.clear();
+    }
+
+    // Loads html into the main frame and waits for the load to finish.
+    void load(const QString& html)
+    {
+        QEventLoop loop;
+        QObject::connect(mPage.data(), SIGNAL(loadFinished(bool)), &loop, SLOT(quit()));
+        mPage->mainFrame()->setHtml(html);
+        loop.exec();
+    }
+
+    QVariant evaluate(const QString& script)
+    {
+        return mPage->mainFrame()->evaluateJavaScript(script);
+    }
+
+    QWebFrame* frame()
+    {
+        return mPage->mainFrame();
+    }
+
+    ArtemisWebPagePtr mPage;
+};
+
+}
+
+#endif // WEBPAGETEST_H
@@ -0,0 +1,102 @@
+#include <QList>
+
+#include "include/gtest/gtest.h"
+
+#include "runtime/pagestate/pagestateabstraction.h"
+#include "runtime/pagestate/visitedstateindex.h"
+
+#include "../browser/webpagetest.h"
+
+namespace artemis
+{
+
+static uint distance(quint64 a, quint64 b)
+{
+    return __builtin_popcountll(a ^ b);
+}
+
+static QList<quint64> features(quint64 first, quint64 count)
+{
+    QList<quint64> result;
+    for (quint64 i = first; i < first + count; i++) {
+        result.append(i);
+    }
+    return result;
+}
+
+TEST(SimHashTest, SIMILAR_FEATURE_SETS_ARE_CLOSE) {
+    QList<quint64> base = features(1, 200);
+    quint64 fingerprint = PageStateAbstraction::simHash(base);
+
+    QList<quint64> reordered = base;
+    reordered.swap(0, 199);
+    ASSERT_EQ(fingerprint, PageStateAbstraction::simHash(reordered));
+
+    QList<quint64> changed = base;
+    changed.replace(199, 1000);
+    ASSERT_LE(distance(fingerprint, PageStateAbstraction::simHash(changed)), VisitedStateIndex::MAX_DISTANCE);
+
+    QList<quint64> added = base;
+    added.append(5000);
+    ASSERT_LE(distance(fingerprint, PageStateAbstraction::simHash(added)), VisitedStateIndex::MAX_DISTANCE);
+
+    ASSERT_GT(distance(fingerprint, PageStateAbstraction::simHash(features(1001, 200))), VisitedStateIndex::MAX_DISTANCE);
+}
+
+TEST(VisitedStateIndexTest, MATCHES_EXACT_STATES) {
+    VisitedStateIndex index(0);
+
+    ASSERT_EQ(NEW_STATE, index.visit(PageStateFingerprint(1, 0xF0)));
+    ASSERT_EQ(VISITED_EXACT, index.visit(PageStateFingerprint(1, 0xF0)));
+
+    // Without a distance, a close SimHash is not a match.
+    ASSERT_EQ(NEW_STATE, index.visit(PageStateFingerprint(2, 0xF1)));
+    ASSERT_EQ(2, index.size());
+}
+
+TEST(VisitedStateIndexTest, MATCHES_STATES_WITHIN_DISTANCE) {
+    VisitedStateIndex index(3);
+    const quint64 simHash = 0x0123456789ABCDEFULL;
+
+    ASSERT_EQ(NEW_STATE, index.visit(PageStateFingerprint(1, simHash)));
+
+    // Three bits in three different blocks, so only the fourth block is shared.
+    ASSERT_EQ(VISITED_APPROXIMATE, index.visit(PageStateFingerprint(2, simHash ^ (1ULL | 1ULL << 20 | 1ULL << 40))));
+
+    // Four bits are too many, even if they are all in one block.
+    ASSERT_EQ(NEW_STATE, index.visit(PageStateFingerprint(3, simHash ^ (0xFULL << 60))));
+
+    // Approximate matches are recorded, so they match exactly afterwards.
+    ASSERT_EQ(VISITED_EXACT, index.visit(PageStateFingerprint(2, simHash)));
+}
+
+class PageStateAbstractionTest : public WebPageTest
+{
+protected:
+    PageStateFingerprint fingerprint()
+    {
+        return PageStateAbstraction(QSet<QString>()).fingerprint(frame(), QList<EventHandlerDescriptorConstPtr>());
+    }
+};
+
+TEST_F(PageStateAbstractionTest, INCLUDES_FORM_VALUES_BUT_NOT_TEXT) {
+    load("<html><body><p id='clock'>12:00</p><input type='text' id='name'>"
+         "<input type='checkbox' id='agree'><select id='choice'><option>a</option><option>b</option></select></body></html>");
+    quint64 initial = fingerprint().hash;
+
+    evaluate("document.getElementById('clock').textContent = '12:01';");
+    ASSERT_EQ(initial, fingerprint().hash);
+
+    evaluate("document.getElementById('name').value = 'user';");
+    quint64 named = fingerprint().hash;
+    ASSERT_NE(initial, named);
+
+    evaluate("document.getElementById('agree').checked = true;");
+    quint64 agreed = fingerprint().hash;
+    ASSERT_NE(named, agreed);
+
+    evaluate("document.getElementById('choice').selectedIndex = 1;");
+    ASSERT_NE(agreed, fingerprint().hash);
+}
+
+}
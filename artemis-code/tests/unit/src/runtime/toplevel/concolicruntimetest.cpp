@@ -0,0 +1,167 @@
+#include <QList>
+#include <QUrl>
+
+#include "include/gtest/gtest.h"
+
+#include "runtime/toplevel/concolicruntime.h"
+
+#include "../browser/webpagetest.h"
+
+namespace artemis
+{
+
+// The runtime needs the QApplication set up by WebPageTest.
+class ConcolicRuntimeTest : public WebPageTest
+{
+protected:
+    typedef ConcolicRuntime::Exploration Exploration;
+
+    void SetUp()
+    {
+        WebPageTest::SetUp();
+
+        Options options;
+        options.concolicTreeOutput = TREE_NONE;
+        options.headless = true;
+        mRuntime = new ConcolicRuntime(NULL, options, QUrl("about:blank"));
+    }
+
+    void TearDown()
+    {
+        delete mRuntime;
+        WebPageTest::TearDown();
+    }
+
+    static Exploration explored(int frontier, int iterations)
+    {
+        Exploration exploration;
+        exploration.runningWithInitialValues = false;
+        exploration.frontier = frontier;
+        exploration.iterations = iterations;
+        return exploration;
+    }
+
+    static int choose(const QList<Exploration>& explorations)
+    {
+        return ConcolicRuntime::chooseExploration(explorations);
+    }
+
+    void addExploration()
+    {
+        mRuntime->addExploration(EventHandlerDescriptorConstPtr());
+    }
+
+    void storeExploration()
+    {
+        mRuntime->storeExploration();
+    }
+
+    void loadExploration(int index)
+    {
+        mRuntime->loadExploration(index);
+    }
+
+    int currentExploration()
+    {
+        return mRuntime->mCurrentExploration;
+    }
+
+    TraceNodePtr& tree()
+    {
+        return mRuntime->mSymbolicExecutionGraph;
+    }
+
+    int& frontier()
+    {
+        return mRuntime->mFrontier;
+    }
+
+    bool& runningWithInitialValues()
+    {
+        return mRuntime->mRunningWithInitialValues;
+    }
+
+    int& searchPasses()
+    {
+        return mRuntime->mSearchPasses;
+    }
+
+    ConcolicRuntime* mRuntime;
+};
+
+TEST_F(ConcolicRuntimeTest, SCHEDULES_NEW_ENTRY_POINTS_FIRST) {
+    QList<Exploration> explorations;
+    explorations.append(explored(10, 1));
+    explorations.append(Exploration());
+    explorations.append(Exploration());
+
+    ASSERT_EQ(1, choose(explorations));
+
+    explorations[1] = explored(0, 1);
+    ASSERT_EQ(2, choose(explorations));
+}
+
+TEST_F(ConcolicRuntimeTest, SCHEDULES_THE_LARGEST_FRONTIER) {
+    QList<Exploration> explorations;
+    explorations.append(explored(2, 1));
+    explorations.append(explored(5, 8));
+    explorations.append(explored(3, 1));
+
+    ASSERT_EQ(1, choose(explorations));
+
+    // Ties go to the entry point with fewer iterations.
+    explorations[2].frontier = 5;
+    ASSERT_EQ(2, choose(explorations));
+}
+
+TEST_F(ConcolicRuntimeTest, SKIPS_FINISHED_EXPLORATIONS) {
+    QList<Exploration> explorations;
+    explorations.append(explored(2, 1));
+    explorations.append(Exploration());
+    explorations[1].finished = true;
+
+    ASSERT_EQ(0, choose(explorations));
+
+    explorations[0].finished = true;
+    ASSERT_EQ(-1, choose(explorations));
+}
+
+TEST_F(ConcolicRuntimeTest, SWAPS_THE_STATE_OF_EXPLORATIONS) {
+    addExploration();
+    addExploration();
+    loadExploration(0);
+
+    TraceNodePtr firstTree = TraceNodePtr(new TraceEndSuccess());
+    tree() = firstTree;
+    frontier() = 3;
+    runningWithInitialValues() = false;
+    searchPasses() = 1;
+
+    storeExploration();
+    loadExploration(1);
+
+    // The second entry point starts from its own empty tree and the initial search settings.
+    ASSERT_EQ(1, currentExploration());
+    ASSERT_TRUE(tree().isNull());
+    ASSERT_EQ(0, frontier());
+    ASSERT_TRUE(runningWithInitialValues());
+    ASSERT_EQ(3, searchPasses());
+
+    tree() = TraceNodePtr(new TraceEndFailure());
+    frontier() = 7;
+
+    storeExploration();
+    loadExploration(0);
+
+    ASSERT_EQ(firstTree, tree());
+    ASSERT_EQ(3, frontier());
+    ASSERT_FALSE(runningWithInitialValues());
+    ASSERT_EQ(1, searchPasses());
+
+    storeExploration();
+    loadExploration(1);
+
+    ASSERT_EQ(7, frontier());
+}
+
+}
@@ -23,7 +23,9 @@ include(../../artemis-core.pri)
 
 HEADERS += \
     include/gtest/gtest.h \
-    include/gmock/gmock.h
+    include/gmock/gmock.h \
+    src/runtime/browser/webpagetest.h \
+    src/concolic/solver/solvertest.h
 
 SOURCES += \
     src/gtest/gtest_main.cc \
@@ -31,4 +33,27 @@ SOURCES += \
     src/gmock/gmock-all.cc \
     src/strategies/inputgenerator/form/constantstringforminputgeneratortest.cpp \
     src/concolic/solver/cvc4regextest.cpp \
-    src/concolic/solver/cvc4solvertest.cpp
+    src/concolic/solver/cvc4solvertest.cpp \
+    src/concolic/solver/z3solvertest.cpp \
+    src/concolic/solver/expressionserializertest.cpp \
+    src/concolic/solver/expressionevaluatortest.cpp \
+    src/concolic/solver/concreteregextest.cpp \
+    src/concolic/solver/cvc4constraintwritertest.cpp \
+    src/concolic/solver/portfoliosolvertest.cpp \
+    src/concolic/solver/cachingsolvertest.cpp \
+    src/concolic/solver/localsearchsolvertest.cpp \
+    src/concolic/solver/expressionsimplifiertest.cpp \
+    src/model/coverage/codeblockinfotest.cpp \
+    src/model/coverage/codeblockinfobenchmark.cpp \
+    src/concolic/domtokenisertest.cpp \
+    src/concolic/domtokeniserbenchmark.cpp \
+    src/concolic/searchdfstest.cpp \
+    src/concolic/tracestatisticstest.cpp \
+    src/concolic/tracemergertest.cpp \
+    src/concolic/tracecheckpointtest.cpp \
+    src/concolic/traceeventlogtest.cpp \
+    src/runtime/browser/domstatehashtest.cpp \
+    src/runtime/browser/elementatpathtest.cpp \
+    src/runtime/browser/quiescencedetectortest.cpp \
+    src/runtime/pagestate/visitedstateindextest.cpp \
+    src/runtime/toplevel/concolicruntimetest.cpp